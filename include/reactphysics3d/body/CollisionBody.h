@@ -118,6 +118,9 @@ class CollisionBody {
         /// Set the current position and orientation
         virtual void setTransform(const Transform& transform);
 
+        /// Discard the interpolation between the previous and the current transform of the body
+        void resetTransformInterpolation();
+
         /// Create a new collider and add it to the body.
         virtual Collider* addCollider(CollisionShape* collisionShape, const Transform& transform);
 
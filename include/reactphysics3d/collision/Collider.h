@@ -75,6 +75,10 @@ class Collider {
         /// changed by the user
         void setHasCollisionShapeChangedSize(bool hasCollisionShapeChangedSize);
 
+        /// Notify the collider that a region of the collision shape has been
+        /// modified by the user
+        void setHasCollisionShapeChangedRegion(const AABB& localRegionAABB);
+
     public:
 
         // -------------------- Methods -------------------- //
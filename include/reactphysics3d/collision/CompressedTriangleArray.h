@@ -0,0 +1,316 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_COMPRESSED_TRIANGLE_ARRAY_H
+#define REACTPHYSICS3D_COMPRESSED_TRIANGLE_ARRAY_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <cassert>
+
+namespace reactphysics3d {
+
+// Declarations
+class TriangleMesh;
+
+// Structure CompressedTriangleCluster
+/**
+ * A cluster of consecutive triangles of a CompressedTriangleArray. The vertices of
+ * the triangles of a cluster are quantized relative to the bounds of the cluster.
+ */
+struct CompressedTriangleCluster {
+
+    /// Position of the origin of the cluster on the quantization lattice of the array
+    uint32 latticeOrigin[3];
+
+    /// Index of the first vertex of the cluster in the array of vertices
+    uint32 firstVertex;
+
+    /// Index of the first triangle of the cluster
+    uint32 firstTriangle;
+};
+
+// Structure CompressedTriangleVertex
+/**
+ * A vertex of a CompressedTriangleArray with coordinates quantized
+ * relative to the origin of its cluster
+ */
+struct CompressedTriangleVertex {
+
+    /// Quantized coordinates of the vertex
+    uint16 coordinates[3];
+};
+
+// Class CompressedTriangleArray
+/**
+ * This class stores all the triangles of a triangle mesh in a compact format owned
+ * by the engine. The triangles are split into clusters of consecutive triangles.
+ * The duplicated vertices of a cluster are welded and each cluster has its own
+ * vertices. The vertices coordinates are quantized on 16 bits relative to the origin
+ * of their cluster and the vertices normals are encoded with an octahedral mapping on
+ * 2x16 bits. The triangle indices are 8-bits indices in the vertices of their cluster.
+ * The quantization step is the same for all the clusters so that a vertex shared by
+ * two clusters has exactly the same decoded coordinates in both. A cluster is closed
+ * before it contains NB_TRIANGLES_PER_CLUSTER triangles if it becomes larger than
+ * MAX_CLUSTER_SIZE_IN_TRIANGLES times the largest triangle of the mesh. Therefore, the
+ * quantization step does not depend on the order of the triangles of the mesh but
+ * meshes whose consecutive triangles are close to each other use fewer clusters.
+ * The maximum distance between a decoded vertex and the original one is given by
+ * getMaxPositionError().
+ */
+class CompressedTriangleArray {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of triangles in a cluster
+        static constexpr uint32 NB_TRIANGLES_PER_CLUSTER = 64;
+
+        /// Maximum size of a cluster along each axis relative to the size of the largest triangle along this axis
+        static constexpr uint32 MAX_CLUSTER_SIZE_IN_TRIANGLES = 32;
+
+    protected:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Number of triangles in the array
+        uint32 mNbTriangles;
+
+        /// Origin of the quantization lattice (minimum coordinates of the vertices)
+        Vector3 mLatticeMin;
+
+        /// Distance between two consecutive points of the quantization lattice in each direction
+        Vector3 mQuantizationStep;
+
+        /// Clusters of triangles
+        Array<CompressedTriangleCluster> mClusters;
+
+        /// Index of the cluster of the first triangle of each block of NB_TRIANGLES_PER_CLUSTER triangles
+        Array<uint32> mBlocksFirstCluster;
+
+        /// Quantized vertices of all the clusters
+        Array<CompressedTriangleVertex> mVertices;
+
+        /// Octahedral encoded normals of the vertices
+        Array<uint32> mVerticesNormals;
+
+        /// Three indices (in the vertices of its cluster) for each triangle
+        Array<uint8> mIndices;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor of an empty array (filled with cooked data)
+        CompressedTriangleArray(MemoryAllocator& allocator);
+
+        /// Compress the triangles of all the sub-parts of a triangle mesh
+        void compressTriangles(const TriangleMesh& triangleMesh, MemoryAllocator& allocator);
+
+        /// Compute the first cluster of each block of triangles from the clusters
+        void computeBlocksFirstCluster();
+
+        /// Return the cluster of a given triangle
+        const CompressedTriangleCluster& getTriangleCluster(uint32 triangleIndex) const;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        CompressedTriangleArray(const TriangleMesh& triangleMesh, MemoryAllocator& allocator);
+
+        /// Destructor
+        ~CompressedTriangleArray() = default;
+
+        /// Deleted copy-constructor
+        CompressedTriangleArray(const CompressedTriangleArray& array) = delete;
+
+        /// Deleted assignment operator
+        CompressedTriangleArray& operator=(const CompressedTriangleArray& array) = delete;
+
+        /// Return the number of triangles
+        uint32 getNbTriangles() const;
+
+        /// Return the number of vertices (after welding)
+        uint32 getNbVertices() const;
+
+        /// Return the vertices coordinates of a triangle
+        void getTriangleVertices(uint32 triangleIndex, Vector3* outTriangleVertices) const;
+
+        /// Return the three vertices normals of a triangle
+        void getTriangleVerticesNormals(uint32 triangleIndex, Vector3* outTriangleVerticesNormals) const;
+
+        /// Return the indices of the three vertices of a given triangle in the array
+        void getTriangleVerticesIndices(uint32 triangleIndex, uint32* outVerticesIndices) const;
+
+        /// Return the number of clusters
+        uint32 getNbClusters() const;
+
+        /// Return the maximum distance between a decoded vertex and the original vertex
+        decimal getMaxPositionError() const;
+
+        /// Return the number of bytes used by the compressed data
+        size_t getSizeInBytes() const;
+
+        /// Encode a unit vector with an octahedral mapping on 2x16 bits
+        static uint32 encodeNormal(const Vector3& normal);
+
+        /// Decode a unit vector encoded with an octahedral mapping on 2x16 bits
+        static Vector3 decodeNormal(uint32 encodedNormal);
+
+        // ---------- Friendship ---------- //
+
+        friend class TriangleMesh;
+};
+
+// Return the number of triangles
+/**
+ * @return The number of triangles in the array
+ */
+RP3D_FORCE_INLINE uint32 CompressedTriangleArray::getNbTriangles() const {
+    return mNbTriangles;
+}
+
+// Return the number of vertices (after welding)
+/**
+ * @return The number of vertices of all the clusters
+ */
+RP3D_FORCE_INLINE uint32 CompressedTriangleArray::getNbVertices() const {
+    return static_cast<uint32>(mVertices.size());
+}
+
+// Return the number of clusters
+/**
+ * @return The number of clusters of triangles
+ */
+RP3D_FORCE_INLINE uint32 CompressedTriangleArray::getNbClusters() const {
+    return static_cast<uint32>(mClusters.size());
+}
+
+// Return the maximum distance between a decoded vertex and the original vertex
+/// A vertex is rounded to the closest point of the quantization lattice. Therefore, the error
+/// is at most half of the diagonal of a cell of the lattice.
+/**
+ * @return The maximum distance between the decoded position of a vertex and its original position
+ */
+RP3D_FORCE_INLINE decimal CompressedTriangleArray::getMaxPositionError() const {
+    return decimal(0.5) * mQuantizationStep.length();
+}
+
+// Return the cluster of a given triangle
+/// The clusters of a block of consecutive triangles are searched from the cluster of the first
+/// triangle of the block. A block usually has a single cluster.
+RP3D_FORCE_INLINE const CompressedTriangleCluster& CompressedTriangleArray::getTriangleCluster(uint32 triangleIndex) const {
+
+    const uint32 nbClusters = static_cast<uint32>(mClusters.size());
+    uint32 clusterIndex = mBlocksFirstCluster[triangleIndex / NB_TRIANGLES_PER_CLUSTER];
+    while (clusterIndex + 1 < nbClusters && mClusters[clusterIndex + 1].firstTriangle <= triangleIndex) {
+        clusterIndex++;
+    }
+
+    return mClusters[clusterIndex];
+}
+
+// Return the vertices coordinates of a triangle
+/**
+ * @param triangleIndex Index of a given triangle in the array
+ * @param[out] outTriangleVertices Pointer to the three output vertex coordinates
+ */
+RP3D_FORCE_INLINE void CompressedTriangleArray::getTriangleVertices(uint32 triangleIndex, Vector3* outTriangleVertices) const {
+
+    assert(triangleIndex < mNbTriangles);
+
+    const CompressedTriangleCluster& cluster = getTriangleCluster(triangleIndex);
+    const uint8* indices = &(mIndices[triangleIndex * 3]);
+
+    for (uint32 k=0; k < 3; k++) {
+
+        // The decoded coordinates only depend on the position on the lattice
+        const CompressedTriangleVertex& vertex = mVertices[cluster.firstVertex + indices[k]];
+        outTriangleVertices[k].x = mLatticeMin.x + decimal(cluster.latticeOrigin[0] + vertex.coordinates[0]) * mQuantizationStep.x;
+        outTriangleVertices[k].y = mLatticeMin.y + decimal(cluster.latticeOrigin[1] + vertex.coordinates[1]) * mQuantizationStep.y;
+        outTriangleVertices[k].z = mLatticeMin.z + decimal(cluster.latticeOrigin[2] + vertex.coordinates[2]) * mQuantizationStep.z;
+    }
+}
+
+// Return the three vertices normals of a triangle
+/**
+ * @param triangleIndex Index of a given triangle in the array
+ * @param[out] outTriangleVerticesNormals Pointer to the three output vertex normals
+ */
+RP3D_FORCE_INLINE void CompressedTriangleArray::getTriangleVerticesNormals(uint32 triangleIndex, Vector3* outTriangleVerticesNormals) const {
+
+    assert(triangleIndex < mNbTriangles);
+
+    const CompressedTriangleCluster& cluster = getTriangleCluster(triangleIndex);
+    const uint8* indices = &(mIndices[triangleIndex * 3]);
+
+    outTriangleVerticesNormals[0] = decodeNormal(mVerticesNormals[cluster.firstVertex + indices[0]]);
+    outTriangleVerticesNormals[1] = decodeNormal(mVerticesNormals[cluster.firstVertex + indices[1]]);
+    outTriangleVerticesNormals[2] = decodeNormal(mVerticesNormals[cluster.firstVertex + indices[2]]);
+}
+
+// Return the indices of the three vertices of a given triangle in the array
+/**
+ * @param triangleIndex Index of a given triangle in the array
+ * @param[out] outVerticesIndices Pointer to the three output vertex indices
+ */
+RP3D_FORCE_INLINE void CompressedTriangleArray::getTriangleVerticesIndices(uint32 triangleIndex, uint32* outVerticesIndices) const {
+
+    assert(triangleIndex < mNbTriangles);
+
+    const CompressedTriangleCluster& cluster = getTriangleCluster(triangleIndex);
+    outVerticesIndices[0] = cluster.firstVertex + mIndices[triangleIndex * 3];
+    outVerticesIndices[1] = cluster.firstVertex + mIndices[triangleIndex * 3 + 1];
+    outVerticesIndices[2] = cluster.firstVertex + mIndices[triangleIndex * 3 + 2];
+}
+
+// Decode a unit vector encoded with an octahedral mapping on 2x16 bits
+/**
+ * @param encodedNormal The encoded normal (see encodeNormal())
+ * @return The decoded unit vector
+ */
+RP3D_FORCE_INLINE Vector3 CompressedTriangleArray::decodeNormal(uint32 encodedNormal) {
+
+    // Position on the octahedron unfolded in the square [-1, 1]^2
+    const decimal u = decimal(static_cast<int16>(encodedNormal & 0xffffu)) / decimal(32767.0);
+    const decimal v = decimal(static_cast<int16>(encodedNormal >> 16)) / decimal(32767.0);
+
+    Vector3 normal(u, v, decimal(1.0) - std::abs(u) - std::abs(v));
+
+    // Fold back the lower hemisphere
+    if (normal.z < decimal(0.0)) {
+        normal.x = (decimal(1.0) - std::abs(v)) * (u >= decimal(0.0) ? decimal(1.0) : decimal(-1.0));
+        normal.y = (decimal(1.0) - std::abs(u)) * (v >= decimal(0.0) ? decimal(1.0) : decimal(-1.0));
+    }
+
+    return normal.getUnit();
+}
+
+}
+
+#endif
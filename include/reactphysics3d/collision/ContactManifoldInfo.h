@@ -46,7 +46,7 @@ struct ContactManifoldInfo {
         // -------------------- Attributes -------------------- //
 
         /// Number of potential contact points
-        uint8 nbPotentialContactPoints;
+        uint16 nbPotentialContactPoints;
 
         /// Indices of the contact points in the mPotentialContactPoints array
         uint32 potentialContactPointsIndices[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
@@ -30,30 +30,137 @@
 #include <cassert>
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/collision/TriangleVertexArray.h>
+#include <reactphysics3d/collision/CompressedTriangleArray.h>
+#include <reactphysics3d/collision/broadphase/StaticAABBTree.h>
 
 namespace reactphysics3d {
 
-// Declarations
-class TriangleVertexArray;
-
 // Class TriangleMesh
 /**
  * This class represents a mesh made of triangles. A TriangleMesh contains
  * one or several parts. Each part is a set of triangles represented in a
  * TriangleVertexArray object describing all the triangles vertices of the part.
  * A TriangleMesh object can be used to create a ConcaveMeshShape from a triangle
- * mesh for instance.
+ * mesh for instance. A TriangleMesh can also be compressed (see
+ * PhysicsCommon::createCompressedTriangleMesh()). In this case, the triangles are stored
+ * in a CompressedTriangleArray owned by the mesh instead of the TriangleVertexArray
+ * objects of the user and the mesh does not have any TriangleVertexArray. A cooked mesh
+ * (see PhysicsCommon::createCookedTriangleMesh()) is a compressed mesh that also contains
+ * the BVH of its triangles and the adjacency of the edges of its triangles. A cooked mesh can
+ * be written into a buffer (to be saved on disk for instance) and loaded later without any
+ * processing of the triangles.
  */
 class TriangleMesh {
 
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Index used for the adjacent triangle of an edge without adjacent triangle
+        static constexpr uint32 NO_ADJACENT_TRIANGLE = 0xffffffff;
+
     protected:
 
+        /// Header at the beginning of the cooked data of a triangle mesh
+        struct CookedDataHeader {
+
+            /// Magic number used to identify the cooked data
+            uint32 magicNumber;
+
+            /// Version of the cooked data format
+            uint32 version;
+
+            /// Size (in bytes) of a decimal value
+            uint32 decimalSize;
+
+            /// Number of sub-parts of the mesh
+            uint32 nbSubparts;
+
+            /// Number of triangles of the mesh
+            uint32 nbTriangles;
+
+            /// Number of clusters of the compressed triangles
+            uint32 nbClusters;
+
+            /// Number of vertices of the compressed triangles
+            uint32 nbVertices;
+
+            /// Number of nodes of the BVH
+            int32 nbNodes;
+
+            /// Origin of the quantization lattice of the vertices
+            Vector3 latticeMin;
+
+            /// Quantization step of the vertices
+            Vector3 quantizationStep;
+
+            /// AABB of the root node of the BVH
+            AABB rootAABB;
+        };
+
+        /// Magic number of the cooked data
+        static const uint32 COOKED_DATA_MAGIC_NUMBER;
+
+        /// Version of the cooked data format
+        static const uint32 COOKED_DATA_VERSION;
+
+        /// Maximum distance (relative to the edge length) of the opposite vertex of an adjacent
+        /// triangle to the plane of a triangle for the shared edge to be considered flat
+        static const decimal FLAT_EDGE_TOLERANCE;
+
+        // -------------------- Attributes -------------------- //
+
         /// All the triangle arrays of the mesh (one triangle array per part)
         Array<TriangleVertexArray*> mTriangleArrays;
 
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Compressed triangles of all the sub-parts (nullptr if the mesh is not compressed)
+        CompressedTriangleArray* mCompressedTriangles;
+
+        /// Index of the first triangle of each sub-part in the compressed triangles (with
+        /// the total number of triangles at the end)
+        Array<uint32> mCompressedSubpartsFirstTriangle;
+
+        /// True if the mesh is cooked (compressed with a BVH)
+        bool mIsCooked;
+
+        /// BVH of the triangles of a cooked mesh (the data of a leaf is the index of its triangle in the whole mesh)
+        StaticAABBTree mCookedBVH;
+
+        /// Index (in the whole mesh) of the adjacent triangle of each edge of the triangles of a
+        /// cooked mesh (the edge i of a triangle goes from its vertex i to its vertex (i+1) % 3)
+        Array<uint32> mCookedAdjacentTriangles;
+
+        /// Convexity flags of the edges of each triangle of a cooked mesh (the bit i is set if the
+        /// edge i of the triangle is convex or has no adjacent triangle)
+        Array<uint8> mCookedConvexEdges;
+
+        // -------------------- Methods -------------------- //
+
         /// Constructor
         TriangleMesh(reactphysics3d::MemoryAllocator& allocator);
 
+        /// Store the triangles of another mesh in compressed form
+        void compress(const TriangleMesh& triangleMesh);
+
+        /// Compress the triangles of another mesh and build their BVH
+        void cook(const TriangleMesh& triangleMesh);
+
+        /// Compute the adjacent triangles and the convexity of the edges of the compressed triangles
+        void computeEdgesAdjacency();
+
+        /// Load the compressed triangles and the BVH of the mesh from cooked data
+        bool loadCookedData(const void* data, size_t dataSize);
+
+        /// Return true if some cooked data is valid
+        static bool isCookedDataValid(const void* data, size_t dataSize);
+
+        /// Return the BVH of the triangles of a cooked mesh
+        const StaticAABBTree& getCookedBVH() const;
+
     public:
 
         /// Destructor
@@ -68,10 +175,47 @@ class TriangleMesh {
         /// Return the number of subparts of the mesh
         uint32 getNbSubparts() const;
 
+        /// Return the number of triangles of a sub-part of the mesh
+        uint32 getNbTriangles(uint32 indexSubpart) const;
+
+        /// Return the number of triangles of all the sub-parts of the mesh
+        uint32 getNbTriangles() const;
+
+        /// Return the vertices coordinates of a triangle of a sub-part
+        void getTriangleVertices(uint32 indexSubpart, uint32 triangleIndex, Vector3* outTriangleVertices) const;
+
+        /// Return the three vertices normals of a triangle of a sub-part
+        void getTriangleVerticesNormals(uint32 indexSubpart, uint32 triangleIndex, Vector3* outTriangleVerticesNormals) const;
+
+        /// Return the indices of the three vertices of a triangle of a sub-part
+        void getTriangleVerticesIndices(uint32 indexSubpart, uint32 triangleIndex, uint32* outVerticesIndices) const;
+
+        /// Return true if the triangles of the mesh are compressed
+        bool isCompressed() const;
+
+        /// Return a pointer to the compressed triangles of the mesh (nullptr if the mesh is not compressed)
+        const CompressedTriangleArray* getCompressedTriangles() const;
+
+        /// Return true if the mesh is cooked
+        bool isCooked() const;
+
+        /// Return the indices of the adjacent triangles of the three edges of a triangle of a cooked mesh
+        void getTriangleAdjacentTriangles(uint32 indexSubpart, uint32 triangleIndex, uint32* outAdjacentTriangles) const;
+
+        /// Return the convexity flags of the three edges of a triangle of a cooked mesh
+        uint8 getTriangleConvexEdges(uint32 indexSubpart, uint32 triangleIndex) const;
+
+        /// Return the size (in bytes) of the cooked data of the mesh
+        size_t getCookedDataSize() const;
+
+        /// Write the cooked data of the mesh into a buffer
+        size_t writeCookedData(void* buffer, size_t bufferSize) const;
+
 
         // ---------- Friendship ---------- //
 
         friend class PhysicsCommon;
+        friend class ConcaveMeshShape;
 };
 
 // Add a subpart of the mesh
@@ -79,15 +223,18 @@ class TriangleMesh {
  * @param triangleVertexArray Pointer to the TriangleVertexArray to add into the mesh
  */
 RP3D_FORCE_INLINE void TriangleMesh::addSubpart(TriangleVertexArray* triangleVertexArray) {
+    assert(mCompressedTriangles == nullptr);
     mTriangleArrays.add(triangleVertexArray );
 }
 
 // Return a pointer to a given subpart (triangle vertex array) of the mesh
+/// This method cannot be used with a compressed mesh.
 /**
  * @param indexSubpart The index of the sub-part of the mesh
  * @return A pointer to the triangle vertex array of a given sub-part of the mesh
  */
 RP3D_FORCE_INLINE TriangleVertexArray* TriangleMesh::getSubpart(uint32 indexSubpart) const {
+   assert(mCompressedTriangles == nullptr);
    assert(indexSubpart < mTriangleArrays.size());
    return mTriangleArrays[indexSubpart];
 }
@@ -97,9 +244,132 @@ RP3D_FORCE_INLINE TriangleVertexArray* TriangleMesh::getSubpart(uint32 indexSubp
  * @return The number of sub-parts of the mesh
  */
 RP3D_FORCE_INLINE uint32 TriangleMesh::getNbSubparts() const {
+    if (mCompressedTriangles != nullptr) {
+        return static_cast<uint32>(mCompressedSubpartsFirstTriangle.size()) - 1;
+    }
     return static_cast<uint32>(mTriangleArrays.size());
 }
 
+// Return the number of triangles of a sub-part of the mesh
+/**
+ * @param indexSubpart The index of the sub-part of the mesh
+ * @return The number of triangles of the sub-part
+ */
+RP3D_FORCE_INLINE uint32 TriangleMesh::getNbTriangles(uint32 indexSubpart) const {
+    assert(indexSubpart < getNbSubparts());
+    if (mCompressedTriangles != nullptr) {
+        return mCompressedSubpartsFirstTriangle[indexSubpart + 1] - mCompressedSubpartsFirstTriangle[indexSubpart];
+    }
+    return mTriangleArrays[indexSubpart]->getNbTriangles();
+}
+
+// Return the vertices coordinates of a triangle of a sub-part
+/**
+ * @param indexSubpart The index of the sub-part of the mesh
+ * @param triangleIndex Index of the triangle in the sub-part
+ * @param[out] outTriangleVertices Pointer to the three output vertex coordinates
+ */
+RP3D_FORCE_INLINE void TriangleMesh::getTriangleVertices(uint32 indexSubpart, uint32 triangleIndex, Vector3* outTriangleVertices) const {
+    if (mCompressedTriangles != nullptr) {
+        mCompressedTriangles->getTriangleVertices(mCompressedSubpartsFirstTriangle[indexSubpart] + triangleIndex, outTriangleVertices);
+    }
+    else {
+        mTriangleArrays[indexSubpart]->getTriangleVertices(triangleIndex, outTriangleVertices);
+    }
+}
+
+// Return the three vertices normals of a triangle of a sub-part
+/**
+ * @param indexSubpart The index of the sub-part of the mesh
+ * @param triangleIndex Index of the triangle in the sub-part
+ * @param[out] outTriangleVerticesNormals Pointer to the three output vertex normals
+ */
+RP3D_FORCE_INLINE void TriangleMesh::getTriangleVerticesNormals(uint32 indexSubpart, uint32 triangleIndex, Vector3* outTriangleVerticesNormals) const {
+    if (mCompressedTriangles != nullptr) {
+        mCompressedTriangles->getTriangleVerticesNormals(mCompressedSubpartsFirstTriangle[indexSubpart] + triangleIndex, outTriangleVerticesNormals);
+    }
+    else {
+        mTriangleArrays[indexSubpart]->getTriangleVerticesNormals(triangleIndex, outTriangleVerticesNormals);
+    }
+}
+
+// Return the indices of the three vertices of a triangle of a sub-part
+/// For a compressed mesh, the indices are the indices of the welded vertices of all the sub-parts
+/**
+ * @param indexSubpart The index of the sub-part of the mesh
+ * @param triangleIndex Index of the triangle in the sub-part
+ * @param[out] outVerticesIndices Pointer to the three output vertex indices
+ */
+RP3D_FORCE_INLINE void TriangleMesh::getTriangleVerticesIndices(uint32 indexSubpart, uint32 triangleIndex, uint32* outVerticesIndices) const {
+    if (mCompressedTriangles != nullptr) {
+        mCompressedTriangles->getTriangleVerticesIndices(mCompressedSubpartsFirstTriangle[indexSubpart] + triangleIndex, outVerticesIndices);
+    }
+    else {
+        mTriangleArrays[indexSubpart]->getTriangleVerticesIndices(triangleIndex, outVerticesIndices);
+    }
+}
+
+// Return true if the triangles of the mesh are compressed
+/**
+ * @return True if the mesh has been created with PhysicsCommon::createCompressedTriangleMesh()
+ */
+RP3D_FORCE_INLINE bool TriangleMesh::isCompressed() const {
+    return mCompressedTriangles != nullptr;
+}
+
+// Return a pointer to the compressed triangles of the mesh (nullptr if the mesh is not compressed)
+/**
+ * @return A pointer to the compressed triangles of the mesh
+ */
+RP3D_FORCE_INLINE const CompressedTriangleArray* TriangleMesh::getCompressedTriangles() const {
+    return mCompressedTriangles;
+}
+
+// Return true if the mesh is cooked
+/**
+ * @return True if the mesh has been created with PhysicsCommon::createCookedTriangleMesh() or
+ *         PhysicsCommon::createTriangleMeshFromCookedData()
+ */
+RP3D_FORCE_INLINE bool TriangleMesh::isCooked() const {
+    return mIsCooked;
+}
+
+// Return the indices of the adjacent triangles of the three edges of a triangle of a cooked mesh
+/// The edge i of a triangle goes from its vertex i to its vertex (i+1) % 3. The adjacent triangles
+/// are given by their index in the whole mesh and NO_ADJACENT_TRIANGLE is returned for an edge that
+/// is not shared by exactly two triangles with the same orientation.
+/**
+ * @param indexSubpart The index of the sub-part of the mesh
+ * @param triangleIndex Index of the triangle in the sub-part
+ * @param[out] outAdjacentTriangles Pointer to the three output triangle indices
+ */
+RP3D_FORCE_INLINE void TriangleMesh::getTriangleAdjacentTriangles(uint32 indexSubpart, uint32 triangleIndex, uint32* outAdjacentTriangles) const {
+    assert(mIsCooked);
+    const uint32 triangleId = mCompressedSubpartsFirstTriangle[indexSubpart] + triangleIndex;
+    outAdjacentTriangles[0] = mCookedAdjacentTriangles[triangleId * 3];
+    outAdjacentTriangles[1] = mCookedAdjacentTriangles[triangleId * 3 + 1];
+    outAdjacentTriangles[2] = mCookedAdjacentTriangles[triangleId * 3 + 2];
+}
+
+// Return the convexity flags of the three edges of a triangle of a cooked mesh
+/// The bit i of the flags is set if the edge i (from the vertex i to the vertex (i+1) % 3) is
+/// convex or has no adjacent triangle. It is not set if the edge is flat or concave.
+/**
+ * @param indexSubpart The index of the sub-part of the mesh
+ * @param triangleIndex Index of the triangle in the sub-part
+ * @return The convexity flags of the edges of the triangle
+ */
+RP3D_FORCE_INLINE uint8 TriangleMesh::getTriangleConvexEdges(uint32 indexSubpart, uint32 triangleIndex) const {
+    assert(mIsCooked);
+    return mCookedConvexEdges[mCompressedSubpartsFirstTriangle[indexSubpart] + triangleIndex];
+}
+
+// Return the BVH of the triangles of a cooked mesh
+RP3D_FORCE_INLINE const StaticAABBTree& TriangleMesh::getCookedBVH() const {
+    assert(mIsCooked);
+    return mCookedBVH;
+}
+
 }
 
 #endif
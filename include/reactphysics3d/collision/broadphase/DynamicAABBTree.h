@@ -43,6 +43,8 @@ struct RaycastTest;
 class AABB;
 class Profiler;
 class MemoryAllocator;
+class SnapshotWriter;
+class SnapshotReader;
 
 
 // Structure TreeNode
@@ -143,6 +145,19 @@ class DynamicAABBTree {
 
     private:
 
+        /// Leaf used during the top-down construction of the tree
+        struct BuildLeaf {
+
+            /// AABB of the leaf
+            AABB aabb;
+
+            /// Center of the AABB of the leaf
+            Vector3 centroid;
+
+            /// Index of the leaf in the input arrays
+            int32 index;
+        };
+
         // -------------------- Attributes -------------------- //
 
         /// Memory allocator
@@ -199,6 +214,12 @@ class DynamicAABBTree {
         /// Initialize the tree
         void init();
 
+        /// Release the memory of the nodes
+        void releaseNodes();
+
+        /// Compute the best split of a range of leaves using the binned surface area heuristic
+        int32 computeSAHSplit(BuildLeaf* leaves, int32 start, int32 end) const;
+
 #ifndef NDEBUG
 
         /// Check if the tree structure is valid (for debugging purpose)
@@ -259,6 +280,27 @@ class DynamicAABBTree {
         /// Clear all the nodes and reset the tree
         void reset();
 
+        /// Build the whole tree from a set of leaves using the surface area heuristic (SAH)
+        void buildTopDown(const AABB* leafAABBs, const int32* leafData, int32 nbLeaves);
+
+        /// Return a pointer to the array of nodes of the tree
+        const TreeNode* getNodes() const;
+
+        /// Return the number of allocated nodes in the nodes array of the tree
+        int32 getNbAllocatedNodes() const;
+
+        /// Return the ID of the root node of the tree
+        int32 getRootNodeID() const;
+
+        /// Write the nodes of the tree into a snapshot
+        void takeSnapshot(SnapshotWriter& writer) const;
+
+        /// Check that a snapshot of the nodes of the tree is valid and skip it
+        bool validateSnapshot(SnapshotReader& reader) const;
+
+        /// Restore the nodes of the tree from a snapshot
+        void restoreSnapshot(SnapshotReader& reader);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -298,6 +340,21 @@ RP3D_FORCE_INLINE AABB DynamicAABBTree::getRootAABB() const {
     return getFatAABB(mRootNodeID);
 }
 
+// Return a pointer to the array of nodes of the tree
+RP3D_FORCE_INLINE const TreeNode* DynamicAABBTree::getNodes() const {
+    return mNodes;
+}
+
+// Return the number of allocated nodes in the nodes array of the tree
+RP3D_FORCE_INLINE int32 DynamicAABBTree::getNbAllocatedNodes() const {
+    return mNbAllocatedNodes;
+}
+
+// Return the ID of the root node of the tree
+RP3D_FORCE_INLINE int32 DynamicAABBTree::getRootNodeID() const {
+    return mRootNodeID;
+}
+
 // Add an object into the tree. This method creates a new leaf node in the tree and
 // returns the ID of the corresponding node.
 RP3D_FORCE_INLINE int32 DynamicAABBTree::addObject(const AABB& aabb, int32 data1, int32 data2) {
@@ -0,0 +1,252 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_STATIC_AABB_TREE_H
+#define REACTPHYSICS3D_STATIC_AABB_TREE_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/collision/shapes/AABB.h>
+#include <reactphysics3d/containers/Array.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+struct Ray;
+class Profiler;
+class MemoryAllocator;
+
+// Structure QuantizedTreeNode
+/**
+ * This structure represents a node of a static AABB tree. The AABB of the node is
+ * quantized with 16 bits per coordinate relative to the AABB of its parent node. The
+ * nodes are stored in depth-first order so that the left child of an internal node is
+ * always the next node in the array.
+ */
+struct QuantizedTreeNode {
+
+    // -------------------- Constants -------------------- //
+
+    /// Maximum quantized value of a coordinate
+    const static uint16 MAX_QUANTIZED_VALUE = 65535;
+
+    // -------------------- Attributes -------------------- //
+
+    /// Quantized minimum coordinates of the AABB (relative to the minimum of the parent AABB)
+    uint16 quantizedMin[3];
+
+    /// Quantized maximum coordinates of the AABB (relative to the maximum of the parent AABB)
+    uint16 quantizedMax[3];
+
+    /// Index of the right child node (internal node) or -(data + 1) for a leaf node
+    int32 rightChildOrData;
+
+    // -------------------- Methods -------------------- //
+
+    /// Return true if the node is a leaf of the tree
+    bool isLeaf() const;
+
+    /// Return the data of a leaf node
+    int32 getData() const;
+
+    /// Compute the AABB of the node from the AABB of its parent and the quantization step of the parent
+    AABB computeAABB(const AABB& parentAABB, const Vector3& parentStep) const;
+
+    /// Return the size of a quantization step along each axis inside an AABB
+    static Vector3 computeQuantizationStep(const AABB& aabb);
+};
+
+// Class StaticAABBTreeRaycastCallback
+/**
+ * Raycast callback in the static AABB tree called when the AABB of a leaf
+ * node is hit by the ray.
+ */
+class StaticAABBTreeRaycastCallback {
+
+    public:
+
+        // Called when the AABB of a leaf node is hit by a ray
+        virtual decimal raycastLeaf(int32 leafData, const Ray& ray)=0;
+
+        virtual ~StaticAABBTreeRaycastCallback() = default;
+
+};
+
+// Class StaticAABBTree
+/**
+ * This class implements a compact AABB tree for static objects. The tree is built once
+ * with the surface area heuristic and cannot be modified afterwards. The AABBs of the nodes
+ * are quantized relative to the AABB of their parent which makes a node only 16 bytes and
+ * makes the traversal of the tree touch much less memory than with a DynamicAABBTree.
+ */
+class StaticAABBTree {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Pointer to the memory location of the nodes of the tree
+        QuantizedTreeNode* mNodes;
+
+        /// Number of nodes in the tree
+        int32 mNbNodes;
+
+        /// AABB of the root node of the tree
+        AABB mRootAABB;
+
+        /// True if the nodes memory is owned by the user (nodes loaded from external data)
+        bool mIsUsingExternalNodes;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Pointer to the profiler
+		Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Release the memory of the nodes (if it is owned by the tree)
+        void releaseNodes();
+
+        /// Quantize the AABB of a node relative to the AABB of its parent
+        static void quantizeAABB(const AABB& aabb, const AABB& parentAABB, QuantizedTreeNode& node);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        StaticAABBTree(MemoryAllocator& allocator);
+
+        /// Destructor
+        ~StaticAABBTree();
+
+        /// Deleted copy-constructor
+        StaticAABBTree(const StaticAABBTree& tree) = delete;
+
+        /// Deleted assignment operator
+        StaticAABBTree& operator=(const StaticAABBTree& tree) = delete;
+
+        /// Build the tree with a set of leaves
+        void build(const AABB* leafAABBs, int32 nbLeaves);
+
+        /// Use an external read-only array of nodes for the tree (without copying it)
+        void setExternalNodes(const QuantizedTreeNode* nodes, int32 nbNodes, const AABB& rootAABB);
+
+        /// Use a copy of an array of nodes for the tree
+        void copyNodes(const QuantizedTreeNode* nodes, int32 nbNodes, const AABB& rootAABB);
+
+        /// Return true if an array of nodes (possibly not aligned) only references valid nodes and leaves data
+        static bool areNodesValid(const void* nodes, int32 nbNodes, int32 nbLeavesData);
+
+        /// Return a pointer to the array of nodes of the tree
+        const QuantizedTreeNode* getNodes() const;
+
+        /// Return the number of nodes of the tree
+        int32 getNbNodes() const;
+
+        /// Return the root AABB of the tree
+        const AABB& getRootAABB() const;
+
+        /// Report the data of all the leaves overlapping with the AABB given in parameter
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingLeavesData) const;
+
+        /// Ray casting method
+        void raycast(const Ray& ray, StaticAABBTreeRaycastCallback& callback) const;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Set the profiler
+		void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+// Return true if the node is a leaf of the tree
+RP3D_FORCE_INLINE bool QuantizedTreeNode::isLeaf() const {
+    return rightChildOrData < 0;
+}
+
+// Return the data of a leaf node
+RP3D_FORCE_INLINE int32 QuantizedTreeNode::getData() const {
+    assert(isLeaf());
+    return -(rightChildOrData + 1);
+}
+
+// Compute the AABB of the node from the AABB of its parent and the quantization step of the parent
+/// The minimum coordinates are relative to the minimum of the parent AABB and the maximum
+/// coordinates are relative to the maximum of the parent AABB. This way, the extreme
+/// quantized values give exactly the bounds of the parent AABB.
+RP3D_FORCE_INLINE AABB QuantizedTreeNode::computeAABB(const AABB& parentAABB, const Vector3& parentStep) const {
+
+    const Vector3& parentMin = parentAABB.getMin();
+    const Vector3& parentMax = parentAABB.getMax();
+
+    AABB aabb;
+    aabb.setMin(Vector3(parentMin.x + quantizedMin[0] * parentStep.x, parentMin.y + quantizedMin[1] * parentStep.y,
+                        parentMin.z + quantizedMin[2] * parentStep.z));
+    aabb.setMax(Vector3(parentMax.x - quantizedMax[0] * parentStep.x, parentMax.y - quantizedMax[1] * parentStep.y,
+                        parentMax.z - quantizedMax[2] * parentStep.z));
+    return aabb;
+}
+
+// Return the size of a quantization step along each axis inside an AABB
+RP3D_FORCE_INLINE Vector3 QuantizedTreeNode::computeQuantizationStep(const AABB& aabb) {
+    return (aabb.getMax() - aabb.getMin()) * (decimal(1.0) / decimal(MAX_QUANTIZED_VALUE));
+}
+
+// Return a pointer to the array of nodes of the tree
+RP3D_FORCE_INLINE const QuantizedTreeNode* StaticAABBTree::getNodes() const {
+    return mNodes;
+}
+
+// Return the number of nodes of the tree
+RP3D_FORCE_INLINE int32 StaticAABBTree::getNbNodes() const {
+    return mNbNodes;
+}
+
+// Return the root AABB of the tree
+RP3D_FORCE_INLINE const AABB& StaticAABBTree::getRootAABB() const {
+    return mRootAABB;
+}
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+RP3D_FORCE_INLINE void StaticAABBTree::setProfiler(Profiler* profiler) {
+	mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+#define	REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseAlgorithm.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+struct NarrowPhaseInfoBatch;
+class Transform;
+
+// Class BoxVsBoxAlgorithm
+/**
+ * This class is used to compute the narrow-phase collision detection
+ * between two box collision shapes. The 15 potential separating axes (the
+ * three face normals of each box and the nine cross products of their edges)
+ * are tested directly from the half-extents of the boxes and their relative
+ * rotation without going through the half-edge structure of the boxes. The
+ * contact points of a face contact are computed by clipping the incident face
+ * against the rectangle of the reference face and the contact point of an
+ * edge contact is the closest point between the two edges.
+ */
+class BoxVsBoxAlgorithm : public NarrowPhaseAlgorithm {
+
+    protected :
+
+        // -------------------- Constants -------------------- //
+
+        /// Relative and absolute bias used to make sure the SAT algorithm returns the same penetration axis between frames
+        static const decimal SEPARATING_AXIS_RELATIVE_TOLERANCE;
+        static const decimal SEPARATING_AXIS_ABSOLUTE_TOLERANCE;
+
+        /// Minimum squared length of the cross product of two edges to be tested as a separating axis
+        static const decimal PARALLEL_EDGES_TOLERANCE;
+
+        // -------------------- Methods -------------------- //
+
+        /// Compute the contact points between the reference face of a box and the incident face of the other box
+        bool computeFaceContactPoints(const Vector3& referenceHalfExtents, const Vector3& incidentHalfExtents,
+                                      const Transform& referenceToIncidentTransform, const Transform& incidentToReferenceTransform,
+                                      int referenceAxis, decimal referenceNormalSign, bool isReferenceBox1,
+                                      NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) const;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BoxVsBoxAlgorithm() = default;
+
+        /// Destructor
+        virtual ~BoxVsBoxAlgorithm() override = default;
+
+        /// Deleted copy-constructor
+        BoxVsBoxAlgorithm(const BoxVsBoxAlgorithm& algorithm) = delete;
+
+        /// Deleted assignment operator
+        BoxVsBoxAlgorithm& operator=(const BoxVsBoxAlgorithm& algorithm) = delete;
+
+        /// Compute the narrow-phase collision detection between two boxes
+        bool testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems);
+};
+
+}
+
+#endif
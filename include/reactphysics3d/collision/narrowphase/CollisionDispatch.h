@@ -33,6 +33,7 @@
 #include <reactphysics3d/collision/narrowphase/CapsuleVsCapsuleAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/CapsuleVsConvexPolyhedronAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/ConvexPolyhedronVsConvexPolyhedronAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/BoxVsBoxAlgorithm.h>
 #include <reactphysics3d/collision/shapes/CollisionShape.h>
 
 namespace reactphysics3d {
@@ -46,7 +47,9 @@ enum class NarrowPhaseAlgorithmType {
     CapsuleVsCapsule,
     SphereVsConvexPolyhedron,
     CapsuleVsConvexPolyhedron,
-    ConvexPolyhedronVsConvexPolyhedron
+    ConvexPolyhedronVsConvexPolyhedron,
+    BoxVsBox,
+    ConvexPolyhedronVsConvexPolyhedronEPA
 };
 
 // Class CollisionDispatch
@@ -59,6 +62,11 @@ class CollisionDispatch {
 
     protected:
 
+        // -------------------- Constants -------------------- //
+
+        /// Default minimum number of pairs of edges to use the EPA algorithm between two convex polyhedra
+        static const uint32 DEFAULT_MIN_NB_EDGE_PAIRS_FOR_EPA;
+
         /// Memory allocator
         MemoryAllocator& mAllocator;
 
@@ -80,6 +88,9 @@ class CollisionDispatch {
         /// True if the convex polyhedron vs convex polyhedron algorithm is the default one
         bool mIsConvexPolyhedronVsConvexPolyhedronDefault = true;
 
+        /// True if the box vs box algorithm is the default one
+        bool mIsBoxVsBoxDefault = true;
+
         /// Sphere vs Sphere collision algorithm
         SphereVsSphereAlgorithm* mSphereVsSphereAlgorithm;
 
@@ -98,6 +109,13 @@ class CollisionDispatch {
         /// Convex Polyhedron vs Convex Polyhedron collision algorithm
         ConvexPolyhedronVsConvexPolyhedronAlgorithm* mConvexPolyhedronVsConvexPolyhedronAlgorithm;
 
+        /// Box vs Box collision algorithm
+        BoxVsBoxAlgorithm* mBoxVsBoxAlgorithm;
+
+        /// Minimum number of pairs of edges (product of the numbers of edges of the two polyhedra)
+        /// for which we use the EPA algorithm instead of the SAT algorithm between two convex polyhedra
+        uint32 mMinNbEdgePairsForEPA;
+
         /// Collision detection matrix (algorithms to use)
         NarrowPhaseAlgorithmType mCollisionMatrix[NB_COLLISION_SHAPE_TYPES][NB_COLLISION_SHAPE_TYPES];
 
@@ -156,6 +174,18 @@ class CollisionDispatch {
         /// Get the Convex Polyhedron vs Convex Polyhedron narrow-phase collision detection algorithm
         ConvexPolyhedronVsConvexPolyhedronAlgorithm* getConvexPolyhedronVsConvexPolyhedronAlgorithm();
 
+        /// Set the Box vs Box narrow-phase collision detection algorithm
+        void setBoxVsBoxAlgorithm(BoxVsBoxAlgorithm* algorithm);
+
+        /// Get the Box vs Box narrow-phase collision detection algorithm
+        BoxVsBoxAlgorithm* getBoxVsBoxAlgorithm();
+
+        /// Return the minimum number of pairs of edges to use the EPA algorithm between two convex polyhedra
+        uint32 getMinNbEdgePairsForEPA() const;
+
+        /// Set the minimum number of pairs of edges to use the EPA algorithm between two convex polyhedra
+        void setMinNbEdgePairsForEPA(uint32 minNbEdgePairs);
+
         /// Fill-in the collision detection matrix
         void fillInCollisionMatrix();
 
@@ -163,6 +193,9 @@ class CollisionDispatch {
         NarrowPhaseAlgorithmType selectNarrowPhaseAlgorithm(const CollisionShapeType& shape1Type,
                                                             const CollisionShapeType& shape2Type) const;
 
+        /// Return the corresponding narrow-phase algorithm type to use for two convex collision shapes
+        NarrowPhaseAlgorithmType selectNarrowPhaseAlgorithm(const CollisionShape* shape1, const CollisionShape* shape2) const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -202,6 +235,24 @@ RP3D_FORCE_INLINE ConvexPolyhedronVsConvexPolyhedronAlgorithm* CollisionDispatch
     return mConvexPolyhedronVsConvexPolyhedronAlgorithm;
 }
 
+// Get the Box vs Box narrow-phase collision detection algorithm
+RP3D_FORCE_INLINE BoxVsBoxAlgorithm* CollisionDispatch::getBoxVsBoxAlgorithm() {
+    return mBoxVsBoxAlgorithm;
+}
+
+// Return the minimum number of pairs of edges to use the EPA algorithm between two convex polyhedra
+RP3D_FORCE_INLINE uint32 CollisionDispatch::getMinNbEdgePairsForEPA() const {
+    return mMinNbEdgePairsForEPA;
+}
+
+// Set the minimum number of pairs of edges to use the EPA algorithm between two convex polyhedra
+/// The SAT algorithm tests all the pairs of edges of two convex polyhedra. When the product of the numbers
+/// of edges of the two polyhedra is at least this value, the EPA algorithm is used instead. Note that the
+/// algorithm of an overlapping pair is selected when the pair is created.
+RP3D_FORCE_INLINE void CollisionDispatch::setMinNbEdgePairsForEPA(uint32 minNbEdgePairs) {
+    mMinNbEdgePairsForEPA = minNbEdgePairs;
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
@@ -214,6 +265,7 @@ RP3D_FORCE_INLINE void CollisionDispatch::setProfiler(Profiler* profiler) {
     mSphereVsConvexPolyhedronAlgorithm->setProfiler(profiler);
     mCapsuleVsConvexPolyhedronAlgorithm->setProfiler(profiler);
     mConvexPolyhedronVsConvexPolyhedronAlgorithm->setProfiler(profiler);
+    mBoxVsBoxAlgorithm->setProfiler(profiler);
 }
 
 #endif
@@ -42,12 +42,22 @@ struct NarrowPhaseInfoBatch;
  * between two convex polyhedra. Here we do not use the GJK algorithm but
  * we run the SAT algorithm to get the contact points and normal.
  * This is based on the "Robust Contact Creation for Physics Simulation"
- * presentation by Dirk Gregorius.
+ * presentation by Dirk Gregorius. For polyhedra with many edges, the
+ * penetration axis can also be computed with the EPA algorithm (see
+ * testCollisionUsingEPA()) and the SAT clipping is only used to compute the
+ * contact points of a face contact.
  */
 class ConvexPolyhedronVsConvexPolyhedronAlgorithm : public NarrowPhaseAlgorithm {
 
     protected :
 
+        // -------------------- Constants -------------------- //
+
+        /// Relative and absolute bias used to prefer a face normal axis (with more contact points) over
+        /// the penetration axis found by the EPA algorithm when their penetration depths are almost the same
+        static const decimal FACE_CONTACT_RELATIVE_TOLERANCE;
+        static const decimal FACE_CONTACT_ABSOLUTE_TOLERANCE;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -67,6 +77,10 @@ class ConvexPolyhedronVsConvexPolyhedronAlgorithm : public NarrowPhaseAlgorithm
         /// Compute the narrow-phase collision detection between two convex polyhedra
         bool testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems,
                            bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator);
+
+        /// Compute the narrow-phase collision detection between two convex polyhedra with the EPA algorithm
+        bool testCollisionUsingEPA(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems,
+                                   bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator);
 };
 
 }
@@ -0,0 +1,179 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_EPA_ALGORITHM_H
+#define REACTPHYSICS3D_EPA_ALGORITHM_H
+
+// Libraries
+#include <reactphysics3d/decimal.h>
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/containers/Pair.h>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class ConvexShape;
+class MemoryAllocator;
+class Profiler;
+class Transform;
+
+// Class EPAAlgorithm
+/**
+ * This class implements the Expanding Polytope Algorithm (EPA) to compute the penetration
+ * depth between two convex shapes (without margin). The GJK algorithm is first used to find
+ * a simplex of the Minkowski difference of the two shapes that contains the origin. This simplex
+ * is then expanded into a polytope until the face of the polytope closest to the origin is
+ * on the boundary of the Minkowski difference. The cost of this algorithm depends on the number
+ * of support point queries instead of the number of pairs of edges of the two shapes. This
+ * implementation is based on the book "Collision Detection in Interactive 3D Environments"
+ * by Gino van den Bergen.
+ */
+class EPAAlgorithm {
+
+    public :
+
+        enum class EPAResult {
+            SEPARATED,              // The two shapes are separated
+            INTERPENETRATE,         // The two shapes overlap and the penetration depth has been computed
+            FAILED                  // The penetration depth could not be computed (degenerate polytope)
+        };
+
+    private :
+
+        /// Triangle face of the expanding polytope
+        struct TriangleEPA {
+
+            /// Indices of the three vertices of the triangle (counter-clockwise seen from outside)
+            uint32 vertices[3];
+
+            /// Outward unit normal of the triangle
+            Vector3 normal;
+
+            /// Distance between the origin and the plane of the triangle
+            decimal distance;
+
+            /// True if the triangle has been removed from the polytope
+            bool isObsolete;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of iterations of the GJK algorithm
+        static const uint32 MAX_NB_GJK_ITERATIONS;
+
+        /// Maximum number of iterations of the expanding polytope
+        static const uint32 MAX_NB_EPA_ITERATIONS;
+
+        /// Relative and absolute tolerance used to stop the expansion of the polytope
+        static const decimal EPA_RELATIVE_TOLERANCE;
+        static const decimal EPA_ABSOLUTE_TOLERANCE;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Points of the polytope (Minkowski difference) in local-space of the first shape
+        Array<Vector3> mPoints;
+
+        /// Support points of the first shape for each point of the polytope
+        Array<Vector3> mSuppPointsA;
+
+        /// Support points of the second shape (in local-space of the first shape) for each point of the polytope
+        Array<Vector3> mSuppPointsB;
+
+        /// Triangle faces of the polytope
+        Array<TriangleEPA> mTriangles;
+
+        /// Edges of the horizon seen from a new support point
+        Array<Pair<uint32, uint32>> mHorizonEdges;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Pointer to the profiler
+        Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Compute the support point of the Minkowski difference of the two shapes in a given direction
+        void computeSupportPoint(const ConvexShape* shape1, const ConvexShape* shape2, const Transform& shape2ToShape1,
+                                 const Vector3& direction, Vector3& outSuppPointA, Vector3& outSuppPointB) const;
+
+        /// Add a point to the polytope and return its index
+        uint32 addPoint(const Vector3& suppPointA, const Vector3& suppPointB);
+
+        /// Add a triangle to the polytope and return false if the triangle is degenerate
+        bool addTriangle(uint32 v0, uint32 v1, uint32 v2);
+
+        /// Complete the final simplex of the GJK algorithm into a tetrahedron
+        bool completeTetrahedron(const ConvexShape* shape1, const ConvexShape* shape2, const Transform& shape2ToShape1);
+
+        /// Remove the triangles visible from a new point of the polytope and replace them with triangles to this point
+        bool expandPolytope(uint32 newPointIndex);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        EPAAlgorithm(MemoryAllocator& memoryAllocator);
+
+        /// Destructor
+        ~EPAAlgorithm() = default;
+
+        /// Deleted copy-constructor
+        EPAAlgorithm(const EPAAlgorithm& algorithm) = delete;
+
+        /// Deleted assignment operator
+        EPAAlgorithm& operator=(const EPAAlgorithm& algorithm) = delete;
+
+        /// Compute the penetration depth between two convex shapes
+        EPAResult computePenetrationDepth(const ConvexShape* shape1, const ConvexShape* shape2, const Transform& shape2ToShape1,
+                                          Vector3& inOutSearchDirection, Vector3& outNormal, decimal& outPenetrationDepth,
+                                          Vector3& outContactPointShape1, Vector3& outContactPointShape2);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Set the profiler
+        void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+RP3D_FORCE_INLINE void EPAAlgorithm::setProfiler(Profiler* profiler) {
+    mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
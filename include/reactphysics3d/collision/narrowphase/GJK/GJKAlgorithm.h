@@ -37,7 +37,13 @@ namespace reactphysics3d {
 struct ContactManifoldInfo;
 struct NarrowPhaseInfoBatch;
 class ConvexShape;
+class SphereShape;
+class CapsuleShape;
+class BoxShape;
+class ConvexMeshShape;
+class TriangleShape;
 class Profiler;
+struct Vector3;
 class VoronoiSimplex;
 template<typename T> class Array;
 
@@ -58,6 +64,8 @@ constexpr int MAX_ITERATIONS_GJK_RAYCAST = 32;
  * computed using the GJK algorithm on the original objects (without margin).
  * If the original objects (without margin) intersect, we exit GJK and run
  * the SAT algorithm to get contacts and collision data.
+ * The GJK loop is instantiated for each combination of shape types so that the
+ * support functions of the shapes are inlined instead of being virtual calls.
  */
 class GJKAlgorithm {
 
@@ -72,8 +80,6 @@ class GJKAlgorithm {
 
 #endif
 
-        // -------------------- Methods -------------------- //
-
     public :
 
         enum class GJKResult {
@@ -82,6 +88,43 @@ class GJKAlgorithm {
             INTERPENETRATE          // The two shapes overlap event without the margin (deep penetration)
         };
 
+    private :
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the local support point of a sphere without margin
+        static Vector3 computeLocalSupportPoint(const SphereShape* shape, const Vector3& direction);
+
+        /// Return the local support point of a capsule without margin
+        static Vector3 computeLocalSupportPoint(const CapsuleShape* shape, const Vector3& direction);
+
+        /// Return the local support point of a box without margin
+        static Vector3 computeLocalSupportPoint(const BoxShape* shape, const Vector3& direction);
+
+        /// Return the local support point of a convex mesh without margin
+        static Vector3 computeLocalSupportPoint(const ConvexMeshShape* shape, const Vector3& direction);
+
+        /// Return the local support point of a triangle without margin
+        static Vector3 computeLocalSupportPoint(const TriangleShape* shape, const Vector3& direction);
+
+        /// Return the local support point of a convex shape of unknown type without margin
+        static Vector3 computeLocalSupportPoint(const ConvexShape* shape, const Vector3& direction);
+
+        /// Select the GJK kernel for the type of the second shape of a pair
+        template<typename ShapeType1>
+        GJKResult testCollisionWithShapeType2(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex);
+
+        /// Run the GJK algorithm on a pair of shapes whose types are known at compile time
+        template<typename ShapeType1, typename ShapeType2>
+        GJKResult testCollisionPair(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex);
+
+        /// Compute a contact info if the two bounding volumes collide using the generic GJK kernel
+        /// (virtual support functions) for all the shape types
+        void testCollisionGeneric(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex,
+                                  uint32 batchNbItems, Array<GJKResult>& gjkResults);
+
+    public :
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -107,6 +150,10 @@ class GJKAlgorithm {
 
 #endif
 
+        // -------------------- Friendship -------------------- //
+
+        /// The unit test compares the specialized kernels with the generic kernel
+        friend class TestGJKAlgorithm;
 };
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -40,6 +40,9 @@ struct NarrowPhaseInfoBatch;
 struct ContactPointInfo;
 class Profiler;
 class MemoryAllocator;
+class ConvexShape;
+class Transform;
+struct LastFrameCollisionInfo;
 
 // Class NarrowPhaseCallback
 /**
@@ -62,7 +65,10 @@ class NarrowPhaseCallback {
 /**
  * This abstract class is the base class for a  narrow-phase collision
  * detection algorithm. The goal of the narrow phase algorithm is to
- * compute information about the contact between two colliders.
+ * compute information about the contact between two colliders. The algorithms
+ * store the axis that separated two shapes into the LastFrameCollisionInfo of the
+ * pair so that the narrow-phase test can be skipped in the next frames if the shapes
+ * are still separated along this axis.
  */
 class NarrowPhaseAlgorithm {
 
@@ -94,6 +100,11 @@ class NarrowPhaseAlgorithm {
         /// Deleted assignment operator
         NarrowPhaseAlgorithm& operator=(const NarrowPhaseAlgorithm& algorithm) = delete;
 
+        /// Return true if two convex shapes are still separated along the separating axis of the previous frame
+        static bool isSeparatedAlongLastFrameAxis(const ConvexShape* shape1, const ConvexShape* shape2,
+                                                  const Transform& shape1ToWorldTransform, const Transform& shape2ToWorldTransform,
+                                                  const LastFrameCollisionInfo& lastFrameInfo);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -40,6 +40,23 @@ struct LastFrameCollisionInfo;
 struct ContactManifoldInfo;
 struct ContactPointInfo;
 
+// Struct NarrowPhaseTriangle
+/**
+ * A triangle of a concave shape to test collision with during the narrow-phase. The
+ * triangle is stored directly in a narrow-phase batch (without any TriangleShape object).
+ */
+struct NarrowPhaseTriangle {
+
+    /// Three vertices of the triangle (in the local-space of the concave shape)
+    Vector3 vertices[3];
+
+    /// Three vertices normals for smooth collision with the triangle mesh
+    Vector3 verticesNormals[3];
+
+    /// Flags of the flat or concave edges of the triangle in its mesh
+    uint8 internalEdges;
+};
+
 // Struct NarrowPhaseInfoBatch
 /**
  * This structure collects all the potential collisions from the middle-phase algorithm
@@ -111,11 +128,18 @@ struct NarrowPhaseInfoBatch {
         /// Cached capacity
         uint32 mCachedCapacity = 0;
 
+        /// Cached capacity of the triangles
+        uint32 mCachedTrianglesCapacity = 0;
+
     public:
 
         /// For each collision test, we keep some meta data
         Array<NarrowPhaseInfo> narrowPhaseInfos;
 
+        /// Triangle of each collision test of a batch of tests against triangles (the triangle of
+        /// a test replaces the collision shape that is nullptr in its narrow-phase info)
+        Array<NarrowPhaseTriangle> triangles;
+
         /// Constructor
         NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator);
 
@@ -127,6 +151,12 @@ struct NarrowPhaseInfoBatch {
                                                       CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
                                                       bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
 
+        /// Add a convex shape and a triangle to be tested during narrow-phase collision detection into the batch
+        void addNarrowPhaseInfoWithTriangle(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
+                                            CollisionShape* shape2, const Vector3* triangleVertices, const Vector3* triangleVerticesNormals,
+                                            uint8 triangleInternalEdges, const Transform& shape1Transform, const Transform& shape2Transform,
+                                            bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+
         /// Return the number of objects in the batch
         uint32 getNbObjects() const;
 
@@ -158,6 +188,31 @@ RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addNarrowPhaseInfo(uint64 pairId, E
     narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shapeAllocator, shape1Transform, shape2Transform, shape1, shape2, needToReportContacts);
 }
 
+// Add a convex shape and a triangle to be tested during narrow-phase collision detection into the batch
+/// The triangle side of the test is given by the collision shape that is nullptr
+RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addNarrowPhaseInfoWithTriangle(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
+                                              CollisionShape* shape2, const Vector3* triangleVertices, const Vector3* triangleVerticesNormals,
+                                              uint8 triangleInternalEdges, const Transform& shape1Transform, const Transform& shape2Transform,
+                                              bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator) {
+
+    assert((shape1 == nullptr) != (shape2 == nullptr));
+    assert(triangles.size() == narrowPhaseInfos.size());
+
+    // Create a meta data object
+    narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shapeAllocator, shape1Transform, shape2Transform, shape1, shape2, needToReportContacts);
+
+    // Copy the triangle
+    NarrowPhaseTriangle triangle;
+    triangle.vertices[0] = triangleVertices[0];
+    triangle.vertices[1] = triangleVertices[1];
+    triangle.vertices[2] = triangleVertices[2];
+    triangle.verticesNormals[0] = triangleVerticesNormals[0];
+    triangle.verticesNormals[1] = triangleVerticesNormals[1];
+    triangle.verticesNormals[2] = triangleVerticesNormals[2];
+    triangle.internalEdges = triangleInternalEdges;
+    triangles.add(triangle);
+}
+
 // Add a new contact point
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addContactPoint(uint32 index, const Vector3& contactNormal, decimal penDepth, const Vector3& localPt1, const Vector3& localPt2) {
 
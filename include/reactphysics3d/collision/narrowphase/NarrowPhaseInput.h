@@ -59,6 +59,9 @@ class NarrowPhaseInput {
         NarrowPhaseInfoBatch mSphereVsConvexPolyhedronBatch;
         NarrowPhaseInfoBatch mCapsuleVsConvexPolyhedronBatch;
         NarrowPhaseInfoBatch mConvexPolyhedronVsConvexPolyhedronBatch;
+        NarrowPhaseInfoBatch mSphereVsTriangleBatch;
+        NarrowPhaseInfoBatch mBoxVsBoxBatch;
+        NarrowPhaseInfoBatch mConvexPolyhedronVsConvexPolyhedronEPABatch;
 
     public:
 
@@ -71,6 +74,12 @@ class NarrowPhaseInput {
                         const Transform& shape2Transform, NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts,
                         LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
 
+        /// Add a sphere and a triangle of a concave shape to be tested during narrow-phase collision detection into the batch
+        void addSphereVsTriangleTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
+                                     CollisionShape* shape2, const Vector3* triangleVertices, const Vector3* triangleVerticesNormals,
+                                     uint8 triangleInternalEdges, const Transform& shape1Transform, const Transform& shape2Transform,
+                                     bool reportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+
         /// Get a reference to the sphere vs sphere batch
         NarrowPhaseInfoBatch& getSphereVsSphereBatch();
 
@@ -89,6 +98,15 @@ class NarrowPhaseInput {
         /// Get a reference to the convex polyhedron vs convex polyhedron batch
         NarrowPhaseInfoBatch& getConvexPolyhedronVsConvexPolyhedronBatch();
 
+        /// Get a reference to the sphere vs triangle batch
+        NarrowPhaseInfoBatch& getSphereVsTriangleBatch();
+
+        /// Get a reference to the box vs box batch
+        NarrowPhaseInfoBatch& getBoxVsBoxBatch();
+
+        /// Get a reference to the convex polyhedron vs convex polyhedron (with EPA) batch
+        NarrowPhaseInfoBatch& getConvexPolyhedronVsConvexPolyhedronEPABatch();
+
         /// Reserve memory for the containers with cached capacity
         void reserveMemory();
 
@@ -127,6 +145,21 @@ RP3D_FORCE_INLINE NarrowPhaseInfoBatch &NarrowPhaseInput::getConvexPolyhedronVsC
    return mConvexPolyhedronVsConvexPolyhedronBatch;
 }
 
+// Get a reference to the sphere vs triangle batch contacts
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getSphereVsTriangleBatch() {
+   return mSphereVsTriangleBatch;
+}
+
+// Get a reference to the box vs box batch contacts
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getBoxVsBoxBatch() {
+   return mBoxVsBoxBatch;
+}
+
+// Get a reference to the convex polyhedron vs convex polyhedron (with EPA) batch
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getConvexPolyhedronVsConvexPolyhedronEPABatch() {
+    return mConvexPolyhedronVsConvexPolyhedronEPABatch;
+}
+
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1, CollisionShape* shape2,
                                           const Transform& shape1Transform, const Transform& shape2Transform,
@@ -152,11 +185,29 @@ RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, Entit
         case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
             mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
             break;
+        case NarrowPhaseAlgorithmType::BoxVsBox:
+            mBoxVsBoxBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            break;
+        case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronEPA:
+            mConvexPolyhedronVsConvexPolyhedronEPABatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            break;
         case NarrowPhaseAlgorithmType::None:
             // Must never happen
             assert(false);
             break;
     }
 }
+
+// Add a sphere and a triangle of a concave shape to be tested during narrow-phase collision detection into the batch
+/// The collision shape of the triangle side of the test must be nullptr
+RP3D_FORCE_INLINE void NarrowPhaseInput::addSphereVsTriangleTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
+                                          CollisionShape* shape2, const Vector3* triangleVertices, const Vector3* triangleVerticesNormals,
+                                          uint8 triangleInternalEdges, const Transform& shape1Transform, const Transform& shape2Transform,
+                                          bool reportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator) {
+
+    mSphereVsTriangleBatch.addNarrowPhaseInfoWithTriangle(pairId, collider1, collider2, shape1, shape2, triangleVertices, triangleVerticesNormals,
+                                                          triangleInternalEdges, shape1Transform, shape2Transform, reportContacts,
+                                                          lastFrameInfo, shapeAllocator);
+}
 }
 #endif
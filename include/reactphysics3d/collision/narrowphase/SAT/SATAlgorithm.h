@@ -29,6 +29,7 @@
 // Libraries
 #include <reactphysics3d/decimal.h>
 #include <reactphysics3d/collision/HalfEdgeStructure.h>
+#include <reactphysics3d/containers/Array.h>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -39,6 +40,7 @@ class SphereShape;
 struct ContactManifoldInfo;
 struct NarrowPhaseInfoBatch;
 class ConvexPolyhedronShape;
+class ConvexMeshShape;
 class MemoryAllocator;
 class Profiler;
 
@@ -103,17 +105,24 @@ class SATAlgorithm {
                                             const Vector3& edge1Direction, const Vector3& edge2Direction,
                                             bool isShape1Triangle, Vector3& outSeparatingAxis) const;
 
-        /// Return the penetration depth between two polyhedra along a face normal axis of the first polyhedron
-        decimal testSingleFaceDirectionPolyhedronVsPolyhedron(const ConvexPolyhedronShape* polyhedron1,
-                                                              const ConvexPolyhedronShape* polyhedron2,
-                                                              const Transform& polyhedron1ToPolyhedron2,
-                                                              uint32 faceIndex) const;
-
 
         /// Test all the normals of a polyhedron for separating axis in the polyhedron vs polyhedron case
         decimal testFacesDirectionPolyhedronVsPolyhedron(const ConvexPolyhedronShape* polyhedron1, const ConvexPolyhedronShape* polyhedron2,
                                                         const Transform& polyhedron1ToPolyhedron2, uint& minFaceIndex) const;
 
+        /// Test all the face normals of a convex mesh against all the vertices of another convex mesh
+        decimal testFacesDirectionConvexMeshVsConvexMesh(const ConvexMeshShape* mesh1, const ConvexMeshShape* mesh2,
+                                                         const Transform& mesh2ToMesh1, Array<decimal>& buffer,
+                                                         uint& minFaceIndex) const;
+
+        /// Compute the Gauss map data of the edges of the second polyhedron in a structure of arrays layout
+        void computeEdgesGaussMapData(const ConvexPolyhedronShape* polyhedron2, Array<decimal>& edgesData) const;
+
+        /// Test the Gauss map arcs of an edge of the first polyhedron against all the edges of the second polyhedron
+        void testGaussMapArcsIntersect(const Vector3& a, const Vector3& b, const Vector3& bCrossA,
+                                       const Array<decimal>& edgesData, uint32 nbEdges2,
+                                       Array<uint8>& outBuildMinkowskiFace) const;
+
         /// Compute the penetration depth between a face of the polyhedron and a sphere along the polyhedron face normal direction
         decimal computePolyhedronFaceVsSpherePenetrationDepth(uint32 faceIndex, const ConvexPolyhedronShape* polyhedron,
                                                               const SphereShape* sphere, const Vector3& sphereCenter) const;
@@ -129,12 +138,6 @@ class SATAlgorithm {
                                                                  const Vector3& edgeDirectionCapsuleSpace,
                                                                  const Transform& polyhedronToCapsuleTransform, Vector3& outAxis) const;
 
-        /// Compute the contact points between two faces of two convex polyhedra.
-        bool computePolyhedronVsPolyhedronFaceContactPoints(bool isMinPenetrationFaceNormalPolyhedron1, const ConvexPolyhedronShape* polyhedron1,
-                                                            const ConvexPolyhedronShape* polyhedron2, const Transform& polyhedron1ToPolyhedron2,
-                                                            const Transform& polyhedron2ToPolyhedron1, uint32 minFaceIndex,
-                                                            NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) const;
-
 
     public :
 
@@ -170,6 +173,18 @@ class SATAlgorithm {
         bool isMinkowskiFaceCapsuleVsEdge(const Vector3& capsuleSegment, const Vector3& edgeAdjacentFace1Normal,
                                           const Vector3& edgeAdjacentFace2Normal) const;
 
+        /// Return the penetration depth between two polyhedra along a face normal axis of the first polyhedron
+        decimal testSingleFaceDirectionPolyhedronVsPolyhedron(const ConvexPolyhedronShape* polyhedron1,
+                                                              const ConvexPolyhedronShape* polyhedron2,
+                                                              const Transform& polyhedron1ToPolyhedron2,
+                                                              uint32 faceIndex) const;
+
+        /// Compute the contact points between two faces of two convex polyhedra.
+        bool computePolyhedronVsPolyhedronFaceContactPoints(bool isMinPenetrationFaceNormalPolyhedron1, const ConvexPolyhedronShape* polyhedron1,
+                                                            const ConvexPolyhedronShape* polyhedron2, const Transform& polyhedron1ToPolyhedron2,
+                                                            const Transform& polyhedron2ToPolyhedron1, uint32 minFaceIndex,
+                                                            NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) const;
+
         /// Test collision between two convex meshes
         bool testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems) const;
 
@@ -48,7 +48,9 @@ struct NarrowPhaseInfoBatch;
  * (the center of the sphere is inside the polyhedron) we run the SAT
  * algorithm to get the contact point and contact normal.
  * This is based on the "Robust Contact Creation for Physics Simulation"
- * presentation by Dirk Gregorius.
+ * presentation by Dirk Gregorius. The collision between a sphere and a triangle
+ * of a concave shape is computed directly with the closest point of the triangle
+ * to the center of the sphere.
  */
 class SphereVsConvexPolyhedronAlgorithm : public NarrowPhaseAlgorithm {
 
@@ -73,6 +75,9 @@ class SphereVsConvexPolyhedronAlgorithm : public NarrowPhaseAlgorithm {
         /// Compute the narrow-phase collision detection between a sphere and a convex polyhedron
         bool testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems,
                            bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator);
+
+        /// Compute the narrow-phase collision detection between a sphere and a triangle of a concave shape
+        bool testCollisionVsTriangles(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems);
 };
 
 }
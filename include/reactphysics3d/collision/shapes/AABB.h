@@ -88,6 +88,9 @@ class AABB {
         /// Return the volume of the AABB
         decimal getVolume() const;
 
+        /// Return the surface area of the AABB
+        decimal getSurfaceArea() const;
+
         /// Merge the AABB in parameter with the current one
         void mergeWithAABB(const AABB& aabb);
 
@@ -106,12 +109,19 @@ class AABB {
         /// Return true if the ray intersects the AABB
         bool testRayIntersect(const Vector3& rayOrigin, const Vector3& rayDirectionInv, decimal rayMaxFraction) const;
 
+        /// Return true if the ray intersects the AABB and compute the fraction where the ray enters the AABB
+        bool testRayIntersect(const Vector3& rayOrigin, const Vector3& rayDirectionInv, decimal rayMaxFraction,
+                              decimal& outEntryFraction) const;
+
         /// Compute the intersection of a ray and the AABB
         bool raycast(const Ray& ray, Vector3& hitPoint) const;
 
         /// Apply a scale factor to the AABB
         void applyScale(const Vector3& scale);
 
+        /// Replace the AABB by the AABB of its transformed box
+        void applyTransform(const Transform& transform);
+
         /// Create and return an AABB for a triangle
         static AABB createAABBForTriangle(const Vector3* trianglePoints);
 
@@ -174,6 +184,12 @@ RP3D_FORCE_INLINE decimal AABB::getVolume() const {
     return (diff.x * diff.y * diff.z);
 }
 
+// Return the surface area of the AABB
+RP3D_FORCE_INLINE decimal AABB::getSurfaceArea() const {
+    const Vector3 diff = mMaxCoordinates - mMinCoordinates;
+    return decimal(2.0) * (diff.x * diff.y + diff.y * diff.z + diff.z * diff.x);
+}
+
 // Return true if the AABB of a triangle intersects the AABB
 RP3D_FORCE_INLINE bool AABB::testCollisionTriangleAABB(const Vector3* trianglePoints) const {
 
@@ -266,6 +282,14 @@ RP3D_FORCE_INLINE AABB AABB::createAABBForTriangle(const Vector3* trianglePoints
 // Return true if the ray intersects the AABB
 RP3D_FORCE_INLINE bool AABB::testRayIntersect(const Vector3& rayOrigin, const Vector3& rayDirectionInverse, decimal rayMaxFraction) const {
 
+    decimal entryFraction;
+    return testRayIntersect(rayOrigin, rayDirectionInverse, rayMaxFraction, entryFraction);
+}
+
+// Return true if the ray intersects the AABB and compute the fraction where the ray enters the AABB
+RP3D_FORCE_INLINE bool AABB::testRayIntersect(const Vector3& rayOrigin, const Vector3& rayDirectionInverse, decimal rayMaxFraction,
+                                              decimal& outEntryFraction) const {
+
     // This algorithm relies on the IEE floating point properties (division by zero). If the rayDirection is zero, rayDirectionInverse and
     // therfore t1 and t2 will be +-INFINITY. If the i coordinate of the ray's origin is inside the AABB (mMinCoordinates[i] < rayOrigin[i] < mMaxCordinates[i)), we have
     // t1 = -t2 = +- INFINITY. Since max(n, -INFINITY) = min(n, INFINITY) = n for all n, tMin and tMax will stay unchanged. Secondly, if the i
@@ -293,7 +317,9 @@ RP3D_FORCE_INLINE bool AABB::testRayIntersect(const Vector3& rayOrigin, const Ve
         tMax = std::min(tMax, std::max(t1, t2));
     }
 
-    return tMax >= std::max(tMin, decimal(0.0));
+    outEntryFraction = std::max(tMin, decimal(0.0));
+
+    return tMax >= outEntryFraction;
 }
 
 // Compute the intersection of a ray and the AABB
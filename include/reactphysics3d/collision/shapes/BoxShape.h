@@ -135,6 +135,7 @@ class BoxShape : public ConvexPolyhedronShape {
         // ----- Friendship ----- //
 
         friend class PhysicsCommon;
+        friend class GJKAlgorithm;
 };
 
 // Return the extents of the box
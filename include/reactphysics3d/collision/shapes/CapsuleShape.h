@@ -120,6 +120,7 @@ class CapsuleShape : public ConvexShape {
         // ----- Friendship ----- //
 
         friend class PhysicsCommon;
+        friend class GJKAlgorithm;
 };
 
 // Get the radius of the capsule
@@ -106,6 +106,9 @@ class CollisionShape {
         /// Notify all the assign colliders that the size of the collision shape has changed
         void notifyColliderAboutChangedSize();
 
+        /// Notify all the assign colliders that a region of the collision shape has been modified
+        void notifyColliderAboutChangedRegion(const AABB& localRegionAABB);
+
     public :
 
         // -------------------- Methods -------------------- //
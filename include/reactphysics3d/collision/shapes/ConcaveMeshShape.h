@@ -28,7 +28,7 @@
 
 // Libraries
 #include <reactphysics3d/collision/shapes/ConcaveShape.h>
-#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/collision/broadphase/StaticAABBTree.h>
 #include <reactphysics3d/containers/Array.h>
 
 namespace reactphysics3d {
@@ -39,45 +39,14 @@ class Profiler;
 class TriangleShape;
 class TriangleMesh;
 
-// class ConvexTriangleAABBOverlapCallback
-class ConvexTriangleAABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
-
-    private:
-
-        TriangleCallback& mTriangleTestCallback;
-
-        // Reference to the concave mesh shape
-        const ConcaveMeshShape& mConcaveMeshShape;
-
-        // Reference to the Dynamic AABB tree
-        const DynamicAABBTree& mDynamicAABBTree;
-
-    public:
-
-        // Constructor
-        ConvexTriangleAABBOverlapCallback(TriangleCallback& triangleCallback, const ConcaveMeshShape& concaveShape,
-                                          const DynamicAABBTree& dynamicAABBTree)
-          : mTriangleTestCallback(triangleCallback), mConcaveMeshShape(concaveShape), mDynamicAABBTree(dynamicAABBTree) {
-
-        }
-
-        // Called when a overlapping node has been found during the call to
-        // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
-        virtual void notifyOverlappingNode(int nodeId) override;
-
-};
-
 /// Class ConcaveMeshRaycastCallback
-class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
+class ConcaveMeshRaycastCallback : public StaticAABBTreeRaycastCallback {
 
     private :
 
-        Array<int32> mHitAABBNodes;
-        const DynamicAABBTree& mDynamicAABBTree;
         const ConcaveMeshShape& mConcaveMeshShape;
         Collider* mCollider;
         RaycastInfo& mRaycastInfo;
-        const Ray& mRay;
         bool mIsHit;
         MemoryAllocator& mAllocator;
         const Vector3& mMeshScale;
@@ -92,18 +61,15 @@ class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
     public:
 
         // Constructor
-        ConcaveMeshRaycastCallback(const DynamicAABBTree& dynamicAABBTree, const ConcaveMeshShape& concaveMeshShape,
-                                   Collider* collider, RaycastInfo& raycastInfo, const Ray& ray, const Vector3& meshScale, MemoryAllocator& allocator)
-            : mHitAABBNodes(allocator), mDynamicAABBTree(dynamicAABBTree), mConcaveMeshShape(concaveMeshShape), mCollider(collider),
-              mRaycastInfo(raycastInfo), mRay(ray), mIsHit(false), mAllocator(allocator), mMeshScale(meshScale) {
+        ConcaveMeshRaycastCallback(const ConcaveMeshShape& concaveMeshShape, Collider* collider, RaycastInfo& raycastInfo,
+                                   const Vector3& meshScale, MemoryAllocator& allocator)
+            : mConcaveMeshShape(concaveMeshShape), mCollider(collider), mRaycastInfo(raycastInfo), mIsHit(false),
+              mAllocator(allocator), mMeshScale(meshScale) {
 
         }
 
-        /// Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
-        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override;
-
-        /// Raycast all collision shapes that have been collected
-        void raycastTriangles();
+        /// Raycast the triangle of a leaf of the tree that is hit by the ray
+        virtual decimal raycastLeaf(int32 triangleId, const Ray& ray) override;
 
         /// Return true if a raycast hit has been found
         bool getIsHit() const {
@@ -130,13 +96,50 @@ class ConcaveMeshShape : public ConcaveShape {
 
     protected:
 
+        /// Header at the beginning of the serialized BVH data of a concave mesh
+        struct BVHDataHeader {
+
+            /// Magic number used to identify the BVH data
+            uint32 magicNumber;
+
+            /// Version of the BVH data format
+            uint32 version;
+
+            /// Size (in bytes) of a decimal value
+            uint32 decimalSize;
+
+            /// Size (in bytes) of a node of the tree
+            uint32 nodeSize;
+
+            /// Number of sub-parts of the triangle mesh
+            uint32 nbSubparts;
+
+            /// Total number of triangles of the triangle mesh
+            uint32 nbTriangles;
+
+            /// Number of nodes in the tree
+            int32 nbNodes;
+
+            /// AABB of the root node of the tree
+            AABB rootAABB;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Magic number of the serialized BVH data
+        static const uint32 BVH_DATA_MAGIC_NUMBER;
+
+        /// Version of the serialized BVH data format
+        static const uint32 BVH_DATA_VERSION;
+
         // -------------------- Attributes -------------------- //
 
         /// Pointer to the triangle mesh
         TriangleMesh* mTriangleMesh;
 
-        /// Dynamic AABB tree to accelerate collision with the triangles
-        DynamicAABBTree mDynamicAABBTree;
+        /// Static AABB tree to accelerate collision with the triangles (the data of a
+        /// leaf is the index of its triangle in the whole mesh)
+        StaticAABBTree mStaticAABBTree;
 
         /// Array with computed vertices normals for each TriangleVertexArray of the triangle mesh (only
         /// if the user did not provide its own vertices normals)
@@ -148,7 +151,8 @@ class ConcaveMeshShape : public ConcaveShape {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ConcaveMeshShape(TriangleMesh* triangleMesh, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure, const Vector3& scaling = Vector3(1, 1, 1));
+        ConcaveMeshShape(TriangleMesh* triangleMesh, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure,
+                         const Vector3& scaling = Vector3(1, 1, 1), const void* bvhData = nullptr);
 
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const override;
@@ -156,8 +160,14 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Return the number of bytes used by the collision shape
         virtual size_t getSizeInBytes() const override;
 
-        /// Insert all the triangles into the dynamic AABB tree
-        void initBVHTree();
+        /// Build the dynamic AABB tree with all the triangles of the mesh
+        void initBVHTree(MemoryAllocator& allocator);
+
+        /// Initialize the dynamic AABB tree using serialized BVH data (without copying it)
+        void initBVHTreeFromData(const void* bvhData);
+
+        /// Return true if the serialized BVH data can be used with a given triangle mesh
+        static bool isBVHDataValid(const TriangleMesh* triangleMesh, const void* bvhData, size_t bvhDataSize);
 
         /// Return the three vertices coordinates (in the array outTriangleVertices) of a triangle
         void getTriangleVertices(uint32 subPart, uint32 triangleIndex, Vector3* outTriangleVertices) const;
@@ -165,12 +175,13 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Return the three vertex normals (in the array outVerticesNormals) of a triangle
         void getTriangleVerticesNormals(uint32 subPart, uint32 triangleIndex, Vector3* outVerticesNormals) const;
 
-        /// Compute the shape Id for a given triangle of the mesh
-        uint32 computeTriangleShapeId(uint32 subPart, uint32 triangleIndex) const;
+        /// Return the sub-part and the index in this sub-part of a triangle of the mesh
+        void getTriangleSubpartAndIndex(uint32 triangleId, uint32& outSubPart, uint32& outTriangleIndex) const;
 
         /// Compute all the triangles of the mesh that are overlapping with the AABB in parameter
         virtual void computeOverlappingTriangles(const AABB& localAABB, Array<Vector3>& triangleVertices,
-                                                 Array<Vector3> &triangleVerticesNormals, Array<uint32>& shapeIds,
+                                                 Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
+                                                 Array<uint8>& trianglesInternalEdges,
                                                  MemoryAllocator& allocator) const override;
 
         /// Destructor
@@ -196,6 +207,12 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Return the local bounds of the shape in x, y and z directions.
         virtual void getLocalBounds(Vector3& min, Vector3& max) const override;
 
+        /// Return the size (in bytes) of the serialized BVH data of the mesh
+        size_t getBVHDataSize() const;
+
+        /// Serialize the BVH of the mesh into a buffer
+        size_t writeBVHData(void* buffer, size_t bufferSize) const;
+
         /// Return the string representation of the shape
         virtual std::string to_string() const override;
 
@@ -208,7 +225,6 @@ class ConcaveMeshShape : public ConcaveShape {
 
         // ---------- Friendship ----------- //
 
-        friend class ConvexTriangleAABBOverlapCallback;
         friend class ConcaveMeshRaycastCallback;
         friend class PhysicsCommon;
         friend class DebugRenderer;
@@ -228,31 +244,12 @@ RP3D_FORCE_INLINE size_t ConcaveMeshShape::getSizeInBytes() const {
 RP3D_FORCE_INLINE void ConcaveMeshShape::getLocalBounds(Vector3& min, Vector3& max) const {
 
     // Get the AABB of the whole tree
-    AABB treeAABB = mDynamicAABBTree.getRootAABB();
+    const AABB& treeAABB = mStaticAABBTree.getRootAABB();
 
     min = treeAABB.getMin();
     max = treeAABB.getMax();
 }
 
-// Called when a overlapping node has been found during the call to
-// DynamicAABBTree:reportAllShapesOverlappingWithAABB()
-RP3D_FORCE_INLINE void ConvexTriangleAABBOverlapCallback::notifyOverlappingNode(int nodeId) {
-
-    // Get the node data (triangle index and mesh subpart index)
-    int32* data = mDynamicAABBTree.getNodeDataInt(nodeId);
-
-    // Get the triangle vertices for this node from the concave mesh shape
-    Vector3 trianglePoints[3];
-    mConcaveMeshShape.getTriangleVertices(data[0], data[1], trianglePoints);
-
-    // Get the vertices normals of the triangle
-    Vector3 verticesNormals[3];
-    mConcaveMeshShape.getTriangleVerticesNormals(data[0], data[1], verticesNormals);
-
-    // Call the callback to test narrow-phase collision with this triangle
-    mTriangleTestCallback.testTriangle(trianglePoints, verticesNormals, mConcaveMeshShape.computeTriangleShapeId(data[0], data[1]));
-}
-
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
@@ -260,7 +257,7 @@ RP3D_FORCE_INLINE void ConcaveMeshShape::setProfiler(Profiler* profiler) {
 
     CollisionShape::setProfiler(profiler);
 
-    mDynamicAABBTree.setProfiler(profiler);
+    mStaticAABBTree.setProfiler(profiler);
 }
 
 
@@ -111,8 +111,11 @@ class ConcaveShape : public CollisionShape {
         virtual bool isPolyhedron() const override;
 
         /// Use a callback method on all triangles of the concave shape inside a given AABB
+        /// (the bit i of the internal edges flags of a triangle is set if its edge i is known
+        /// to be a flat or concave edge between two triangles of the shape)
         virtual void computeOverlappingTriangles(const AABB& localAABB, Array<Vector3>& triangleVertices,
                                                  Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
+                                                 Array<uint8>& trianglesInternalEdges,
                                                  MemoryAllocator& allocator) const=0;
 
         /// Compute and return the volume of the collision shape
@@ -63,6 +63,14 @@ class ConvexMeshShape : public ConvexPolyhedronShape {
         /// Scale of the mesh
         Vector3 mScale;
 
+        /// Planes of the faces of the scaled mesh in a structure of arrays layout: the x, y and z
+        /// coordinates of the normals of all the faces followed by the offsets of all the planes
+        Array<decimal> mFacesPlanes;
+
+        /// Vertices of the scaled mesh in a structure of arrays layout: the x, y and z
+        /// coordinates of all the vertices
+        Array<decimal> mVerticesCoordinates;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -71,6 +79,9 @@ class ConvexMeshShape : public ConvexPolyhedronShape {
         /// Recompute the bounds of the mesh
         void recalculateBounds();
 
+        /// Recompute the planes of the faces and the coordinates of the vertices of the scaled mesh
+        void recalculateFacesPlanes();
+
         /// Return a local support point in a given direction without the object margin.
         virtual Vector3 getLocalSupportPointWithoutMargin(const Vector3& direction) const override;
 
@@ -135,6 +146,12 @@ class ConvexMeshShape : public ConvexPolyhedronShape {
         /// Return the centroid of the polyhedron
         virtual Vector3 getCentroid() const override;
 
+        /// Return the planes of the faces of the scaled mesh in a structure of arrays layout
+        const decimal* getFacesPlanes() const;
+
+        /// Return the coordinates of the vertices of the scaled mesh in a structure of arrays layout
+        const decimal* getVerticesCoordinates() const;
+
         /// Compute and return the volume of the collision shape
         virtual decimal getVolume() const override;
 
@@ -162,6 +179,7 @@ RP3D_FORCE_INLINE const Vector3& ConvexMeshShape::getScale() const {
 RP3D_FORCE_INLINE void ConvexMeshShape::setScale(const Vector3& scale) {
     mScale = scale;
     recalculateBounds();
+    recalculateFacesPlanes();
     notifyColliderAboutChangedSize();
 }
 
@@ -241,6 +259,20 @@ RP3D_FORCE_INLINE Vector3 ConvexMeshShape::getCentroid() const {
     return mPolyhedronMesh->getCentroid() * mScale;
 }
 
+// Return the planes of the faces of the scaled mesh in a structure of arrays layout
+/// The array contains the x coordinates of the normals of all the faces, then the y coordinates,
+/// then the z coordinates and finally the offsets of the planes (dot product of the normal with a
+/// vertex of the face)
+RP3D_FORCE_INLINE const decimal* ConvexMeshShape::getFacesPlanes() const {
+    return &(mFacesPlanes[0]);
+}
+
+// Return the coordinates of the vertices of the scaled mesh in a structure of arrays layout
+/// The array contains the x coordinates of all the vertices, then the y coordinates and then the z coordinates
+RP3D_FORCE_INLINE const decimal* ConvexMeshShape::getVerticesCoordinates() const {
+    return &(mVerticesCoordinates[0]);
+}
+
 
 // Compute and return the volume of the collision shape
 RP3D_FORCE_INLINE decimal ConvexMeshShape::getVolume() const {
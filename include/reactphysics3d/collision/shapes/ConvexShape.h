@@ -80,6 +80,8 @@ class ConvexShape : public CollisionShape {
 
         friend class GJKAlgorithm;
         friend class SATAlgorithm;
+        friend class EPAAlgorithm;
+        friend class NarrowPhaseAlgorithm;
 };
 
 // Return true if the collision shape is convex, false if it is concave
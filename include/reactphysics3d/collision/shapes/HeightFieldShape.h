@@ -29,6 +29,7 @@
 // Libraries
 #include <reactphysics3d/collision/shapes/ConcaveShape.h>
 #include <reactphysics3d/collision/shapes/AABB.h>
+#include <cstring>
 
 namespace reactphysics3d {
 
@@ -36,26 +37,82 @@ class HeightFieldShape;
 class Profiler;
 class TriangleShape;
 
+// Structure HeightFieldHalf
+/**
+ * Height value of a height field stored as an IEEE 754 half-precision (16 bits)
+ * floating-point number.
+ */
+struct HeightFieldHalf {
+
+    /// Bits of the half-precision floating-point number
+    uint16 bits;
+};
+
+// Structure HeightFieldBlockBounds
+/**
+ * Minimum and maximum height values of a block of cells of a height field
+ */
+struct HeightFieldBlockBounds {
+
+    /// Minimum height value in the block
+    decimal minHeight;
+
+    /// Maximum height value in the block
+    decimal maxHeight;
+};
+
+// Structure HeightFieldPyramidLevel
+/**
+ * A level of the min/max heights pyramid of a height field. Each block of a level
+ * is made of 2x2 blocks of the level below.
+ */
+struct HeightFieldPyramidLevel {
+
+    /// Number of blocks in the direction of the columns
+    int nbBlocksI;
+
+    /// Number of blocks in the direction of the rows
+    int nbBlocksJ;
+
+    /// Number of cells in each direction of a block
+    int blockSize;
+
+    /// Index of the first block of the level in the array of blocks bounds
+    uint32 offset;
+};
+
 // Class HeightFieldShape
 /**
  * This class represents a static height field that can be used to represent
  * a terrain. The height field is made of a grid with rows and columns with a
  * height value at each grid point. Note that the height values are not copied into the shape
- * but are shared instead. The height values can be of type integer, float or double.
+ * but are shared instead. The height values can be of type integer, float, double, half-precision float
+ * or 16-bits unsigned integer. A 16-bits unsigned integer value is quantized over the range between the
+ * minimum and maximum height values of the height field (0 is the minimum height and 65535 the maximum height).
  * When creating a HeightFieldShape, you need to specify the minimum and maximum height value of
  * your height field. Note that the HeightFieldShape will be re-centered based on its AABB. It means
  * that for instance, if the minimum height value is -200 and the maximum value is 400, the final
  * minimum height of the field in the simulation will be -300 and the maximum height will be 300.
+ * A height field can also be tiled. In this case, the grid is split into square tiles and the
+ * height values of each tile are given separately. The tiles can be loaded and unloaded at any time.
+ * The cells of an unloaded tile do not collide. The height values of a height field can be modified
+ * in place by the user who then needs to call the updateHeights() method with the modified region.
  */
 class HeightFieldShape : public ConcaveShape {
 
     public:
 
         /// Data type for the height data of the height field
-        enum class HeightDataType {HEIGHT_FLOAT_TYPE, HEIGHT_DOUBLE_TYPE, HEIGHT_INT_TYPE};
+        enum class HeightDataType {HEIGHT_FLOAT_TYPE, HEIGHT_DOUBLE_TYPE, HEIGHT_INT_TYPE, HEIGHT_UINT16_TYPE, HEIGHT_HALF_TYPE};
 
     protected:
 
+        /// Number of cells in each direction of a block of the lowest level of the min/max heights pyramid
+        static constexpr int PYRAMID_BLOCK_SIZE = 4;
+
+        /// Pointer to a method that reads the height values of a range of columns in a row
+        using ReadHeightsFunction = void (HeightFieldShape::*)(int row, int startColumn, int endColumn, decimal* outHeights) const;
+
         // -------------------- Attributes -------------------- //
 
         /// Number of columns in the grid of the height field
@@ -82,12 +139,43 @@ class HeightFieldShape : public ConcaveShape {
         /// Height values scale for height field with integer height values
         decimal mIntegerHeightScale;
 
+        /// Height difference between two consecutive quantized values for height field with 16-bits unsigned integer values
+        decimal mQuantizedHeightScale;
+
         /// Data type of the height values
         HeightDataType mHeightDataType;
 
-        /// Array of data with all the height values of the height field
+        /// Array of data with all the height values of the height field (nullptr if the height field is tiled)
         const void*	mHeightFieldData;
 
+        /// Number of cells in each direction of a tile (zero if the height field is not tiled)
+        int mNbTileCells;
+
+        /// Number of columns of tiles
+        int mNbTileColumns;
+
+        /// Number of rows of tiles
+        int mNbTileRows;
+
+        /// Array with the height values data of each tile (nullptr for an unloaded tile)
+        Array<const void*> mTilesData;
+
+        /// Method used to read the height values (chosen at construction for the data type)
+        ReadHeightsFunction mReadHeightsFunction;
+
+        /// Array with the precomputed normal of each vertex of the grid (without scaling) or
+        /// nullptr if the vertices normals cache is disabled
+        Vector3* mVerticesNormals;
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Levels of the min/max heights pyramid (the first level has the smallest blocks)
+        Array<HeightFieldPyramidLevel> mPyramidLevels;
+
+        /// Min/max height values of the blocks of all the levels of the pyramid
+        Array<HeightFieldBlockBounds> mPyramidBlocksBounds;
+
         /// Local AABB of the height field (without scaling)
         AABB mAABB;
 
@@ -100,7 +188,7 @@ class HeightFieldShape : public ConcaveShape {
         HeightFieldShape(int nbGridColumns, int nbGridRows, decimal minHeight, decimal maxHeight,
                          const void* heightFieldData, HeightDataType dataType, MemoryAllocator& allocator,
                          HalfEdgeStructure& triangleHalfEdgeStructure, int upAxis = 1, decimal integerHeightScale = 1.0f,
-                         const Vector3& scaling = Vector3(1,1,1));
+                         const Vector3& scaling = Vector3(1,1,1), int nbTileCells = 0);
 
         /// Raycast a single triangle of the height-field
         bool raycastTriangle(const Ray& ray, const Vector3& p1, const Vector3& p2, const Vector3& p3, uint32 shapeId,
@@ -123,11 +211,64 @@ class HeightFieldShape : public ConcaveShape {
         /// Compute the shape Id for a given triangle
         uint32 computeTriangleShapeId(uint32 iIndex, uint32 jIndex, uint32 secondTriangleIncrement) const;
 
-        /// Compute the first grid cell of the heightfield intersected by a ray
-        bool computeEnteringRayGridCoordinates(const Ray& ray, int& i, int& j, Vector3& outHitPoint) const;
-        
+        /// Create the levels of the min/max heights pyramid
+        void createHeightsPyramid();
+
+        /// Update the min/max heights pyramid for a range of cells
+        void updateHeightsPyramid(int cellIMin, int cellJMin, int cellIMax, int cellJMax);
+
+        /// Return the min/max heights of a block of the pyramid
+        const HeightFieldBlockBounds& getBlockBounds(int level, int blockI, int blockJ) const;
+
+        /// Return true if some cells in a range have height values in a given interval
+        bool testHeightsOverlap(int cellIMin, int cellJMin, int cellIMax, int cellJMax, decimal minHeight,
+                                decimal maxHeight, MemoryAllocator& allocator) const;
+
+        /// Return the local AABB (without scaling) of a range of cells with given min/max heights
+        AABB computeCellsAABB(int cellIMin, int cellJMin, int cellIMax, int cellJMax, decimal minHeight, decimal maxHeight) const;
+
+        /// Raycast against the triangles of the cells of a block of the lowest level of the pyramid
+        bool raycastBlockCells(int blockI, int blockJ, const Ray& ray, const Ray& scaledRay, const Vector3& rayDirectionInverse,
+                               Collider* collider, RaycastInfo& raycastInfo, decimal& smallestHitFraction,
+                               MemoryAllocator& allocator) const;
+
+        /// Convert a stored height value into a height value
+        decimal decodeHeight(float height) const;
+
+        /// Convert a stored height value into a height value
+        decimal decodeHeight(double height) const;
+
+        /// Convert a stored integer height value into a height value
+        decimal decodeHeight(int height) const;
+
+        /// Convert a stored quantized height value into a height value
+        decimal decodeHeight(uint16 height) const;
+
+        /// Convert a stored half-precision height value into a height value
+        decimal decodeHeight(HeightFieldHalf height) const;
+
+        /// Read the height values of a range of columns in a row for a given data type
+        template<typename T>
+        void readHeights(int row, int startColumn, int endColumn, decimal* outHeights) const;
+
+        /// Read the height values of a range of columns in a row of a tiled height field for a given data type
+        template<typename T>
+        void readTiledHeights(int row, int startColumn, int endColumn, decimal* outHeights) const;
+
+        /// Return the data of the tile where to read the height value of a vertex of a tiled height field
+        const void* getVertexTileData(int x, int y, int& outTileColumn, int& outTileRow) const;
+
+        /// Return true if a cell can collide (false if it is in an unloaded tile)
+        bool isCellLoaded(int i, int j) const;
+
+        /// Return the vertex (local-coordinates without scaling) of the height field for a given height
+        Vector3 computeVertex(int x, int y, decimal height) const;
+
+        /// Compute the normal of each vertex in a region of the grid
+        void computeVerticesNormals(int columnMin, int rowMin, int columnMax, int rowMax);
+
         /// Destructor
-        virtual ~HeightFieldShape() override = default;
+        virtual ~HeightFieldShape() override;
 
     public:
 
@@ -152,12 +293,40 @@ class HeightFieldShape : public ConcaveShape {
         /// Return the type of height value in the height field
         HeightDataType getHeightDataType() const;
 
+        /// Return true if the normals of the vertices are precomputed
+        bool isVerticesNormalsCacheEnabled() const;
+
+        /// Enable/Disable the precomputed normals of the vertices
+        void setIsVerticesNormalsCacheEnabled(bool isEnabled);
+
+        /// Notify the height field that the height values of a region of the grid have been modified
+        void updateHeights(int columnMin, int rowMin, int columnMax, int rowMax);
+
+        /// Return true if the height field is tiled
+        bool isTiled() const;
+
+        /// Return the number of cells in each direction of a tile
+        int getNbTileCells() const;
+
+        /// Return the number of columns of tiles
+        int getNbTileColumns() const;
+
+        /// Return the number of rows of tiles
+        int getNbTileRows() const;
+
+        /// Return the height values data of a tile (nullptr if the tile is not loaded)
+        const void* getTileData(int tileColumn, int tileRow) const;
+
+        /// Load (or unload with nullptr) the height values data of a tile
+        void setTileData(int tileColumn, int tileRow, const void* tileData);
+
         /// Return the local bounds of the shape in x, y and z directions.
         virtual void getLocalBounds(Vector3& min, Vector3& max) const override;
 
         /// Use a callback method on all triangles of the concave shape inside a given AABB
         virtual void computeOverlappingTriangles(const AABB& localAABB, Array<Vector3>& triangleVertices,
                                                    Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
+                                                   Array<uint8>& trianglesInternalEdges,
                                                    MemoryAllocator& allocator) const override;
 
         /// Return the string representation of the shape
@@ -165,7 +334,6 @@ class HeightFieldShape : public ConcaveShape {
 
         // ---------- Friendship ----------- //
 
-        friend class ConvexTriangleAABBOverlapCallback;
         friend class ConcaveMeshRaycastCallback;
         friend class PhysicsCommon;
 };
@@ -185,23 +353,202 @@ RP3D_FORCE_INLINE HeightFieldShape::HeightDataType HeightFieldShape::getHeightDa
     return mHeightDataType;
 }
 
+// Return true if the height field is tiled
+RP3D_FORCE_INLINE bool HeightFieldShape::isTiled() const {
+    return mNbTileCells > 0;
+}
+
+// Return the number of cells in each direction of a tile
+RP3D_FORCE_INLINE int HeightFieldShape::getNbTileCells() const {
+    return mNbTileCells;
+}
+
+// Return the number of columns of tiles
+RP3D_FORCE_INLINE int HeightFieldShape::getNbTileColumns() const {
+    return mNbTileColumns;
+}
+
+// Return the number of rows of tiles
+RP3D_FORCE_INLINE int HeightFieldShape::getNbTileRows() const {
+    return mNbTileRows;
+}
+
+// Return the height values data of a tile (nullptr if the tile is not loaded)
+RP3D_FORCE_INLINE const void* HeightFieldShape::getTileData(int tileColumn, int tileRow) const {
+    assert(tileColumn >= 0 && tileColumn < mNbTileColumns);
+    assert(tileRow >= 0 && tileRow < mNbTileRows);
+    return mTilesData[tileRow * mNbTileColumns + tileColumn];
+}
+
+// Return true if a cell can collide (false if it is in an unloaded tile)
+RP3D_FORCE_INLINE bool HeightFieldShape::isCellLoaded(int i, int j) const {
+    return mNbTileCells == 0 || getTileData(i / mNbTileCells, j / mNbTileCells) != nullptr;
+}
+
+// Return the min/max heights of a block of the pyramid
+RP3D_FORCE_INLINE const HeightFieldBlockBounds& HeightFieldShape::getBlockBounds(int level, int blockI, int blockJ) const {
+    const HeightFieldPyramidLevel& pyramidLevel = mPyramidLevels[level];
+    assert(blockI >= 0 && blockI < pyramidLevel.nbBlocksI);
+    assert(blockJ >= 0 && blockJ < pyramidLevel.nbBlocksJ);
+    return mPyramidBlocksBounds[pyramidLevel.offset + blockJ * pyramidLevel.nbBlocksI + blockI];
+}
+
+// Return the local AABB (without scaling) of a range of cells with given min/max heights
+RP3D_FORCE_INLINE AABB HeightFieldShape::computeCellsAABB(int cellIMin, int cellJMin, int cellIMax, int cellJMax,
+                                                          decimal minHeight, decimal maxHeight) const {
+
+    // Note that the coordinates of the vertices are increasing with the grid coordinates and the heights.
+    // The AABB is slightly inflated to make sure that it is not missed by a ray because of rounding errors
+    const decimal epsilon = decimal(0.0001);
+    return AABB(computeVertex(cellIMin, cellJMin, minHeight) - Vector3(epsilon, epsilon, epsilon),
+                computeVertex(cellIMax + 1, cellJMax + 1, maxHeight) + Vector3(epsilon, epsilon, epsilon));
+}
+
+// Return true if the normals of the vertices are precomputed
+RP3D_FORCE_INLINE bool HeightFieldShape::isVerticesNormalsCacheEnabled() const {
+    return mVerticesNormals != nullptr;
+}
+
 // Return the number of bytes used by the collision shape
 RP3D_FORCE_INLINE size_t HeightFieldShape::getSizeInBytes() const {
     return sizeof(HeightFieldShape);
 }
 
+// Convert a stored height value into a height value
+RP3D_FORCE_INLINE decimal HeightFieldShape::decodeHeight(float height) const {
+    return decimal(height);
+}
+
+// Convert a stored height value into a height value
+RP3D_FORCE_INLINE decimal HeightFieldShape::decodeHeight(double height) const {
+    return decimal(height);
+}
+
+// Convert a stored integer height value into a height value
+RP3D_FORCE_INLINE decimal HeightFieldShape::decodeHeight(int height) const {
+    return decimal(height * mIntegerHeightScale);
+}
+
+// Convert a stored quantized height value into a height value
+/// The quantized values are distributed over the range between the min and max heights
+RP3D_FORCE_INLINE decimal HeightFieldShape::decodeHeight(uint16 height) const {
+    return mMinHeight + decimal(height) * mQuantizedHeightScale;
+}
+
+// Convert a stored half-precision height value into a height value
+/// The exponent and mantissa bits are moved into a single-precision float and the exponent is re-biased.
+/// This only uses integer operations and therefore the loops reading the height values can be vectorized.
+RP3D_FORCE_INLINE decimal HeightFieldShape::decodeHeight(HeightFieldHalf height) const {
+
+    const uint32 shiftedExponentMask = 0x7c00u << 13;
+
+    // Exponent and mantissa bits
+    uint32 bits = (uint32(height.bits) & 0x7fffu) << 13;
+    const uint32 exponent = bits & shiftedExponentMask;
+
+    // Re-bias the exponent
+    bits += (127u - 15u) << 23;
+
+    float value;
+    if (exponent == shiftedExponentMask) {
+
+        // Infinity or NaN
+        bits += (128u - 16u) << 23;
+        std::memcpy(&value, &bits, sizeof(float));
+    }
+    else if (exponent == 0) {
+
+        // Zero or denormalized number (renormalize it)
+        bits += 1u << 23;
+        std::memcpy(&value, &bits, sizeof(float));
+        value -= 6.10351562e-05f;
+    }
+    else {
+        std::memcpy(&value, &bits, sizeof(float));
+    }
+
+    // Sign bit
+    return (height.bits & 0x8000u) != 0 ? -decimal(value) : decimal(value);
+}
+
+// Read the height values of a range of columns in a row for a given data type
+/**
+ * @param row Index of the row
+ * @param startColumn Index of the first column
+ * @param endColumn Index of the last column (included)
+ * @param[out] outHeights Array where to write the (endColumn - startColumn + 1) height values
+ */
+template<typename T>
+RP3D_FORCE_INLINE void HeightFieldShape::readHeights(int row, int startColumn, int endColumn, decimal* outHeights) const {
+
+    assert(row >= 0 && row < mNbRows);
+    assert(startColumn >= 0 && endColumn < mNbColumns && startColumn <= endColumn);
+
+    const T* heights = static_cast<const T*>(mHeightFieldData) + row * mNbColumns + startColumn;
+    const int nbHeights = endColumn - startColumn + 1;
+    for (int i = 0; i < nbHeights; i++) {
+        outHeights[i] = decodeHeight(heights[i]);
+    }
+}
+
+// Read the height values of a range of columns in a row of a tiled height field for a given data type
+/// The height values of the vertices in an unloaded tile are the minimum height of the height field.
+template<typename T>
+RP3D_FORCE_INLINE void HeightFieldShape::readTiledHeights(int row, int startColumn, int endColumn, decimal* outHeights) const {
+
+    assert(row >= 0 && row < mNbRows);
+    assert(startColumn >= 0 && endColumn < mNbColumns && startColumn <= endColumn);
+
+    const int nbTileVertices = mNbTileCells + 1;
+
+    int x = startColumn;
+    while (x <= endColumn) {
+
+        // Read the height values of the vertices of the row inside the current tile
+        int tileColumn, tileRow;
+        const T* tileHeights = static_cast<const T*>(getVertexTileData(x, row, tileColumn, tileRow));
+        const int lastX = std::min(endColumn, (tileColumn + 1) * mNbTileCells);
+
+        if (tileHeights != nullptr) {
+            const T* heights = tileHeights + (row - tileRow * mNbTileCells) * nbTileVertices + (x - tileColumn * mNbTileCells);
+            for (int k = 0; k <= lastX - x; k++) {
+                outHeights[x - startColumn + k] = decodeHeight(heights[k]);
+            }
+        }
+        else {
+            for (int k = 0; k <= lastX - x; k++) {
+                outHeights[x - startColumn + k] = mMinHeight;
+            }
+        }
+
+        x = lastX + 1;
+    }
+}
+
+// Return the vertex (local-coordinates without scaling) of the height field for a given height
+RP3D_FORCE_INLINE Vector3 HeightFieldShape::computeVertex(int x, int y, decimal height) const {
+
+    // Height values origin
+    const decimal heightOrigin = -(mMaxHeight - mMinHeight) * decimal(0.5) - mMinHeight;
+
+    switch (mUpAxis) {
+        case 0: return Vector3(heightOrigin + height, -mWidth * decimal(0.5) + x, -mLength * decimal(0.5) + y);
+        case 1: return Vector3(-mWidth * decimal(0.5) + x, heightOrigin + height, -mLength * decimal(0.5) + y);
+        case 2: return Vector3(-mWidth * decimal(0.5) + x, -mLength * decimal(0.5) + y, heightOrigin + height);
+        default: assert(false); return Vector3::zero();
+    }
+}
+
 // Return the height of a given (x,y) point in the height field
 RP3D_FORCE_INLINE decimal HeightFieldShape::getHeightAt(int x, int y) const {
 
     assert(x >= 0 && x < mNbColumns);
     assert(y >= 0 && y < mNbRows);
 
-    switch(mHeightDataType) {
-        case HeightDataType::HEIGHT_FLOAT_TYPE : return decimal(((float*)mHeightFieldData)[y * mNbColumns + x]);
-        case HeightDataType::HEIGHT_DOUBLE_TYPE : return decimal(((double*)mHeightFieldData)[y * mNbColumns + x]);
-        case HeightDataType::HEIGHT_INT_TYPE : return decimal(((int*)mHeightFieldData)[y * mNbColumns + x] * mIntegerHeightScale);
-        default: assert(false); return 0;
-    }
+    decimal height;
+    (this->*mReadHeightsFunction)(y, x, x, &height);
+
+    return height;
 }
 
 // Compute the shape Id for a given triangle
@@ -105,6 +105,7 @@ class SphereShape : public ConvexShape {
         // ----- Friendship ----- //
 
         friend class PhysicsCommon;
+        friend class GJKAlgorithm;
 };
 
 // Get the radius of the sphere
@@ -73,6 +73,10 @@ class TriangleShape : public ConvexPolyhedronShape {
         /// Three vertices normals for smooth collision with triangle mesh
         Vector3 mVerticesNormals[3];
 
+        /// Flags of the internal edges of the triangle in its mesh (the bit i is set if the edge
+        /// from the vertex i to the vertex (i+1) % 3 is a flat or concave edge of the mesh)
+        uint8 mInternalEdges;
+
         /// Raycast test type for the triangle (front, back, front-back)
         TriangleRaycastSide mRaycastTestType;
 
@@ -107,8 +111,8 @@ class TriangleShape : public ConvexPolyhedronShape {
                                       Vector3& outNewLocalContactPointOtherShape, Vector3& outSmoothWorldContactTriangleNormal) const;
 
         /// Constructor
-        TriangleShape(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId, HalfEdgeStructure& triangleHalfEdgeStructure,
-                      MemoryAllocator& allocator);
+        TriangleShape(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId, uint8 internalEdges,
+                      HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator);
 
         /// Constructor
         TriangleShape(const Vector3* vertices, uint32 shapeId, HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator);
@@ -177,6 +181,10 @@ class TriangleShape : public ConvexPolyhedronShape {
                                                      const Transform& shape1ToWorld, const Transform& shape2ToWorld,
                                                      decimal penetrationDepth, Vector3& outSmoothVertexNormal);
 
+        /// Get a smooth contact normal for collision for a triangle of a mesh given by its vertices and vertices normals
+        static Vector3 computeSmoothLocalContactNormal(const Vector3* points, const Vector3& normal, const Vector3* verticesNormals,
+                                                       uint8 internalEdges, const Vector3& localContactPoint);
+
         /// Return the string representation of the shape
         virtual std::string to_string() const override;
 
@@ -187,6 +195,7 @@ class TriangleShape : public ConvexPolyhedronShape {
         friend class MiddlePhaseTriangleCallback;
         friend class HeightFieldShape;
         friend class CollisionDetectionSystem;
+        friend class GJKAlgorithm;
 };
 
 // Return the number of bytes used by the collision shape
@@ -305,30 +314,59 @@ RP3D_FORCE_INLINE decimal TriangleShape::getVolume() const {
 /// of the Game Physics Pearl book by Gino van der Bergen and Dirk Gregorius. The vertices normals of the
 /// mesh are either provided by the user or precomputed if the user did not provide them. Note that we only
 /// use the interpolated normal if the contact point is on an edge of the triangle. If the contact is in the
-/// middle of the triangle, we return the true triangle normal.
+/// middle of the triangle, we return the true triangle normal. We also return the true triangle normal if
+/// all the edges where the contact point lies are flat or concave edges of the mesh (precomputed when the
+/// mesh is cooked) because a contact on such an edge can only be a contact with the face of the triangle.
 RP3D_FORCE_INLINE Vector3 TriangleShape::computeSmoothLocalContactNormalForTriangle(const Vector3& localContactPoint) const {
+    return computeSmoothLocalContactNormal(mPoints, mNormal, mVerticesNormals, mInternalEdges, localContactPoint);
+}
 
-    assert(mNormal.length() > decimal(0.0));
+// Get a smooth contact normal for collision for a triangle of a mesh given by its vertices and vertices normals
+/// See computeSmoothLocalContactNormalForTriangle(). This method is also used for the triangles that are
+/// tested during the narrow-phase without any TriangleShape object.
+/**
+ * @param points The three vertices of the triangle
+ * @param normal The unit normal of the triangle
+ * @param verticesNormals The three vertices normals of the triangle
+ * @param internalEdges The flags of the flat or concave edges of the triangle in its mesh
+ * @param localContactPoint The contact point on the triangle
+ * @return The smooth contact normal
+ */
+RP3D_FORCE_INLINE Vector3 TriangleShape::computeSmoothLocalContactNormal(const Vector3* points, const Vector3& normal, const Vector3* verticesNormals,
+                                                                         uint8 internalEdges, const Vector3& localContactPoint) {
+
+    assert(normal.length() > decimal(0.0));
 
     // Compute the barycentric coordinates of the point in the triangle
     decimal u, v, w;
-    computeBarycentricCoordinatesInTriangle(mPoints[0], mPoints[1], mPoints[2], localContactPoint, u, v, w);
+    computeBarycentricCoordinatesInTriangle(points[0], points[1], points[2], localContactPoint, u, v, w);
 
     // If the contact is in the middle of the triangle face (not on the edges)
     if (u > MACHINE_EPSILON && v > MACHINE_EPSILON && w > MACHINE_EPSILON) {
 
         // We return the true triangle face normal (not the interpolated one)
-        return mNormal;
+        return normal;
+    }
+
+    // Flags of the edges where the contact point lies (the edge i is opposite to the vertex (i+2) % 3)
+    const uint8 contactEdges = static_cast<uint8>((w <= MACHINE_EPSILON ? 1 : 0) | (u <= MACHINE_EPSILON ? 2 : 0) |
+                                                  (v <= MACHINE_EPSILON ? 4 : 0));
+
+    // If the contact point is only on flat or concave edges of the mesh
+    if ((contactEdges & internalEdges) == contactEdges) {
+
+        // The contact normal does not need to be smoothed
+        return normal;
     }
 
     // We compute the contact normal as the barycentric interpolation of the three vertices normals
-    const Vector3 interpolatedNormal = u * mVerticesNormals[0] + v * mVerticesNormals[1] + w * mVerticesNormals[2];
+    const Vector3 interpolatedNormal = u * verticesNormals[0] + v * verticesNormals[1] + w * verticesNormals[2];
 
     // If the interpolated normal is degenerated
     if (interpolatedNormal.lengthSquare() < MACHINE_EPSILON) {
 
         // Return the original normal
-        return mNormal;
+        return normal;
     }
 
     return interpolatedNormal.getUnit();
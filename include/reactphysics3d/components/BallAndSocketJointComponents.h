@@ -146,6 +146,15 @@ class BallAndSocketJointComponents : public Components {
         /// Add a component
         void addComponent(Entity jointEntity, bool isSleeping, const BallAndSocketJointComponent& component);
 
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const override;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const override;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader) override;
+
         /// Return a pointer to a given joint
         BallAndSocketJoint* getJoint(Entity jointEntity) const;
 
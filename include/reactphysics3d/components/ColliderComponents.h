@@ -155,6 +155,15 @@ class ColliderComponents : public Components {
         /// Add a component
         void addComponent(Entity colliderEntity, bool isSleeping, const ColliderComponent& component);
 
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const override;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const override;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader) override;
+
         /// Return the body entity of a given collider
         Entity getBody(Entity colliderEntity) const;
 
@@ -30,6 +30,7 @@
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/engine/Entity.h>
 #include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/Array.h>
 
 // ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -37,6 +38,8 @@ namespace reactphysics3d {
 // Class declarations
 class MemoryAllocator;
 class EntityManager;
+class SnapshotWriter;
+class SnapshotReader;
 
 // Class Components
 /**
@@ -110,6 +113,9 @@ class Components {
         /// Notify if a given entity is disabled
         void setIsEntityDisabled(Entity entity, bool isDisabled);
 
+        /// Notify if a group of entities are disabled
+        void setIsEntitiesDisabled(const Array<Entity>& entities, bool isDisabled);
+
         /// Return true if there is a component for a given entity
         bool hasComponent(Entity entity) const;
 
@@ -124,6 +130,15 @@ class Components {
 
         /// Return the index in the arrays for a given entity
         uint32 getEntityIndex(Entity entity) const;
+
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader);
 };
 
 // Return true if an entity is sleeping
@@ -204,6 +204,15 @@ class HingeJointComponents : public Components {
         /// Add a component
         void addComponent(Entity jointEntity, bool isSleeping, const HingeJointComponent& component);
 
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const override;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const override;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader) override;
+
         /// Return a pointer to a given joint
         HingeJoint* getJoint(Entity jointEntity) const;
 
@@ -32,6 +32,7 @@
 #include <reactphysics3d/engine/Entity.h>
 #include <reactphysics3d/components/Components.h>
 #include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/SmallArray.h>
 
 // ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -149,7 +150,8 @@ class RigidBodyComponents : public Components {
         Array<Entity>* mJoints;
 
         /// For each body, the array of the indices of contact pairs in which the body is involved
-        Array<uint>* mContactPairs;
+        /// (the first contact pairs are stored inline in the component)
+        SmallArray<uint, 4>* mContactPairs;
 
         /// For each body, the vector of lock translation vectors
         Vector3* mLinearLockAxisFactors;
@@ -157,6 +159,21 @@ class RigidBodyComponents : public Components {
         /// For each body, the vector of lock rotation vectors
         Vector3* mAngularLockAxisFactors;
 
+        /// For each body, the previous body in the circular list of bodies of its sleeping island
+        /// (the body itself if it is not part of a sleeping island)
+        Entity* mPreviousBodiesInSleepingIsland;
+
+        /// For each body, the next body in the circular list of bodies of its sleeping island
+        /// (the body itself if it is not part of a sleeping island)
+        Entity* mNextBodiesInSleepingIsland;
+
+        /// For each body, true if its transform or its velocities have changed since the last
+        /// call to PhysicsWorld::exportRigidBodiesState()
+        bool* mHasChangedSinceLastExport;
+
+        /// Index of each body in the array of rigid bodies of the world (as in PhysicsWorld::getRigidBody())
+        uint32* mBodyIndicesInWorld;
+
         // -------------------- Methods -------------------- //
 
         /// Allocate memory for a given number of components
@@ -198,6 +215,15 @@ class RigidBodyComponents : public Components {
         /// Add a component
         void addComponent(Entity bodyEntity, bool isSleeping, const RigidBodyComponent& component);
 
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const override;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const override;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader) override;
+
         /// Return a pointer to a rigid body
         RigidBody* getRigidBody(Entity bodyEntity);
 
@@ -318,6 +344,12 @@ class RigidBodyComponents : public Components {
         /// Return true if the entity is already in an island
         bool getIsAlreadyInIsland(Entity bodyEntity) const;
 
+        /// Return true if the transform or the velocities of the body have changed since the last export
+        bool getHasChangedSinceLastExport(Entity bodyEntity) const;
+
+        /// Return the index of the body in the array of rigid bodies of the world
+        uint32 getBodyIndexInWorld(Entity bodyEntity) const;
+
         /// Return the lock translation factor
         const Vector3& getLinearLockAxisFactor(Entity bodyEntity) const;
 
@@ -354,6 +386,12 @@ class RigidBodyComponents : public Components {
         /// Set the value to know if the entity is already in an island
         void setIsAlreadyInIsland(Entity bodyEntity, bool isAlreadyInIsland);
 
+        /// Set the value to know if the transform or the velocities of the body have changed since the last export
+        void setHasChangedSinceLastExport(Entity bodyEntity, bool hasChanged);
+
+        /// Set the index of the body in the array of rigid bodies of the world
+        void setBodyIndexInWorld(Entity bodyEntity, uint32 index);
+
         /// Set the linear lock axis factor
         void setLinearLockAxisFactor(Entity bodyEntity, const Vector3& linearLockAxisFactor);
 
@@ -372,6 +410,15 @@ class RigidBodyComponents : public Components {
         /// A an associated contact pairs into the contact pairs array of the body
         void addContacPair(Entity bodyEntity, uint32 contactPairIndex);
 
+        /// Link a range of bodies of an array together into a single sleeping island
+        void setSleepingIsland(const Array<Entity>& bodyEntities, uint32 startIndex, uint32 nbBodies);
+
+        /// Remove a body from its sleeping island (if any)
+        void removeBodyFromSleepingIsland(Entity bodyEntity);
+
+        /// Add all the bodies of the sleeping island of a given body into an array
+        void getSleepingIslandBodies(Entity bodyEntity, Array<Entity>& outBodyEntities) const;
+
         // -------------------- Friendship -------------------- //
 
         friend class PhysicsWorld;
@@ -772,6 +819,22 @@ RP3D_FORCE_INLINE bool RigidBodyComponents::getIsAlreadyInIsland(Entity bodyEnti
    return mIsAlreadyInIsland[mMapEntityToComponentIndex[bodyEntity]];
 }
 
+// Return true if the transform or the velocities of the body have changed since the last export
+RP3D_FORCE_INLINE bool RigidBodyComponents::getHasChangedSinceLastExport(Entity bodyEntity) const {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+   return mHasChangedSinceLastExport[mMapEntityToComponentIndex[bodyEntity]];
+}
+
+// Return the index of the body in the array of rigid bodies of the world
+RP3D_FORCE_INLINE uint32 RigidBodyComponents::getBodyIndexInWorld(Entity bodyEntity) const {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+   return mBodyIndicesInWorld[mMapEntityToComponentIndex[bodyEntity]];
+}
+
 
 // Return the linear lock axis factor
 RP3D_FORCE_INLINE const Vector3& RigidBodyComponents::getLinearLockAxisFactor(Entity bodyEntity) const {
@@ -804,6 +867,20 @@ RP3D_FORCE_INLINE void RigidBodyComponents::setIsAlreadyInIsland(Entity bodyEnti
    mIsAlreadyInIsland[mMapEntityToComponentIndex[bodyEntity]] = isAlreadyInIsland;
 }
 
+// Set the value to know if the transform or the velocities of the body have changed since the last export
+RP3D_FORCE_INLINE void RigidBodyComponents::setHasChangedSinceLastExport(Entity bodyEntity, bool hasChanged) {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+   mHasChangedSinceLastExport[mMapEntityToComponentIndex[bodyEntity]] = hasChanged;
+}
+
+// Set the index of the body in the array of rigid bodies of the world
+RP3D_FORCE_INLINE void RigidBodyComponents::setBodyIndexInWorld(Entity bodyEntity, uint32 index) {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+   mBodyIndicesInWorld[mMapEntityToComponentIndex[bodyEntity]] = index;
+}
+
 // Set the linear lock axis factor
 RP3D_FORCE_INLINE void RigidBodyComponents::setLinearLockAxisFactor(Entity bodyEntity, const Vector3& linearLockAxisFactor) {
 
@@ -846,6 +923,54 @@ RP3D_FORCE_INLINE void RigidBodyComponents::addContacPair(Entity bodyEntity, uin
     mContactPairs[mMapEntityToComponentIndex[bodyEntity]].add(contactPairIndex);
 }
 
+// Link a group of bodies together into a single sleeping island
+/// The bodies are stored in a circular doubly-linked list so that the whole island can be
+/// retrieved (and woken up) from any of its bodies.
+RP3D_FORCE_INLINE void RigidBodyComponents::setSleepingIsland(const Array<Entity>& bodyEntities, uint32 startIndex, uint32 nbBodies) {
+
+    assert(startIndex + nbBodies <= bodyEntities.size());
+
+    const uint32 endIndex = startIndex + nbBodies;
+    for (uint32 i=startIndex; i < endIndex; i++) {
+
+        assert(mMapEntityToComponentIndex.containsKey(bodyEntities[i]));
+
+        const uint32 index = mMapEntityToComponentIndex[bodyEntities[i]];
+        mPreviousBodiesInSleepingIsland[index] = bodyEntities[i == startIndex ? endIndex - 1 : i - 1];
+        mNextBodiesInSleepingIsland[index] = bodyEntities[i == endIndex - 1 ? startIndex : i + 1];
+    }
+}
+
+// Remove a body from its sleeping island (if any)
+RP3D_FORCE_INLINE void RigidBodyComponents::removeBodyFromSleepingIsland(Entity bodyEntity) {
+
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+    const uint32 index = mMapEntityToComponentIndex[bodyEntity];
+    const Entity previousBody = mPreviousBodiesInSleepingIsland[index];
+    const Entity nextBody = mNextBodiesInSleepingIsland[index];
+
+    if (nextBody == bodyEntity) return;
+
+    mNextBodiesInSleepingIsland[mMapEntityToComponentIndex[previousBody]] = nextBody;
+    mPreviousBodiesInSleepingIsland[mMapEntityToComponentIndex[nextBody]] = previousBody;
+    mPreviousBodiesInSleepingIsland[index] = bodyEntity;
+    mNextBodiesInSleepingIsland[index] = bodyEntity;
+}
+
+// Add all the bodies of the sleeping island of a given body into an array
+/// If the body is not part of a sleeping island, only the body itself is added
+RP3D_FORCE_INLINE void RigidBodyComponents::getSleepingIslandBodies(Entity bodyEntity, Array<Entity>& outBodyEntities) const {
+
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+    Entity currentBody = bodyEntity;
+    do {
+        outBodyEntities.add(currentBody);
+        currentBody = mNextBodiesInSleepingIsland[mMapEntityToComponentIndex[currentBody]];
+    } while (currentBody != bodyEntity);
+}
+
 }
 
 #endif
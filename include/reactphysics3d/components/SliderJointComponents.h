@@ -219,6 +219,15 @@ class SliderJointComponents : public Components {
         /// Add a component
         void addComponent(Entity jointEntity, bool isSleeping, const SliderJointComponent& component);
 
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const override;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const override;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader) override;
+
         /// Return a pointer to a given joint
         SliderJoint* getJoint(Entity jointEntity) const;
 
@@ -57,6 +57,14 @@ class TransformComponents : public Components {
         /// Array of transform of each component
         Transform* mTransforms;
 
+        /// Array with the transform of each component at the beginning of the last time step
+        /// (used to interpolate the transforms between two fixed time steps)
+        Transform* mPreviousTransforms;
+
+        /// Array with a boolean for each component that is true if the transform has been set by
+        /// the user since the beginning of the last time step (cleared at the beginning of each step)
+        bool* mIsMovedSinceLastStep;
+
         // -------------------- Methods -------------------- //
 
         /// Allocate memory for a given number of components
@@ -95,15 +103,34 @@ class TransformComponents : public Components {
         /// Add a component
         void addComponent(Entity bodyEntity, bool isSleeping, const TransformComponent& component);
 
+        /// Write the state of the components into a snapshot
+        virtual void takeSnapshot(SnapshotWriter& writer) const override;
+
+        /// Check that a snapshot of the components matches the components and skip it
+        virtual bool validateSnapshot(SnapshotReader& reader) const override;
+
+        /// Restore the state of the components from a snapshot
+        virtual void restoreSnapshot(SnapshotReader& reader) override;
+
         /// Return the transform of an entity
         Transform& getTransform(Entity bodyEntity) const;
 
         /// Set the transform of an entity
         void setTransform(Entity bodyEntity, const Transform& transform);
 
+        /// Return the transform of an entity at the beginning of the last fixed time step
+        const Transform& getPreviousTransform(Entity bodyEntity) const;
+
+        /// Set the previous transform of an entity to its current transform
+        void resetPreviousTransform(Entity bodyEntity);
+
+        /// Store the current transforms of all the components as the previous transforms
+        void storePreviousTransforms();
+
         // -------------------- Friendship -------------------- //
 
         friend class BroadPhaseSystem;
+        friend class PhysicsWorld;
 };
 
 // Return the transform of an entity
@@ -113,9 +140,44 @@ RP3D_FORCE_INLINE Transform& TransformComponents::getTransform(Entity bodyEntity
 }
 
 // Set the transform of an entity
+/// The first time the transform is set between two fixed time steps, the transform at the end of
+/// the last step becomes the previous transform so that the move is interpolated during the next step
 RP3D_FORCE_INLINE void TransformComponents::setTransform(Entity bodyEntity, const Transform& transform) {
     assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
-    mTransforms[mMapEntityToComponentIndex[bodyEntity]] = transform;
+    const uint32 index = mMapEntityToComponentIndex[bodyEntity];
+    if (!mIsMovedSinceLastStep[index]) {
+        mPreviousTransforms[index] = mTransforms[index];
+        mIsMovedSinceLastStep[index] = true;
+    }
+    mTransforms[index] = transform;
+}
+
+// Return the transform of an entity at the beginning of the last fixed time step
+RP3D_FORCE_INLINE const Transform& TransformComponents::getPreviousTransform(Entity bodyEntity) const {
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+    return mPreviousTransforms[mMapEntityToComponentIndex[bodyEntity]];
+}
+
+// Set the previous transform of an entity to its current transform
+/// This way, a teleported body is not interpolated between its old and its new location
+RP3D_FORCE_INLINE void TransformComponents::resetPreviousTransform(Entity bodyEntity) {
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+    const uint32 index = mMapEntityToComponentIndex[bodyEntity];
+    mPreviousTransforms[index] = mTransforms[index];
+}
+
+// Store the current transforms of all the components as the previous transforms
+/// The components that have been moved since the last step keep the previous transform
+/// that has been set in setTransform()
+RP3D_FORCE_INLINE void TransformComponents::storePreviousTransforms() {
+    for (uint32 i=0; i < mNbComponents; i++) {
+        if (!mIsMovedSinceLastStep[i]) {
+            mPreviousTransforms[i] = mTransforms[i];
+        }
+    }
+    if (mNbComponents > 0) {
+        memset(mIsMovedSinceLastStep, 0, mNbComponents * sizeof(bool));
+    }
 }
 
 }
@@ -36,6 +36,9 @@
 
 namespace reactphysics3d {
 
+// Declarations
+template<typename T, uint64 N> class SmallArray;
+
 // Class Array
 /**
  * This class represents a simple dynamic array with custom memory allocator.
@@ -235,6 +238,10 @@ class Array {
             addRange(array);
         }
 
+        /// Deleted copy of a SmallArray into an Array (the copy would use the inline buffer of the SmallArray as allocator)
+        template<uint64 N>
+        Array(const SmallArray<T, N>& array) = delete;
+
         /// Destructor
         ~Array() {
 
@@ -478,6 +485,10 @@ class Array {
             return *this;
         }
 
+        /// Deleted assignment of a SmallArray to an Array (a SmallArray must only be copied into another SmallArray)
+        template<uint64 N>
+        Array<T>& operator=(const SmallArray<T, N>& array) = delete;
+
         /// Return a begin iterator
         Iterator begin() const {
             return Iterator(mBuffer, 0, mSize);
@@ -0,0 +1,260 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_FLAT_HASH_GROUP_H
+#define REACTPHYSICS3D_FLAT_HASH_GROUP_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <cstddef>
+#include <cassert>
+
+// Use SSE2 instructions to compare the control bytes of a group if they are available
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define RP3D_FLAT_HASH_USE_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace reactphysics3d {
+
+// Structure FlatHashVoid
+/**
+ * Helper that maps any type to void (used to detect the is_avalanching type of a hash function)
+ */
+template<typename T>
+struct FlatHashVoid {
+    using type = void;
+};
+
+// Structure IsAvalanchingHash
+/**
+ * The value of this structure is true if the hash function declares an is_avalanching type.
+ * Such a hash function already returns well mixed hash codes and the open-addressing
+ * containers use its hash codes directly (see Uint64Hash and EntityHash).
+ */
+template<class Hash, typename Enable = void>
+struct IsAvalanchingHash {
+    static constexpr bool value = false;
+};
+
+template<class Hash>
+struct IsAvalanchingHash<Hash, typename FlatHashVoid<typename Hash::is_avalanching>::type> {
+    static constexpr bool value = true;
+};
+
+/// Return a hash code with well mixed bits for an integer key (Fibonacci hashing)
+RP3D_FORCE_INLINE size_t hashInteger(uint64 key) {
+    const uint64 hashCode = key * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hashCode ^ (hashCode >> 32));
+}
+
+// Structure Uint64Hash
+/**
+ * Hash function for uint64 keys (like the pair ids). Unlike std::hash<uint64>, which is
+ * usually the identity, the bits of the hash codes are mixed. Therefore, the open-addressing
+ * containers (FlatMap and FlatSet) do not need to mix them again.
+ */
+struct Uint64Hash {
+
+    /// The hash codes are well mixed
+    using is_avalanching = void;
+
+    size_t operator()(uint64 key) const {
+        return hashInteger(key);
+    }
+};
+
+// Class FlatHashGroup
+/**
+ * This class contains the control bytes logic of the open-addressing hash containers
+ * (like FlatMap). Each slot of the hash table has a control byte. This byte is EMPTY,
+ * DELETED or, for a used slot, the 7 lowest bits of the hash code of its key. The slots
+ * are probed by groups of GROUP_SIZE consecutive control bytes that are compared at once
+ * (with SSE2 instructions when available). This way, most lookups only read a single
+ * group of control bytes and compare a single key.
+ */
+class FlatHashGroup {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of slots in a group
+        static constexpr uint32 GROUP_SIZE = 16;
+
+        /// Control byte of an empty slot
+        static constexpr int8 EMPTY = -128;
+
+        /// Control byte of a slot whose item has been removed
+        static constexpr int8 DELETED = -2;
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Pointer to the first control byte of the group
+        const int8* mControlBytes;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        explicit FlatHashGroup(const int8* controlBytes) : mControlBytes(controlBytes) {
+
+        }
+
+        /// Return a mask with a bit set for each slot of the group with a given control byte
+        uint32 match(int8 controlByte) const;
+
+        /// Return a mask with a bit set for each empty slot of the group
+        uint32 matchEmpty() const;
+
+        /// Return a mask with a bit set for each empty or deleted slot of the group
+        uint32 matchEmptyOrDeleted() const;
+
+        /// Return true if a control byte is the one of a used slot
+        static bool isFull(int8 controlByte);
+
+        /// Return the index of the lowest bit set in a non-zero mask
+        static uint32 lowestBitIndex(uint32 mask);
+
+        /// Mix the bits of a hash code. The hash tables use both the lowest and the highest bits
+        /// of the mixed code. Therefore, simple hash functions (like the identity) still work well.
+        static uint64 mixHashCode(size_t hashCode);
+
+        /// Return the mixed hash code of a key for a given hash function
+        template<class Hash, typename K>
+        static uint64 computeHashCode(const K& key);
+
+        /// Return the 7 bits stored in the control byte of a slot for a mixed hash code
+        static int8 getControlByte(uint64 mixedHashCode);
+
+        /// Return the group where the probing of a mixed hash code starts
+        static uint64 getFirstGroup(uint64 mixedHashCode, uint64 groupMask);
+};
+
+// Return a mask with a bit set for each slot of the group with a given control byte
+RP3D_FORCE_INLINE uint32 FlatHashGroup::match(int8 controlByte) const {
+
+#ifdef RP3D_FLAT_HASH_USE_SSE2
+
+    const __m128i controlBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mControlBytes));
+    return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(controlByte), controlBytes)));
+#else
+
+    uint32 mask = 0;
+    for (uint32 i=0; i < GROUP_SIZE; i++) {
+        mask |= static_cast<uint32>(mControlBytes[i] == controlByte) << i;
+    }
+    return mask;
+#endif
+}
+
+// Return a mask with a bit set for each empty slot of the group
+RP3D_FORCE_INLINE uint32 FlatHashGroup::matchEmpty() const {
+    return match(EMPTY);
+}
+
+// Return a mask with a bit set for each empty or deleted slot of the group
+RP3D_FORCE_INLINE uint32 FlatHashGroup::matchEmptyOrDeleted() const {
+
+    // The empty and deleted control bytes are the only negative ones
+#ifdef RP3D_FLAT_HASH_USE_SSE2
+
+    const __m128i controlBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mControlBytes));
+    return static_cast<uint32>(_mm_movemask_epi8(controlBytes));
+#else
+
+    uint32 mask = 0;
+    for (uint32 i=0; i < GROUP_SIZE; i++) {
+        mask |= static_cast<uint32>(mControlBytes[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+// Return true if a control byte is the one of a used slot
+RP3D_FORCE_INLINE bool FlatHashGroup::isFull(int8 controlByte) {
+    return controlByte >= 0;
+}
+
+// Return the index of the lowest bit set in a non-zero mask
+RP3D_FORCE_INLINE uint32 FlatHashGroup::lowestBitIndex(uint32 mask) {
+
+    assert(mask != 0);
+
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<uint32>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32>(__builtin_ctz(mask));
+#else
+    uint32 index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Mix the bits of a hash code
+RP3D_FORCE_INLINE uint64 FlatHashGroup::mixHashCode(size_t hashCode) {
+
+    // Finalizer of the MurmurHash3 hash function
+    uint64 code = static_cast<uint64>(hashCode);
+    code ^= code >> 33;
+    code *= 0xff51afd7ed558ccdULL;
+    code ^= code >> 33;
+    return code;
+}
+
+// Return the mixed hash code of a key for a given hash function
+template<class Hash, typename K>
+RP3D_FORCE_INLINE uint64 FlatHashGroup::computeHashCode(const K& key) {
+
+    const size_t hashCode = Hash()(key);
+    return IsAvalanchingHash<Hash>::value ? static_cast<uint64>(hashCode) : mixHashCode(hashCode);
+}
+
+// Return the 7 bits stored in the control byte of a slot for a mixed hash code
+RP3D_FORCE_INLINE int8 FlatHashGroup::getControlByte(uint64 mixedHashCode) {
+    return static_cast<int8>(mixedHashCode & 0x7F);
+}
+
+// Return the group where the probing of a mixed hash code starts
+RP3D_FORCE_INLINE uint64 FlatHashGroup::getFirstGroup(uint64 mixedHashCode, uint64 groupMask) {
+    return (mixedHashCode >> 7) & groupMask;
+}
+
+}
+
+#endif
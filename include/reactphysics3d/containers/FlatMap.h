@@ -0,0 +1,576 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_FLAT_MAP_H
+#define REACTPHYSICS3D_FLAT_MAP_H
+
+// Libraries
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/mathematics/mathematics_functions.h>
+#include <reactphysics3d/containers/Pair.h>
+#include <reactphysics3d/containers/FlatHashGroup.h>
+#include <cstring>
+#include <stdexcept>
+#include <functional>
+#include <limits>
+
+namespace reactphysics3d {
+
+// Class FlatMap
+/**
+ * This class represents a generic associative map implemented with an open-addressing
+ * hash table. It has the same interface as the Map class. The items are stored directly
+ * in an array of slots. A second array contains a control byte for each slot. A lookup
+ * compares a whole group of control bytes at once (see FlatHashGroup) and only compares
+ * the keys of the slots with matching control bytes. Compared to the Map class, there are
+ * no buckets and no chains of entries to follow. This map is a good choice for small keys
+ * and values that are looked up very often (like pair ids).
+ * Note that adding an item can move the other items of the map (when the table grows).
+ */
+template<typename K, typename V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class FlatMap {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of slots in a group
+        static constexpr uint64 GROUP_SIZE = FlatHashGroup::GROUP_SIZE;
+
+        /// Invalid index in the array
+        static constexpr uint64 INVALID_INDEX = -1;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Number of items in the map
+        uint64 mNbEntries;
+
+        /// Number of slots with a DELETED control byte
+        uint64 mNbDeletedSlots;
+
+        /// Total number of slots (zero or a power of two larger or equal to GROUP_SIZE)
+        uint64 mNbSlots;
+
+        /// Array with the control byte of each slot
+        int8* mControlBytes;
+
+        /// Array with all the slots
+        Pair<K, V>* mSlots;
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the maximum number of used and deleted slots for a given number of slots
+        static uint64 getMaxNbLoadedSlots(uint64 nbSlots) {
+
+            // Maximum load factor of 7/8. There is always at least one empty slot
+            // and therefore the probing of a key always terminates
+            return nbSlots - nbSlots / 8;
+        }
+
+        /// Return the index of the slot with a given key or INVALID_INDEX if there is no item with this key
+        uint64 findEntry(const K& key) const {
+
+            if (mNbSlots > 0) {
+
+                const uint64 hashCode = FlatHashGroup::computeHashCode<Hash>(key);
+                const int8 controlByte = FlatHashGroup::getControlByte(hashCode);
+                const uint64 groupMask = mNbSlots / GROUP_SIZE - 1;
+                uint64 group = FlatHashGroup::getFirstGroup(hashCode, groupMask);
+                auto keyEqual = KeyEqual();
+
+                // Triangular probing of the groups (this visits all the groups)
+                for (uint64 i=1; ; i++) {
+
+                    const FlatHashGroup controlGroup(mControlBytes + group * GROUP_SIZE);
+
+                    // Compare the keys of the slots with the same control byte
+                    uint32 matchMask = controlGroup.match(controlByte);
+                    while (matchMask != 0) {
+
+                        const uint64 slot = group * GROUP_SIZE + FlatHashGroup::lowestBitIndex(matchMask);
+                        if (keyEqual(mSlots[slot].first, key)) {
+                            return slot;
+                        }
+
+                        matchMask &= matchMask - 1;
+                    }
+
+                    // If there is an empty slot in the group, the key cannot be further
+                    if (controlGroup.matchEmpty() != 0) {
+                        return INVALID_INDEX;
+                    }
+
+                    assert(i <= groupMask);
+                    group = (group + i) & groupMask;
+                }
+            }
+
+            return INVALID_INDEX;
+        }
+
+        /// Return the index of the first empty or deleted slot in the probing sequence of a mixed hash code
+        uint64 findFreeSlot(uint64 hashCode) const {
+
+            assert(mNbSlots > 0);
+
+            const uint64 groupMask = mNbSlots / GROUP_SIZE - 1;
+            uint64 group = FlatHashGroup::getFirstGroup(hashCode, groupMask);
+
+            for (uint64 i=1; ; i++) {
+
+                const uint32 freeMask = FlatHashGroup(mControlBytes + group * GROUP_SIZE).matchEmptyOrDeleted();
+                if (freeMask != 0) {
+                    return group * GROUP_SIZE + FlatHashGroup::lowestBitIndex(freeMask);
+                }
+
+                assert(i <= groupMask);
+                group = (group + i) & groupMask;
+            }
+        }
+
+        /// Return the index of the first used slot at or after a given slot (or mNbSlots if there is none)
+        uint64 findUsedSlot(uint64 slot) const {
+
+            while (slot < mNbSlots && !FlatHashGroup::isFull(mControlBytes[slot])) {
+                slot++;
+            }
+
+            return slot;
+        }
+
+        /// Rebuild the hash table with a given number of slots
+        void rehash(uint64 nbSlots) {
+
+            assert(nbSlots >= GROUP_SIZE && isPowerOfTwo(nbSlots));
+            assert(mNbEntries <= getMaxNbLoadedSlots(nbSlots));
+
+            int8* oldControlBytes = mControlBytes;
+            Pair<K, V>* oldSlots = mSlots;
+            const uint64 oldNbSlots = mNbSlots;
+
+            // Allocate memory for the new slots
+            mControlBytes = static_cast<int8*>(mAllocator.allocate(nbSlots * sizeof(int8)));
+            mSlots = static_cast<Pair<K, V>*>(mAllocator.allocate(nbSlots * sizeof(Pair<K, V>)));
+            assert(mControlBytes != nullptr);
+            assert(mSlots != nullptr);
+            std::memset(mControlBytes, FlatHashGroup::EMPTY, nbSlots * sizeof(int8));
+            mNbSlots = nbSlots;
+            mNbDeletedSlots = 0;
+
+            // Move the items into the new slots
+            for (uint64 i=0; i < oldNbSlots; i++) {
+
+                if (FlatHashGroup::isFull(oldControlBytes[i])) {
+
+                    const uint64 hashCode = FlatHashGroup::computeHashCode<Hash>(oldSlots[i].first);
+                    const uint64 slot = findFreeSlot(hashCode);
+                    mControlBytes[slot] = FlatHashGroup::getControlByte(hashCode);
+
+                    // Copy the item to the new location and destroy the previous one
+                    new (mSlots + slot) Pair<K, V>(oldSlots[i]);
+                    oldSlots[i].~Pair<K, V>();
+                }
+            }
+
+            if (oldNbSlots > 0) {
+
+                // Release previously allocated memory
+                mAllocator.release(oldControlBytes, oldNbSlots * sizeof(int8));
+                mAllocator.release(oldSlots, oldNbSlots * sizeof(Pair<K, V>));
+            }
+        }
+
+        /// Copy the slots of another map with the same number of slots
+        void copySlotsFrom(const FlatMap& map) {
+
+            assert(mNbSlots == map.mNbSlots);
+
+            if (mNbSlots > 0) {
+
+                mControlBytes = static_cast<int8*>(mAllocator.allocate(mNbSlots * sizeof(int8)));
+                mSlots = static_cast<Pair<K, V>*>(mAllocator.allocate(mNbSlots * sizeof(Pair<K, V>)));
+
+                // Copy the control bytes and the used slots
+                std::memcpy(mControlBytes, map.mControlBytes, mNbSlots * sizeof(int8));
+                for (uint64 i=0; i < mNbSlots; i++) {
+                    if (FlatHashGroup::isFull(mControlBytes[i])) {
+                        new (mSlots + i) Pair<K, V>(map.mSlots[i]);
+                    }
+                }
+            }
+        }
+
+    public:
+
+        /// Class Iterator
+        /**
+         * This class represents an iterator for the FlatMap.
+         */
+        class Iterator {
+
+            private:
+
+                /// Pointer to the map
+                const FlatMap* mMap;
+
+                /// Index of the current slot
+                uint64 mCurrentSlotIndex;
+
+            public:
+
+                // Iterator traits
+                using value_type = Pair<K,V>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = Pair<K, V>*;
+                using reference = Pair<K,V>&;
+                using iterator_category = std::forward_iterator_tag;
+
+                /// Constructor
+                Iterator() = default;
+
+                /// Constructor
+                Iterator(const FlatMap* map, uint64 slotIndex) :mMap(map), mCurrentSlotIndex(slotIndex) {
+
+                }
+
+                /// Deferencable
+                reference operator*() const {
+                    assert(mCurrentSlotIndex < mMap->mNbSlots);
+                    assert(FlatHashGroup::isFull(mMap->mControlBytes[mCurrentSlotIndex]));
+                    return mMap->mSlots[mCurrentSlotIndex];
+                }
+
+                /// Deferencable
+                pointer operator->() const {
+                    assert(mCurrentSlotIndex < mMap->mNbSlots);
+                    assert(FlatHashGroup::isFull(mMap->mControlBytes[mCurrentSlotIndex]));
+                    return &(mMap->mSlots[mCurrentSlotIndex]);
+                }
+
+                /// Pre increment (++it)
+                Iterator& operator++() {
+                    mCurrentSlotIndex = mMap->findUsedSlot(mCurrentSlotIndex + 1);
+                    return *this;
+                }
+
+                /// Post increment (it++)
+                Iterator operator++(int) {
+                    Iterator tmp = *this;
+                    mCurrentSlotIndex = mMap->findUsedSlot(mCurrentSlotIndex + 1);
+                    return tmp;
+                }
+
+                /// Equality operator (it == end())
+                bool operator==(const Iterator& iterator) const {
+                    return mCurrentSlotIndex == iterator.mCurrentSlotIndex && mMap == iterator.mMap;
+                }
+
+                /// Inequality operator (it != end())
+                bool operator!=(const Iterator& iterator) const {
+                    return !(*this == iterator);
+                }
+        };
+
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        FlatMap(MemoryAllocator& allocator, uint64 capacity = 0)
+            : mNbEntries(0), mNbDeletedSlots(0), mNbSlots(0), mControlBytes(nullptr), mSlots(nullptr),
+              mAllocator(allocator) {
+
+            if (capacity > 0) {
+
+               reserve(capacity);
+            }
+        }
+
+        /// Copy constructor
+        FlatMap(const FlatMap& map)
+          :mNbEntries(map.mNbEntries), mNbDeletedSlots(map.mNbDeletedSlots), mNbSlots(map.mNbSlots),
+           mControlBytes(nullptr), mSlots(nullptr), mAllocator(map.mAllocator) {
+
+            copySlotsFrom(map);
+        }
+
+        /// Destructor
+        ~FlatMap() {
+
+            clear(true);
+        }
+
+        /// Allocate memory for a given number of elements
+        void reserve(uint64 capacity) {
+
+            if (capacity <= getMaxNbLoadedSlots(mNbSlots)) return;
+
+            // Number of slots such that the capacity does not exceed the maximum load factor
+            uint64 nbSlots = capacity + capacity / 7 + 1;
+            if (nbSlots < GROUP_SIZE) nbSlots = GROUP_SIZE;
+
+            // Make sure we have a power of two size
+            if (!isPowerOfTwo(nbSlots)) {
+                nbSlots = nextPowerOfTwo64Bits(nbSlots);
+            }
+
+            assert(getMaxNbLoadedSlots(nbSlots) >= capacity);
+
+            rehash(nbSlots);
+        }
+
+        /// Return true if the map contains an item with the given key
+        bool containsKey(const K& key) const {
+            return findEntry(key) != INVALID_INDEX;
+        }
+
+        /// Add an element into the map
+        /// Returns true if the item has been inserted and false otherwise.
+        bool add(const Pair<K,V>& keyValue, bool insertIfAlreadyPresent = false) {
+
+            // If there is already an item with the same key in the map
+            const uint64 entry = findEntry(keyValue.first);
+            if (entry != INVALID_INDEX) {
+
+                if (insertIfAlreadyPresent) {
+
+                    // Destruct the previous key/value
+                    mSlots[entry].~Pair<K, V>();
+
+                    // Copy construct the new key/value
+                    new (mSlots + entry) Pair<K,V>(keyValue);
+
+                    return true;
+                }
+                else {
+                    assert(false);
+                    throw std::runtime_error("The key and value pair already exists in the map");
+                }
+            }
+
+            // Compute the hash code of the key
+            const uint64 hashCode = FlatHashGroup::computeHashCode<Hash>(keyValue.first);
+
+            uint64 slot = mNbSlots > 0 ? findFreeSlot(hashCode) : INVALID_INDEX;
+
+            // If we need to use an empty slot but the table is full
+            if (slot == INVALID_INDEX || (mControlBytes[slot] == FlatHashGroup::EMPTY &&
+                                          mNbEntries + mNbDeletedSlots + 1 > getMaxNbLoadedSlots(mNbSlots))) {
+
+                // Grow the table or only get rid of the deleted slots if there are many of them
+                const bool isTableLarge = mNbEntries + 1 > getMaxNbLoadedSlots(mNbSlots) / 2;
+                rehash(mNbSlots == 0 ? GROUP_SIZE : (isTableLarge ? mNbSlots * 2 : mNbSlots));
+
+                slot = findFreeSlot(hashCode);
+            }
+
+            if (mControlBytes[slot] == FlatHashGroup::DELETED) {
+                mNbDeletedSlots--;
+            }
+
+            // Use the slot
+            mControlBytes[slot] = FlatHashGroup::getControlByte(hashCode);
+            new (mSlots + slot) Pair<K, V>(keyValue);
+            mNbEntries++;
+
+            return true;
+        }
+
+        /// Remove the element pointed by some iterator
+        /// This method returns an iterator pointing to the element after
+        /// the one that has been removed
+        Iterator remove(const Iterator& it) {
+
+            const K& key = it->first;
+            return remove(key);
+        }
+
+        /// Remove the element from the map with a given key
+        /// This method returns an iterator pointing to the element after
+        /// the one that has been removed
+        Iterator remove(const K& key) {
+
+            const uint64 slot = findEntry(key);
+            if (slot == INVALID_INDEX) {
+                return end();
+            }
+
+            mSlots[slot].~Pair<K,V>();
+            mNbEntries--;
+
+            // If the group of the slot already has an empty slot, the probing of any key stops in this
+            // group and the slot can be marked as empty. Otherwise, the probing must continue after it.
+            const uint64 groupStart = slot - (slot % GROUP_SIZE);
+            if (FlatHashGroup(mControlBytes + groupStart).matchEmpty() != 0) {
+                mControlBytes[slot] = FlatHashGroup::EMPTY;
+            }
+            else {
+                mControlBytes[slot] = FlatHashGroup::DELETED;
+                mNbDeletedSlots++;
+            }
+
+            // The other items do not move
+            return Iterator(this, findUsedSlot(slot + 1));
+        }
+
+        /// Clear the map
+        void clear(bool releaseMemory = false) {
+
+            for (uint64 i=0; i < mNbSlots; i++) {
+
+                // Destroy the item
+                if (FlatHashGroup::isFull(mControlBytes[i])) {
+                    mSlots[i].~Pair<K,V>();
+                }
+            }
+
+            if (releaseMemory && mNbSlots > 0) {
+
+                // Release previously allocated memory
+                mAllocator.release(mControlBytes, mNbSlots * sizeof(int8));
+                mAllocator.release(mSlots, mNbSlots * sizeof(Pair<K, V>));
+
+                mControlBytes = nullptr;
+                mSlots = nullptr;
+                mNbSlots = 0;
+            }
+            else if (mNbSlots > 0) {
+                std::memset(mControlBytes, FlatHashGroup::EMPTY, mNbSlots * sizeof(int8));
+            }
+
+            mNbEntries = 0;
+            mNbDeletedSlots = 0;
+        }
+
+        /// Return the number of elements in the map
+        uint64 size() const {
+            return mNbEntries;
+        }
+
+        /// Return the capacity of the map (number of elements it can contain without allocating memory)
+        uint64 capacity() const {
+            return getMaxNbLoadedSlots(mNbSlots);
+        }
+
+        /// Try to find an item of the map given a key.
+        /// The method returns an iterator to the found item or
+        /// an iterator pointing to the end if not found
+        Iterator find(const K& key) const {
+
+            const uint64 slot = findEntry(key);
+
+            if (slot == INVALID_INDEX) {
+                return end();
+            }
+
+            return Iterator(this, slot);
+        }
+
+        /// Overloaded index operator
+        V& operator[](const K& key) {
+
+            const uint64 slot = findEntry(key);
+
+            if (slot == INVALID_INDEX) {
+                assert(false);
+                throw std::runtime_error("No item with given key has been found in the map");
+            }
+
+            return mSlots[slot].second;
+        }
+
+        /// Overloaded index operator
+        const V& operator[](const K& key) const {
+
+            const uint64 slot = findEntry(key);
+
+            if (slot == INVALID_INDEX) {
+                assert(false);
+                throw std::runtime_error("No item with given key has been found in the map");
+            }
+
+            return mSlots[slot].second;
+        }
+
+        /// Overloaded equality operator
+        bool operator==(const FlatMap& map) const {
+
+            if (size() != map.size()) return false;
+
+            for (auto it = begin(); it != end(); ++it) {
+                auto it2 = map.find(it->first);
+                if (it2 == map.end() || it2->second != it->second) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Overloaded not equal operator
+        bool operator!=(const FlatMap& map) const {
+
+            return !((*this) == map);
+        }
+
+        /// Overloaded assignment operator
+        FlatMap& operator=(const FlatMap& map) {
+
+            // Check for self assignment
+            if (this != &map) {
+
+                // Clear the map
+                clear(true);
+
+                mNbEntries = map.mNbEntries;
+                mNbDeletedSlots = map.mNbDeletedSlots;
+                mNbSlots = map.mNbSlots;
+
+                copySlotsFrom(map);
+            }
+
+            return *this;
+        }
+
+        /// Return a begin iterator
+        Iterator begin() const {
+            return Iterator(this, findUsedSlot(0));
+        }
+
+        /// Return a end iterator
+        Iterator end() const {
+            return Iterator(this, mNbSlots);
+        }
+
+        // ---------- Friendship ---------- //
+
+        friend class Iterator;
+};
+
+}
+
+#endif
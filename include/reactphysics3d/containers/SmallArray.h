@@ -0,0 +1,161 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SMALL_ARRAY_H
+#define REACTPHYSICS3D_SMALL_ARRAY_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+
+namespace reactphysics3d {
+
+// Class SmallArrayBuffer
+/**
+ * This class is the inline storage of a SmallArray. It is also the memory allocator of
+ * the array: the inline buffer is returned when it is free and large enough, otherwise
+ * the memory is allocated with the base allocator.
+ */
+template<typename T, uint64 N>
+class SmallArrayBuffer : public MemoryAllocator {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Inline buffer for the first N elements of the array
+        alignas(T) unsigned char mInlineBuffer[N * sizeof(T)];
+
+        /// Allocator used when the elements do not fit into the inline buffer anymore
+        MemoryAllocator& mBaseAllocator;
+
+        /// True if the inline buffer is currently used by the array
+        bool mIsInlineBufferUsed;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SmallArrayBuffer(MemoryAllocator& baseAllocator)
+            : mBaseAllocator(baseAllocator), mIsInlineBufferUsed(false) {
+
+        }
+
+        /// Return the base allocator
+        MemoryAllocator& getBaseAllocator() const {
+            return mBaseAllocator;
+        }
+
+        /// Return true if the inline buffer is currently used
+        bool isInlineBufferUsed() const {
+            return mIsInlineBufferUsed;
+        }
+
+        /// Allocate memory of a given size (in bytes) and return a pointer to the allocated memory
+        virtual void* allocate(size_t size) override {
+
+            if (!mIsInlineBufferUsed && size <= N * sizeof(T)) {
+                mIsInlineBufferUsed = true;
+                return mInlineBuffer;
+            }
+
+            return mBaseAllocator.allocate(size);
+        }
+
+        /// Release previously allocated memory
+        virtual void release(void* pointer, size_t size) override {
+
+            if (pointer == mInlineBuffer) {
+                assert(mIsInlineBufferUsed);
+                mIsInlineBufferUsed = false;
+                return;
+            }
+
+            mBaseAllocator.release(pointer, size);
+        }
+};
+
+// Class SmallArray
+/**
+ * This class represents a dynamic array that stores its first N elements in an inline
+ * buffer. The memory allocator is only used when the array grows past N elements. A
+ * SmallArray is an Array and can be passed to the methods that take an Array. Note that
+ * the array uses its own inline buffer as memory allocator. Therefore, a SmallArray must
+ * only be copied into another SmallArray and never into an Array (the copy constructor
+ * and the assignment operator of Array that take a SmallArray are deleted).
+ */
+template<typename T, uint64 N>
+class SmallArray : private SmallArrayBuffer<T, N>, public Array<T> {
+
+    static_assert(N > 0, "The inline capacity of a SmallArray must be positive");
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SmallArray(MemoryAllocator& allocator)
+            : SmallArrayBuffer<T, N>(allocator), Array<T>(static_cast<MemoryAllocator&>(*this), N) {
+
+        }
+
+        /// Copy constructor
+        SmallArray(const SmallArray<T, N>& array)
+            : SmallArrayBuffer<T, N>(array.getBaseAllocator()), Array<T>(static_cast<MemoryAllocator&>(*this), N) {
+
+            Array<T>::addRange(array);
+        }
+
+        /// Destructor
+        ~SmallArray() = default;
+
+        /// Clear the array
+        void clear(bool releaseMemory = false) {
+
+            Array<T>::clear(releaseMemory);
+
+            // Use the inline buffer again
+            if (releaseMemory) {
+                Array<T>::reserve(N);
+            }
+        }
+
+        /// Return true if the elements are stored in the inline buffer
+        bool isInline() const {
+            return SmallArrayBuffer<T, N>::isInlineBufferUsed();
+        }
+
+        /// Overloaded assignment operator
+        SmallArray<T, N>& operator=(const SmallArray<T, N>& array) {
+            Array<T>::operator=(static_cast<const Array<T>&>(array));
+            return *this;
+        }
+};
+
+}
+
+#endif
@@ -28,6 +28,7 @@
 
 // Libraries
 #include <reactphysics3d/configuration.h>
+#include <reactphysics3d/containers/FlatHashGroup.h>
 
 /// Namespace reactphysics3d
 namespace reactphysics3d {
@@ -123,6 +124,24 @@ RP3D_FORCE_INLINE bool Entity::operator!=(const Entity& entity) const {
     return entity.id != id;
 }
 
+// Structure EntityHash
+/**
+ * Hash function for the entities in the open-addressing containers (FlatMap and FlatSet).
+ * The entity indices are dense and the entities are often looked up in the order of their
+ * indices. Therefore, the index of an entity directly selects its group of slots (consecutive
+ * entities are in consecutive groups) and only the 7 bits of the control byte of the slot
+ * come from the mixed id of the entity. The containers do not mix these hash codes again.
+ */
+struct EntityHash {
+
+    /// The hash codes are used as they are by the containers
+    using is_avalanching = void;
+
+    size_t operator()(const Entity& entity) const {
+        return (static_cast<size_t>(entity.id) << 7) | (hashInteger(entity.id) & 0x7F);
+    }
+};
+
 }
 
 // Hash function for a reactphysics3d Entity
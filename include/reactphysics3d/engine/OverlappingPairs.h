@@ -29,6 +29,8 @@
 // Libraries
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/FlatMap.h>
+#include <reactphysics3d/containers/FlatSet.h>
 #include <reactphysics3d/containers/Pair.h>
 #include <reactphysics3d/containers/Set.h>
 #include <reactphysics3d/containers/containers_common.h>
@@ -46,6 +48,8 @@ struct NarrowPhaseInfoBatch;
 enum class NarrowPhaseAlgorithmType;
 class CollisionShape;
 class CollisionDispatch;
+class SnapshotWriter;
+class SnapshotReader;
 
 // Structure LastFrameCollisionInfo
 /**
@@ -83,11 +87,21 @@ struct LastFrameCollisionInfo {
     uint8 satMinEdge1Index;
     uint8 satMinEdge2Index;
 
+    // ----- All algorithms -----
+
+    /// True if the shapes were separated along the separating axis below in the previous frame
+    bool isSeparatingAxisValid;
+
+    /// Axis that separated the shapes (with their margins) in the previous frame. This axis is
+    /// in local-space of the first shape and points toward the second shape. It is used to
+    /// quickly check if the shapes are still separated before running the narrow-phase algorithm
+    Vector3 separatingAxis;
+
     /// Constructor
     LastFrameCollisionInfo()
         :isValid(false), isObsolete(false), wasColliding(false), wasUsingGJK(false), gjkSeparatingAxis(Vector3(0, 1, 0)),
          satIsAxisFacePolyhedron1(false), satIsAxisFacePolyhedron2(false), satMinAxisFaceIndex(0),
-         satMinEdge1Index(0), satMinEdge2Index(0) {
+         satMinEdge1Index(0), satMinEdge2Index(0), isSeparatingAxisValid(false), separatingAxis(Vector3(0, 1, 0)) {
 
     }
 };
@@ -285,11 +299,11 @@ class OverlappingPairs {
         /// Array of convex vs concave overlapping pairs
         Array<ConcaveOverlappingPair> mConcavePairs;
 
-        /// Map a pair id to the internal array index
-        Map<uint64, uint64> mMapConvexPairIdToPairIndex;
+        /// Map a pair id to the internal array index (this map is probed for each pair in each frame)
+        FlatMap<uint64, uint64, Uint64Hash> mMapConvexPairIdToPairIndex;
 
-        /// Map a pair id to the internal array index
-        Map<uint64, uint64> mMapConcavePairIdToPairIndex;
+        /// Map a pair id to the internal array index (this map is probed for each pair in each frame)
+        FlatMap<uint64, uint64, Uint64Hash> mMapConcavePairIdToPairIndex;
 
         /// Reference to the colliders components
         ColliderComponents& mColliderComponents;
@@ -301,7 +315,7 @@ class OverlappingPairs {
         RigidBodyComponents& mRigidBodyComponents;
 
         /// Reference to the set of bodies that cannot collide with each others
-        Set<bodypair>& mNoCollisionPairs;
+        FlatSet<bodypair>& mNoCollisionPairs;
 
         /// Reference to the collision dispatch
         CollisionDispatch& mCollisionDispatch;
@@ -321,6 +335,12 @@ class OverlappingPairs {
         /// Swap two pairs in the array
         void swapPairs(uint64 index1, uint64 index2);
 
+        /// Remove an overlapping pair from the arrays of pairs of its two colliders
+        void removePairFromColliders(const OverlappingPair& pair);
+
+        /// Return true if the bit of a given pair index is set in a bit set of pairs
+        static bool isPairInBitSet(const Array<uint64>& pairsBitSet, uint64 pairIndex);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -328,7 +348,7 @@ class OverlappingPairs {
         /// Constructor
         OverlappingPairs(MemoryManager& memoryManager,  ColliderComponents& colliderComponents,
                          CollisionBodyComponents& collisionBodyComponents,
-                         RigidBodyComponents& rigidBodyComponents, Set<bodypair>& noCollisionPairs,
+                         RigidBodyComponents& rigidBodyComponents, FlatSet<bodypair>& noCollisionPairs,
                          CollisionDispatch& collisionDispatch);
 
         /// Destructor
@@ -349,6 +369,9 @@ class OverlappingPairs {
         /// Remove a pair
         void removePair(uint64 pairIndex, bool isConvexVsConvex);
 
+        /// Remove all the pairs whose index is set in a bit set of pairs
+        void removePairs(const Array<uint64>& pairsToRemove, bool isConvexVsConvex);
+
         /// Delete all the obsolete last frame collision info
         void clearObsoleteLastFrameCollisionInfos();
 
@@ -364,6 +387,15 @@ class OverlappingPairs {
         /// Return a reference to an overlapping pair
         OverlappingPair* getOverlappingPair(uint64 pairId);
 
+        /// Write the overlapping pairs into a snapshot
+        void takeSnapshot(SnapshotWriter& writer) const;
+
+        /// Check that a snapshot of the overlapping pairs is complete and skip it
+        bool validateSnapshot(SnapshotReader& reader) const;
+
+        /// Restore the overlapping pairs from a snapshot
+        void restoreSnapshot(SnapshotReader& reader);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
         /// Set the profiler
@@ -377,6 +409,11 @@ class OverlappingPairs {
         friend class CollisionDetectionSystem;
 };
 
+// Return true if the bit of a given pair index is set in a bit set of pairs
+RP3D_FORCE_INLINE bool OverlappingPairs::isPairInBitSet(const Array<uint64>& pairsBitSet, uint64 pairIndex) {
+    return (pairsBitSet[pairIndex >> 6] >> (pairIndex & 63)) & 1;
+}
+
 // Return the pair of bodies index
 RP3D_FORCE_INLINE bodypair OverlappingPairs::computeBodiesIndexPair(Entity body1Entity, Entity body2Entity) {
 
@@ -202,12 +202,22 @@ class PhysicsCommon {
                                                  int upAxis = 1, decimal integerHeightScale = 1.0f,
                                                   const Vector3& scaling = Vector3(1,1,1));
 
+        /// Create and return a tiled height-field shape
+        HeightFieldShape* createTiledHeightFieldShape(int nbGridColumns, int nbGridRows, int nbTileCells,
+                                                      decimal minHeight, decimal maxHeight, HeightFieldShape::HeightDataType dataType,
+                                                      int upAxis = 1, decimal integerHeightScale = 1.0f,
+                                                      const Vector3& scaling = Vector3(1,1,1));
+
         /// Destroy a height-field shape
         void destroyHeightFieldShape(HeightFieldShape* heightFieldShape);
 
         /// Create and return a concave mesh shape
         ConcaveMeshShape* createConcaveMeshShape(TriangleMesh* triangleMesh, const Vector3& scaling = Vector3(1, 1, 1));
 
+        /// Create and return a concave mesh shape using a BVH that has been built offline
+        ConcaveMeshShape* createConcaveMeshShape(TriangleMesh* triangleMesh, const void* bvhData, size_t bvhDataSize,
+                                                 const Vector3& scaling = Vector3(1, 1, 1));
+
         /// Destroy a concave mesh shape
         void destroyConcaveMeshShape(ConcaveMeshShape* concaveMeshShape);
 
@@ -220,6 +230,15 @@ class PhysicsCommon {
         /// Create a triangle mesh
         TriangleMesh* createTriangleMesh();
 
+        /// Create and return a compressed copy of a triangle mesh
+        TriangleMesh* createCompressedTriangleMesh(const TriangleMesh* triangleMesh);
+
+        /// Create and return a cooked copy of a triangle mesh (compressed triangles with their BVH)
+        TriangleMesh* createCookedTriangleMesh(const TriangleMesh* triangleMesh);
+
+        /// Create and return a cooked triangle mesh from cooked data
+        TriangleMesh* createTriangleMeshFromCookedData(const void* cookedData, size_t cookedDataSize);
+
         /// Destroy a triangle mesh
         void destroyTriangleMesh(TriangleMesh* triangleMesh);
 
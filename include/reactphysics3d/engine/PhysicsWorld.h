@@ -60,6 +60,7 @@ namespace reactphysics3d {
 class Island;
 class RigidBody;
 class PhysicsCommon;
+class SnapshotWriter;
 struct JointInfo;
 
 // Class PhysicsWorld
@@ -119,6 +120,17 @@ class PhysicsWorld {
             /// than the value bellow, the manifold are considered to be similar.
             decimal cosAngleSimilarContactManifold;
 
+            /// Time step (in seconds) of each simulation step run by PhysicsWorld::updateWithFixedTimeStep()
+            decimal fixedTimeStep;
+
+            /// Maximum number of simulation steps run by a single call to PhysicsWorld::updateWithFixedTimeStep()
+            uint32 maxNbFixedTimeSteps;
+
+            /// True if the overlapping pairs must be processed in a canonical order that does not depend
+            /// on the iteration order of the hash tables. This is required to get the same simulation on
+            /// different platforms (the library must also be compiled with RP3D_DETERMINISTIC_ENABLED)
+            bool isDeterministic;
+
             WorldSettings() {
 
                 worldName = "";
@@ -134,6 +146,13 @@ class PhysicsWorld {
                 defaultSleepLinearVelocity = decimal(0.02);
                 defaultSleepAngularVelocity = decimal(3.0) * (PI_RP3D / decimal(180.0));
                 cosAngleSimilarContactManifold = decimal(0.95);
+                fixedTimeStep = decimal(1.0) / decimal(60.0);
+                maxNbFixedTimeSteps = 8;
+#ifdef IS_RP3D_DETERMINISTIC_ENABLED
+                isDeterministic = true;
+#else
+                isDeterministic = false;
+#endif
             }
 
             ~WorldSettings() = default;
@@ -156,6 +175,9 @@ class PhysicsWorld {
                 ss << "defaultSleepLinearVelocity=" << defaultSleepLinearVelocity << std::endl;
                 ss << "defaultSleepAngularVelocity=" << defaultSleepAngularVelocity << std::endl;
                 ss << "cosAngleSimilarContactManifold=" << cosAngleSimilarContactManifold << std::endl;
+                ss << "fixedTimeStep=" << fixedTimeStep << std::endl;
+                ss << "maxNbFixedTimeSteps=" << maxNbFixedTimeSteps << std::endl;
+                ss << "isDeterministic=" << isDeterministic << std::endl;
 
                 return ss.str();
             }
@@ -228,6 +250,9 @@ class PhysicsWorld {
         /// Total number of worlds
         static uint32 mNbWorlds;
 
+        /// Number written at the beginning of a snapshot of the world
+        static const uint32 SNAPSHOT_MAGIC_NUMBER;
+
         /// All the islands of bodies of the current frame
         Islands mIslands;
 
@@ -270,6 +295,24 @@ class PhysicsWorld {
         /// becomes smaller than the sleep velocity.
         decimal mTimeBeforeSleep;
 
+        /// Time step (in seconds) of the fixed time step simulation
+        decimal mFixedTimeStep;
+
+        /// Maximum number of fixed time steps run in a single call to updateWithFixedTimeStep()
+        uint32 mMaxNbFixedTimeSteps;
+
+        /// Elapsed time (in seconds) that has not been simulated yet by the fixed time step simulation
+        decimal mTimeAccumulator;
+
+        /// Bodies whose sleeping state changes in setBodiesSleeping() (kept to reuse its memory)
+        Array<Entity> mBodiesChangingSleepingState;
+
+        /// Colliders of the bodies that are disabled or enabled in setBodiesDisabled() (kept to reuse its memory)
+        Array<Entity> mCollidersOfBodiesChangingState;
+
+        /// Kinematic bodies to wake up in setKinematicBodiesState() (kept to reuse its memory)
+        Array<Entity> mKinematicBodiesToWakeUp;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -278,6 +321,12 @@ class PhysicsWorld {
         /// Notify the world if a body is disabled (slepping or inactive) or not
         void setBodyDisabled(Entity entity, bool isDisabled);
 
+        /// Notify the world if a group of bodies are disabled (sleeping or inactive) or not
+        void setBodiesDisabled(const Array<Entity>& bodyEntities, bool isDisabled);
+
+        /// Put a group of bodies to sleep or wake them up
+        void setBodiesSleeping(const Array<Entity>& bodyEntities, bool isSleeping);
+
         /// Notify the world whether a joint is disabled or not
         void setJointDisabled(Entity jointEntity, bool isDisabled);
 
@@ -296,6 +345,9 @@ class PhysicsWorld {
         /// Put bodies to sleep if needed.
         void updateSleepingBodies(decimal timeStep);
 
+        /// Write the simulation state of the world into a snapshot
+        void writeSnapshot(SnapshotWriter& writer) const;
+
         /// Add the joint to the array of joints of the two bodies involved in the joint
         void addJointToBodies(Entity body1, Entity body2, Entity joint);
 
@@ -357,6 +409,46 @@ class PhysicsWorld {
         /// Update the physics simulation
         void update(decimal timeStep);
 
+        /// Update the physics simulation with fixed time steps covering the elapsed time
+        uint32 updateWithFixedTimeStep(decimal elapsedTime);
+
+        /// Return the time step of the fixed time step simulation
+        decimal getFixedTimeStep() const;
+
+        /// Set the time step of the fixed time step simulation
+        void setFixedTimeStep(decimal fixedTimeStep);
+
+        /// Return the maximum number of fixed time steps run in a single update
+        uint32 getMaxNbFixedTimeSteps() const;
+
+        /// Set the maximum number of fixed time steps run in a single update
+        void setMaxNbFixedTimeSteps(uint32 maxNbFixedTimeSteps);
+
+        /// Return the interpolation factor between the two last fixed time steps
+        decimal getInterpolationFactor() const;
+
+        /// Compute the interpolated transforms of all the rigid bodies of the world
+        void getInterpolatedTransforms(Transform* outTransforms) const;
+
+        /// Copy the positions, orientations and velocities of the rigid bodies into contiguous arrays
+        uint32 exportRigidBodiesState(Vector3* outPositions, Quaternion* outOrientations,
+                                      Vector3* outLinearVelocities, Vector3* outAngularVelocities,
+                                      uint32* outBodyIndices = nullptr, bool onlyChangedBodies = false);
+
+        /// Set the positions, orientations and velocities of a group of kinematic rigid bodies
+        void setKinematicBodiesState(const uint32* bodyIndices, uint32 nbBodies,
+                                     const Vector3* positions, const Quaternion* orientations,
+                                     const Vector3* linearVelocities, const Vector3* angularVelocities);
+
+        /// Return the size (in bytes) of a snapshot of the current simulation state of the world
+        size_t getSnapshotSize() const;
+
+        /// Write a snapshot of the simulation state of the world into a buffer
+        size_t takeSnapshot(void* buffer, size_t bufferSize) const;
+
+        /// Restore the simulation state of the world from a snapshot
+        bool restoreSnapshot(const void* buffer, size_t bufferSize);
+
         /// Get the number of iterations for the velocity constraint solver
         uint16 getNbIterationsVelocitySolver() const;
 
@@ -491,6 +583,32 @@ RP3D_FORCE_INLINE CollisionDispatch& PhysicsWorld::getCollisionDispatch() {
     return mCollisionDetection.getCollisionDispatch();
 }
 
+// Return the time step of the fixed time step simulation
+/**
+ * @return The time step (in seconds) used by updateWithFixedTimeStep()
+ */
+RP3D_FORCE_INLINE decimal PhysicsWorld::getFixedTimeStep() const {
+    return mFixedTimeStep;
+}
+
+// Return the maximum number of fixed time steps run in a single update
+/**
+ * @return The maximum number of steps run by a single call to updateWithFixedTimeStep()
+ */
+RP3D_FORCE_INLINE uint32 PhysicsWorld::getMaxNbFixedTimeSteps() const {
+    return mMaxNbFixedTimeSteps;
+}
+
+// Return the interpolation factor between the two last fixed time steps
+/// This is the fraction of a fixed time step that has not been simulated yet.
+/// It can be used to interpolate between the previous and the current transforms of the bodies.
+/**
+ * @return The interpolation factor (in range [0, 1))
+ */
+RP3D_FORCE_INLINE decimal PhysicsWorld::getInterpolationFactor() const {
+    return mTimeAccumulator / mFixedTimeStep;
+}
+
 // Ray cast method
 /**
  * @param ray Ray to use for raycasting
@@ -218,6 +218,55 @@ RP3D_FORCE_INLINE void computeBarycentricCoordinatesInTriangle(const Vector3& a,
     u = decimal(1.0) - v - w;
 }
 
+// Compute and return the point of the triangle (a, b, c) that is closest to the point p
+// This method uses the technique described in the book Real-Time collision detection by
+// Christer Ericson.
+RP3D_FORCE_INLINE Vector3 computeClosestPointOnTriangle(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& p) {
+
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+
+    // Check if p is in the vertex region outside a
+    const Vector3 ap = p - a;
+    const decimal d1 = ab.dot(ap);
+    const decimal d2 = ac.dot(ap);
+    if (d1 <= decimal(0.0) && d2 <= decimal(0.0)) return a;
+
+    // Check if p is in the vertex region outside b
+    const Vector3 bp = p - b;
+    const decimal d3 = ab.dot(bp);
+    const decimal d4 = ac.dot(bp);
+    if (d3 >= decimal(0.0) && d4 <= d3) return b;
+
+    // Check if p is in the edge region of ab
+    const decimal vc = d1 * d4 - d3 * d2;
+    if (vc <= decimal(0.0) && d1 >= decimal(0.0) && d3 <= decimal(0.0)) {
+        return a + (d1 / (d1 - d3)) * ab;
+    }
+
+    // Check if p is in the vertex region outside c
+    const Vector3 cp = p - c;
+    const decimal d5 = ab.dot(cp);
+    const decimal d6 = ac.dot(cp);
+    if (d6 >= decimal(0.0) && d5 <= d6) return c;
+
+    // Check if p is in the edge region of ac
+    const decimal vb = d5 * d2 - d1 * d6;
+    if (vb <= decimal(0.0) && d2 >= decimal(0.0) && d6 <= decimal(0.0)) {
+        return a + (d2 / (d2 - d6)) * ac;
+    }
+
+    // Check if p is in the edge region of bc
+    const decimal va = d3 * d6 - d5 * d4;
+    if (va <= decimal(0.0) && (d4 - d3) >= decimal(0.0) && (d5 - d6) >= decimal(0.0)) {
+        return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+    }
+
+    // The point p is inside the face region (the triangle must not be degenerate)
+    const decimal denom = decimal(1.0) / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
 // Compute the intersection between a plane and a segment
 // Let the plane define by the equation planeNormal.dot(X) = planeD with X a point on the plane and "planeNormal" the plane normal. This method
 // computes the intersection P between the plane and the segment (segA, segB). The method returns the value "t" such
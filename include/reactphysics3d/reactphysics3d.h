@@ -55,6 +55,7 @@
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/collision/TriangleMesh.h>
+#include <reactphysics3d/collision/CompressedTriangleArray.h>
 #include <reactphysics3d/collision/PolyhedronMesh.h>
 #include <reactphysics3d/collision/TriangleVertexArray.h>
 #include <reactphysics3d/collision/PolygonVertexArray.h>
@@ -186,6 +186,15 @@ class BroadPhaseSystem {
         /// Compute all the overlapping pairs of collision shapes
         void computeOverlappingPairs(MemoryManager& memoryManager, Array<Pair<int32, int32>>& overlappingNodes);
 
+        /// Write the state of the broad-phase into a snapshot
+        void takeSnapshot(SnapshotWriter& writer) const;
+
+        /// Check that a snapshot of the broad-phase is valid and skip it
+        bool validateSnapshot(SnapshotReader& reader) const;
+
+        /// Restore the state of the broad-phase from a snapshot
+        void restoreSnapshot(SnapshotReader& reader);
+
         /// Return the collider corresponding to the broad-phase node id in parameter
         Collider* getColliderForBroadPhaseId(int broadPhaseId) const;
 
@@ -198,6 +207,9 @@ class BroadPhaseSystem {
         /// Ray casting method
         void raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const;
 
+        /// Report the broad-phase ids of all the colliders whose fat AABB overlaps a given AABB
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes) const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -212,6 +224,11 @@ RP3D_FORCE_INLINE const AABB& BroadPhaseSystem::getFatAABB(int broadPhaseId) con
     return mDynamicAABBTree.getFatAABB(broadPhaseId);
 }
 
+// Report the broad-phase ids of all the colliders whose fat AABB overlaps a given AABB
+RP3D_FORCE_INLINE void BroadPhaseSystem::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes) const {
+    mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+}
+
 // Remove a collider from the array of colliders that have moved in the last simulation step
 // and that need to be tested again for broad-phase overlapping.
 RP3D_FORCE_INLINE void BroadPhaseSystem::removeMovedCollider(int broadPhaseID) {
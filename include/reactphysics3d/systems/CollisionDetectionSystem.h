@@ -41,6 +41,8 @@
 #include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
 #include <reactphysics3d/containers/Map.h>
 #include <reactphysics3d/containers/Set.h>
+#include <reactphysics3d/containers/FlatMap.h>
+#include <reactphysics3d/containers/FlatSet.h>
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/components/TransformComponents.h>
 #include <reactphysics3d/collision/HalfEdgeStructure.h>
@@ -57,6 +59,8 @@ class ContactPoint;
 class MemoryManager;
 class EventListener;
 class CollisionDispatch;
+class SnapshotWriter;
+class SnapshotReader;
 
 // Class CollisionDetectionSystem
 /**
@@ -76,6 +80,28 @@ class CollisionDetectionSystem {
         /// Maximum number of contact points in a reduced contact manifold
         static const int8 MAX_CONTACT_POINTS_IN_MANIFOLD = 4;
 
+        // -------------------- Types -------------------- //
+
+        /// Candidate contact points of a manifold during its reduction. The points are stored
+        /// as a structure of arrays with a fixed capacity so that the scoring loops of the
+        /// reduction run over contiguous memory on the stack and can be vectorized
+        struct ContactPointCandidates {
+
+            /// Coordinates of the candidate points (in the local-space of the first shape)
+            decimal x[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
+            decimal y[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
+            decimal z[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
+
+            /// Score of each candidate for the current step of the reduction
+            decimal scores[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
+
+            /// Indices of the candidates in the array of potential contact points
+            uint32 indices[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
+
+            /// Number of candidates
+            uint16 nbCandidates;
+        };
+
         // -------------------- Attributes -------------------- //
 
         /// Memory manager
@@ -94,11 +120,17 @@ class CollisionDetectionSystem {
         PhysicsWorld* mWorld;
 
         /// Set of pair of bodies that cannot collide between each other
-        Set<bodypair> mNoCollisionPairs;
+        FlatSet<bodypair> mNoCollisionPairs;
 
         /// Broad-phase overlapping pairs
         OverlappingPairs mOverlappingPairs;
 
+        /// Bit set of the convex pairs to remove (reused every frame and only reset when a pair has to be removed)
+        Array<uint64> mConvexPairsToRemove;
+
+        /// Bit set of the concave pairs to remove (reused every frame and only reset when a pair has to be removed)
+        Array<uint64> mConcavePairsToRemove;
+
         /// Overlapping nodes during broad-phase computation
         Array<Pair<int32, int32>> mBroadPhaseOverlappingNodes;
 
@@ -134,7 +166,7 @@ class CollisionDetectionSystem {
 
         /// Pointer to the map of overlappingPairId to the index of contact pair of the previous frame
         /// (either mMapPairIdToContactPairIndex1 or mMapPairIdToContactPairIndex2)
-        Map<uint64, uint> mPreviousMapPairIdToContactPairIndex;
+        FlatMap<uint64, uint, Uint64Hash> mPreviousMapPairIdToContactPairIndex;
 
         /// First array with the contact manifolds
         Array<ContactManifold> mContactManifolds1;
@@ -210,9 +242,15 @@ class CollisionDetectionSystem {
         /// Take an array of overlapping nodes in the broad-phase and create new overlapping pairs if necessary
         void updateOverlappingPairs(const Array<Pair<int32, int32> >& overlappingNodes);
 
+        /// Sort the pairs of overlapping broad-phase nodes in a canonical order
+        void sortOverlappingNodes(Array<Pair<int32, int32>>& overlappingNodes) const;
+
         /// Remove pairs that are not overlapping anymore
         void removeNonOverlappingPairs();
 
+        /// Reset a bit set of pairs with enough bits for a given number of pairs
+        static void resetPairsBitSet(Array<uint64>& pairsBitSet, uint64 nbPairs);
+
         /// Add a lost contact pair (pair of colliders that are not in contact anymore)
         void addLostContactPair(OverlappingPairs::OverlappingPair& overlappingPair);
 
@@ -230,7 +268,7 @@ class CollisionDetectionSystem {
         void processPotentialContacts(NarrowPhaseInfoBatch& narrowPhaseInfoBatch,
                                       bool updateLastFrameInfo, Array<ContactPointInfo>& potentialContactPoints,
                                       Array<ContactManifoldInfo>& potentialContactManifolds,
-                                      Map<uint64, uint>& mapPairIdToContactPairIndex, Array<ContactPair>* contactPairs);
+                                      FlatMap<uint64, uint, Uint64Hash>& mapPairIdToContactPairIndex, Array<ContactPair>* contactPairs);
 
         /// Process the potential contacts after narrow-phase collision detection
         void processAllPotentialContacts(NarrowPhaseInput& narrowPhaseInput, bool updateLastFrameInfo, Array<ContactPointInfo>& potentialContactPoints,
@@ -261,10 +299,20 @@ class CollisionDetectionSystem {
         /// Initialize the current contacts with the contacts from the previous frame (for warmstarting)
         void initContactsWithPreviousOnes();
 
+        /// Reduce the potential contact manifolds and contact points of a single contact pair
+        void reduceContactPairManifolds(ContactPair& contactPair, Array<ContactManifoldInfo>& potentialContactManifolds,
+                                        const Array<ContactPointInfo>& potentialContactPoints) const;
+
         /// Reduce the number of contact points of a potential contact manifold
         void reduceContactPoints(ContactManifoldInfo& manifold, const Transform& shape1ToWorldTransform,
                                  const Array<ContactPointInfo>& potentialContactPoints) const;
 
+        /// Return the index of the candidate contact point with the largest score
+        static uint16 findLargestScoreCandidate(const ContactPointCandidates& candidates);
+
+        /// Remove the candidate contact points that are closer than a distance threshold to a given point
+        static void removeCandidatesCloseToPoint(ContactPointCandidates& candidates, const Vector3& point, decimal distThresholdSqr);
+
         /// Report contacts
         void reportContacts(CollisionCallback& callback, Array<ContactPair>* contactPairs,
                             Array<ContactManifold>* manifolds, Array<ContactPoint>* contactPoints, Array<ContactPair>& lostContactPairs);
@@ -288,9 +336,6 @@ class CollisionDetectionSystem {
         /// Filter the overlapping pairs to keep only the pairs where two given bodies are involved
         void filterOverlappingPairs(Entity body1Entity, Entity body2Entity, Array<uint64>& convexPairs, Array<uint64>& concavePairs) const;
 
-        /// Remove an element in an array (and replace it by the last one in the array)
-        void removeItemAtInArray(uint array[], uint8 index, uint8& arraySize) const;
-
         /// Remove the duplicated contact points in a given contact manifold
         void removeDuplicatedContactPointsInManifold(ContactManifoldInfo& manifold, const Array<ContactPointInfo>& potentialContactPoints) const;
 
@@ -336,6 +381,9 @@ class CollisionDetectionSystem {
         /// Ask for a collision shape to be tested again during broad-phase.
         void askForBroadPhaseCollisionCheck(Collider* collider);
 
+        /// Invalidate the temporal coherence data of the overlapping pairs of a collider near a modified region
+        void invalidateCachedCollisionData(Entity colliderEntity, const AABB& worldRegionAABB);
+
         /// Notify that the overlapping pairs where a given collider is involved need to be tested for overlap
         void notifyOverlappingPairsToTestOverlap(Collider* collider);
 
@@ -386,6 +434,15 @@ class CollisionDetectionSystem {
         /// Return the world-space AABB of a given collider
         const AABB getWorldAABB(const Collider* collider) const;
 
+        /// Write the state of the collision detection into a snapshot
+        void takeSnapshot(SnapshotWriter& writer) const;
+
+        /// Check that a snapshot of the collision detection is valid and skip it
+        bool validateSnapshot(SnapshotReader& reader) const;
+
+        /// Restore the state of the collision detection from a snapshot
+        void restoreSnapshot(SnapshotReader& reader);
+
         // -------------------- Friendship -------------------- //
 
         friend class PhysicsWorld;
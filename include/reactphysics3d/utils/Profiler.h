@@ -279,11 +279,36 @@ class Profiler {
 
     private :
 
+        /// Counter of the number of times a test (a cache lookup for instance) has been
+        /// performed and of the number of times it was successful
+        struct HitCounter {
+
+            /// Name of the counter
+            const char* name;
+
+            /// Total number of tests
+            uint64 nbTests;
+
+            /// Total number of successful tests
+            uint64 nbHits;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of hit counters
+        static const uint MAX_NB_HIT_COUNTERS = 16;
+
         // -------------------- Attributes -------------------- //
 
         /// Root node of the profiler tree
         ProfileNode mRootNode;
 
+        /// Hit counters
+        HitCounter mHitCounters[MAX_NB_HIT_COUNTERS];
+
+        /// Number of hit counters
+        uint mNbHitCounters;
+
         /// Current node in the current execution
         ProfileNode* mCurrentNode;
 
@@ -306,6 +331,9 @@ class Profiler {
         void printRecursiveNodeReport(ProfileNodeIterator* iterator,  int spacing,
                                       std::ostream &outputStream);
 
+        /// Print the report of the hit counters
+        void printHitCountersReport(std::ostream& outputStream);
+
 		/// Destroy a previously allocated iterator
 		void destroyIterator(ProfileNodeIterator* iterator);
 
@@ -333,6 +361,9 @@ class Profiler {
         /// Reset the timing data of the profiler (but not the profiler tree structure)
         void reset();
 
+        /// Add a number of tests and successful tests to a hit counter
+        void addHitCounterSamples(const char* name, uint64 nbTests, uint64 nbHits);
+
         /// Return the number of frames
         uint getNbFrames();
 
@@ -401,6 +432,9 @@ class ProfileSample {
 // Use this macro to start profile a block of code
 #define RP3D_PROFILE(name, profiler) ProfileSample profileSample(name, profiler)
 
+// Use this macro to report the number of tests and successful tests of a hit counter
+#define RP3D_PROFILE_HIT_COUNTER(name, nbTests, nbHits, profiler) profiler->addHitCounterSamples(name, nbTests, nbHits)
+
 // Return true if we are at the root of the profiler tree
 RP3D_FORCE_INLINE bool ProfileNodeIterator::isRoot() {
     return (mCurrentParentNode->getParentNode() == nullptr);
@@ -518,6 +552,7 @@ RP3D_FORCE_INLINE void Profiler::destroy() {
 
 // Empty macro in case profiling is not active
 #define RP3D_PROFILE(name, profiler)
+#define RP3D_PROFILE_HIT_COUNTER(name, nbTests, nbHits, profiler) do { (void)(nbTests); (void)(nbHits); } while (false)
 
 #endif
 
@@ -0,0 +1,182 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef REACTPHYSICS3D_SNAPSHOT_H
+#define REACTPHYSICS3D_SNAPSHOT_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <cstring>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class SnapshotWriter
+/**
+ * This class is used to write the state of the world into a snapshot buffer.
+ * If the buffer is nullptr, nothing is written and the writer is only used to
+ * compute the size of the snapshot.
+ */
+class SnapshotWriter {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Buffer where the data is written (can be nullptr)
+        uint8* mBuffer;
+
+        /// Number of bytes written so far
+        size_t mSize;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SnapshotWriter(uint8* buffer) : mBuffer(buffer), mSize(0) {
+
+        }
+
+        /// Write raw bytes into the snapshot
+        void writeBytes(const void* data, size_t nbBytes) {
+
+            if (mBuffer != nullptr && nbBytes > 0) {
+                std::memcpy(mBuffer + mSize, data, nbBytes);
+            }
+            mSize += nbBytes;
+        }
+
+        /// Write a value into the snapshot
+        template<typename T>
+        void write(const T& value) {
+            writeBytes(&value, sizeof(T));
+        }
+
+        /// Write a value at a given position (in number of T values) in a region starting at a given offset
+        template<typename T>
+        void writeAt(size_t regionOffset, size_t index, const T& value) {
+
+            if (mBuffer != nullptr) {
+                std::memcpy(mBuffer + regionOffset + index * sizeof(T), &value, sizeof(T));
+            }
+        }
+
+        /// Skip a region of bytes that will be written later with writeAt() and return its offset
+        size_t skipBytes(size_t nbBytes) {
+
+            const size_t offset = mSize;
+            mSize += nbBytes;
+            return offset;
+        }
+
+        /// Return the number of bytes written so far
+        size_t getSize() const {
+            return mSize;
+        }
+};
+
+// Class SnapshotReader
+/**
+ * This class is used to read the state of the world from a snapshot buffer.
+ * A read past the end of the buffer does not read anything and marks the
+ * reader as failed.
+ */
+class SnapshotReader {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Buffer where the data is read
+        const uint8* mBuffer;
+
+        /// Size of the buffer (in bytes)
+        size_t mBufferSize;
+
+        /// Number of bytes read so far
+        size_t mPosition;
+
+        /// True if a read has gone past the end of the buffer
+        bool mHasFailed;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SnapshotReader(const uint8* buffer, size_t bufferSize)
+            : mBuffer(buffer), mBufferSize(bufferSize), mPosition(0), mHasFailed(false) {
+
+        }
+
+        /// Skip bytes of the snapshot and return false if there are not enough remaining bytes
+        bool skipBytes(size_t nbBytes) {
+
+            if (mHasFailed || nbBytes > mBufferSize - mPosition) {
+                mHasFailed = true;
+                return false;
+            }
+
+            mPosition += nbBytes;
+            return true;
+        }
+
+        /// Read raw bytes from the snapshot and return false if there are not enough remaining bytes
+        bool readBytes(void* data, size_t nbBytes) {
+
+            const size_t position = mPosition;
+            if (!skipBytes(nbBytes)) return false;
+
+            if (nbBytes > 0) {
+                std::memcpy(data, mBuffer + position, nbBytes);
+            }
+            return true;
+        }
+
+        /// Read a value from the snapshot (a default value is returned if the read fails)
+        template<typename T>
+        T read() {
+
+            T value{};
+            readBytes(&value, sizeof(T));
+            return value;
+        }
+
+        /// Return true if a read has gone past the end of the buffer
+        bool hasFailed() const {
+            return mHasFailed;
+        }
+
+        /// Return the number of bytes that have not been read yet
+        size_t getNbRemainingBytes() const {
+            return mBufferSize - mPosition;
+        }
+};
+
+}
+
+#endif
@@ -406,6 +406,17 @@ void CollisionBody::setTransform(const Transform& transform) {
              "Body " + std::to_string(mEntity.id) + ": Set transform=" + transform.to_string(),  __FILE__, __LINE__);
 }
 
+// Discard the interpolation between the previous and the current transform of the body
+/// The transform of the body at the beginning of the last fixed time step is set to its
+/// current transform. This method must be called after setTransform() when a body is
+/// teleported so that getInterpolatedTransforms() does not interpolate it between its old
+/// and its new location. A body moved with setTransform() between two fixed time steps
+/// (a kinematic body for instance) is interpolated as any other body.
+void CollisionBody::resetTransformInterpolation() {
+
+    mWorld.mTransformComponents.resetPreviousTransform(mEntity);
+}
+
 // Return true if the body is active
 /**
  * @return True if the body currently active and false otherwise
@@ -76,6 +76,7 @@ void RigidBody::setType(BodyType type) {
         // Reset the velocity to zero
         mWorld.mRigidBodyComponents.setLinearVelocity(mEntity, Vector3::zero());
         mWorld.mRigidBodyComponents.setAngularVelocity(mEntity, Vector3::zero());
+        mWorld.mRigidBodyComponents.setHasChangedSinceLastExport(mEntity, true);
     }
 
     // If it is a static or a kinematic body
@@ -782,6 +783,7 @@ void RigidBody::setLinearVelocity(const Vector3& linearVelocity) {
 
     // Update the linear velocity of the current body state
     mWorld.mRigidBodyComponents.setLinearVelocity(mEntity, linearVelocity);
+    mWorld.mRigidBodyComponents.setHasChangedSinceLastExport(mEntity, true);
 
     // If the linear velocity is not zero, awake the body
     if (linearVelocity.lengthSquare() > decimal(0.0)) {
@@ -803,6 +805,7 @@ void RigidBody::setAngularVelocity(const Vector3& angularVelocity) {
 
     // Set the angular velocity
     mWorld.mRigidBodyComponents.setAngularVelocity(mEntity, angularVelocity);
+    mWorld.mRigidBodyComponents.setHasChangedSinceLastExport(mEntity, true);
 
     // If the velocity is not zero, awake the body
     if (angularVelocity.lengthSquare() > decimal(0.0)) {
@@ -832,6 +835,7 @@ void RigidBody::setTransform(const Transform& transform) {
     const Vector3& centerOfMassWorld = mWorld.mRigidBodyComponents.getCenterOfMassWorld(mEntity);
     linearVelocity += angularVelocity.cross(centerOfMassWorld - oldCenterOfMass);
     mWorld.mRigidBodyComponents.setLinearVelocity(mEntity, linearVelocity);
+    mWorld.mRigidBodyComponents.setHasChangedSinceLastExport(mEntity, true);
 
     CollisionBody::setTransform(transform);
 
@@ -1004,6 +1008,9 @@ void RigidBody::setIsSleeping(bool isSleeping) {
 
     mWorld.mRigidBodyComponents.setIsSleeping(mEntity, isSleeping);
 
+    // The body does not belong to the sleeping island it might have been part of anymore
+    mWorld.mRigidBodyComponents.removeBodyFromSleepingIsland(mEntity);
+
     // Notify all the components
     mWorld.setBodyDisabled(mEntity, isSleeping);
 
@@ -1016,6 +1023,7 @@ void RigidBody::setIsSleeping(bool isSleeping) {
         mWorld.mRigidBodyComponents.setAngularVelocity(mEntity, Vector3::zero());
         mWorld.mRigidBodyComponents.setExternalForce(mEntity, Vector3::zero());
         mWorld.mRigidBodyComponents.setExternalTorque(mEntity, Vector3::zero());
+        mWorld.mRigidBodyComponents.setHasChangedSinceLastExport(mEntity, true);
     }
 
     RP3D_LOG(mWorld.mConfig.worldName, Logger::Level::Information, Logger::Category::Body,
@@ -214,6 +214,18 @@ void Collider::setHasCollisionShapeChangedSize(bool hasCollisionShapeChangedSize
     mBody->mWorld.mCollidersComponents.setHasCollisionShapeChangedSize(mEntity, hasCollisionShapeChangedSize);
 }
 
+// Notify the collider that a region of the collision shape has been modified by the user
+/**
+ * @param localRegionAABB AABB of the modified region in the local-space of the collision shape
+ */
+void Collider::setHasCollisionShapeChangedRegion(const AABB& localRegionAABB) {
+
+    AABB worldRegionAABB = localRegionAABB;
+    worldRegionAABB.applyTransform(getLocalToWorldTransform());
+
+    mBody->mWorld.mCollisionDetection.invalidateCachedCollisionData(mEntity, worldRegionAABB);
+}
+
 // Set a new material for this rigid body
 /**
  * @param material The material you want to set to the body
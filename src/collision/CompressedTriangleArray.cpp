@@ -0,0 +1,263 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/CompressedTriangleArray.h>
+#include <reactphysics3d/collision/TriangleMesh.h>
+#include <reactphysics3d/collision/TriangleVertexArray.h>
+#include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/Pair.h>
+#include <cmath>
+
+using namespace reactphysics3d;
+
+// Constructor
+/**
+ * @param triangleMesh The triangle mesh with the triangles to compress (the mesh data is not referenced after this call)
+ * @param allocator Memory allocator used for the compressed data
+ */
+CompressedTriangleArray::CompressedTriangleArray(const TriangleMesh& triangleMesh, MemoryAllocator& allocator)
+                        : mNbTriangles(0), mClusters(allocator), mBlocksFirstCluster(allocator), mVertices(allocator),
+                          mVerticesNormals(allocator), mIndices(allocator) {
+
+    compressTriangles(triangleMesh, allocator);
+}
+
+// Constructor of an empty array (filled with cooked data)
+CompressedTriangleArray::CompressedTriangleArray(MemoryAllocator& allocator)
+                        : mNbTriangles(0), mLatticeMin(0, 0, 0), mQuantizationStep(0, 0, 0), mClusters(allocator),
+                          mBlocksFirstCluster(allocator), mVertices(allocator), mVerticesNormals(allocator), mIndices(allocator) {
+
+}
+
+// Compress the triangles of all the sub-parts of a triangle mesh
+void CompressedTriangleArray::compressTriangles(const TriangleMesh& triangleMesh, MemoryAllocator& allocator) {
+
+    // Get the vertices and normals of all the triangles of the mesh
+    mNbTriangles = triangleMesh.getNbTriangles();
+    Array<Vector3> trianglesVertices(allocator, mNbTriangles * 3);
+    Array<Vector3> trianglesNormals(allocator, mNbTriangles * 3);
+    trianglesVertices.addWithoutInit(mNbTriangles * 3);
+    trianglesNormals.addWithoutInit(mNbTriangles * 3);
+    uint32 triangleId = 0;
+    for (uint32 subPart=0; subPart < triangleMesh.getNbSubparts(); subPart++) {
+        for (uint32 t=0; t < triangleMesh.getNbTriangles(subPart); t++) {
+            triangleMesh.getTriangleVertices(subPart, t, &(trianglesVertices[triangleId * 3]));
+            triangleMesh.getTriangleVerticesNormals(subPart, t, &(trianglesNormals[triangleId * 3]));
+            triangleId++;
+        }
+    }
+
+    if (mNbTriangles == 0) {
+        mLatticeMin.setToZero();
+        mQuantizationStep.setToZero();
+        return;
+    }
+
+    // Compute the bounds of the mesh and the size of its largest triangle
+    Vector3 meshMin(DECIMAL_LARGEST, DECIMAL_LARGEST, DECIMAL_LARGEST);
+    Vector3 meshMax(-DECIMAL_LARGEST, -DECIMAL_LARGEST, -DECIMAL_LARGEST);
+    decimal largestTriangleSize = decimal(0.0);
+    for (uint32 t=0; t < mNbTriangles; t++) {
+
+        const Vector3* vertices = &(trianglesVertices[t * 3]);
+        const Vector3 triangleMin = Vector3::min(Vector3::min(vertices[0], vertices[1]), vertices[2]);
+        const Vector3 triangleMax = Vector3::max(Vector3::max(vertices[0], vertices[1]), vertices[2]);
+        meshMin = Vector3::min(meshMin, triangleMin);
+        meshMax = Vector3::max(meshMax, triangleMax);
+        largestTriangleSize = std::max(largestTriangleSize, (triangleMax - triangleMin).getMaxValue());
+    }
+
+    // Split the triangles into clusters of consecutive triangles. A cluster is closed when it is full
+    // or when the next triangle would make it too large so that a few triangles far from the others
+    // cannot make the quantization step of the whole mesh large.
+    const decimal maxClusterSize = decimal(MAX_CLUSTER_SIZE_IN_TRIANGLES) * largestTriangleSize;
+    Array<Vector3> clustersMin(allocator);
+    Vector3 largestClusterSize(0, 0, 0);
+    Vector3 clusterMin, clusterMax;
+    for (uint32 t=0; t < mNbTriangles; t++) {
+
+        const Vector3* vertices = &(trianglesVertices[t * 3]);
+        const Vector3 triangleMin = Vector3::min(Vector3::min(vertices[0], vertices[1]), vertices[2]);
+        const Vector3 triangleMax = Vector3::max(Vector3::max(vertices[0], vertices[1]), vertices[2]);
+
+        const bool isClusterFull = mClusters.size() > 0 && t - mClusters[mClusters.size() - 1].firstTriangle == NB_TRIANGLES_PER_CLUSTER;
+        if (mClusters.size() == 0 || isClusterFull ||
+            (Vector3::max(clusterMax, triangleMax) - Vector3::min(clusterMin, triangleMin)).getMaxValue() > maxClusterSize) {
+
+            // Close the current cluster
+            if (mClusters.size() > 0) {
+                clustersMin.add(clusterMin);
+                largestClusterSize = Vector3::max(largestClusterSize, clusterMax - clusterMin);
+            }
+
+            CompressedTriangleCluster cluster;
+            cluster.firstTriangle = t;
+            mClusters.add(cluster);
+            clusterMin = triangleMin;
+            clusterMax = triangleMax;
+        }
+        else {
+            clusterMin = Vector3::min(clusterMin, triangleMin);
+            clusterMax = Vector3::max(clusterMax, triangleMax);
+        }
+    }
+    clustersMin.add(clusterMin);
+    largestClusterSize = Vector3::max(largestClusterSize, clusterMax - clusterMin);
+
+    const uint32 nbClusters = static_cast<uint32>(mClusters.size());
+
+    // The quantization step is chosen so that the largest cluster fits into 16 bits
+    // (with one more step because the origin of a cluster is snapped on the lattice)
+    // and the whole mesh fits into the 32 bits positions on the lattice
+    mLatticeMin = meshMin;
+    const Vector3 meshSize = meshMax - meshMin;
+    for (int a=0; a < 3; a++) {
+        mQuantizationStep[a] = std::max(largestClusterSize[a] / decimal(65534.0), meshSize[a] / decimal(4.0e9));
+    }
+
+    // Compute the position of a point on the lattice in a given direction
+    auto computeLatticePosition = [this](decimal coordinate, int axis) {
+        if (mQuantizationStep[axis] <= decimal(0.0)) return int64(0);
+        return static_cast<int64>(std::round((coordinate - mLatticeMin[axis]) / mQuantizationStep[axis]));
+    };
+
+    mIndices.reserve(mNbTriangles * 3);
+
+    // Map a quantized vertex and its encoded normal to its index in the vertices of the cluster
+    Map<Pair<uint64, uint32>, uint32> mapVertexToIndex(allocator);
+
+    // For each cluster
+    for (uint32 c=0; c < nbClusters; c++) {
+
+        CompressedTriangleCluster& cluster = mClusters[c];
+        cluster.firstVertex = static_cast<uint32>(mVertices.size());
+        for (int a=0; a < 3; a++) {
+            const decimal origin = mQuantizationStep[a] > decimal(0.0) ?
+                                   std::floor((clustersMin[c][a] - mLatticeMin[a]) / mQuantizationStep[a]) : decimal(0.0);
+            cluster.latticeOrigin[a] = static_cast<uint32>(std::max(origin, decimal(0.0)));
+        }
+
+        mapVertexToIndex.clear();
+
+        // For each vertex of the triangles of the cluster
+        const uint32 endVertex = (c + 1 < nbClusters ? mClusters[c + 1].firstTriangle : mNbTriangles) * 3;
+        for (uint32 v = cluster.firstTriangle * 3; v < endVertex; v++) {
+
+            // Quantize the vertex relative to the origin of the cluster
+            CompressedTriangleVertex vertex;
+            for (int a=0; a < 3; a++) {
+                const int64 coordinate = computeLatticePosition(trianglesVertices[v][a], a) - int64(cluster.latticeOrigin[a]);
+                vertex.coordinates[a] = static_cast<uint16>(std::min(std::max(coordinate, int64(0)), int64(65535)));
+            }
+            const uint32 encodedNormal = encodeNormal(trianglesNormals[v]);
+
+            // Weld the vertex with a previous vertex of the cluster with the same quantized coordinates and normal
+            const Pair<uint64, uint32> key(uint64(vertex.coordinates[0]) | (uint64(vertex.coordinates[1]) << 16) |
+                                           (uint64(vertex.coordinates[2]) << 32), encodedNormal);
+            auto it = mapVertexToIndex.find(key);
+            uint32 localIndex;
+            if (it != mapVertexToIndex.end()) {
+                localIndex = it->second;
+            }
+            else {
+                localIndex = static_cast<uint32>(mVertices.size()) - cluster.firstVertex;
+                mVertices.add(vertex);
+                mVerticesNormals.add(encodedNormal);
+                mapVertexToIndex.add(Pair<Pair<uint64, uint32>, uint32>(key, localIndex));
+            }
+
+            // A cluster has at most 3 * NB_TRIANGLES_PER_CLUSTER vertices
+            assert(localIndex < 256);
+            mIndices.add(static_cast<uint8>(localIndex));
+        }
+    }
+
+    computeBlocksFirstCluster();
+}
+
+// Compute the first cluster of each block of triangles from the clusters
+/// A block is a group of NB_TRIANGLES_PER_CLUSTER consecutive triangles. Because a cluster has at
+/// most NB_TRIANGLES_PER_CLUSTER triangles, the cluster of a triangle is found from the cluster of
+/// the first triangle of its block in a few steps.
+void CompressedTriangleArray::computeBlocksFirstCluster() {
+
+    const uint32 nbBlocks = (mNbTriangles + NB_TRIANGLES_PER_CLUSTER - 1) / NB_TRIANGLES_PER_CLUSTER;
+    const uint32 nbClusters = static_cast<uint32>(mClusters.size());
+
+    mBlocksFirstCluster.clear();
+    mBlocksFirstCluster.reserve(nbBlocks);
+
+    uint32 clusterIndex = 0;
+    for (uint32 b=0; b < nbBlocks; b++) {
+
+        const uint32 firstTriangle = b * NB_TRIANGLES_PER_CLUSTER;
+        while (clusterIndex + 1 < nbClusters && mClusters[clusterIndex + 1].firstTriangle <= firstTriangle) {
+            clusterIndex++;
+        }
+        mBlocksFirstCluster.add(clusterIndex);
+    }
+}
+
+// Return the number of bytes used by the compressed data
+size_t CompressedTriangleArray::getSizeInBytes() const {
+    return sizeof(CompressedTriangleArray) + mClusters.size() * sizeof(CompressedTriangleCluster) +
+           mBlocksFirstCluster.size() * sizeof(uint32) +
+           mVertices.size() * sizeof(CompressedTriangleVertex) + mVerticesNormals.size() * sizeof(uint32) +
+           mIndices.size() * sizeof(uint8);
+}
+
+// Encode a unit vector with an octahedral mapping on 2x16 bits
+/// The unit vector is projected on the octahedron |x| + |y| + |z| = 1 and the lower
+/// half of the octahedron is unfolded so that the vector is represented by a point of
+/// the square [-1, 1]^2. The two coordinates of this point are stored as 16 bits signed
+/// normalized integers.
+/**
+ * @param normal A unit vector
+ * @return The encoded vector
+ */
+uint32 CompressedTriangleArray::encodeNormal(const Vector3& normal) {
+
+    const decimal l1Norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1Norm < MACHINE_EPSILON) {
+        return encodeNormal(Vector3(0, 0, 1));
+    }
+
+    decimal u = normal.x / l1Norm;
+    decimal v = normal.y / l1Norm;
+
+    // Unfold the lower hemisphere
+    if (normal.z < decimal(0.0)) {
+        const decimal foldedU = (decimal(1.0) - std::abs(v)) * (u >= decimal(0.0) ? decimal(1.0) : decimal(-1.0));
+        const decimal foldedV = (decimal(1.0) - std::abs(u)) * (v >= decimal(0.0) ? decimal(1.0) : decimal(-1.0));
+        u = foldedU;
+        v = foldedV;
+    }
+
+    const int16 encodedU = static_cast<int16>(std::round(std::min(std::max(u, decimal(-1.0)), decimal(1.0)) * decimal(32767.0)));
+    const int16 encodedV = static_cast<int16>(std::round(std::min(std::max(v, decimal(-1.0)), decimal(1.0)) * decimal(32767.0)));
+
+    return uint32(static_cast<uint16>(encodedU)) | (uint32(static_cast<uint16>(encodedV)) << 16);
+}
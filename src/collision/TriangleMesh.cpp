@@ -25,15 +25,447 @@
 
 // Libraries
 #include <reactphysics3d/collision/TriangleMesh.h>
+#include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/Pair.h>
+#include <cstring>
 
 using namespace reactphysics3d;
 
+// Initialization of static variables
+const uint32 TriangleMesh::COOKED_DATA_MAGIC_NUMBER = 0x52503343;
+const uint32 TriangleMesh::COOKED_DATA_VERSION = 3;
+const decimal TriangleMesh::FLAT_EDGE_TOLERANCE = decimal(0.01);
+
+// Return the size (in bytes) of the cooked data described by a header
+static size_t computeCookedDataSize(uint32 nbSubparts, uint32 nbTriangles, uint32 nbClusters, uint32 nbVertices, int32 nbNodes) {
+
+    return (static_cast<size_t>(nbSubparts) + 1) * sizeof(uint32) +
+           static_cast<size_t>(nbClusters) * sizeof(CompressedTriangleCluster) +
+           static_cast<size_t>(nbVertices) * (sizeof(CompressedTriangleVertex) + sizeof(uint32)) +
+           static_cast<size_t>(nbTriangles) * 3 * sizeof(uint8) +
+           static_cast<size_t>(nbNodes) * sizeof(QuantizedTreeNode) +
+           static_cast<size_t>(nbTriangles) * (3 * sizeof(uint32) + sizeof(uint8));
+}
+
 // Constructor
-TriangleMesh::TriangleMesh(MemoryAllocator& allocator) : mTriangleArrays(allocator) {
+TriangleMesh::TriangleMesh(MemoryAllocator& allocator)
+             : mTriangleArrays(allocator), mAllocator(allocator), mCompressedTriangles(nullptr),
+               mCompressedSubpartsFirstTriangle(allocator), mIsCooked(false), mCookedBVH(allocator),
+               mCookedAdjacentTriangles(allocator), mCookedConvexEdges(allocator) {
 
 }
 
 // Destructor
 TriangleMesh::~TriangleMesh() {
 
+    if (mCompressedTriangles != nullptr) {
+
+        // Release the compressed triangles
+        mCompressedTriangles->~CompressedTriangleArray();
+        mAllocator.release(mCompressedTriangles, sizeof(CompressedTriangleArray));
+    }
+}
+
+// Return the number of triangles of all the sub-parts of the mesh
+/**
+ * @return The total number of triangles of the mesh
+ */
+uint32 TriangleMesh::getNbTriangles() const {
+
+    if (mCompressedTriangles != nullptr) {
+        return mCompressedTriangles->getNbTriangles();
+    }
+
+    uint32 nbTriangles = 0;
+    for (uint32 i=0; i < mTriangleArrays.size(); i++) {
+        nbTriangles += mTriangleArrays[i]->getNbTriangles();
+    }
+    return nbTriangles;
+}
+
+// Store the triangles of another mesh in compressed form
+/// The other mesh and its triangle vertex arrays are not referenced after this call.
+void TriangleMesh::compress(const TriangleMesh& triangleMesh) {
+
+    assert(mCompressedTriangles == nullptr);
+    assert(mTriangleArrays.size() == 0);
+
+    // Sub-parts of the mesh
+    mCompressedSubpartsFirstTriangle.add(0);
+    for (uint32 i=0; i < triangleMesh.getNbSubparts(); i++) {
+        mCompressedSubpartsFirstTriangle.add(mCompressedSubpartsFirstTriangle[i] + triangleMesh.getNbTriangles(i));
+    }
+
+    mCompressedTriangles = new (mAllocator.allocate(sizeof(CompressedTriangleArray))) CompressedTriangleArray(triangleMesh, mAllocator);
+}
+
+// Compress the triangles of another mesh and build their BVH
+/// The vertices of the triangles are welded and compressed, the normals are encoded and the BVH
+/// is built with the decoded triangles. The adjacency and the convexity of the edges of the
+/// triangles are also computed so that they do not have to be computed during the collision
+/// detection. The other mesh is read only once and is not referenced
+/// after this call.
+void TriangleMesh::cook(const TriangleMesh& triangleMesh) {
+
+    compress(triangleMesh);
+
+    // Compute the AABB of each compressed triangle (the index of the AABB in the
+    // array is the index of the triangle in the whole mesh)
+    const uint32 nbTriangles = mCompressedTriangles->getNbTriangles();
+    Array<AABB> trianglesAABBs(mAllocator, nbTriangles);
+    for (uint32 t=0; t < nbTriangles; t++) {
+
+        Vector3 trianglePoints[3];
+        mCompressedTriangles->getTriangleVertices(t, trianglePoints);
+        trianglesAABBs.add(AABB::createAABBForTriangle(trianglePoints));
+    }
+
+    // Build the BVH with the surface area heuristic
+    mCookedBVH.build(nbTriangles > 0 ? &(trianglesAABBs[0]) : nullptr, static_cast<int32>(nbTriangles));
+
+    computeEdgesAdjacency();
+
+    mIsCooked = true;
+}
+
+// Compute the adjacent triangles and the convexity of the edges of the compressed triangles
+/// Two triangles are adjacent if they share an edge with opposite orientations. The vertices
+/// are matched with their position on the quantization lattice because the vertices are only
+/// welded inside a cluster. An edge shared by more than two triangles or by two triangles
+/// with the same orientation does not have any adjacent triangle. An edge is convex if the
+/// opposite vertex of its adjacent triangle is below the plane of the triangle and flat if
+/// it is (almost) in the plane of the triangle.
+void TriangleMesh::computeEdgesAdjacency() {
+
+    const uint32 nbTriangles = mCompressedTriangles->mNbTriangles;
+
+    mCookedAdjacentTriangles.clear();
+    mCookedConvexEdges.clear();
+    mCookedAdjacentTriangles.reserve(nbTriangles * 3);
+    mCookedConvexEdges.reserve(nbTriangles);
+
+    // Compute an identifier for each distinct position on the lattice of the vertices of the triangles
+    const uint32 nbVertices = mCompressedTriangles->getNbVertices();
+    Array<uint32> verticesPositionIds(mAllocator, nbVertices);
+    Map<Pair<uint64, uint32>, uint32> positionIds(mAllocator, nbVertices);
+    for (uint32 c=0; c < mCompressedTriangles->mClusters.size(); c++) {
+
+        const CompressedTriangleCluster& cluster = mCompressedTriangles->mClusters[c];
+        const uint32 endVertex = c + 1 < mCompressedTriangles->mClusters.size() ?
+                                 mCompressedTriangles->mClusters[c + 1].firstVertex : nbVertices;
+        for (uint32 v = cluster.firstVertex; v < endVertex; v++) {
+
+            const CompressedTriangleVertex& vertex = mCompressedTriangles->mVertices[v];
+            const uint64 x = cluster.latticeOrigin[0] + vertex.coordinates[0];
+            const uint64 y = cluster.latticeOrigin[1] + vertex.coordinates[1];
+            const uint32 z = cluster.latticeOrigin[2] + vertex.coordinates[2];
+            const Pair<uint64, uint32> position(x | (y << 32), z);
+
+            auto it = positionIds.find(position);
+            if (it == positionIds.end()) {
+                const uint32 positionId = static_cast<uint32>(positionIds.size());
+                positionIds.add(Pair<Pair<uint64, uint32>, uint32>(position, positionId));
+                verticesPositionIds.add(positionId);
+            }
+            else {
+                verticesPositionIds.add(it->second);
+            }
+        }
+    }
+
+    // Index (triangle * 3 + edge) of the triangle edge of each oriented edge of the mesh
+    // (NO_ADJACENT_TRIANGLE if the oriented edge belongs to several triangles)
+    Map<Pair<uint32, uint32>, uint32> orientedEdges(mAllocator, nbTriangles * 3);
+    for (uint32 t=0; t < nbTriangles; t++) {
+
+        uint32 verticesIndices[3];
+        mCompressedTriangles->getTriangleVerticesIndices(t, verticesIndices);
+
+        for (uint32 i=0; i < 3; i++) {
+
+            const uint32 v1 = verticesPositionIds[verticesIndices[i]];
+            const uint32 v2 = verticesPositionIds[verticesIndices[(i + 1) % 3]];
+            if (v1 == v2) continue;
+
+            auto it = orientedEdges.find(Pair<uint32, uint32>(v1, v2));
+            if (it == orientedEdges.end()) {
+                orientedEdges.add(Pair<Pair<uint32, uint32>, uint32>(Pair<uint32, uint32>(v1, v2), t * 3 + i));
+            }
+            else {
+                it->second = NO_ADJACENT_TRIANGLE;
+            }
+        }
+    }
+
+    // For each triangle
+    for (uint32 t=0; t < nbTriangles; t++) {
+
+        uint32 verticesIndices[3];
+        mCompressedTriangles->getTriangleVerticesIndices(t, verticesIndices);
+
+        Vector3 points[3];
+        mCompressedTriangles->getTriangleVertices(t, points);
+        Vector3 normal = (points[1] - points[0]).cross(points[2] - points[0]);
+        const bool isDegenerate = normal.lengthSquare() < MACHINE_EPSILON;
+        if (!isDegenerate) normal.normalize();
+
+        uint8 convexEdges = 0;
+
+        // For each edge of the triangle
+        for (uint32 i=0; i < 3; i++) {
+
+            uint32 adjacentTriangle = NO_ADJACENT_TRIANGLE;
+
+            const uint32 v1 = verticesPositionIds[verticesIndices[i]];
+            const uint32 v2 = verticesPositionIds[verticesIndices[(i + 1) % 3]];
+            auto itEdge = orientedEdges.find(Pair<uint32, uint32>(v1, v2));
+            auto itTwin = orientedEdges.find(Pair<uint32, uint32>(v2, v1));
+
+            // The edge has an adjacent triangle if both oriented edges belong to a single triangle
+            if (v1 != v2 && itEdge->second != NO_ADJACENT_TRIANGLE && itTwin != orientedEdges.end() &&
+                itTwin->second != NO_ADJACENT_TRIANGLE) {
+                adjacentTriangle = itTwin->second / 3;
+            }
+
+            bool isConvex = true;
+            if (adjacentTriangle != NO_ADJACENT_TRIANGLE && !isDegenerate) {
+
+                // Vertex of the adjacent triangle that is not on the shared edge
+                Vector3 adjacentPoints[3];
+                mCompressedTriangles->getTriangleVertices(adjacentTriangle, adjacentPoints);
+                const Vector3& oppositeVertex = adjacentPoints[(itTwin->second % 3 + 2) % 3];
+
+                // Distance of the opposite vertex to the plane and to the line of the edge
+                const Vector3 edgeDirection = (points[(i + 1) % 3] - points[i]).getUnit();
+                const Vector3 edgeToVertex = oppositeVertex - points[i];
+                const decimal distanceToPlane = normal.dot(edgeToVertex);
+                const decimal distanceToEdge = edgeDirection.cross(edgeToVertex).length();
+
+                isConvex = distanceToPlane < -FLAT_EDGE_TOLERANCE * distanceToEdge;
+            }
+
+            mCookedAdjacentTriangles.add(adjacentTriangle);
+            if (isConvex) convexEdges |= static_cast<uint8>(1 << i);
+        }
+
+        mCookedConvexEdges.add(convexEdges);
+    }
+}
+
+// Return the size (in bytes) of the cooked data of the mesh
+/**
+ * @return The size of the cooked data or zero if the mesh is not cooked
+ */
+size_t TriangleMesh::getCookedDataSize() const {
+
+    if (!mIsCooked) return 0;
+
+    return sizeof(CookedDataHeader) + computeCookedDataSize(getNbSubparts(), mCompressedTriangles->mNbTriangles,
+                                                            static_cast<uint32>(mCompressedTriangles->mClusters.size()),
+                                                            mCompressedTriangles->getNbVertices(), mCookedBVH.getNbNodes());
+}
+
+// Write the cooked data of the mesh into a buffer
+/// The cooked data contains a small header followed by the compressed triangles, the
+/// nodes of the BVH and the adjacency of the edges of the mesh. This data can be saved on disk and used later to create
+/// the same mesh without any processing (see PhysicsCommon::createTriangleMeshFromCookedData()).
+/// The data can only be loaded with the same version of the library, on the same platform and
+/// with the same decimal precision.
+/**
+ * @param buffer Pointer to the buffer where to write the cooked data
+ * @param bufferSize Size (in bytes) of the buffer (see getCookedDataSize())
+ * @return The number of bytes written or zero if the mesh is not cooked or the buffer is too small
+ */
+size_t TriangleMesh::writeCookedData(void* buffer, size_t bufferSize) const {
+
+    const size_t dataSize = getCookedDataSize();
+    if (!mIsCooked || buffer == nullptr || bufferSize < dataSize) {
+        return 0;
+    }
+
+    CookedDataHeader header;
+    header.magicNumber = COOKED_DATA_MAGIC_NUMBER;
+    header.version = COOKED_DATA_VERSION;
+    header.decimalSize = sizeof(decimal);
+    header.nbSubparts = getNbSubparts();
+    header.nbTriangles = mCompressedTriangles->mNbTriangles;
+    header.nbClusters = static_cast<uint32>(mCompressedTriangles->mClusters.size());
+    header.nbVertices = mCompressedTriangles->getNbVertices();
+    header.nbNodes = mCookedBVH.getNbNodes();
+    header.latticeMin = mCompressedTriangles->mLatticeMin;
+    header.quantizationStep = mCompressedTriangles->mQuantizationStep;
+    header.rootAABB = mCookedBVH.getRootAABB();
+
+    uint8* bytes = static_cast<uint8*>(buffer);
+    auto write = [&bytes](const void* data, size_t size) {
+        if (size > 0) {
+            std::memcpy(bytes, data, size);
+            bytes += size;
+        }
+    };
+
+    write(&header, sizeof(CookedDataHeader));
+    write(&(mCompressedSubpartsFirstTriangle[0]), mCompressedSubpartsFirstTriangle.size() * sizeof(uint32));
+    if (header.nbTriangles > 0) {
+        write(&(mCompressedTriangles->mClusters[0]), header.nbClusters * sizeof(CompressedTriangleCluster));
+        write(&(mCompressedTriangles->mVertices[0]), header.nbVertices * sizeof(CompressedTriangleVertex));
+        write(&(mCompressedTriangles->mVerticesNormals[0]), header.nbVertices * sizeof(uint32));
+        write(&(mCompressedTriangles->mIndices[0]), header.nbTriangles * 3 * sizeof(uint8));
+        write(mCookedBVH.getNodes(), static_cast<size_t>(header.nbNodes) * sizeof(QuantizedTreeNode));
+        write(&(mCookedAdjacentTriangles[0]), header.nbTriangles * 3 * sizeof(uint32));
+        write(&(mCookedConvexEdges[0]), header.nbTriangles * sizeof(uint8));
+    }
+
+    assert(static_cast<size_t>(bytes - static_cast<uint8*>(buffer)) == dataSize);
+
+    return dataSize;
+}
+
+// Return true if some cooked data is valid
+/// The header and all the indices of the data are checked so that corrupted data cannot be loaded.
+bool TriangleMesh::isCookedDataValid(const void* data, size_t dataSize) {
+
+    if (data == nullptr || dataSize < sizeof(CookedDataHeader)) return false;
+
+    CookedDataHeader header;
+    std::memcpy(&header, data, sizeof(CookedDataHeader));
+    if (header.magicNumber != COOKED_DATA_MAGIC_NUMBER || header.version != COOKED_DATA_VERSION ||
+        header.decimalSize != sizeof(decimal) || header.nbSubparts == 0) {
+        return false;
+    }
+
+    const uint32 nbTrianglesPerCluster = CompressedTriangleArray::NB_TRIANGLES_PER_CLUSTER;
+    if (header.nbClusters < (header.nbTriangles + nbTrianglesPerCluster - 1) / nbTrianglesPerCluster ||
+        header.nbClusters > header.nbTriangles) {
+        return false;
+    }
+    if (header.nbNodes != (header.nbTriangles > 0 ? static_cast<int32>(2 * header.nbTriangles - 1) : 0)) return false;
+    if (dataSize < sizeof(CookedDataHeader) + computeCookedDataSize(header.nbSubparts, header.nbTriangles, header.nbClusters,
+                                                                    header.nbVertices, header.nbNodes)) {
+        return false;
+    }
+
+    const uint8* bytes = static_cast<const uint8*>(data) + sizeof(CookedDataHeader);
+
+    // The sub-parts must contain all the triangles
+    uint32 previousFirstTriangle = 0;
+    for (uint32 i=0; i <= header.nbSubparts; i++) {
+        uint32 firstTriangle;
+        std::memcpy(&firstTriangle, bytes, sizeof(uint32));
+        bytes += sizeof(uint32);
+        if ((i == 0 && firstTriangle != 0) || firstTriangle < previousFirstTriangle) return false;
+        previousFirstTriangle = firstTriangle;
+    }
+    if (previousFirstTriangle != header.nbTriangles) return false;
+
+    // The clusters must contain all the triangles (with at most NB_TRIANGLES_PER_CLUSTER triangles per cluster)
+    // and the triangles indices must reference vertices of their cluster
+    const uint8* clusters = bytes;
+    const uint8* indices = bytes + header.nbClusters * sizeof(CompressedTriangleCluster) +
+                           header.nbVertices * (sizeof(CompressedTriangleVertex) + sizeof(uint32));
+    for (uint32 c=0; c < header.nbClusters; c++) {
+
+        CompressedTriangleCluster cluster, nextCluster;
+        std::memcpy(&cluster, clusters + c * sizeof(CompressedTriangleCluster), sizeof(CompressedTriangleCluster));
+        nextCluster.firstVertex = header.nbVertices;
+        nextCluster.firstTriangle = header.nbTriangles;
+        if (c + 1 < header.nbClusters) {
+            std::memcpy(&nextCluster, clusters + (c + 1) * sizeof(CompressedTriangleCluster), sizeof(CompressedTriangleCluster));
+        }
+        if (nextCluster.firstVertex < cluster.firstVertex || nextCluster.firstVertex > header.nbVertices) return false;
+        if ((c == 0 && cluster.firstTriangle != 0) || nextCluster.firstTriangle <= cluster.firstTriangle ||
+            nextCluster.firstTriangle > header.nbTriangles || nextCluster.firstTriangle - cluster.firstTriangle > nbTrianglesPerCluster) {
+            return false;
+        }
+
+        const uint32 endIndex = nextCluster.firstTriangle * 3;
+        for (uint32 i = cluster.firstTriangle * 3; i < endIndex; i++) {
+            if (cluster.firstVertex + indices[i] >= nextCluster.firstVertex) return false;
+        }
+    }
+
+    // The nodes of the BVH must reference valid nodes and triangles
+    const uint8* nodes = indices + header.nbTriangles * 3 * sizeof(uint8);
+    if (!StaticAABBTree::areNodesValid(nodes, header.nbNodes, static_cast<int32>(header.nbTriangles))) return false;
+
+    // The adjacent triangles must be valid triangles and the convexity flags must be flags of three edges
+    const uint8* adjacentTriangles = nodes + static_cast<size_t>(header.nbNodes) * sizeof(QuantizedTreeNode);
+    for (uint32 i=0; i < header.nbTriangles * 3; i++) {
+        uint32 adjacentTriangle;
+        std::memcpy(&adjacentTriangle, adjacentTriangles + i * sizeof(uint32), sizeof(uint32));
+        if (adjacentTriangle >= header.nbTriangles && adjacentTriangle != NO_ADJACENT_TRIANGLE) return false;
+    }
+    const uint8* convexEdges = adjacentTriangles + header.nbTriangles * 3 * sizeof(uint32);
+    for (uint32 t=0; t < header.nbTriangles; t++) {
+        if (convexEdges[t] > 7) return false;
+    }
+
+    return true;
+}
+
+// Load the compressed triangles and the BVH of the mesh from cooked data
+/// The data is copied and does not need to remain valid after this call.
+/**
+ * @param data Pointer to the cooked data (see writeCookedData())
+ * @param dataSize Size (in bytes) of the cooked data
+ * @return True if the data is valid and has been loaded
+ */
+bool TriangleMesh::loadCookedData(const void* data, size_t dataSize) {
+
+    assert(mCompressedTriangles == nullptr);
+    assert(mTriangleArrays.size() == 0);
+
+    if (!isCookedDataValid(data, dataSize)) return false;
+
+    CookedDataHeader header;
+    std::memcpy(&header, data, sizeof(CookedDataHeader));
+    const uint8* bytes = static_cast<const uint8*>(data) + sizeof(CookedDataHeader);
+
+    mCompressedSubpartsFirstTriangle.addWithoutInit(header.nbSubparts + 1);
+    std::memcpy(&(mCompressedSubpartsFirstTriangle[0]), bytes, (header.nbSubparts + 1) * sizeof(uint32));
+    bytes += (header.nbSubparts + 1) * sizeof(uint32);
+
+    mCompressedTriangles = new (mAllocator.allocate(sizeof(CompressedTriangleArray))) CompressedTriangleArray(mAllocator);
+    mCompressedTriangles->mNbTriangles = header.nbTriangles;
+    mCompressedTriangles->mLatticeMin = header.latticeMin;
+    mCompressedTriangles->mQuantizationStep = header.quantizationStep;
+
+    if (header.nbTriangles > 0) {
+
+        mCompressedTriangles->mClusters.addWithoutInit(header.nbClusters);
+        std::memcpy(&(mCompressedTriangles->mClusters[0]), bytes, header.nbClusters * sizeof(CompressedTriangleCluster));
+        bytes += header.nbClusters * sizeof(CompressedTriangleCluster);
+
+        mCompressedTriangles->mVertices.addWithoutInit(header.nbVertices);
+        std::memcpy(&(mCompressedTriangles->mVertices[0]), bytes, header.nbVertices * sizeof(CompressedTriangleVertex));
+        bytes += header.nbVertices * sizeof(CompressedTriangleVertex);
+
+        mCompressedTriangles->mVerticesNormals.addWithoutInit(header.nbVertices);
+        std::memcpy(&(mCompressedTriangles->mVerticesNormals[0]), bytes, header.nbVertices * sizeof(uint32));
+        bytes += header.nbVertices * sizeof(uint32);
+
+        mCompressedTriangles->mIndices.addWithoutInit(header.nbTriangles * 3);
+        std::memcpy(&(mCompressedTriangles->mIndices[0]), bytes, header.nbTriangles * 3 * sizeof(uint8));
+        bytes += header.nbTriangles * 3 * sizeof(uint8);
+
+        mCompressedTriangles->computeBlocksFirstCluster();
+    }
+
+    // The nodes are copied because the data might not be aligned for the nodes
+    mCookedBVH.copyNodes(reinterpret_cast<const QuantizedTreeNode*>(bytes), header.nbNodes, header.rootAABB);
+    bytes += static_cast<size_t>(header.nbNodes) * sizeof(QuantizedTreeNode);
+
+    if (header.nbTriangles > 0) {
+
+        mCookedAdjacentTriangles.addWithoutInit(header.nbTriangles * 3);
+        std::memcpy(&(mCookedAdjacentTriangles[0]), bytes, header.nbTriangles * 3 * sizeof(uint32));
+        bytes += header.nbTriangles * 3 * sizeof(uint32);
+
+        mCookedConvexEdges.addWithoutInit(header.nbTriangles);
+        std::memcpy(&(mCookedConvexEdges[0]), bytes, header.nbTriangles * sizeof(uint8));
+    }
+
+    mIsCooked = true;
+
+    return true;
 }
@@ -28,6 +28,7 @@
 #include <reactphysics3d/systems/BroadPhaseSystem.h>
 #include <reactphysics3d/containers/Stack.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Snapshot.h>
 
 using namespace reactphysics3d;
 
@@ -45,7 +46,7 @@ DynamicAABBTree::DynamicAABBTree(MemoryAllocator& allocator, decimal fatAABBInfl
 DynamicAABBTree::~DynamicAABBTree() {
 
     // Free the allocated memory for the nodes
-    mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+    releaseNodes();
 }
 
 // Initialize the tree
@@ -77,6 +78,16 @@ void DynamicAABBTree::init() {
 // Clear all the nodes and reset the tree
 void DynamicAABBTree::reset() {
 
+    // Free the allocated memory for the nodes
+    releaseNodes();
+
+    // Initialize the tree
+    init();
+}
+
+// Release the memory of the nodes
+void DynamicAABBTree::releaseNodes() {
+
     // Call the destructor of all the nodes
     for (int32 i=0; i < mNbAllocatedNodes; i++) {
         mNodes[i].~TreeNode();
@@ -84,9 +95,280 @@ void DynamicAABBTree::reset() {
 
     // Free the allocated memory for the nodes
     mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+}
 
-    // Initialize the tree
-    init();
+// Build the whole tree from a set of leaves using the surface area heuristic (SAH)
+/// This method replaces the current content of the tree. The tree is built top-down by
+/// recursively splitting the leaves with the binned surface area heuristic. This is much
+/// faster than inserting the leaves one by one and produces a tree of better quality for
+/// static objects. The nodes are stored in depth-first order (the root is the first node
+/// and the left child of a node is always the next node) and the leaf nodes are stored
+/// with their two integer data.
+/**
+ * @param leafAABBs Array with the AABB of each leaf
+ * @param leafData Array with the two integer data of each leaf (two consecutive values per leaf)
+ * @param nbLeaves Number of leaves
+ */
+void DynamicAABBTree::buildTopDown(const AABB* leafAABBs, const int32* leafData, int32 nbLeaves) {
+
+    releaseNodes();
+
+    if (nbLeaves == 0) {
+        init();
+        return;
+    }
+
+    // A binary tree with n leaves has exactly 2n-1 nodes
+    mNbAllocatedNodes = 2 * nbLeaves - 1;
+    mNbNodes = mNbAllocatedNodes;
+    mFreeNodeID = TreeNode::NULL_TREE_NODE;
+    mRootNodeID = TreeNode::NULL_TREE_NODE;
+    mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
+    assert(mNodes);
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        new (mNodes + i) TreeNode();
+    }
+
+    // Copy the leaves into a contiguous array that will be partitioned during the build
+    BuildLeaf* leaves = static_cast<BuildLeaf*>(mAllocator.allocate(static_cast<size_t>(nbLeaves) * sizeof(BuildLeaf)));
+    for (int32 i=0; i < nbLeaves; i++) {
+        leaves[i].aabb = leafAABBs[i];
+        leaves[i].centroid = leafAABBs[i].getCenter();
+        leaves[i].index = i;
+    }
+
+    // Range of leaves to split into a new node
+    struct BuildTask {
+        int32 parentID;
+        int32 childIndex;
+        int32 start;
+        int32 end;
+    };
+
+    Stack<BuildTask> stack(mAllocator, 64);
+    stack.push({TreeNode::NULL_TREE_NODE, 0, 0, nbLeaves});
+    int32 nextNodeID = 0;
+
+    while (stack.size() > 0) {
+
+        const BuildTask task = stack.pop();
+
+        // Nodes are created in depth-first order (a child always has a larger ID than its parent)
+        const int32 nodeID = nextNodeID++;
+        TreeNode& node = mNodes[nodeID];
+        node.parentID = task.parentID;
+        if (task.parentID == TreeNode::NULL_TREE_NODE) {
+            mRootNodeID = nodeID;
+        }
+        else {
+            mNodes[task.parentID].children[task.childIndex] = nodeID;
+        }
+
+        // If there is a single leaf in the range, we create a leaf node
+        if (task.end - task.start == 1) {
+
+            const BuildLeaf& leaf = leaves[task.start];
+            const Vector3 gap(leaf.aabb.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+            node.aabb.setMin(leaf.aabb.getMin() - gap);
+            node.aabb.setMax(leaf.aabb.getMax() + gap);
+            node.dataInt[0] = leafData[2 * leaf.index];
+            node.dataInt[1] = leafData[2 * leaf.index + 1];
+            node.height = 0;
+            continue;
+        }
+
+        const int32 split = computeSAHSplit(leaves, task.start, task.end);
+        assert(split > task.start && split < task.end);
+
+        // The height and AABB of an internal node are computed once its children are built
+        node.height = 1;
+
+        // Push the right child first so that the left sub-tree is built first
+        stack.push({nodeID, 1, split, task.end});
+        stack.push({nodeID, 0, task.start, split});
+    }
+
+    assert(nextNodeID == mNbNodes);
+
+    // Compute the AABBs and heights of the internal nodes (children have larger IDs than their parent)
+    for (int32 i = mNbNodes - 1; i >= 0; i--) {
+
+        TreeNode& node = mNodes[i];
+        if (!node.isLeaf()) {
+            const TreeNode& leftChild = mNodes[node.children[0]];
+            const TreeNode& rightChild = mNodes[node.children[1]];
+            node.aabb.mergeTwoAABBs(leftChild.aabb, rightChild.aabb);
+            node.height = 1 + std::max(leftChild.height, rightChild.height);
+        }
+    }
+
+    mAllocator.release(leaves, static_cast<size_t>(nbLeaves) * sizeof(BuildLeaf));
+}
+
+// Compute the best split of a range of leaves using the binned surface area heuristic
+/// The centroids of the leaves are distributed into bins along each axis and the split
+/// plane with the minimal SAH cost is selected. The leaves of the range are then partitioned
+/// and the index of the first leaf of the right part is returned.
+int32 DynamicAABBTree::computeSAHSplit(BuildLeaf* leaves, int32 start, int32 end) const {
+
+    const int NB_BINS = 16;
+
+    // Compute the bounds of the centroids of the leaves
+    Vector3 centroidsMin = leaves[start].centroid;
+    Vector3 centroidsMax = leaves[start].centroid;
+    for (int32 i = start + 1; i < end; i++) {
+        centroidsMin = Vector3::min(centroidsMin, leaves[i].centroid);
+        centroidsMax = Vector3::max(centroidsMax, leaves[i].centroid);
+    }
+    const Vector3 centroidsExtent = centroidsMax - centroidsMin;
+
+    // Scale to compute the bin of a centroid along each axis (zero if all the centroids
+    // are at the same position along this axis)
+    Vector3 binScale;
+    for (int axis = 0; axis < 3; axis++) {
+        binScale[axis] = centroidsExtent[axis] > MACHINE_EPSILON ? decimal(NB_BINS) * (decimal(1.0) - MACHINE_EPSILON) / centroidsExtent[axis] : decimal(0.0);
+    }
+
+    // Distribute the leaves into the bins of the three axis
+    AABB binAABBs[3][NB_BINS];
+    int32 binNbLeaves[3][NB_BINS] = {};
+    for (int32 i = start; i < end; i++) {
+
+        const BuildLeaf& leaf = leaves[i];
+        for (int axis = 0; axis < 3; axis++) {
+
+            const int bin = static_cast<int>((leaf.centroid[axis] - centroidsMin[axis]) * binScale[axis]);
+            assert(bin >= 0 && bin < NB_BINS);
+            if (binNbLeaves[axis][bin] == 0) {
+                binAABBs[axis][bin] = leaf.aabb;
+            }
+            else {
+                binAABBs[axis][bin].mergeWithAABB(leaf.aabb);
+            }
+            binNbLeaves[axis][bin]++;
+        }
+    }
+
+    decimal bestCost = DECIMAL_LARGEST;
+    int bestAxis = -1;
+    int bestBin = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+
+        if (binScale[axis] == decimal(0.0)) continue;
+
+        // Sweep from the right to compute the area and number of leaves on the right of each split plane
+        decimal rightAreas[NB_BINS - 1];
+        int32 rightNbLeaves[NB_BINS - 1];
+        AABB rightAABB;
+        int32 nbLeavesRight = 0;
+        for (int bin = NB_BINS - 1; bin > 0; bin--) {
+            if (binNbLeaves[axis][bin] > 0) {
+                if (nbLeavesRight == 0) {
+                    rightAABB = binAABBs[axis][bin];
+                }
+                else {
+                    rightAABB.mergeWithAABB(binAABBs[axis][bin]);
+                }
+                nbLeavesRight += binNbLeaves[axis][bin];
+            }
+            rightNbLeaves[bin - 1] = nbLeavesRight;
+            rightAreas[bin - 1] = nbLeavesRight > 0 ? rightAABB.getSurfaceArea() : decimal(0.0);
+        }
+
+        // Sweep from the left and compute the SAH cost of each split plane
+        AABB leftAABB;
+        int32 nbLeavesLeft = 0;
+        for (int bin = 0; bin < NB_BINS - 1; bin++) {
+            if (binNbLeaves[axis][bin] > 0) {
+                if (nbLeavesLeft == 0) {
+                    leftAABB = binAABBs[axis][bin];
+                }
+                else {
+                    leftAABB.mergeWithAABB(binAABBs[axis][bin]);
+                }
+                nbLeavesLeft += binNbLeaves[axis][bin];
+            }
+
+            if (nbLeavesLeft == 0 || rightNbLeaves[bin] == 0) continue;
+
+            const decimal cost = nbLeavesLeft * leftAABB.getSurfaceArea() + rightNbLeaves[bin] * rightAreas[bin];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = bin;
+            }
+        }
+    }
+
+    // If no split plane has been found (all the centroids at the same position), we split in the middle
+    if (bestAxis == -1) {
+        return start + (end - start) / 2;
+    }
+
+    // Partition the leaves on both sides of the best split plane
+    int32 i = start;
+    int32 j = end - 1;
+    while (i <= j) {
+        const int bin = static_cast<int>((leaves[i].centroid[bestAxis] - centroidsMin[bestAxis]) * binScale[bestAxis]);
+        if (bin <= bestBin) {
+            i++;
+        }
+        else {
+            std::swap(leaves[i], leaves[j]);
+            j--;
+        }
+    }
+
+    return i;
+}
+
+// Write the nodes of the tree into a snapshot
+/// The nodes array is written as a whole (including the free nodes) so that the
+/// tree can be restored with the same node ids.
+void DynamicAABBTree::takeSnapshot(SnapshotWriter& writer) const {
+
+    writer.write(mRootNodeID);
+    writer.write(mFreeNodeID);
+    writer.write(mNbAllocatedNodes);
+    writer.write(mNbNodes);
+    writer.writeBytes(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+}
+
+// Check that a snapshot of the nodes of the tree is valid and skip it
+bool DynamicAABBTree::validateSnapshot(SnapshotReader& reader) const {
+
+    const int32 rootNodeID = reader.read<int32>();
+    const int32 freeNodeID = reader.read<int32>();
+    const int32 nbAllocatedNodes = reader.read<int32>();
+    const int32 nbNodes = reader.read<int32>();
+
+    if (reader.hasFailed() || nbAllocatedNodes <= 0 || nbNodes < 0 || nbNodes > nbAllocatedNodes ||
+        rootNodeID < TreeNode::NULL_TREE_NODE || rootNodeID >= nbAllocatedNodes ||
+        freeNodeID < TreeNode::NULL_TREE_NODE || freeNodeID >= nbAllocatedNodes) {
+        return false;
+    }
+
+    return reader.skipBytes(static_cast<size_t>(nbAllocatedNodes) * sizeof(TreeNode));
+}
+
+// Restore the nodes of the tree from a snapshot
+void DynamicAABBTree::restoreSnapshot(SnapshotReader& reader) {
+
+    mRootNodeID = reader.read<int32>();
+    mFreeNodeID = reader.read<int32>();
+    const int32 nbAllocatedNodes = reader.read<int32>();
+    mNbNodes = reader.read<int32>();
+
+    // Reallocate the nodes if the number of allocated nodes has changed
+    if (nbAllocatedNodes != mNbAllocatedNodes) {
+
+        mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+        mNbAllocatedNodes = nbAllocatedNodes;
+        mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
+    }
+
+    reader.readBytes(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
 }
 
 // Allocate and return a new node in the tree
@@ -0,0 +1,333 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/StaticAABBTree.h>
+#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <cmath>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+// Node to visit during the traversal of the tree (with its dequantized AABB)
+struct StaticAABBTreeStackNode {
+    int32 nodeIndex;
+    AABB aabb;
+};
+
+// Constructor
+StaticAABBTree::StaticAABBTree(MemoryAllocator& allocator)
+               : mAllocator(allocator), mNodes(nullptr), mNbNodes(0), mRootAABB(Vector3::zero(), Vector3::zero()),
+                 mIsUsingExternalNodes(false) {
+
+}
+
+// Destructor
+StaticAABBTree::~StaticAABBTree() {
+
+    releaseNodes();
+}
+
+// Release the memory of the nodes (if it is owned by the tree)
+void StaticAABBTree::releaseNodes() {
+
+    if (mNodes != nullptr && !mIsUsingExternalNodes) {
+        mAllocator.release(mNodes, static_cast<size_t>(mNbNodes) * sizeof(QuantizedTreeNode));
+    }
+
+    mNodes = nullptr;
+    mNbNodes = 0;
+    mIsUsingExternalNodes = false;
+}
+
+// Build the tree with a set of leaves
+/// The tree is first built with the surface area heuristic in a temporary DynamicAABBTree. Its nodes
+/// are then converted into quantized nodes. The data of each leaf is its index in the input array.
+/**
+ * @param leafAABBs Array with the AABB of each leaf
+ * @param nbLeaves Number of leaves
+ */
+void StaticAABBTree::build(const AABB* leafAABBs, int32 nbLeaves) {
+
+    releaseNodes();
+
+    if (nbLeaves == 0) {
+        mRootAABB = AABB(Vector3::zero(), Vector3::zero());
+        return;
+    }
+
+    // The data of a leaf is its index
+    int32* leafData = static_cast<int32*>(mAllocator.allocate(2 * static_cast<size_t>(nbLeaves) * sizeof(int32)));
+    for (int32 i=0; i < nbLeaves; i++) {
+        leafData[2 * i] = i;
+        leafData[2 * i + 1] = 0;
+    }
+
+    // Build the tree with the surface area heuristic
+    DynamicAABBTree tree(mAllocator);
+    tree.buildTopDown(leafAABBs, leafData, nbLeaves);
+    mAllocator.release(leafData, 2 * static_cast<size_t>(nbLeaves) * sizeof(int32));
+
+    mNbNodes = tree.getNbAllocatedNodes();
+    mNodes = static_cast<QuantizedTreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbNodes) * sizeof(QuantizedTreeNode)));
+    assert(mNodes);
+
+    // The nodes of the dynamic tree are in depth-first order with the left child right after its parent
+    const TreeNode* nodes = tree.getNodes();
+    assert(tree.getRootNodeID() == 0);
+    mRootAABB = nodes[0].aabb;
+
+    // Array with the dequantized AABB of each node (to quantize the AABB of the children)
+    AABB* aabbs = static_cast<AABB*>(mAllocator.allocate(static_cast<size_t>(mNbNodes) * sizeof(AABB)));
+
+    for (int32 i=0; i < mNbNodes; i++) {
+
+        QuantizedTreeNode& node = mNodes[i];
+
+        // Quantize the AABB of the node relative to the AABB of its parent
+        if (i == 0) {
+            for (int axis = 0; axis < 3; axis++) {
+                node.quantizedMin[axis] = 0;
+                node.quantizedMax[axis] = 0;
+            }
+            aabbs[i] = mRootAABB;
+        }
+        else {
+            const AABB& parentAABB = aabbs[nodes[i].parentID];
+            quantizeAABB(nodes[i].aabb, parentAABB, node);
+            aabbs[i] = node.computeAABB(parentAABB, QuantizedTreeNode::computeQuantizationStep(parentAABB));
+        }
+
+        if (nodes[i].isLeaf()) {
+            node.rightChildOrData = -(nodes[i].dataInt[0] + 1);
+        }
+        else {
+            assert(nodes[i].children[0] == i + 1);
+            node.rightChildOrData = nodes[i].children[1];
+        }
+    }
+
+    mAllocator.release(aabbs, static_cast<size_t>(mNbNodes) * sizeof(AABB));
+}
+
+// Quantize the AABB of a node relative to the AABB of its parent
+/// The quantized AABB always contains the AABB in parameter because the coordinates
+/// are rounded in the conservative direction.
+void StaticAABBTree::quantizeAABB(const AABB& aabb, const AABB& parentAABB, QuantizedTreeNode& node) {
+
+    const Vector3& parentMin = parentAABB.getMin();
+    const Vector3& parentMax = parentAABB.getMax();
+    const Vector3 step = QuantizedTreeNode::computeQuantizationStep(parentAABB);
+
+    for (int axis = 0; axis < 3; axis++) {
+
+        if (step[axis] <= decimal(0.0)) {
+            node.quantizedMin[axis] = 0;
+            node.quantizedMax[axis] = 0;
+            continue;
+        }
+
+        const decimal maxValue = decimal(QuantizedTreeNode::MAX_QUANTIZED_VALUE);
+        const decimal minValue = std::floor((aabb.getMin()[axis] - parentMin[axis]) / step[axis]);
+        const decimal maxDistanceValue = std::floor((parentMax[axis] - aabb.getMax()[axis]) / step[axis]);
+        uint32 quantizedMin = static_cast<uint32>(std::max(decimal(0.0), std::min(minValue, maxValue)));
+        uint32 quantizedMax = static_cast<uint32>(std::max(decimal(0.0), std::min(maxDistanceValue, maxValue)));
+
+        // Make sure that the rounding errors do not make the quantized AABB smaller than the AABB
+        while (quantizedMin > 0 && parentMin[axis] + quantizedMin * step[axis] > aabb.getMin()[axis]) {
+            quantizedMin--;
+        }
+        while (quantizedMax > 0 && parentMax[axis] - quantizedMax * step[axis] < aabb.getMax()[axis]) {
+            quantizedMax--;
+        }
+
+        node.quantizedMin[axis] = static_cast<uint16>(quantizedMin);
+        node.quantizedMax[axis] = static_cast<uint16>(quantizedMax);
+    }
+}
+
+// Use an external read-only array of nodes for the tree (without copying it)
+/// This is used to load a tree that has been built offline. The memory of the nodes
+/// is owned by the user and must remain valid during the lifetime of the tree.
+/**
+ * @param nodes Pointer to the array of nodes
+ * @param nbNodes Number of nodes in the array
+ * @param rootAABB AABB of the root node of the tree
+ */
+void StaticAABBTree::setExternalNodes(const QuantizedTreeNode* nodes, int32 nbNodes, const AABB& rootAABB) {
+
+    releaseNodes();
+
+    mNodes = const_cast<QuantizedTreeNode*>(nodes);
+    mNbNodes = nbNodes;
+    mRootAABB = rootAABB;
+    mIsUsingExternalNodes = true;
+}
+
+// Use a copy of an array of nodes for the tree
+/**
+ * @param nodes Pointer to the nodes of the tree (in depth-first order)
+ * @param nbNodes Number of nodes of the tree
+ * @param rootAABB AABB of the root node of the tree
+ */
+void StaticAABBTree::copyNodes(const QuantizedTreeNode* nodes, int32 nbNodes, const AABB& rootAABB) {
+
+    releaseNodes();
+
+    mRootAABB = rootAABB;
+
+    if (nbNodes > 0) {
+        mNbNodes = nbNodes;
+        mNodes = static_cast<QuantizedTreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbNodes) * sizeof(QuantizedTreeNode)));
+        std::memcpy(mNodes, nodes, static_cast<size_t>(mNbNodes) * sizeof(QuantizedTreeNode));
+    }
+}
+
+// Return true if an array of nodes (possibly not aligned) only references valid nodes and leaves data
+/// The nodes are in depth-first order: the left child of a node is the next node and its right child
+/// must be after it in the array. The data of each leaf must be smaller than the number of leaves data.
+/// This method must be used before using nodes that do not come from build() (serialized data for instance).
+/**
+ * @param nodes Pointer to the nodes of the tree
+ * @param nbNodes Number of nodes of the tree
+ * @param nbLeavesData The data of a leaf must be in the range [0, nbLeavesData)
+ * @return True if the tree can be traversed without reading outside of the nodes and leaves data
+ */
+bool StaticAABBTree::areNodesValid(const void* nodes, int32 nbNodes, int32 nbLeavesData) {
+
+    const uint8* nodesBytes = static_cast<const uint8*>(nodes);
+
+    for (int32 n=0; n < nbNodes; n++) {
+
+        QuantizedTreeNode node;
+        std::memcpy(&node, nodesBytes + static_cast<size_t>(n) * sizeof(QuantizedTreeNode), sizeof(QuantizedTreeNode));
+        if (node.isLeaf() ? node.getData() >= nbLeavesData :
+                            (node.rightChildOrData <= n + 1 || node.rightChildOrData >= nbNodes)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Report the data of all the leaves overlapping with the AABB given in parameter
+void StaticAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingLeavesData) const {
+
+    RP3D_PROFILE("StaticAABBTree::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    if (mNbNodes == 0 || !aabb.testCollision(mRootAABB)) return;
+
+    // Create a stack with the nodes to visit (their AABB has already been tested)
+    Stack<StaticAABBTreeStackNode> stack(mAllocator, 64);
+    stack.push({0, mRootAABB});
+
+    // While there are still nodes to visit
+    while(stack.size() > 0) {
+
+        const StaticAABBTreeStackNode stackNode = stack.pop();
+        const QuantizedTreeNode& node = mNodes[stackNode.nodeIndex];
+
+        // If the node is a leaf
+        if (node.isLeaf()) {
+            overlappingLeavesData.add(node.getData());
+            continue;
+        }
+
+        // Test the AABBs of the children nodes (the left child is the next node)
+        const Vector3 step = QuantizedTreeNode::computeQuantizationStep(stackNode.aabb);
+        const int32 leftChildIndex = stackNode.nodeIndex + 1;
+        const AABB leftAABB = mNodes[leftChildIndex].computeAABB(stackNode.aabb, step);
+        if (aabb.testCollision(leftAABB)) {
+            stack.push({leftChildIndex, leftAABB});
+        }
+
+        const int32 rightChildIndex = node.rightChildOrData;
+        const AABB rightAABB = mNodes[rightChildIndex].computeAABB(stackNode.aabb, step);
+        if (aabb.testCollision(rightAABB)) {
+            stack.push({rightChildIndex, rightAABB});
+        }
+    }
+}
+
+// Ray casting method
+void StaticAABBTree::raycast(const Ray& ray, StaticAABBTreeRaycastCallback& callback) const {
+
+    RP3D_PROFILE("StaticAABBTree::raycast()", mProfiler);
+
+    if (mNbNodes == 0) return;
+
+    decimal maxFraction = ray.maxFraction;
+
+    // Compute the inverse ray direction
+    const Vector3 rayDirection = ray.point2 - ray.point1;
+    const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
+
+    Stack<StaticAABBTreeStackNode> stack(mAllocator, 128);
+    stack.push({0, mRootAABB});
+
+    while (stack.size() > 0) {
+
+        const StaticAABBTreeStackNode stackNode = stack.pop();
+
+        // Test if the ray intersects with the current node AABB (the maximum fraction might
+        // have been reduced since the node has been pushed)
+        if (!stackNode.aabb.testRayIntersect(ray.point1, rayDirectionInverse, maxFraction)) continue;
+
+        const QuantizedTreeNode& node = mNodes[stackNode.nodeIndex];
+
+        // If the node is a leaf of the tree
+        if (node.isLeaf()) {
+
+            Ray rayTemp(ray.point1, ray.point2, maxFraction);
+
+            // Call the callback that will raycast again the leaf
+            decimal hitFraction = callback.raycastLeaf(node.getData(), rayTemp);
+
+            // If the user returned a hitFraction of zero, it means that
+            // the raycasting should stop here
+            if (hitFraction == decimal(0.0)) {
+                return;
+            }
+
+            // If the user returned a positive fraction, we update the maximum fraction
+            if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+                maxFraction = hitFraction;
+            }
+
+            // If the user returned a negative fraction, we continue
+            // the raycasting as if the leaf did not exist
+        }
+        else {
+
+            // Push the children in the stack of nodes to explore (the left child is the next node)
+            const Vector3 step = QuantizedTreeNode::computeQuantizationStep(stackNode.aabb);
+            const int32 rightChildIndex = node.rightChildOrData;
+            stack.push({rightChildIndex, mNodes[rightChildIndex].computeAABB(stackNode.aabb, step)});
+            stack.push({stackNode.nodeIndex + 1, mNodes[stackNode.nodeIndex + 1].computeAABB(stackNode.aabb, step)});
+        }
+    }
+}
@@ -0,0 +1,354 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/BoxVsBoxAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/shapes/BoxShape.h>
+#include <reactphysics3d/utils/Profiler.h>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Static variables initialization
+const decimal BoxVsBoxAlgorithm::SEPARATING_AXIS_RELATIVE_TOLERANCE = decimal(1.002);
+const decimal BoxVsBoxAlgorithm::SEPARATING_AXIS_ABSOLUTE_TOLERANCE = decimal(0.0005);
+const decimal BoxVsBoxAlgorithm::PARALLEL_EDGES_TOLERANCE = decimal(0.000001);
+
+// Compute the narrow-phase collision detection between two boxes
+/// All the computations are done in the local-space of the second box where the edges
+/// of this box are the coordinate axes and the edges of the first box are the columns
+/// of the relative rotation matrix.
+bool BoxVsBoxAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems) {
+
+    RP3D_PROFILE("BoxVsBoxAlgorithm::testCollision()", mProfiler);
+
+    bool isCollisionFound = false;
+
+    for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
+
+        NarrowPhaseInfoBatch::NarrowPhaseInfo& narrowPhaseInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex];
+
+        assert(narrowPhaseInfo.collisionShape1->getName() == CollisionShapeName::BOX);
+        assert(narrowPhaseInfo.collisionShape2->getName() == CollisionShapeName::BOX);
+        assert(narrowPhaseInfo.nbContactPoints == 0);
+
+        const BoxShape* box1 = static_cast<const BoxShape*>(narrowPhaseInfo.collisionShape1);
+        const BoxShape* box2 = static_cast<const BoxShape*>(narrowPhaseInfo.collisionShape2);
+
+        narrowPhaseInfo.lastFrameCollisionInfo->wasUsingGJK = false;
+        narrowPhaseInfo.lastFrameCollisionInfo->wasUsingSAT = false;
+
+        const Vector3 halfExtents1 = box1->getHalfExtents();
+        const Vector3 halfExtents2 = box2->getHalfExtents();
+
+        const Transform box1ToBox2 = narrowPhaseInfo.shape2ToWorldTransform.getInverse() * narrowPhaseInfo.shape1ToWorldTransform;
+        const Transform box2ToBox1 = box1ToBox2.getInverse();
+
+        // The columns of the rotation matrix are the axes of box 1 in the local-space of box 2
+        const Matrix3x3 rotation = box1ToBox2.getOrientation().getMatrix();
+        const Matrix3x3 rotationTranspose = rotation.getTranspose();
+        const Matrix3x3 absRotation = rotation.getAbsoluteMatrix();
+        const Matrix3x3 absRotationTranspose = absRotation.getTranspose();
+
+        // Center of box 1 in the local-space of box 2 and in the local-space of box 1 rotated back along the axes of box 1
+        const Vector3& center1 = box1ToBox2.getPosition();
+        const Vector3 center1Box1Axes = rotationTranspose * center1;
+
+        bool separatingAxisFound = false;
+
+        // Test the face normals of box 2 as separating axes
+        decimal penetrationDepth2 = DECIMAL_LARGEST;
+        int faceAxis2 = 0;
+        for (int i=0; i < 3; i++) {
+
+            const decimal penetrationDepth = absRotation[i].dot(halfExtents1) + halfExtents2[i] - std::abs(center1[i]);
+            if (penetrationDepth <= decimal(0.0)) {
+                separatingAxisFound = true;
+                break;
+            }
+            if (penetrationDepth < penetrationDepth2) {
+                penetrationDepth2 = penetrationDepth;
+                faceAxis2 = i;
+            }
+        }
+
+        if (separatingAxisFound) continue;
+
+        // Test the face normals of box 1 as separating axes
+        decimal penetrationDepth1 = DECIMAL_LARGEST;
+        int faceAxis1 = 0;
+        for (int i=0; i < 3; i++) {
+
+            const decimal penetrationDepth = halfExtents1[i] + absRotationTranspose[i].dot(halfExtents2) - std::abs(center1Box1Axes[i]);
+            if (penetrationDepth <= decimal(0.0)) {
+                separatingAxisFound = true;
+                break;
+            }
+            if (penetrationDepth < penetrationDepth1) {
+                penetrationDepth1 = penetrationDepth;
+                faceAxis1 = i;
+            }
+        }
+
+        if (separatingAxisFound) continue;
+
+        // If the two penetration depths are almost the same, we always prefer the face of box 1 for
+        // consistency between frames (same bias as in the SAT algorithm)
+        const bool isReferenceBox1 = penetrationDepth1 < penetrationDepth2 * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE;
+        decimal minPenetrationDepth = std::min(penetrationDepth1, penetrationDepth2);
+        bool isMinPenetrationEdges = false;
+        int minEdge1Axis = 0;
+        int minEdge2Axis = 0;
+        Vector3 minEdgesAxis;
+
+        // Test the cross products of the edges of box 1 with the edges of box 2 as separating axes
+        for (int i=0; i < 3 && !separatingAxisFound; i++) {
+
+            const Vector3 edge1Direction = rotation.getColumn(i);
+
+            for (int j=0; j < 3; j++) {
+
+                Vector3 edge2Direction(0, 0, 0);
+                edge2Direction[j] = decimal(1.0);
+
+                // Parallel edges do not give a new axis (it is already tested with the face normals)
+                Vector3 axis = edge1Direction.cross(edge2Direction);
+                const decimal axisLengthSquare = axis.lengthSquare();
+                if (axisLengthSquare < PARALLEL_EDGES_TOLERANCE) continue;
+                axis /= std::sqrt(axisLengthSquare);
+
+                const decimal radius1 = (rotationTranspose * axis).getAbsoluteVector().dot(halfExtents1);
+                const decimal radius2 = axis.getAbsoluteVector().dot(halfExtents2);
+                const decimal center1Distance = axis.dot(center1);
+                const decimal penetrationDepth = radius1 + radius2 - std::abs(center1Distance);
+
+                if (penetrationDepth <= decimal(0.0)) {
+                    separatingAxisFound = true;
+                    break;
+                }
+
+                // We favor the face contacts that are more stable than the single contact point of an edge-edge
+                // contact. Therefore, an edge-edge axis is only used if its penetration depth is really smaller
+                if ((!isMinPenetrationEdges && penetrationDepth * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE < minPenetrationDepth) ||
+                    (isMinPenetrationEdges && penetrationDepth < minPenetrationDepth)) {
+
+                    minPenetrationDepth = penetrationDepth;
+                    isMinPenetrationEdges = true;
+                    minEdge1Axis = i;
+                    minEdge2Axis = j;
+
+                    // The axis is oriented from box 1 toward box 2 (the origin)
+                    minEdgesAxis = center1Distance > decimal(0.0) ? -axis : axis;
+                }
+            }
+        }
+
+        if (separatingAxisFound) continue;
+
+        assert(minPenetrationDepth > decimal(0.0));
+
+        // If the minimum separating axis is the cross product of two edges
+        if (isMinPenetrationEdges) {
+
+            // If we need to report contacts
+            if (narrowPhaseInfo.reportContacts) {
+
+                // Find the edge of box 1 that is the most in the direction of the axis and the edge
+                // of box 2 that is the most in the opposite direction (in the local-space of box 2)
+                const Vector3 axisBox1Axes = rotationTranspose * minEdgesAxis;
+                Vector3 edge1Center = center1;
+                Vector3 edge2Center(0, 0, 0);
+                for (int k=0; k < 3; k++) {
+                    if (k != minEdge1Axis) {
+                        edge1Center += rotation.getColumn(k) * (axisBox1Axes[k] > decimal(0.0) ? halfExtents1[k] : -halfExtents1[k]);
+                    }
+                    if (k != minEdge2Axis) {
+                        edge2Center[k] = minEdgesAxis[k] > decimal(0.0) ? -halfExtents2[k] : halfExtents2[k];
+                    }
+                }
+                const Vector3 edge1HalfDirection = rotation.getColumn(minEdge1Axis) * halfExtents1[minEdge1Axis];
+                Vector3 edge2HalfDirection(0, 0, 0);
+                edge2HalfDirection[minEdge2Axis] = halfExtents2[minEdge2Axis];
+
+                // Compute the closest points between the two edges (in the local-space of box 2)
+                Vector3 closestPointEdge1, closestPointEdge2;
+                computeClosestPointBetweenTwoSegments(edge1Center - edge1HalfDirection, edge1Center + edge1HalfDirection,
+                                                      edge2Center - edge2HalfDirection, edge2Center + edge2HalfDirection,
+                                                      closestPointEdge1, closestPointEdge2);
+
+                const Vector3 normalWorld = narrowPhaseInfo.shape2ToWorldTransform.getOrientation() * minEdgesAxis;
+
+                // Create the contact point
+                narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, minPenetrationDepth, box2ToBox1 * closestPointEdge1, closestPointEdge2);
+            }
+        }
+        else {
+
+            bool contactsFound;
+
+            // The reference face is the face of the reference box in the direction of the other box
+            if (isReferenceBox1) {
+                const decimal referenceNormalSign = center1Box1Axes[faceAxis1] > decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+                contactsFound = computeFaceContactPoints(halfExtents1, halfExtents2, box1ToBox2, box2ToBox1, faceAxis1, referenceNormalSign,
+                                                         true, narrowPhaseInfoBatch, batchIndex);
+            }
+            else {
+                const decimal referenceNormalSign = center1[faceAxis2] < decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+                contactsFound = computeFaceContactPoints(halfExtents2, halfExtents1, box2ToBox1, box1ToBox2, faceAxis2, referenceNormalSign,
+                                                         false, narrowPhaseInfoBatch, batchIndex);
+            }
+
+            // There should be clipping points here. If it is not the case, it might be
+            // because of a numerical issue
+            if (!contactsFound) continue;
+        }
+
+        narrowPhaseInfo.isColliding = true;
+        isCollisionFound = true;
+    }
+
+    return isCollisionFound;
+}
+
+// Compute the contact points between the reference face of a box and the incident face of the other box
+/// The reference face is the face of the reference box with the outward normal along the axis "referenceAxis"
+/// with the sign "referenceNormalSign" (in the local-space of the reference box). The incident face is the face
+/// of the other box that is the most anti-parallel to the reference face. This method returns true if contact
+/// points have been found.
+bool BoxVsBoxAlgorithm::computeFaceContactPoints(const Vector3& referenceHalfExtents, const Vector3& incidentHalfExtents,
+                                                 const Transform& referenceToIncidentTransform, const Transform& incidentToReferenceTransform,
+                                                 int referenceAxis, decimal referenceNormalSign, bool isReferenceBox1,
+                                                 NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) const {
+
+    RP3D_PROFILE("BoxVsBoxAlgorithm::computeFaceContactPoints()", mProfiler);
+
+    const NarrowPhaseInfoBatch::NarrowPhaseInfo& narrowPhaseInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex];
+
+    Vector3 referenceNormal(0, 0, 0);
+    referenceNormal[referenceAxis] = referenceNormalSign;
+
+    // Compute the world normal (from box 1 toward box 2)
+    const Vector3 normalWorld = isReferenceBox1 ? narrowPhaseInfo.shape1ToWorldTransform.getOrientation() * referenceNormal :
+                                                  -(narrowPhaseInfo.shape2ToWorldTransform.getOrientation() * referenceNormal);
+
+    // Find the incident face (most anti-parallel face)
+    const Vector3 referenceNormalIncidentSpace = referenceToIncidentTransform.getOrientation() * referenceNormal;
+    const int incidentAxis = referenceNormalIncidentSpace.getAbsoluteVector().getMaxAxis();
+    const int incidentAxis1 = (incidentAxis + 1) % 3;
+    const int incidentAxis2 = (incidentAxis + 2) % 3;
+
+    // Clipping the four vertices of the incident face with the four side planes of the reference
+    // face adds at most one vertex per plane
+    Vector3 verticesTemp1[8];
+    Vector3 verticesTemp2[8];
+
+    // Get the vertices of the incident face in the local-space of the reference box (in order around the face)
+    const decimal verticesSigns[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+    Vector3 incidentVertex;
+    incidentVertex[incidentAxis] = referenceNormalIncidentSpace[incidentAxis] > decimal(0.0) ? -incidentHalfExtents[incidentAxis] :
+                                                                                               incidentHalfExtents[incidentAxis];
+    for (int i=0; i < 4; i++) {
+        incidentVertex[incidentAxis1] = verticesSigns[i][0] * incidentHalfExtents[incidentAxis1];
+        incidentVertex[incidentAxis2] = verticesSigns[i][1] * incidentHalfExtents[incidentAxis2];
+        verticesTemp1[i] = incidentToReferenceTransform * incidentVertex;
+    }
+
+    // Clip the incident face with the side planes of the reference face using the Sutherland-Hodgman
+    // algorithm. The side planes are aligned with the axes of the reference box.
+    Vector3* inputVertices = verticesTemp1;
+    Vector3* outputVertices = verticesTemp2;
+    uint32 nbVertices = 4;
+    for (int p=0; p < 4 && nbVertices > 0; p++) {
+
+        const int clipAxis = (referenceAxis + 1 + p / 2) % 3;
+        const decimal clipSign = p % 2 == 0 ? decimal(1.0) : decimal(-1.0);
+        const decimal clipHalfExtent = referenceHalfExtents[clipAxis];
+
+        uint32 nbOutputVertices = 0;
+        for (uint32 i=0; i < nbVertices; i++) {
+
+            const Vector3& v1 = inputVertices[i == 0 ? nbVertices - 1 : i - 1];
+            const Vector3& v2 = inputVertices[i];
+
+            // Signed distances of the two vertices of the edge to the clipping plane (negative inside)
+            const decimal distance1 = clipSign * v1[clipAxis] - clipHalfExtent;
+            const decimal distance2 = clipSign * v2[clipAxis] - clipHalfExtent;
+
+            if (distance2 <= decimal(0.0)) {
+
+                // If the edge enters the inside of the plane, we add the intersection point
+                if (distance1 > decimal(0.0)) {
+                    outputVertices[nbOutputVertices++] = v1 + (v2 - v1) * (distance1 / (distance1 - distance2));
+                }
+                outputVertices[nbOutputVertices++] = v2;
+            }
+            else if (distance1 < decimal(0.0)) {
+
+                // The edge exits the inside of the plane
+                outputVertices[nbOutputVertices++] = v1 + (v2 - v1) * (distance1 / (distance1 - distance2));
+            }
+
+            assert(nbOutputVertices <= 8);
+        }
+
+        nbVertices = nbOutputVertices;
+        std::swap(inputVertices, outputVertices);
+    }
+
+    // We only keep the clipped points that are below the reference face
+    bool contactPointsFound = false;
+    for (uint32 i=0; i < nbVertices; i++) {
+
+        const Vector3& clipPoint = inputVertices[i];
+
+        // Compute the penetration depth of this contact point
+        const decimal penetrationDepth = referenceHalfExtents[referenceAxis] - referenceNormalSign * clipPoint[referenceAxis];
+
+        // If the clip point is below the reference face
+        if (penetrationDepth > decimal(0.0)) {
+
+            contactPointsFound = true;
+
+            // If we need to report contacts
+            if (narrowPhaseInfo.reportContacts) {
+
+                // Convert the clip point into the incident box local-space
+                const Vector3 contactPointIncident = referenceToIncidentTransform * clipPoint;
+
+                // Project the contact point onto the reference face
+                Vector3 contactPointReference = clipPoint;
+                contactPointReference[referenceAxis] = referenceNormalSign * referenceHalfExtents[referenceAxis];
+
+                // Create a new contact point
+                narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, penetrationDepth,
+                                                     isReferenceBox1 ? contactPointReference : contactPointIncident,
+                                                     isReferenceBox1 ? contactPointIncident : contactPointReference);
+            }
+        }
+    }
+
+    return contactPointsFound;
+}
@@ -25,11 +25,16 @@
 
 // Libraries
 #include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
+#include <reactphysics3d/collision/shapes/ConvexPolyhedronShape.h>
 
 using namespace reactphysics3d;
 
+// Static variables initialization
+const uint32 CollisionDispatch::DEFAULT_MIN_NB_EDGE_PAIRS_FOR_EPA = 16384;
+
 // Constructor
-CollisionDispatch::CollisionDispatch(MemoryAllocator& allocator) : mAllocator(allocator) {
+CollisionDispatch::CollisionDispatch(MemoryAllocator& allocator)
+                  : mAllocator(allocator), mMinNbEdgePairsForEPA(DEFAULT_MIN_NB_EDGE_PAIRS_FOR_EPA) {
 
     // Create the default narrow-phase algorithms
     mSphereVsSphereAlgorithm = new (allocator.allocate(sizeof(SphereVsSphereAlgorithm))) SphereVsSphereAlgorithm();
@@ -38,6 +43,7 @@ CollisionDispatch::CollisionDispatch(MemoryAllocator& allocator) : mAllocator(al
     mSphereVsConvexPolyhedronAlgorithm = new (allocator.allocate(sizeof(SphereVsConvexPolyhedronAlgorithm))) SphereVsConvexPolyhedronAlgorithm();
     mCapsuleVsConvexPolyhedronAlgorithm = new (allocator.allocate(sizeof(CapsuleVsConvexPolyhedronAlgorithm))) CapsuleVsConvexPolyhedronAlgorithm();
     mConvexPolyhedronVsConvexPolyhedronAlgorithm = new (allocator.allocate(sizeof(ConvexPolyhedronVsConvexPolyhedronAlgorithm))) ConvexPolyhedronVsConvexPolyhedronAlgorithm();
+    mBoxVsBoxAlgorithm = new (allocator.allocate(sizeof(BoxVsBoxAlgorithm))) BoxVsBoxAlgorithm();
 
     // Fill in the collision matrix
     fillInCollisionMatrix();
@@ -65,6 +71,9 @@ CollisionDispatch::~CollisionDispatch() {
     if (mIsConvexPolyhedronVsConvexPolyhedronDefault) {
         mAllocator.release(mConvexPolyhedronVsConvexPolyhedronAlgorithm, sizeof(ConvexPolyhedronVsConvexPolyhedronAlgorithm));
     }
+    if (mIsBoxVsBoxDefault) {
+        mAllocator.release(mBoxVsBoxAlgorithm, sizeof(BoxVsBoxAlgorithm));
+    }
 }
 
 // Select and return the narrow-phase collision detection algorithm to
@@ -184,6 +193,19 @@ void CollisionDispatch::setConvexPolyhedronVsConvexPolyhedronAlgorithm(ConvexPol
     fillInCollisionMatrix();
 }
 
+// Set the Box vs Box narrow-phase collision detection algorithm
+void CollisionDispatch::setBoxVsBoxAlgorithm(BoxVsBoxAlgorithm* algorithm) {
+
+    if (mIsBoxVsBoxDefault) {
+        mAllocator.release(mBoxVsBoxAlgorithm, sizeof(BoxVsBoxAlgorithm));
+        mIsBoxVsBoxDefault = false;
+    }
+
+    mBoxVsBoxAlgorithm = algorithm;
+
+    fillInCollisionMatrix();
+}
+
 
 // Fill-in the collision detection matrix
 void CollisionDispatch::fillInCollisionMatrix() {
@@ -213,5 +235,24 @@ NarrowPhaseAlgorithmType CollisionDispatch::selectNarrowPhaseAlgorithm(const Col
     return mCollisionMatrix[shape1Index][shape2Index];
 }
 
+// Return the corresponding narrow-phase algorithm type to use for two convex collision shapes
+/// Two boxes are convex polyhedra for the collision matrix but they use the dedicated box vs box algorithm.
+/// Two convex polyhedra with many edges use the EPA algorithm because the cost of the SAT algorithm grows
+/// with the number of pairs of edges of the two polyhedra.
+NarrowPhaseAlgorithmType CollisionDispatch::selectNarrowPhaseAlgorithm(const CollisionShape* shape1, const CollisionShape* shape2) const {
+
+    if (shape1->getName() == CollisionShapeName::BOX && shape2->getName() == CollisionShapeName::BOX) {
+        return NarrowPhaseAlgorithmType::BoxVsBox;
+    }
 
+    if (shape1->getType() == CollisionShapeType::CONVEX_POLYHEDRON && shape2->getType() == CollisionShapeType::CONVEX_POLYHEDRON) {
 
+        const uint64 nbEdges1 = static_cast<const ConvexPolyhedronShape*>(shape1)->getNbHalfEdges() / 2;
+        const uint64 nbEdges2 = static_cast<const ConvexPolyhedronShape*>(shape2)->getNbHalfEdges() / 2;
+        if (nbEdges1 * nbEdges2 >= mMinNbEdgePairsForEPA) {
+            return NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronEPA;
+        }
+    }
+
+    return selectNarrowPhaseAlgorithm(shape1->getType(), shape2->getType());
+}
@@ -27,11 +27,19 @@
 #include <reactphysics3d/collision/narrowphase/ConvexPolyhedronVsConvexPolyhedronAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/SAT/SATAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/EPA/EPAAlgorithm.h>
+#include <reactphysics3d/collision/shapes/ConvexPolyhedronShape.h>
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <cassert>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
 
+// Static variables initialization
+const decimal ConvexPolyhedronVsConvexPolyhedronAlgorithm::FACE_CONTACT_RELATIVE_TOLERANCE = decimal(1.002);
+const decimal ConvexPolyhedronVsConvexPolyhedronAlgorithm::FACE_CONTACT_ABSOLUTE_TOLERANCE = decimal(0.0005);
+
 // Compute the narrow-phase collision detection between two convex polyhedra
 // This technique is based on the "Robust Contact Creation for Physics Simulations" presentation
 // by Dirk Gregorius.
@@ -62,3 +70,120 @@ bool ConvexPolyhedronVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoB
 
     return isCollisionFound;
 }
+
+// Compute the narrow-phase collision detection between two convex polyhedra with the EPA algorithm
+/// The GJK and EPA algorithms are used to find the penetration axis with a cost that depends on the number
+/// of support point queries instead of the number of pairs of edges of the polyhedra. If the penetration
+/// axis is a face normal of one of the polyhedra, the contact points are computed by clipping the
+/// faces like in the SAT algorithm. Otherwise, we create a single contact point with the deepest points
+/// found by the EPA algorithm. If the EPA algorithm fails, we fall back to the SAT algorithm for this pair.
+/// Note that the face normal axis is preferred if its penetration depth is almost the same as the one of
+/// the EPA axis because a face contact has more contact points and is therefore more stable.
+bool ConvexPolyhedronVsConvexPolyhedronAlgorithm::testCollisionUsingEPA(NarrowPhaseInfoBatch& narrowPhaseInfoBatch,
+                                                                        uint32 batchStartIndex, uint32 batchNbItems,
+                                                                        bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator) {
+
+    RP3D_PROFILE("ConvexPolyhedronVsConvexPolyhedronAlgorithm::testCollisionUsingEPA()", mProfiler);
+
+    SATAlgorithm satAlgorithm(clipWithPreviousAxisIfStillColliding, memoryAllocator);
+    EPAAlgorithm epaAlgorithm(memoryAllocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+
+    satAlgorithm.setProfiler(mProfiler);
+    epaAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    bool isCollisionFound = false;
+
+    for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
+
+        NarrowPhaseInfoBatch::NarrowPhaseInfo& narrowPhaseInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex];
+
+        assert(narrowPhaseInfo.collisionShape1->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
+        assert(narrowPhaseInfo.collisionShape2->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
+
+        const ConvexPolyhedronShape* polyhedron1 = static_cast<const ConvexPolyhedronShape*>(narrowPhaseInfo.collisionShape1);
+        const ConvexPolyhedronShape* polyhedron2 = static_cast<const ConvexPolyhedronShape*>(narrowPhaseInfo.collisionShape2);
+
+        const Transform polyhedron2ToPolyhedron1 = narrowPhaseInfo.shape1ToWorldTransform.getInverse() * narrowPhaseInfo.shape2ToWorldTransform;
+
+        // Get the last frame collision info
+        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfo.lastFrameCollisionInfo;
+
+        // Use the previous search direction for frame coherence
+        Vector3 searchDirection(0, 1, 0);
+        if (lastFrameCollisionInfo->isValid && lastFrameCollisionInfo->wasUsingGJK) {
+            searchDirection = lastFrameCollisionInfo->gjkSeparatingAxis;
+        }
+
+        Vector3 normal;
+        decimal penetrationDepth;
+        Vector3 contactPoint1;
+        Vector3 contactPoint2;
+        EPAAlgorithm::EPAResult result = epaAlgorithm.computePenetrationDepth(polyhedron1, polyhedron2, polyhedron2ToPolyhedron1, searchDirection,
+                                                                              normal, penetrationDepth, contactPoint1, contactPoint2);
+
+        // If the EPA algorithm has failed, we use the SAT algorithm for this pair
+        if (result == EPAAlgorithm::EPAResult::FAILED) {
+
+            isCollisionFound |= satAlgorithm.testCollisionConvexPolyhedronVsConvexPolyhedron(narrowPhaseInfoBatch, batchIndex, 1);
+
+            lastFrameCollisionInfo->wasUsingSAT = true;
+            lastFrameCollisionInfo->wasUsingGJK = false;
+
+            continue;
+        }
+
+        lastFrameCollisionInfo->wasUsingSAT = false;
+        lastFrameCollisionInfo->wasUsingGJK = true;
+        lastFrameCollisionInfo->gjkSeparatingAxis = searchDirection;
+
+        if (result == EPAAlgorithm::EPAResult::SEPARATED) {
+            lastFrameCollisionInfo->separatingAxis = -searchDirection;
+            lastFrameCollisionInfo->isSeparatingAxisValid = true;
+            continue;
+        }
+
+        narrowPhaseInfo.isColliding = true;
+        isCollisionFound = true;
+
+        // If we do not need to report contacts
+        if (!narrowPhaseInfo.reportContacts) {
+            continue;
+        }
+
+        // Find the face of each polyhedron that is the most aligned with the penetration axis
+        const Transform polyhedron1ToPolyhedron2 = polyhedron2ToPolyhedron1.getInverse();
+        const uint32 faceIndex1 = polyhedron1->findMostAntiParallelFace(-normal);
+        const uint32 faceIndex2 = polyhedron2->findMostAntiParallelFace(polyhedron1ToPolyhedron2.getOrientation() * normal);
+
+        // Compute the penetration depths along the normals of those faces
+        const decimal faceNormalPenetrationDepth1 = satAlgorithm.testSingleFaceDirectionPolyhedronVsPolyhedron(polyhedron1, polyhedron2,
+                                                                                                                polyhedron1ToPolyhedron2, faceIndex1);
+        const decimal faceNormalPenetrationDepth2 = satAlgorithm.testSingleFaceDirectionPolyhedronVsPolyhedron(polyhedron2, polyhedron1,
+                                                                                                                polyhedron2ToPolyhedron1, faceIndex2);
+
+        // If the penetration axis is a face normal, we compute the contact points by clipping the faces
+        if (std::min(faceNormalPenetrationDepth1, faceNormalPenetrationDepth2) <
+            penetrationDepth * FACE_CONTACT_RELATIVE_TOLERANCE + FACE_CONTACT_ABSOLUTE_TOLERANCE) {
+
+            const bool isReferenceFacePolyhedron1 = faceNormalPenetrationDepth1 <
+                                                    faceNormalPenetrationDepth2 * FACE_CONTACT_RELATIVE_TOLERANCE + FACE_CONTACT_ABSOLUTE_TOLERANCE;
+            if (satAlgorithm.computePolyhedronVsPolyhedronFaceContactPoints(isReferenceFacePolyhedron1, polyhedron1, polyhedron2,
+                                                                            polyhedron1ToPolyhedron2, polyhedron2ToPolyhedron1,
+                                                                            isReferenceFacePolyhedron1 ? faceIndex1 : faceIndex2,
+                                                                            narrowPhaseInfoBatch, batchIndex)) {
+                continue;
+            }
+        }
+
+        // Create a single contact point between the deepest points of the polyhedra
+        const Vector3 normalWorld = narrowPhaseInfo.shape1ToWorldTransform.getOrientation() * normal;
+        narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, penetrationDepth, contactPoint1, contactPoint2);
+    }
+
+    return isCollisionFound;
+}
@@ -0,0 +1,401 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/EPA/EPAAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/GJK/VoronoiSimplex.h>
+#include <reactphysics3d/collision/shapes/ConvexShape.h>
+#include <reactphysics3d/mathematics/Transform.h>
+#include <reactphysics3d/mathematics/mathematics_functions.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <cassert>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Static variables initialization
+const uint32 EPAAlgorithm::MAX_NB_GJK_ITERATIONS = 64;
+const uint32 EPAAlgorithm::MAX_NB_EPA_ITERATIONS = 128;
+const decimal EPAAlgorithm::EPA_RELATIVE_TOLERANCE = decimal(0.0001);
+const decimal EPAAlgorithm::EPA_ABSOLUTE_TOLERANCE = decimal(0.00001);
+
+// Constructor
+EPAAlgorithm::EPAAlgorithm(MemoryAllocator& memoryAllocator)
+             : mPoints(memoryAllocator), mSuppPointsA(memoryAllocator), mSuppPointsB(memoryAllocator),
+               mTriangles(memoryAllocator), mHorizonEdges(memoryAllocator) {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    mProfiler = nullptr;
+#endif
+
+}
+
+// Compute the penetration depth between two convex shapes (without margin)
+/// The GJK algorithm is run first. If the shapes are separated, the method returns SEPARATED and the
+/// search direction contains the separating axis. Otherwise, the final simplex of the GJK algorithm is
+/// expanded into a polytope until we find the face of the Minkowski difference closest to the origin.
+/// In this case, the method returns the normal (from shape 1 toward shape 2, in local-space of shape 1),
+/// the penetration depth and the deepest points of both shapes (each in the local-space of its shape).
+/// The search direction is used as the initial direction of the GJK algorithm and it is updated with
+/// the direction to use for the next frame. The method returns FAILED if the polytope is degenerate
+/// or does not converge. In this case, the caller should use another algorithm.
+EPAAlgorithm::EPAResult EPAAlgorithm::computePenetrationDepth(const ConvexShape* shape1, const ConvexShape* shape2,
+                                                              const Transform& shape2ToShape1, Vector3& inOutSearchDirection,
+                                                              Vector3& outNormal, decimal& outPenetrationDepth,
+                                                              Vector3& outContactPointShape1, Vector3& outContactPointShape2) {
+
+    RP3D_PROFILE("EPAAlgorithm::computePenetrationDepth()", mProfiler);
+
+    mPoints.clear();
+    mSuppPointsA.clear();
+    mSuppPointsB.clear();
+    mTriangles.clear();
+
+    // Create a simplex set
+    VoronoiSimplex simplex;
+
+    Vector3 v = inOutSearchDirection;
+    if (v.lengthSquare() < MACHINE_EPSILON) {
+        v.setAllValues(0, 1, 0);
+    }
+
+    Vector3 suppA;
+    Vector3 suppB;
+    decimal distSquare = DECIMAL_LARGEST;
+    decimal prevDistSquare;
+    bool isGJKFinished = false;
+
+    // Run the GJK algorithm to find a simplex of the Minkowski difference that contains the origin
+    for (uint32 i=0; i < MAX_NB_GJK_ITERATIONS && !isGJKFinished; i++) {
+
+        // Compute the support point of the Minkowski difference A-B
+        computeSupportPoint(shape1, shape2, shape2ToShape1, -v, suppA, suppB);
+        const Vector3 w = suppA - suppB;
+        const decimal vDotw = v.dot(w);
+
+        // If v is a separating axis
+        if (vDotw > decimal(0.0)) {
+            inOutSearchDirection = v;
+            return EPAResult::SEPARATED;
+        }
+
+        // If the distance between the shapes does not improve anymore
+        if (simplex.isPointInSimplex(w) || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
+            isGJKFinished = true;
+            break;
+        }
+
+        // Add the new support point to the simplex
+        simplex.addPoint(w, suppA, suppB);
+
+        // If the simplex is affinely dependent or the closest point cannot be computed
+        if (simplex.isAffinelyDependent() || !simplex.computeClosestPoint(v)) {
+            isGJKFinished = true;
+            break;
+        }
+
+        prevDistSquare = distSquare;
+        distSquare = v.lengthSquare();
+
+        // If the simplex contains the origin or the distance does not improve a lot
+        isGJKFinished = simplex.isFull() || distSquare <= MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint() ||
+                        prevDistSquare - distSquare <= MACHINE_EPSILON * prevDistSquare;
+    }
+
+    if (!isGJKFinished) {
+        return EPAResult::FAILED;
+    }
+
+    // If the shapes are separated by a positive distance (without margins)
+    if (!simplex.isFull() && distSquare > MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint()) {
+        inOutSearchDirection = v;
+        return EPAResult::SEPARATED;
+    }
+
+    // Initialize the polytope with the final simplex of the GJK algorithm
+    Vector3 simplexSuppPointsA[4];
+    Vector3 simplexSuppPointsB[4];
+    Vector3 simplexPoints[4];
+    const int nbSimplexPoints = simplex.getSimplex(simplexSuppPointsA, simplexSuppPointsB, simplexPoints);
+    for (int i=0; i < nbSimplexPoints; i++) {
+        addPoint(simplexSuppPointsA[i], simplexSuppPointsB[i]);
+    }
+
+    if (mPoints.size() == 0 || !completeTetrahedron(shape1, shape2, shape2ToShape1)) {
+        return EPAResult::FAILED;
+    }
+
+    // Expand the polytope until its face closest to the origin is on the boundary of the Minkowski difference
+    for (uint32 i=0; i < MAX_NB_EPA_ITERATIONS; i++) {
+
+        // Find the triangle of the polytope closest to the origin
+        uint32 closestTriangleIndex = 0;
+        decimal minDistance = DECIMAL_LARGEST;
+        const uint32 nbTriangles = static_cast<uint32>(mTriangles.size());
+        for (uint32 t=0; t < nbTriangles; t++) {
+            if (!mTriangles[t].isObsolete && mTriangles[t].distance < minDistance) {
+                minDistance = mTriangles[t].distance;
+                closestTriangleIndex = t;
+            }
+        }
+
+        if (minDistance == DECIMAL_LARGEST) {
+            return EPAResult::FAILED;
+        }
+
+        const TriangleEPA triangle = mTriangles[closestTriangleIndex];
+
+        // Compute the support point in the direction of the triangle normal
+        computeSupportPoint(shape1, shape2, shape2ToShape1, triangle.normal, suppA, suppB);
+        const decimal supportDistance = triangle.normal.dot(suppA - suppB);
+
+        // If the triangle is on the boundary of the Minkowski difference
+        if (supportDistance - triangle.distance <= EPA_RELATIVE_TOLERANCE * supportDistance + EPA_ABSOLUTE_TOLERANCE) {
+
+            inOutSearchDirection = triangle.normal;
+
+            // If the shapes are only touching
+            if (triangle.distance <= decimal(0.0)) {
+                return EPAResult::SEPARATED;
+            }
+
+            // Compute the deepest points of both shapes from the barycentric coordinates of
+            // the point of the triangle closest to the origin
+            const uint32 v0 = triangle.vertices[0];
+            const uint32 v1 = triangle.vertices[1];
+            const uint32 v2 = triangle.vertices[2];
+            decimal lambda0, lambda1, lambda2;
+            computeBarycentricCoordinatesInTriangle(mPoints[v0], mPoints[v1], mPoints[v2],
+                                                    triangle.normal * triangle.distance, lambda0, lambda1, lambda2);
+
+            const Vector3 pointBShape1Space = lambda0 * mSuppPointsB[v0] + lambda1 * mSuppPointsB[v1] + lambda2 * mSuppPointsB[v2];
+            outContactPointShape1 = lambda0 * mSuppPointsA[v0] + lambda1 * mSuppPointsA[v1] + lambda2 * mSuppPointsA[v2];
+            outContactPointShape2 = shape2ToShape1.getInverse() * pointBShape1Space;
+            outNormal = triangle.normal;
+            outPenetrationDepth = triangle.distance;
+
+            return EPAResult::INTERPENETRATE;
+        }
+
+        // Expand the polytope with the new support point
+        const uint32 newPointIndex = addPoint(suppA, suppB);
+        if (!expandPolytope(newPointIndex)) {
+            return EPAResult::FAILED;
+        }
+    }
+
+    return EPAResult::FAILED;
+}
+
+// Compute the support point of the Minkowski difference A-B of the two shapes in a given direction
+/// The direction and the support points are in local-space of the first shape
+void EPAAlgorithm::computeSupportPoint(const ConvexShape* shape1, const ConvexShape* shape2, const Transform& shape2ToShape1,
+                                       const Vector3& direction, Vector3& outSuppPointA, Vector3& outSuppPointB) const {
+
+    outSuppPointA = shape1->getLocalSupportPointWithoutMargin(direction);
+    outSuppPointB = shape2ToShape1 * shape2->getLocalSupportPointWithoutMargin(shape2ToShape1.getOrientation().getInverse() * (-direction));
+}
+
+// Add a point to the polytope and return its index
+uint32 EPAAlgorithm::addPoint(const Vector3& suppPointA, const Vector3& suppPointB) {
+
+    mPoints.add(suppPointA - suppPointB);
+    mSuppPointsA.add(suppPointA);
+    mSuppPointsB.add(suppPointB);
+
+    return static_cast<uint32>(mPoints.size() - 1);
+}
+
+// Add a triangle to the polytope and return false if the triangle is degenerate
+/// The vertices must be in counter-clockwise order when seen from outside of the polytope
+bool EPAAlgorithm::addTriangle(uint32 v0, uint32 v1, uint32 v2) {
+
+    const Vector3 edge1 = mPoints[v1] - mPoints[v0];
+    const Vector3 edge2 = mPoints[v2] - mPoints[v0];
+    const Vector3 normal = edge1.cross(edge2);
+    const decimal normalLengthSquare = normal.lengthSquare();
+
+    if (normalLengthSquare <= MACHINE_EPSILON * edge1.lengthSquare() * edge2.lengthSquare() || normalLengthSquare == decimal(0.0)) {
+        return false;
+    }
+
+    TriangleEPA triangle;
+    triangle.vertices[0] = v0;
+    triangle.vertices[1] = v1;
+    triangle.vertices[2] = v2;
+    triangle.normal = normal / std::sqrt(normalLengthSquare);
+    triangle.distance = triangle.normal.dot(mPoints[v0]);
+    triangle.isObsolete = false;
+    mTriangles.add(triangle);
+
+    return true;
+}
+
+// Complete the final simplex of the GJK algorithm into a tetrahedron
+/// The GJK algorithm can stop with less than four points when the origin is on the boundary
+/// of the simplex. In this case, we add support points in directions where the simplex is flat.
+/// The method returns false if the tetrahedron is degenerate or does not contain the origin.
+bool EPAAlgorithm::completeTetrahedron(const ConvexShape* shape1, const ConvexShape* shape2, const Transform& shape2ToShape1) {
+
+    Vector3 suppA;
+    Vector3 suppB;
+
+    // If the simplex is a single point, we add a point in one of the directions of the axes
+    if (mPoints.size() == 1) {
+
+        const Vector3 directions[6] = {Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0),
+                                       Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1)};
+        for (uint32 i=0; i < 6; i++) {
+
+            computeSupportPoint(shape1, shape2, shape2ToShape1, directions[i], suppA, suppB);
+            if ((suppA - suppB - mPoints[0]).lengthSquare() > MACHINE_EPSILON) {
+                addPoint(suppA, suppB);
+                break;
+            }
+        }
+
+        if (mPoints.size() == 1) return false;
+    }
+
+    // If the simplex is a segment, we add a point in a direction orthogonal to the segment
+    if (mPoints.size() == 2) {
+
+        const Vector3 lineDirection = mPoints[1] - mPoints[0];
+        const Vector3 orthogonal1 = lineDirection.getOneUnitOrthogonalVector();
+        const Vector3 orthogonal2 = lineDirection.cross(orthogonal1);
+        const Vector3 directions[4] = {orthogonal1, -orthogonal1, orthogonal2, -orthogonal2};
+        for (uint32 i=0; i < 4; i++) {
+
+            computeSupportPoint(shape1, shape2, shape2ToShape1, directions[i], suppA, suppB);
+            const Vector3 pointToLine = suppA - suppB - mPoints[0];
+            if (pointToLine.cross(lineDirection).lengthSquare() > MACHINE_EPSILON * pointToLine.lengthSquare() * lineDirection.lengthSquare()) {
+                addPoint(suppA, suppB);
+                break;
+            }
+        }
+
+        if (mPoints.size() == 2) return false;
+    }
+
+    // If the simplex is a triangle, we add a point in the direction of the triangle normal
+    if (mPoints.size() == 3) {
+
+        const Vector3 normal = (mPoints[1] - mPoints[0]).cross(mPoints[2] - mPoints[0]);
+        const Vector3 directions[2] = {normal, -normal};
+        for (uint32 i=0; i < 2; i++) {
+
+            computeSupportPoint(shape1, shape2, shape2ToShape1, directions[i], suppA, suppB);
+            const Vector3 pointToPlane = suppA - suppB - mPoints[0];
+            const decimal distance = normal.dot(pointToPlane);
+            if (distance * distance > MACHINE_EPSILON * normal.lengthSquare() * pointToPlane.lengthSquare()) {
+                addPoint(suppA, suppB);
+                break;
+            }
+        }
+
+        if (mPoints.size() == 3) return false;
+    }
+
+    assert(mPoints.size() == 4);
+
+    // Make sure that the triangles of the tetrahedron are counter-clockwise when seen from outside
+    uint32 v1 = 1;
+    uint32 v2 = 2;
+    if ((mPoints[1] - mPoints[0]).cross(mPoints[2] - mPoints[0]).dot(mPoints[3] - mPoints[0]) > decimal(0.0)) {
+        v1 = 2;
+        v2 = 1;
+    }
+
+    if (!addTriangle(0, v1, v2) || !addTriangle(0, 3, v1) || !addTriangle(0, v2, 3) || !addTriangle(v1, 3, v2)) {
+        return false;
+    }
+
+    // The origin must be inside the tetrahedron
+    for (uint32 i=0; i < 4; i++) {
+        if (mTriangles[i].distance < -EPA_ABSOLUTE_TOLERANCE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Remove the triangles visible from a new point of the polytope and replace them with triangles to this point
+/// The new triangles are built between the new point and the edges of the horizon (edges between
+/// a visible triangle and a non-visible triangle). The method returns false if a new triangle is degenerate.
+bool EPAAlgorithm::expandPolytope(uint32 newPointIndex) {
+
+    mHorizonEdges.clear();
+
+    const Vector3& newPoint = mPoints[newPointIndex];
+
+    // For each triangle of the polytope
+    const uint32 nbTriangles = static_cast<uint32>(mTriangles.size());
+    for (uint32 t=0; t < nbTriangles; t++) {
+
+        TriangleEPA& triangle = mTriangles[t];
+
+        // If the triangle is visible from the new point, we remove it
+        if (!triangle.isObsolete && triangle.normal.dot(newPoint - mPoints[triangle.vertices[0]]) > decimal(0.0)) {
+
+            triangle.isObsolete = true;
+
+            // An edge shared by two visible triangles is not on the horizon
+            for (uint32 e=0; e < 3; e++) {
+
+                const uint32 edgeStart = triangle.vertices[e];
+                const uint32 edgeEnd = triangle.vertices[(e + 1) % 3];
+
+                bool isSharedEdge = false;
+                for (uint32 h=0; h < mHorizonEdges.size(); h++) {
+                    if (mHorizonEdges[h].first == edgeEnd && mHorizonEdges[h].second == edgeStart) {
+                        mHorizonEdges.removeAtAndReplaceByLast(h);
+                        isSharedEdge = true;
+                        break;
+                    }
+                }
+
+                if (!isSharedEdge) {
+                    mHorizonEdges.add(Pair<uint32, uint32>(edgeStart, edgeEnd));
+                }
+            }
+        }
+    }
+
+    if (mHorizonEdges.size() == 0) {
+        return false;
+    }
+
+    // Create the new triangles between the edges of the horizon and the new point
+    for (uint32 h=0; h < mHorizonEdges.size(); h++) {
+        if (!addTriangle(mHorizonEdges[h].first, mHorizonEdges[h].second, newPointIndex)) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -28,6 +28,10 @@
 #include <reactphysics3d/constraint/ContactPoint.h>
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/collision/shapes/SphereShape.h>
+#include <reactphysics3d/collision/shapes/CapsuleShape.h>
+#include <reactphysics3d/collision/shapes/BoxShape.h>
+#include <reactphysics3d/collision/shapes/ConvexMeshShape.h>
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/containers/Array.h>
@@ -51,187 +55,301 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
                                  uint32 batchNbItems, Array<GJKResult>& gjkResults) {
 
     RP3D_PROFILE("GJKAlgorithm::testCollision()", mProfiler);
-    
+
     // For each item in the batch
     for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
 
-        Vector3 suppA;             // Support point of object A
-        Vector3 suppB;             // Support point of object B
-        Vector3 w;                 // Support point of Minkowski difference A-B
-        Vector3 pA;                // Closest point of object A
-        Vector3 pB;                // Closest point of object B
-        decimal vDotw;
-        decimal prevDistSquare;
-        bool contactFound = false;
-
         assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->isConvex());
         assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->isConvex());
 
-        const ConvexShape* shape1 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1);
-        const ConvexShape* shape2 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2);
+        GJKResult result;
 
-        // Get the local-space to world-space transforms
-        const Transform& transform1 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape1ToWorldTransform;
-        const Transform& transform2 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape2ToWorldTransform;
+        // Run the GJK kernel of the type of the first shape
+        switch (narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->getName()) {
+            case CollisionShapeName::SPHERE:
+                result = testCollisionWithShapeType2<SphereShape>(narrowPhaseInfoBatch, batchIndex);
+                break;
+            case CollisionShapeName::CAPSULE:
+                result = testCollisionWithShapeType2<CapsuleShape>(narrowPhaseInfoBatch, batchIndex);
+                break;
+            case CollisionShapeName::BOX:
+                result = testCollisionWithShapeType2<BoxShape>(narrowPhaseInfoBatch, batchIndex);
+                break;
+            case CollisionShapeName::CONVEX_MESH:
+                result = testCollisionWithShapeType2<ConvexMeshShape>(narrowPhaseInfoBatch, batchIndex);
+                break;
+            case CollisionShapeName::TRIANGLE:
+                result = testCollisionWithShapeType2<TriangleShape>(narrowPhaseInfoBatch, batchIndex);
+                break;
+            default:
+                result = testCollisionWithShapeType2<ConvexShape>(narrowPhaseInfoBatch, batchIndex);
+                break;
+        }
 
-        // Transform a point from local space of body 2 to local
-        // space of body 1 (the GJK algorithm is done in local space of body 1)
-        Transform transform1Inverse = transform1.getInverse();
-        Transform body2Tobody1 = transform1Inverse * transform2;
+        assert(gjkResults.size() == batchIndex);
+        gjkResults.add(result);
+    }
+}
 
-        // Quaternion that transform a direction from local
-        // space of body 1 into local space of body 2
-        Quaternion rotateToBody2 = transform2.getOrientation().getInverse() * transform1.getOrientation();
+// Compute a contact info if the two collision shapes collide using the generic GJK kernel
+/// This method gives the same results as testCollision() but the support points of all the
+/// shape types are computed with virtual calls. It is used to validate the specialized kernels.
+void GJKAlgorithm::testCollisionGeneric(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex,
+                                        uint32 batchNbItems, Array<GJKResult>& gjkResults) {
 
-        // Initialize the margin (sum of margins of both objects)
-        decimal margin = shape1->getMargin() + shape2->getMargin();
-        decimal marginSquare = margin * margin;
-        assert(margin > decimal(0.0));
+    RP3D_PROFILE("GJKAlgorithm::testCollisionGeneric()", mProfiler);
 
-        // Create a simplex set
-        VoronoiSimplex simplex;
+    // For each item in the batch
+    for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
 
-        // Get the last collision frame info
-        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].lastFrameCollisionInfo;
+        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->isConvex());
+        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->isConvex());
 
-        // Get the previous point V (last cached separating axis)
-        Vector3 v;
-        if (lastFrameCollisionInfo->isValid && lastFrameCollisionInfo->wasUsingGJK) {
-            v = lastFrameCollisionInfo->gjkSeparatingAxis;
-            assert(v.lengthSquare() > decimal(0.000001));
-        }
-        else {
-            v.setAllValues(0, 1, 0);
-        }
+        assert(gjkResults.size() == batchIndex);
+        gjkResults.add(testCollisionPair<ConvexShape, ConvexShape>(narrowPhaseInfoBatch, batchIndex));
+    }
+}
+
+// Select the GJK kernel for the type of the second shape of a pair
+template<typename ShapeType1>
+GJKAlgorithm::GJKResult GJKAlgorithm::testCollisionWithShapeType2(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) {
+
+    switch (narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->getName()) {
+        case CollisionShapeName::SPHERE:
+            return testCollisionPair<ShapeType1, SphereShape>(narrowPhaseInfoBatch, batchIndex);
+        case CollisionShapeName::CAPSULE:
+            return testCollisionPair<ShapeType1, CapsuleShape>(narrowPhaseInfoBatch, batchIndex);
+        case CollisionShapeName::BOX:
+            return testCollisionPair<ShapeType1, BoxShape>(narrowPhaseInfoBatch, batchIndex);
+        case CollisionShapeName::CONVEX_MESH:
+            return testCollisionPair<ShapeType1, ConvexMeshShape>(narrowPhaseInfoBatch, batchIndex);
+        case CollisionShapeName::TRIANGLE:
+            return testCollisionPair<ShapeType1, TriangleShape>(narrowPhaseInfoBatch, batchIndex);
+        default:
+            return testCollisionPair<ShapeType1, ConvexShape>(narrowPhaseInfoBatch, batchIndex);
+    }
+}
 
-        // Initialize the upper bound for the square distance
-        decimal distSquare = DECIMAL_LARGEST;
+// Run the GJK algorithm on a pair of shapes whose types are known at compile time
+/// The support functions of both shapes are resolved at compile time and the rotations between
+/// the local-spaces of the two shapes are computed only once as matrices before the GJK loop.
+template<typename ShapeType1, typename ShapeType2>
+GJKAlgorithm::GJKResult GJKAlgorithm::testCollisionPair(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) {
+
+    Vector3 suppA;             // Support point of object A
+    Vector3 suppB;             // Support point of object B
+    Vector3 w;                 // Support point of Minkowski difference A-B
+    Vector3 pA;                // Closest point of object A
+    Vector3 pB;                // Closest point of object B
+    decimal vDotw;
+    decimal prevDistSquare;
+    bool contactFound = false;
+
+    const ShapeType1* shape1 = static_cast<const ShapeType1*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1);
+    const ShapeType2* shape2 = static_cast<const ShapeType2*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2);
+
+    // Get the local-space to world-space transforms
+    const Transform& transform1 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape1ToWorldTransform;
+    const Transform& transform2 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape2ToWorldTransform;
+
+    // Transform a point from local space of body 2 to local
+    // space of body 1 (the GJK algorithm is done in local space of body 1)
+    const Transform body2Tobody1 = transform1.getInverse() * transform2;
+
+    // Rotation matrices between the local-spaces of both bodies
+    const Matrix3x3 rotateToBody1 = body2Tobody1.getOrientation().getMatrix();
+    const Matrix3x3 rotateToBody2 = rotateToBody1.getTranspose();
+    const Vector3& body2PositionInBody1 = body2Tobody1.getPosition();
+
+    // Initialize the margin (sum of margins of both objects)
+    const decimal margin1 = shape1->getMargin();
+    const decimal margin2 = shape2->getMargin();
+    const decimal margin = margin1 + margin2;
+    const decimal marginSquare = margin * margin;
+    assert(margin > decimal(0.0));
+
+    // Create a simplex set
+    VoronoiSimplex simplex;
+
+    // Get the last collision frame info
+    LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].lastFrameCollisionInfo;
+
+    // Get the previous point V (last cached separating axis)
+    Vector3 v;
+    if (lastFrameCollisionInfo->isValid && lastFrameCollisionInfo->wasUsingGJK) {
+        v = lastFrameCollisionInfo->gjkSeparatingAxis;
+        assert(v.lengthSquare() > decimal(0.000001));
+    }
+    else {
+        v.setAllValues(0, 1, 0);
+    }
 
-        bool noIntersection = false;
+    // Initialize the upper bound for the square distance
+    decimal distSquare = DECIMAL_LARGEST;
 
-        do {
+    do {
 
-            // Compute the support points for original objects (without margins) A and B
-            suppA = shape1->getLocalSupportPointWithoutMargin(-v);
-            suppB = body2Tobody1 * shape2->getLocalSupportPointWithoutMargin(rotateToBody2 * v);
+        // Compute the support points for original objects (without margins) A and B
+        suppA = computeLocalSupportPoint(shape1, -v);
+        suppB = rotateToBody1 * computeLocalSupportPoint(shape2, rotateToBody2 * v) + body2PositionInBody1;
 
-            // Compute the support point for the Minkowski difference A-B
-            w = suppA - suppB;
+        // Compute the support point for the Minkowski difference A-B
+        w = suppA - suppB;
 
-            vDotw = v.dot(w);
+        vDotw = v.dot(w);
 
-            // If the enlarge objects (with margins) do not intersect
-            if (vDotw > decimal(0.0) && vDotw * vDotw > distSquare * marginSquare) {
+        // If the enlarge objects (with margins) do not intersect
+        if (vDotw > decimal(0.0) && vDotw * vDotw > distSquare * marginSquare) {
 
-                // Cache the current separating axis for frame coherence
-                lastFrameCollisionInfo->gjkSeparatingAxis = v;
+            // Cache the current separating axis for frame coherence
+            lastFrameCollisionInfo->gjkSeparatingAxis = v;
+            lastFrameCollisionInfo->separatingAxis = -v;
+            lastFrameCollisionInfo->isSeparatingAxisValid = true;
 
-                // No intersection, we return
-                assert(gjkResults.size() == batchIndex);
-                gjkResults.add(GJKResult::SEPARATED);
-                noIntersection = true;
-                break;
-            }
+            // No intersection, we return
+            return GJKResult::SEPARATED;
+        }
 
-            // If the objects intersect only in the margins
-            if (simplex.isPointInSimplex(w) || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
+        // If the objects intersect only in the margins
+        if (simplex.isPointInSimplex(w) || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
 
-                // Contact point has been found
-                contactFound = true;
-                break;
-            }
+            // Contact point has been found
+            contactFound = true;
+            break;
+        }
 
-            // Add the new support point to the simplex
-            simplex.addPoint(w, suppA, suppB);
+        // Add the new support point to the simplex
+        simplex.addPoint(w, suppA, suppB);
 
-            // If the simplex is affinely dependent
-            if (simplex.isAffinelyDependent()) {
+        // If the simplex is affinely dependent
+        if (simplex.isAffinelyDependent()) {
 
-                // Contact point has been found
-                contactFound = true;
-                break;
-            }
+            // Contact point has been found
+            contactFound = true;
+            break;
+        }
 
-            // Compute the point of the simplex closest to the origin
-            // If the computation of the closest point fails
-            if (!simplex.computeClosestPoint(v)) {
+        // Compute the point of the simplex closest to the origin
+        // If the computation of the closest point fails
+        if (!simplex.computeClosestPoint(v)) {
 
-                // Contact point has been found
-                contactFound = true;
-                break;
-            }
+            // Contact point has been found
+            contactFound = true;
+            break;
+        }
+
+        // Store and update the squared distance of the closest point
+        prevDistSquare = distSquare;
+        distSquare = v.lengthSquare();
+
+        // If the distance to the closest point doesn't improve a lot
+        if (prevDistSquare - distSquare <= MACHINE_EPSILON * prevDistSquare) {
+
+            simplex.backupClosestPointInSimplex(v);
 
-            // Store and update the squared distance of the closest point
-            prevDistSquare = distSquare;
+            // Get the new squared distance
             distSquare = v.lengthSquare();
 
-            // If the distance to the closest point doesn't improve a lot
-            if (prevDistSquare - distSquare <= MACHINE_EPSILON * prevDistSquare) {
+            // Contact point has been found
+            contactFound = true;
+            break;
+        }
 
-                simplex.backupClosestPointInSimplex(v);
+    } while(!simplex.isFull() && distSquare > MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint());
 
-                // Get the new squared distance
-                distSquare = v.lengthSquare();
+    if (contactFound && distSquare > MACHINE_EPSILON) {
 
-                // Contact point has been found
-                contactFound = true;
-                break;
-            }
+        // Compute the closet points of both objects (without the margins)
+        simplex.computeClosestPointsOfAandB(pA, pB);
 
-        } while(!simplex.isFull() && distSquare > MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint());
+        // Project those two points on the margins to have the closest points of both
+        // object with the margins
+        decimal dist = std::sqrt(distSquare);
+        assert(dist > decimal(0.0));
+        pA = (pA - (margin1 / dist) * v);
+        pB = rotateToBody2 * (pB + (margin2 / dist) * v - body2PositionInBody1);
 
-        if (noIntersection) {
-            continue;
+        // Compute the contact info
+        Vector3 normal = transform1.getOrientation() * (-v.getUnit());
+        decimal penetrationDepth = margin - dist;
+
+        // If the penetration depth is negative (due too numerical errors), there is no contact
+        if (penetrationDepth <= decimal(0.0)) {
+            return GJKResult::SEPARATED;
         }
 
-        if (contactFound && distSquare > MACHINE_EPSILON) {
+        // Do not generate a contact point with zero normal length
+        if (normal.lengthSquare() < MACHINE_EPSILON) {
+            return GJKResult::SEPARATED;
+        }
 
-            // Compute the closet points of both objects (without the margins)
-            simplex.computeClosestPointsOfAandB(pA, pB);
+        // If we need to report contacts
+        if (narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].reportContacts) {
 
-            // Project those two points on the margins to have the closest points of both
-            // object with the margins
-            decimal dist = std::sqrt(distSquare);
-            assert(dist > decimal(0.0));
-            pA = (pA - (shape1->getMargin() / dist) * v);
-            pB = body2Tobody1.getInverse() * (pB + (shape2->getMargin() / dist) * v);
+            // Compute smooth triangle mesh contact if one of the two collision shapes is a triangle
+            TriangleShape::computeSmoothTriangleMeshContact(shape1, shape2, pA, pB, transform1, transform2,
+                                                            penetrationDepth, normal);
 
-            // Compute the contact info
-            Vector3 normal = transform1.getOrientation() * (-v.getUnit());
-            decimal penetrationDepth = margin - dist;
+            // Add a new contact point
+            narrowPhaseInfoBatch.addContactPoint(batchIndex, normal, penetrationDepth, pA, pB);
+        }
 
-            // If the penetration depth is negative (due too numerical errors), there is no contact
-            if (penetrationDepth <= decimal(0.0)) {
-                assert(gjkResults.size() == batchIndex);
-                gjkResults.add(GJKResult::SEPARATED);
-                continue;
-            }
+        return GJKResult::COLLIDE_IN_MARGIN;
+    }
 
-            // Do not generate a contact point with zero normal length
-            if (normal.lengthSquare() < MACHINE_EPSILON) {
-                assert(gjkResults.size() == batchIndex);
-                gjkResults.add(GJKResult::SEPARATED);
-                continue;
-            }
+    return GJKResult::INTERPENETRATE;
+}
 
-            // If we need to report contacts
-            if (narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].reportContacts) {
+// Return the local support point of a sphere without margin
+Vector3 GJKAlgorithm::computeLocalSupportPoint(const SphereShape* shape, const Vector3& direction) {
+    return shape->SphereShape::getLocalSupportPointWithoutMargin(direction);
+}
 
-                // Compute smooth triangle mesh contact if one of the two collision shapes is a triangle
-                TriangleShape::computeSmoothTriangleMeshContact(shape1, shape2, pA, pB, transform1, transform2,
-                                                                penetrationDepth, normal);
+// Return the local support point of a capsule without margin
+Vector3 GJKAlgorithm::computeLocalSupportPoint(const CapsuleShape* shape, const Vector3& direction) {
+    return shape->CapsuleShape::getLocalSupportPointWithoutMargin(direction);
+}
 
-                // Add a new contact point
-                narrowPhaseInfoBatch.addContactPoint(batchIndex, normal, penetrationDepth, pA, pB);
-            }
+// Return the local support point of a box without margin
+Vector3 GJKAlgorithm::computeLocalSupportPoint(const BoxShape* shape, const Vector3& direction) {
+    return shape->BoxShape::getLocalSupportPointWithoutMargin(direction);
+}
 
-            assert(gjkResults.size() == batchIndex);
-            gjkResults.add(GJKResult::COLLIDE_IN_MARGIN);
+// Return the local support point of a convex mesh without margin
+/// We go through the coordinates of the scaled vertices that are stored in a structure of arrays
+/// layout in the shape and pick up the vertex with the largest dot product in the support direction
+Vector3 GJKAlgorithm::computeLocalSupportPoint(const ConvexMeshShape* shape, const Vector3& direction) {
 
-            continue;
-        }
+    const uint32 nbVertices = shape->ConvexMeshShape::getNbVertices();
+    const decimal* verticesX = shape->getVerticesCoordinates();
+    const decimal* verticesY = verticesX + nbVertices;
+    const decimal* verticesZ = verticesY + nbVertices;
 
-        assert(gjkResults.size() == batchIndex);
-        gjkResults.add(GJKResult::INTERPENETRATE);
+    decimal maxDotProduct = DECIMAL_SMALLEST;
+    uint32 indexMaxDotProduct = 0;
+
+    // For each vertex of the mesh
+    for (uint32 i=0; i < nbVertices; i++) {
+
+        // Compute the dot product of the current vertex
+        const decimal dotProduct = direction.x * verticesX[i] + direction.y * verticesY[i] + direction.z * verticesZ[i];
+
+        // If the current dot product is larger than the maximum one
+        if (dotProduct > maxDotProduct) {
+            indexMaxDotProduct = i;
+            maxDotProduct = dotProduct;
+        }
     }
+
+    return Vector3(verticesX[indexMaxDotProduct], verticesY[indexMaxDotProduct], verticesZ[indexMaxDotProduct]);
+}
+
+// Return the local support point of a triangle without margin
+Vector3 GJKAlgorithm::computeLocalSupportPoint(const TriangleShape* shape, const Vector3& direction) {
+    return shape->TriangleShape::getLocalSupportPointWithoutMargin(direction);
+}
+
+// Return the local support point of a convex shape of unknown type without margin
+Vector3 GJKAlgorithm::computeLocalSupportPoint(const ConvexShape* shape, const Vector3& direction) {
+    return shape->getLocalSupportPointWithoutMargin(direction);
 }
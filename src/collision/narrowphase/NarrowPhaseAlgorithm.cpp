@@ -0,0 +1,63 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseAlgorithm.h>
+#include <reactphysics3d/collision/shapes/ConvexShape.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <reactphysics3d/mathematics/Transform.h>
+#include <cassert>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Return true if two convex shapes are still separated along the separating axis of the previous frame
+/// We project both shapes (with their margins) onto the separating axis stored in the last frame collision
+/// info and check that the projection intervals still do not overlap. This test only needs one support
+/// point of each shape and is therefore much cheaper than running a narrow-phase algorithm.
+bool NarrowPhaseAlgorithm::isSeparatedAlongLastFrameAxis(const ConvexShape* shape1, const ConvexShape* shape2,
+                                                         const Transform& shape1ToWorldTransform, const Transform& shape2ToWorldTransform,
+                                                         const LastFrameCollisionInfo& lastFrameInfo) {
+
+    assert(lastFrameInfo.isSeparatingAxisValid);
+
+    const Vector3& axis = lastFrameInfo.separatingAxis;
+    const decimal axisLength = axis.length();
+    if (axisLength < MACHINE_EPSILON) {
+        return false;
+    }
+
+    // Transform from local-space of shape 2 to local-space of shape 1
+    const Transform shape2ToShape1 = shape1ToWorldTransform.getInverse() * shape2ToWorldTransform;
+
+    // Largest projection of shape 1 onto the axis
+    const decimal maxProjection1 = axis.dot(shape1->getLocalSupportPointWithoutMargin(axis)) + shape1->getMargin() * axisLength;
+
+    // Smallest projection of shape 2 onto the axis
+    const Vector3 supportPoint2 = shape2ToShape1 * shape2->getLocalSupportPointWithoutMargin(shape2ToShape1.getOrientation().getInverse() * (-axis));
+    const decimal minProjection2 = axis.dot(supportPoint2) - shape2->getMargin() * axisLength;
+
+    return minProjection2 > maxProjection1;
+}
@@ -34,7 +34,8 @@ using namespace reactphysics3d;
 
 // Constructor
 NarrowPhaseInfoBatch::NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator)
-                     : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs), narrowPhaseInfos(allocator){
+                     : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs), narrowPhaseInfos(allocator),
+                       triangles(allocator) {
 
 }
 
@@ -47,6 +48,7 @@ NarrowPhaseInfoBatch::~NarrowPhaseInfoBatch() {
 void NarrowPhaseInfoBatch::reserveMemory() {
 
     narrowPhaseInfos.reserve(mCachedCapacity);
+    triangles.reserve(mCachedTrianglesCapacity);
 }
 
 // Clear all the objects in the batch
@@ -59,6 +61,9 @@ void NarrowPhaseInfoBatch::clear() {
 
         // TODO OPTI : Better manage this
 
+        // The triangles of the tests against triangles are not stored in TriangleShape objects
+        if (narrowPhaseInfos[i].collisionShape1 == nullptr || narrowPhaseInfos[i].collisionShape2 == nullptr) continue;
+
         // Release the memory of the TriangleShape (this memory was allocated in the
         // MiddlePhaseTriangleCallback::testTriangle() method)
         if (narrowPhaseInfos[i].collisionShape1->getName() == CollisionShapeName::TRIANGLE) {
@@ -77,6 +82,8 @@ void NarrowPhaseInfoBatch::clear() {
     // location of the allocated memory of a single frame allocator might change between two frames)
 
     mCachedCapacity = static_cast<uint32>(narrowPhaseInfos.capacity());
+    mCachedTrianglesCapacity = static_cast<uint32>(triangles.capacity());
 
     narrowPhaseInfos.clear(true);
+    triangles.clear(true);
 }
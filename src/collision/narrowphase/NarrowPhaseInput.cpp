@@ -33,7 +33,8 @@ NarrowPhaseInput::NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs&
     :mSphereVsSphereBatch(overlappingPairs, allocator), mSphereVsCapsuleBatch(overlappingPairs, allocator),
      mCapsuleVsCapsuleBatch(overlappingPairs, allocator), mSphereVsConvexPolyhedronBatch(overlappingPairs, allocator),
      mCapsuleVsConvexPolyhedronBatch(overlappingPairs, allocator),
-     mConvexPolyhedronVsConvexPolyhedronBatch(overlappingPairs, allocator) {
+     mConvexPolyhedronVsConvexPolyhedronBatch(overlappingPairs, allocator), mSphereVsTriangleBatch(overlappingPairs, allocator),
+     mBoxVsBoxBatch(overlappingPairs, allocator), mConvexPolyhedronVsConvexPolyhedronEPABatch(overlappingPairs, allocator) {
 
 }
 
@@ -46,6 +47,9 @@ void NarrowPhaseInput::reserveMemory() {
     mSphereVsConvexPolyhedronBatch.reserveMemory();
     mCapsuleVsConvexPolyhedronBatch.reserveMemory();
     mConvexPolyhedronVsConvexPolyhedronBatch.reserveMemory();
+    mSphereVsTriangleBatch.reserveMemory();
+    mBoxVsBoxBatch.reserveMemory();
+    mConvexPolyhedronVsConvexPolyhedronEPABatch.reserveMemory();
 }
 
 // Clear
@@ -57,4 +61,7 @@ void NarrowPhaseInput::clear() {
     mSphereVsConvexPolyhedronBatch.clear();
     mCapsuleVsConvexPolyhedronBatch.clear();
     mConvexPolyhedronVsConvexPolyhedronBatch.clear();
+    mSphereVsTriangleBatch.clear();
+    mBoxVsBoxBatch.clear();
+    mConvexPolyhedronVsConvexPolyhedronEPABatch.clear();
 }
@@ -28,10 +28,12 @@
 #include <reactphysics3d/constraint/ContactPoint.h>
 #include <reactphysics3d/collision/PolyhedronMesh.h>
 #include <reactphysics3d/collision/shapes/CapsuleShape.h>
+#include <reactphysics3d/collision/shapes/ConvexMeshShape.h>
 #include <reactphysics3d/collision/shapes/SphereShape.h>
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/containers/SmallArray.h>
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <cassert>
@@ -394,8 +396,8 @@ bool SATAlgorithm::computeCapsulePolyhedronFaceContactPoints(uint32 referenceFac
     uint32 firstEdgeIndex = face.edgeIndex;
     uint32 edgeIndex = firstEdgeIndex;
 
-    Array<Vector3> planesPoints(mMemoryAllocator, 2);
-    Array<Vector3> planesNormals(mMemoryAllocator, 2);
+    SmallArray<Vector3, 8> planesPoints(mMemoryAllocator);
+    SmallArray<Vector3, 8> planesNormals(mMemoryAllocator);
 
     // For each adjacent edge of the separating face of the polyhedron
     do {
@@ -484,6 +486,11 @@ bool SATAlgorithm::testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseIn
 
     bool isCollisionFound = false;
 
+    // Temporary buffers (in structure of arrays layout) reused for all the pairs of the batch
+    Array<decimal> facesBuffer(mMemoryAllocator);
+    Array<decimal> edgesGaussMapData(mMemoryAllocator);
+    Array<uint8> edgesBuildMinkowskiFace(mMemoryAllocator);
+
     for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
 
         assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
@@ -687,14 +694,24 @@ bool SATAlgorithm::testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseIn
         minPenetrationDepth = DECIMAL_LARGEST;
         isMinPenetrationFaceNormal = false;
 
+        // If both shapes are convex meshes, we test all the faces at once using their cached planes and vertices
+        const bool areBothConvexMeshes = polyhedron1->getName() == CollisionShapeName::CONVEX_MESH &&
+                                         polyhedron2->getName() == CollisionShapeName::CONVEX_MESH;
+        const ConvexMeshShape* convexMesh1 = static_cast<const ConvexMeshShape*>(polyhedron1);
+        const ConvexMeshShape* convexMesh2 = static_cast<const ConvexMeshShape*>(polyhedron2);
+
         // Test all the face normals of the polyhedron 1 for separating axis
         uint32 faceIndex1;
-        decimal penetrationDepth1 = testFacesDirectionPolyhedronVsPolyhedron(polyhedron1, polyhedron2, polyhedron1ToPolyhedron2, faceIndex1);
+        decimal penetrationDepth1 = areBothConvexMeshes ?
+                    testFacesDirectionConvexMeshVsConvexMesh(convexMesh1, convexMesh2, polyhedron2ToPolyhedron1, facesBuffer, faceIndex1) :
+                    testFacesDirectionPolyhedronVsPolyhedron(polyhedron1, polyhedron2, polyhedron1ToPolyhedron2, faceIndex1);
         if (penetrationDepth1 <= decimal(0.0)) {
 
             lastFrameCollisionInfo->satIsAxisFacePolyhedron1 = true;
             lastFrameCollisionInfo->satIsAxisFacePolyhedron2 = false;
             lastFrameCollisionInfo->satMinAxisFaceIndex = faceIndex1;
+            lastFrameCollisionInfo->separatingAxis = polyhedron1->getFaceNormal(faceIndex1);
+            lastFrameCollisionInfo->isSeparatingAxisValid = true;
 
             // We have found a separating axis
             continue;
@@ -702,12 +719,16 @@ bool SATAlgorithm::testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseIn
 
         // Test all the face normals of the polyhedron 2 for separating axis
         uint32 faceIndex2;
-        decimal penetrationDepth2 = testFacesDirectionPolyhedronVsPolyhedron(polyhedron2, polyhedron1, polyhedron2ToPolyhedron1, faceIndex2);
+        decimal penetrationDepth2 = areBothConvexMeshes ?
+                    testFacesDirectionConvexMeshVsConvexMesh(convexMesh2, convexMesh1, polyhedron1ToPolyhedron2, facesBuffer, faceIndex2) :
+                    testFacesDirectionPolyhedronVsPolyhedron(polyhedron2, polyhedron1, polyhedron2ToPolyhedron1, faceIndex2);
         if (penetrationDepth2 <= decimal(0.0)) {
 
             lastFrameCollisionInfo->satIsAxisFacePolyhedron1 = false;
             lastFrameCollisionInfo->satIsAxisFacePolyhedron2 = true;
             lastFrameCollisionInfo->satMinAxisFaceIndex = faceIndex2;
+            lastFrameCollisionInfo->separatingAxis = polyhedron2ToPolyhedron1.getOrientation() * (-polyhedron2->getFaceNormal(faceIndex2));
+            lastFrameCollisionInfo->isSeparatingAxisValid = true;
 
             // We have found a separating axis
             continue;
@@ -741,28 +762,40 @@ bool SATAlgorithm::testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseIn
 
         bool separatingAxisFound = false;
 
+        // Compute the Gauss map data of all the edges of polyhedron 2 once for the whole edges loop
+        const uint32 nbEdges2 = polyhedron2->getNbHalfEdges() / 2;
+        computeEdgesGaussMapData(polyhedron2, edgesGaussMapData);
+
         // Test the cross products of edges of polyhedron 1 with edges of polyhedron 2 for separating axis
         for (uint32 i=0; i < polyhedron1->getNbHalfEdges(); i += 2) {
 
             // Get an edge of polyhedron 1
             const HalfEdgeStructure::Edge& edge1 = polyhedron1->getHalfEdge(i);
+            const HalfEdgeStructure::Edge& twinEdge1 = polyhedron1->getHalfEdge(edge1.twinEdgeIndex);
 
             const Vector3 edge1A = polyhedron1ToPolyhedron2 * polyhedron1->getVertexPosition(edge1.vertexIndex);
             const Vector3 edge1B = polyhedron1ToPolyhedron2 * polyhedron1->getVertexPosition(polyhedron1->getHalfEdge(edge1.nextEdgeIndex).vertexIndex);
             const Vector3 edge1Direction = edge1B - edge1A;
 
-            for (uint32 j=0; j < polyhedron2->getNbHalfEdges(); j += 2) {
+            // Test the Gauss map arcs of this edge against the arcs of all the edges of polyhedron 2 at once
+            const Vector3 a = polyhedron1ToPolyhedron2.getOrientation() * polyhedron1->getFaceNormal(edge1.faceIndex);
+            const Vector3 b = polyhedron1ToPolyhedron2.getOrientation() * polyhedron1->getFaceNormal(twinEdge1.faceIndex);
+            const Vector3 bCrossA = polyhedron1ToPolyhedron2.getOrientation() * (polyhedron1->getVertexPosition(edge1.vertexIndex) -
+                                                                                 polyhedron1->getVertexPosition(twinEdge1.vertexIndex));
+            testGaussMapArcsIntersect(a, b, bCrossA, edgesGaussMapData, nbEdges2, edgesBuildMinkowskiFace);
 
-                // Get an edge of polyhedron 2
-                const HalfEdgeStructure::Edge& edge2 = polyhedron2->getHalfEdge(j);
-
-                const Vector3 edge2A = polyhedron2->getVertexPosition(edge2.vertexIndex);
-                const Vector3 edge2B = polyhedron2->getVertexPosition(polyhedron2->getHalfEdge(edge2.nextEdgeIndex).vertexIndex);
-                const Vector3 edge2Direction = edge2B - edge2A;
+            for (uint32 j=0; j < polyhedron2->getNbHalfEdges(); j += 2) {
 
                 // If the two edges build a minkowski face (and the cross product is
                 // therefore a candidate for separating axis
-                if (testEdgesBuildMinkowskiFace(polyhedron1, edge1, polyhedron2, edge2, polyhedron1ToPolyhedron2)) {
+                if (edgesBuildMinkowskiFace[j / 2]) {
+
+                    // Get an edge of polyhedron 2
+                    const HalfEdgeStructure::Edge& edge2 = polyhedron2->getHalfEdge(j);
+
+                    const Vector3 edge2A = polyhedron2->getVertexPosition(edge2.vertexIndex);
+                    const Vector3 edge2B = polyhedron2->getVertexPosition(polyhedron2->getHalfEdge(edge2.nextEdgeIndex).vertexIndex);
+                    const Vector3 edge2Direction = edge2B - edge2A;
 
                     Vector3 separatingAxisPolyhedron2Space;
 
@@ -777,6 +810,8 @@ bool SATAlgorithm::testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseIn
                         lastFrameCollisionInfo->satIsAxisFacePolyhedron2 = false;
                         lastFrameCollisionInfo->satMinEdge1Index = i;
                         lastFrameCollisionInfo->satMinEdge2Index = j;
+                        lastFrameCollisionInfo->separatingAxis = polyhedron2ToPolyhedron1.getOrientation() * separatingAxisPolyhedron2Space;
+                        lastFrameCollisionInfo->isSeparatingAxisValid = true;
 
                         // We have found a separating axis
                         separatingAxisFound = true;
@@ -790,7 +825,7 @@ bool SATAlgorithm::testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseIn
                     // the face contact and do not generate an edge-edge contact. However, if the new penetration depth from the edge-edge contact is really smaller than
                     // the current one, we generate an edge-edge contact.
                     // To do this, we use a relative and absolute bias to increase a little bit the new penetration depth from the edge-edge contact during the comparison test
-                    if ((isMinPenetrationFaceNormal && penetrationDepth1 * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE < minPenetrationDepth) ||
+                    if ((isMinPenetrationFaceNormal && penetrationDepth * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE < minPenetrationDepth) ||
                         (!isMinPenetrationFaceNormal && penetrationDepth < minPenetrationDepth)) {
 
                         minPenetrationDepth = penetrationDepth;
@@ -926,8 +961,10 @@ bool SATAlgorithm::computePolyhedronVsPolyhedronFaceContactPoints(bool isMinPene
 
     const uint32 nbIncidentFaceVertices = static_cast<uint32>(incidentFace.faceVertices.size());
     const uint32 nbMaxElements = nbIncidentFaceVertices * 2 * static_cast<uint32>(referenceFace.faceVertices.size());
-    Array<Vector3> verticesTemp1(mMemoryAllocator, nbMaxElements);
-    Array<Vector3> verticesTemp2(mMemoryAllocator, nbMaxElements);
+    SmallArray<Vector3, 32> verticesTemp1(mMemoryAllocator);
+    SmallArray<Vector3, 32> verticesTemp2(mMemoryAllocator);
+    verticesTemp1.reserve(nbMaxElements);
+    verticesTemp2.reserve(nbMaxElements);
 
     // Get all the vertices of the incident face (in the reference local-space)
     for (uint32 i=0; i < nbIncidentFaceVertices; i++) {
@@ -1138,6 +1175,158 @@ decimal SATAlgorithm::testFacesDirectionPolyhedronVsPolyhedron(const ConvexPolyh
     return minPenetrationDepth;
 }
 
+// Test all the face normals of a convex mesh against all the vertices of another convex mesh
+/// This is the same test as testFacesDirectionPolyhedronVsPolyhedron() but it uses the planes and vertices
+/// cached by the convex meshes in a structure of arrays layout. The vertices of the second mesh are first
+/// transformed into the local-space of the first mesh and then the faces are tested against all the vertices
+/// with contiguous loops without branches that can be vectorized by the compiler.
+decimal SATAlgorithm::testFacesDirectionConvexMeshVsConvexMesh(const ConvexMeshShape* mesh1, const ConvexMeshShape* mesh2,
+                                                               const Transform& mesh2ToMesh1, Array<decimal>& buffer,
+                                                               uint& minFaceIndex) const {
+
+    RP3D_PROFILE("SATAlgorithm::testFacesDirectionConvexMeshVsConvexMesh", mProfiler);
+
+    const uint32 nbFaces = mesh1->getNbFaces();
+    const uint32 nbVertices = mesh2->getNbVertices();
+
+    // The buffer contains the vertices of mesh 2 in mesh 1 space followed by
+    // the minimum projection of those vertices on each face normal of mesh 1
+    buffer.clear();
+    buffer.addWithoutInit(3 * nbVertices + nbFaces);
+    decimal* verticesX = &(buffer[0]);
+    decimal* verticesY = verticesX + nbVertices;
+    decimal* verticesZ = verticesY + nbVertices;
+    decimal* minProjections = verticesZ + nbVertices;
+
+    const decimal* facesPlanes = mesh1->getFacesPlanes();
+    const decimal* normalsX = facesPlanes;
+    const decimal* normalsY = normalsX + nbFaces;
+    const decimal* normalsZ = normalsY + nbFaces;
+    const decimal* offsets = normalsZ + nbFaces;
+
+    const decimal* mesh2VerticesX = mesh2->getVerticesCoordinates();
+    const decimal* mesh2VerticesY = mesh2VerticesX + nbVertices;
+    const decimal* mesh2VerticesZ = mesh2VerticesY + nbVertices;
+
+    // Transform the vertices of mesh 2 into the local-space of mesh 1
+    const Matrix3x3 rotation = mesh2ToMesh1.getOrientation().getMatrix();
+    const Vector3& translation = mesh2ToMesh1.getPosition();
+    for (uint32 v=0; v < nbVertices; v++) {
+        verticesX[v] = rotation[0][0] * mesh2VerticesX[v] + rotation[0][1] * mesh2VerticesY[v] + rotation[0][2] * mesh2VerticesZ[v] + translation.x;
+        verticesY[v] = rotation[1][0] * mesh2VerticesX[v] + rotation[1][1] * mesh2VerticesY[v] + rotation[1][2] * mesh2VerticesZ[v] + translation.y;
+        verticesZ[v] = rotation[2][0] * mesh2VerticesX[v] + rotation[2][1] * mesh2VerticesY[v] + rotation[2][2] * mesh2VerticesZ[v] + translation.z;
+    }
+
+    // Compute the minimum projection of the vertices of mesh 2 on each face normal of mesh 1
+    for (uint32 f=0; f < nbFaces; f++) {
+        minProjections[f] = DECIMAL_LARGEST;
+    }
+    for (uint32 v=0; v < nbVertices; v++) {
+
+        const decimal x = verticesX[v];
+        const decimal y = verticesY[v];
+        const decimal z = verticesZ[v];
+
+        for (uint32 f=0; f < nbFaces; f++) {
+            const decimal projection = normalsX[f] * x + normalsY[f] * y + normalsZ[f] * z;
+            minProjections[f] = projection < minProjections[f] ? projection : minProjections[f];
+        }
+    }
+
+    decimal minPenetrationDepth = DECIMAL_LARGEST;
+
+    // For each face of the first mesh
+    for (uint32 f = 0; f < nbFaces; f++) {
+
+        const decimal penetrationDepth = offsets[f] - minProjections[f];
+
+        // If the penetration depth is negative, we have found a separating axis
+        if (penetrationDepth <= decimal(0.0)) {
+            minFaceIndex = f;
+            return penetrationDepth;
+        }
+
+        // Check if we have found a new minimum penetration axis
+        if (penetrationDepth < minPenetrationDepth) {
+            minPenetrationDepth = penetrationDepth;
+            minFaceIndex = f;
+        }
+    }
+
+    return minPenetrationDepth;
+}
+
+// Compute the Gauss map data of the edges of the second polyhedron in a structure of arrays layout
+/// For each edge of the polyhedron, we store the negated normals of its two adjacent faces (C and D) and the
+/// vector D x C (computed using the edge direction). Those values only depend on the second polyhedron and
+/// can therefore be computed once and tested against all the edges of the first polyhedron.
+void SATAlgorithm::computeEdgesGaussMapData(const ConvexPolyhedronShape* polyhedron2, Array<decimal>& edgesData) const {
+
+    const uint32 nbEdges = polyhedron2->getNbHalfEdges() / 2;
+
+    edgesData.clear();
+    edgesData.addWithoutInit(9 * nbEdges);
+
+    for (uint32 e=0; e < nbEdges; e++) {
+
+        const HalfEdgeStructure::Edge& edge = polyhedron2->getHalfEdge(2 * e);
+        const HalfEdgeStructure::Edge& twinEdge = polyhedron2->getHalfEdge(edge.twinEdgeIndex);
+
+        // Note that we negate the normals of the second polyhedron because we are looking at the
+        // Gauss map of the minkowski difference of the polyhedrons
+        const Vector3 c = -polyhedron2->getFaceNormal(edge.faceIndex);
+        const Vector3 d = -polyhedron2->getFaceNormal(twinEdge.faceIndex);
+        const Vector3 dCrossC = polyhedron2->getVertexPosition(edge.vertexIndex) - polyhedron2->getVertexPosition(twinEdge.vertexIndex);
+
+        edgesData[e] = c.x;
+        edgesData[nbEdges + e] = c.y;
+        edgesData[2 * nbEdges + e] = c.z;
+        edgesData[3 * nbEdges + e] = d.x;
+        edgesData[4 * nbEdges + e] = d.y;
+        edgesData[5 * nbEdges + e] = d.z;
+        edgesData[6 * nbEdges + e] = dCrossC.x;
+        edgesData[7 * nbEdges + e] = dCrossC.y;
+        edgesData[8 * nbEdges + e] = dCrossC.z;
+    }
+}
+
+// Test the Gauss map arcs of an edge of the first polyhedron against all the edges of the second polyhedron
+/// This is the same test as testGaussMapArcsIntersect() for a single pair of arcs but the arc AB of the edge of the
+/// first polyhedron is tested against all the arcs CD of the second polyhedron with a loop without branches.
+/// The output array contains 1 for each edge of the second polyhedron that builds a minkowski face with the edge.
+void SATAlgorithm::testGaussMapArcsIntersect(const Vector3& a, const Vector3& b, const Vector3& bCrossA,
+                                             const Array<decimal>& edgesData, uint32 nbEdges2,
+                                             Array<uint8>& outBuildMinkowskiFace) const {
+
+    RP3D_PROFILE("SATAlgorithm::testGaussMapArcsIntersect", mProfiler);
+
+    outBuildMinkowskiFace.clear();
+    outBuildMinkowskiFace.addWithoutInit(nbEdges2);
+
+    if (nbEdges2 == 0) return;
+
+    const decimal* cX = &(edgesData[0]);
+    const decimal* cY = cX + nbEdges2;
+    const decimal* cZ = cY + nbEdges2;
+    const decimal* dX = cZ + nbEdges2;
+    const decimal* dY = dX + nbEdges2;
+    const decimal* dZ = dY + nbEdges2;
+    const decimal* dCrossCX = dZ + nbEdges2;
+    const decimal* dCrossCY = dCrossCX + nbEdges2;
+    const decimal* dCrossCZ = dCrossCY + nbEdges2;
+    uint8* buildMinkowskiFace = &(outBuildMinkowskiFace[0]);
+
+    for (uint32 e=0; e < nbEdges2; e++) {
+
+        const decimal cba = cX[e] * bCrossA.x + cY[e] * bCrossA.y + cZ[e] * bCrossA.z;
+        const decimal dba = dX[e] * bCrossA.x + dY[e] * bCrossA.y + dZ[e] * bCrossA.z;
+        const decimal adc = a.x * dCrossCX[e] + a.y * dCrossCY[e] + a.z * dCrossCZ[e];
+        const decimal bdc = b.x * dCrossCX[e] + b.y * dCrossCY[e] + b.z * dCrossCZ[e];
+
+        buildMinkowskiFace[e] = uint8(cba * dba < decimal(0.0)) & uint8(adc * bdc < decimal(0.0)) & uint8(cba * bdc > decimal(0.0));
+    }
+}
+
 
 // Return true if two edges of two polyhedrons build a minkowski face (and can therefore be a separating axis)
 bool SATAlgorithm::testEdgesBuildMinkowskiFace(const ConvexPolyhedronShape* polyhedron1, const HalfEdgeStructure::Edge& edge1,
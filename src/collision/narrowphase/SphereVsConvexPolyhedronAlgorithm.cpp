@@ -28,6 +28,9 @@
 #include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/SAT/SATAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/shapes/SphereShape.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/utils/Profiler.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -101,3 +104,93 @@ bool SphereVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoBatch& narr
 
     return isCollisionFound;
 }
+
+// Compute the narrow-phase collision detection between a sphere and a triangle of a concave shape
+/// The triangles of the batch are not TriangleShape objects but the triangles stored in the batch. The
+/// contact is computed with the point of the triangle that is closest to the center of the sphere and
+/// the contact normal is smoothed with the vertices normals of the triangle as for a TriangleShape.
+bool SphereVsConvexPolyhedronAlgorithm::testCollisionVsTriangles(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex,
+                                                                 uint32 batchNbItems) {
+
+    RP3D_PROFILE("SphereVsConvexPolyhedronAlgorithm::testCollisionVsTriangles()", mProfiler);
+
+    bool isCollisionFound = false;
+
+    // For each item in the batch
+    for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
+
+        NarrowPhaseInfoBatch::NarrowPhaseInfo& narrowPhaseInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex];
+        const NarrowPhaseTriangle& triangle = narrowPhaseInfoBatch.triangles[batchIndex];
+
+        assert(narrowPhaseInfo.nbContactPoints == 0);
+        assert(!narrowPhaseInfo.isColliding);
+
+        // The collision shape of the triangle is nullptr
+        const bool isSphereShape1 = narrowPhaseInfo.collisionShape1 != nullptr;
+        const SphereShape* sphereShape = static_cast<const SphereShape*>(isSphereShape1 ? narrowPhaseInfo.collisionShape1 : narrowPhaseInfo.collisionShape2);
+        assert(sphereShape->getType() == CollisionShapeType::SPHERE);
+
+        const Transform& sphereToWorldTransform = isSphereShape1 ? narrowPhaseInfo.shape1ToWorldTransform : narrowPhaseInfo.shape2ToWorldTransform;
+        const Transform& triangleToWorldTransform = isSphereShape1 ? narrowPhaseInfo.shape2ToWorldTransform : narrowPhaseInfo.shape1ToWorldTransform;
+
+        narrowPhaseInfo.lastFrameCollisionInfo->wasUsingGJK = false;
+        narrowPhaseInfo.lastFrameCollisionInfo->wasUsingSAT = false;
+
+        // Ignore the degenerate triangles
+        Vector3 triangleNormal = (triangle.vertices[1] - triangle.vertices[0]).cross(triangle.vertices[2] - triangle.vertices[0]);
+        if (triangleNormal.lengthSquare() < MACHINE_EPSILON) continue;
+        triangleNormal.normalize();
+
+        // Compute the point of the triangle that is closest to the center of the sphere (in the local-space of the triangle)
+        const Vector3 sphereCenter = triangleToWorldTransform.getInverse() * sphereToWorldTransform.getPosition();
+        const Vector3 closestPoint = computeClosestPointOnTriangle(triangle.vertices[0], triangle.vertices[1], triangle.vertices[2], sphereCenter);
+
+        const Vector3 closestPointToCenter = sphereCenter - closestPoint;
+        const decimal distanceSquare = closestPointToCenter.lengthSquare();
+        const decimal radius = sphereShape->getRadius();
+
+        // If the sphere does not overlap the triangle
+        if (distanceSquare >= radius * radius) continue;
+
+        const decimal distance = std::sqrt(distanceSquare);
+        const decimal penetrationDepth = radius - distance;
+
+        // Make sure the penetration depth is not zero because of precision issues
+        if (penetrationDepth <= decimal(0.0)) continue;
+
+        narrowPhaseInfo.isColliding = true;
+        isCollisionFound = true;
+
+        // If we need to report contacts
+        if (narrowPhaseInfo.reportContacts) {
+
+            // Penetration axis from the triangle to the sphere (the triangle normal if the center
+            // of the sphere is on the triangle)
+            const Vector3 penetrationAxis = distance > MACHINE_EPSILON ? closestPointToCenter / distance : triangleNormal;
+
+            // Get the smooth contact normal of the mesh at the contact point on the triangle in
+            // the direction out of the colliding face of the triangle
+            Vector3 localNormal = TriangleShape::computeSmoothLocalContactNormal(triangle.vertices, triangleNormal, triangle.verticesNormals,
+                                                                                 triangle.internalEdges, closestPoint);
+            if (localNormal.dot(penetrationAxis) < decimal(0.0)) {
+                localNormal = -localNormal;
+            }
+
+            // Align the contact point on the sphere along the contact normal
+            const Vector3 spherePoint = sphereToWorldTransform.getInverse() * (triangleToWorldTransform * (closestPoint - localNormal * penetrationDepth));
+
+            // Contact normal from the shape 1 to the shape 2
+            const Vector3 worldNormal = triangleToWorldTransform.getOrientation() * localNormal;
+
+            // Add the contact point
+            if (isSphereShape1) {
+                narrowPhaseInfoBatch.addContactPoint(batchIndex, -worldNormal, penetrationDepth, spherePoint, closestPoint);
+            }
+            else {
+                narrowPhaseInfoBatch.addContactPoint(batchIndex, worldNormal, penetrationDepth, closestPoint, spherePoint);
+            }
+        }
+    }
+
+    return isCollisionFound;
+}
@@ -36,3 +36,37 @@ AABB::AABB(const Vector3& minCoordinates, const Vector3& maxCoordinates)
      :mMinCoordinates(minCoordinates), mMaxCoordinates(maxCoordinates) {
 
 }
+
+// Replace the AABB by the AABB of its transformed box
+void AABB::applyTransform(const Transform& transform) {
+
+    const Vector3& translation = transform.getPosition();
+    const Matrix3x3 matrix = transform.getOrientation().getMatrix();
+    Vector3 resultMin;
+    Vector3 resultMax;
+
+    // For each of the three axis
+    for (int i=0; i<3; i++) {
+
+        // Add translation component
+        resultMin[i] = translation[i];
+        resultMax[i] = translation[i];
+
+        for (int j=0; j<3; j++) {
+            decimal e = matrix[i][j] * mMinCoordinates[j];
+            decimal f = matrix[i][j] * mMaxCoordinates[j];
+
+            if (e < f) {
+                resultMin[i] += e;
+                resultMax[i] += f;
+            }
+            else {
+                resultMin[i] += f;
+                resultMax[i] += e;
+            }
+        }
+    }
+
+    mMinCoordinates = resultMin;
+    mMaxCoordinates = resultMax;
+}
@@ -61,36 +61,9 @@ void CollisionShape::computeAABB(AABB& aabb, const Transform& transform) const {
     Vector3 maxBounds;
     getLocalBounds(minBounds, maxBounds);
 
-    const Vector3& translation = transform.getPosition();
-    Matrix3x3 matrix = transform.getOrientation().getMatrix();
-    Vector3 resultMin;
-    Vector3 resultMax;
-
-    // For each of the three axis
-    for (int i=0; i<3; i++) {
-
-        // Add translation component
-        resultMin[i] = translation[i];
-        resultMax[i] = translation[i];
-
-        for (int j=0; j<3; j++) {
-            decimal e = matrix[i][j] * minBounds[j];
-            decimal f = matrix[i][j] * maxBounds[j];
-
-            if (e < f) {
-                resultMin[i] += e;
-                resultMax[i] += f;
-            }
-            else {
-                resultMin[i] += f;
-                resultMax[i] += e;
-            }
-        }
-    }
-
-    // Update the AABB with the new minimum and maximum coordinates
-    aabb.setMin(resultMin);
-    aabb.setMax(resultMax);
+    aabb.setMin(minBounds);
+    aabb.setMax(maxBounds);
+    aabb.applyTransform(transform);
 }
 
 /// Notify all the assign colliders that the size of the collision shape has changed
@@ -101,3 +74,15 @@ void CollisionShape::notifyColliderAboutChangedSize() {
         mColliders[i]->setHasCollisionShapeChangedSize(true);
     }
 }
+
+/// Notify all the assign colliders that a region of the collision shape has been modified
+/**
+ * @param localRegionAABB AABB of the modified region in the local-space of the collision shape
+ */
+void CollisionShape::notifyColliderAboutChangedRegion(const AABB& localRegionAABB) {
+
+    const uint32 nbColliders = static_cast<uint32>(mColliders.size());
+    for (uint32 i=0; i < nbColliders; i++) {
+        mColliders[i]->setHasCollisionShapeChangedRegion(localRegionAABB);
+    }
+}
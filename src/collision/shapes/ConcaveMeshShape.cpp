@@ -30,56 +30,158 @@
 #include <reactphysics3d/collision/TriangleMesh.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/collision/TriangleVertexArray.h>
+#include <cstring>
+#include <cstdint>
 
 using namespace reactphysics3d;
 
+// Initialization of static variables
+const uint32 ConcaveMeshShape::BVH_DATA_MAGIC_NUMBER = 0x52503342;
+const uint32 ConcaveMeshShape::BVH_DATA_VERSION = 2;
+
 // Constructor
-ConcaveMeshShape::ConcaveMeshShape(TriangleMesh* triangleMesh, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure, const Vector3& scaling)
-                 : ConcaveShape(CollisionShapeName::TRIANGLE_MESH, allocator, scaling), mDynamicAABBTree(allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+/// If the "bvhData" parameter is not null, it must point to valid serialized BVH data
+/// for the triangle mesh (see isBVHDataValid()). This data is used directly (without copy)
+/// and must remain valid during the lifetime of the shape. Otherwise, the BVH of a cooked
+/// mesh is used directly and the BVH is built for a mesh that is not cooked.
+ConcaveMeshShape::ConcaveMeshShape(TriangleMesh* triangleMesh, MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure,
+                                   const Vector3& scaling, const void* bvhData)
+                 : ConcaveShape(CollisionShapeName::TRIANGLE_MESH, allocator, scaling), mStaticAABBTree(allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
     mTriangleMesh = triangleMesh;
     mRaycastTestType = TriangleRaycastSide::FRONT;
 
-    // Insert all the triangles into the dynamic AABB tree
-    initBVHTree();
+    if (bvhData != nullptr) {
+
+        // Use the BVH that has been built offline
+        initBVHTreeFromData(bvhData);
+    }
+    else if (triangleMesh->isCooked()) {
+
+        // Use the BVH of the cooked mesh
+        const StaticAABBTree& cookedBVH = triangleMesh->getCookedBVH();
+        mStaticAABBTree.setExternalNodes(cookedBVH.getNodes(), cookedBVH.getNbNodes(), cookedBVH.getRootAABB());
+    }
+    else {
+
+        // Build the BVH with all the triangles of the mesh
+        initBVHTree(allocator);
+    }
 }
 
-// Insert all the triangles into the dynamic AABB tree
-void ConcaveMeshShape::initBVHTree() {
+// Build the dynamic AABB tree with all the triangles of the mesh
+void ConcaveMeshShape::initBVHTree(MemoryAllocator& allocator) {
 
-    // TODO : Try to randomly add the triangles into the tree to obtain a better tree
+    const uint32 nbTriangles = mTriangleMesh->getNbTriangles();
+
+    Array<AABB> trianglesAABBs(allocator, nbTriangles);
 
     // For each sub-part of the mesh
     for (uint32 subPart=0; subPart<mTriangleMesh->getNbSubparts(); subPart++) {
 
-        // Get the triangle vertex array of the current sub-part
-        TriangleVertexArray* triangleVertexArray = mTriangleMesh->getSubpart(subPart);
-
         // For each triangle of the concave mesh
-        for (uint32 triangleIndex=0; triangleIndex<triangleVertexArray->getNbTriangles(); triangleIndex++) {
+        for (uint32 triangleIndex=0; triangleIndex<mTriangleMesh->getNbTriangles(subPart); triangleIndex++) {
 
             Vector3 trianglePoints[3];
 
             // Get the triangle vertices
-            triangleVertexArray->getTriangleVertices(triangleIndex, trianglePoints);
-
-            // Create the AABB for the triangle
-            AABB aabb = AABB::createAABBForTriangle(trianglePoints);
+            mTriangleMesh->getTriangleVertices(subPart, triangleIndex, trianglePoints);
 
-            // Add the AABB with the index of the triangle into the dynamic AABB tree
-            mDynamicAABBTree.addObject(aabb, subPart, triangleIndex);
+            // Create the AABB for the triangle (the index of the AABB in the array is the index
+            // of the triangle in the whole mesh)
+            trianglesAABBs.add(AABB::createAABBForTriangle(trianglePoints));
         }
     }
+
+    // Build the tree with the surface area heuristic
+    mStaticAABBTree.build(nbTriangles > 0 ? &(trianglesAABBs[0]) : nullptr, static_cast<int32>(nbTriangles));
+}
+
+// Initialize the dynamic AABB tree using serialized BVH data (without copying it)
+void ConcaveMeshShape::initBVHTreeFromData(const void* bvhData) {
+
+    const BVHDataHeader* header = static_cast<const BVHDataHeader*>(bvhData);
+    const QuantizedTreeNode* nodes = reinterpret_cast<const QuantizedTreeNode*>(static_cast<const uint8*>(bvhData) + sizeof(BVHDataHeader));
+
+    mStaticAABBTree.setExternalNodes(nodes, header->nbNodes, header->rootAABB);
+}
+
+// Return true if the serialized BVH data can be used with a given triangle mesh
+/// The data must have been written by writeBVHData() with the same version of the library,
+/// the same platform and the same decimal precision, for a mesh with the same triangles.
+/// The data must also be aligned in memory for the nodes of the tree. Each node of the tree is
+/// checked such that corrupted data cannot make a query read outside of the nodes or the mesh.
+bool ConcaveMeshShape::isBVHDataValid(const TriangleMesh* triangleMesh, const void* bvhData, size_t bvhDataSize) {
+
+    if (bvhData == nullptr || bvhDataSize < sizeof(BVHDataHeader)) return false;
+    if (reinterpret_cast<std::uintptr_t>(bvhData) % alignof(QuantizedTreeNode) != 0) return false;
+
+    const BVHDataHeader* header = static_cast<const BVHDataHeader*>(bvhData);
+    if (header->magicNumber != BVH_DATA_MAGIC_NUMBER || header->version != BVH_DATA_VERSION ||
+        header->decimalSize != sizeof(decimal) || header->nodeSize != sizeof(QuantizedTreeNode)) {
+        return false;
+    }
+
+    const uint32 nbTriangles = triangleMesh->getNbTriangles();
+    if (header->nbSubparts != triangleMesh->getNbSubparts() || header->nbTriangles != nbTriangles) {
+        return false;
+    }
+
+    // A tree with one leaf per triangle has 2n-1 nodes
+    if (nbTriangles == 0 || header->nbNodes != static_cast<int32>(2 * nbTriangles - 1)) return false;
+
+    if (bvhDataSize < sizeof(BVHDataHeader) + static_cast<size_t>(header->nbNodes) * sizeof(QuantizedTreeNode)) return false;
+
+    // The nodes are used as they are by the tree. Therefore, they must only reference valid nodes and triangles.
+    return StaticAABBTree::areNodesValid(static_cast<const uint8*>(bvhData) + sizeof(BVHDataHeader), header->nbNodes,
+                                         static_cast<int32>(nbTriangles));
+}
+
+// Return the size (in bytes) of the serialized BVH data of the mesh
+size_t ConcaveMeshShape::getBVHDataSize() const {
+    return sizeof(BVHDataHeader) + static_cast<size_t>(mStaticAABBTree.getNbNodes()) * sizeof(QuantizedTreeNode);
+}
+
+// Serialize the BVH of the mesh into a buffer
+/// The BVH data contains a small header followed by the array of quantized nodes of the
+/// tree. The leaf nodes of the tree store the index of their triangle in the whole mesh. This data can be
+/// written to a file offline and used later to create a ConcaveMeshShape for the same mesh
+/// without building the tree (see PhysicsCommon::createConcaveMeshShape()). The data does
+/// not depend on the scaling of the shape.
+/**
+ * @param buffer Pointer to the buffer where to write the BVH data
+ * @param bufferSize Size (in bytes) of the buffer (see getBVHDataSize())
+ * @return The number of bytes written or zero if the buffer is too small
+ */
+size_t ConcaveMeshShape::writeBVHData(void* buffer, size_t bufferSize) const {
+
+    const size_t dataSize = getBVHDataSize();
+    if (buffer == nullptr || bufferSize < dataSize) {
+        return 0;
+    }
+
+    BVHDataHeader header;
+    header.magicNumber = BVH_DATA_MAGIC_NUMBER;
+    header.version = BVH_DATA_VERSION;
+    header.decimalSize = sizeof(decimal);
+    header.nodeSize = sizeof(QuantizedTreeNode);
+    header.nbSubparts = mTriangleMesh->getNbSubparts();
+    header.nbTriangles = mTriangleMesh->getNbTriangles();
+    header.nbNodes = mStaticAABBTree.getNbNodes();
+    header.rootAABB = mStaticAABBTree.getRootAABB();
+
+    uint8* bytes = static_cast<uint8*>(buffer);
+    std::memcpy(bytes, &header, sizeof(BVHDataHeader));
+    std::memcpy(bytes + sizeof(BVHDataHeader), mStaticAABBTree.getNodes(), static_cast<size_t>(header.nbNodes) * sizeof(QuantizedTreeNode));
+
+    return dataSize;
 }
 
 // Return the three vertices coordinates (in the array outTriangleVertices) of a triangle
 void ConcaveMeshShape::getTriangleVertices(uint32 subPart, uint32 triangleIndex, Vector3* outTriangleVertices) const {
 
-    // Get the triangle vertex array of the current sub-part
-    TriangleVertexArray* triangleVertexArray = mTriangleMesh->getSubpart(subPart);
-
     // Get the vertices coordinates of the triangle
-    triangleVertexArray->getTriangleVertices(triangleIndex, outTriangleVertices);
+    mTriangleMesh->getTriangleVertices(subPart, triangleIndex, outTriangleVertices);
 
     // Apply the scaling factor to the vertices
     outTriangleVertices[0].x *= mScale.x;
@@ -96,21 +198,15 @@ void ConcaveMeshShape::getTriangleVertices(uint32 subPart, uint32 triangleIndex,
 // Return the three vertex normals (in the array outVerticesNormals) of a triangle
 void ConcaveMeshShape::getTriangleVerticesNormals(uint32 subPart, uint32 triangleIndex, Vector3* outVerticesNormals) const {
 
-    // Get the triangle vertex array of the current sub-part
-    TriangleVertexArray* triangleVertexArray = mTriangleMesh->getSubpart(subPart);
-
     // Get the vertices normals of the triangle
-    triangleVertexArray->getTriangleVerticesNormals(triangleIndex, outVerticesNormals);
+    mTriangleMesh->getTriangleVerticesNormals(subPart, triangleIndex, outVerticesNormals);
 }
 
 // Return the indices of the three vertices of a given triangle in the array
 void ConcaveMeshShape::getTriangleVerticesIndices(uint32 subPart, uint32 triangleIndex, uint32* outVerticesIndices) const {
 
-    // Get the triangle vertex array of the current sub-part
-    TriangleVertexArray* triangleVertexArray = mTriangleMesh->getSubpart(subPart);
-
-    // Get the vertices normals of the triangle
-    triangleVertexArray->getTriangleVerticesIndices(triangleIndex, outVerticesIndices);
+    // Get the vertices indices of the triangle
+    mTriangleMesh->getTriangleVerticesIndices(subPart, triangleIndex, outVerticesIndices);
 }
 
 // Return the number of sub parts contained in this mesh
@@ -122,13 +218,13 @@ uint32 ConcaveMeshShape::getNbSubparts() const
 // Return the number of triangles in a sub part of the mesh
 uint32 ConcaveMeshShape::getNbTriangles(uint32 subPart) const
 {
-	assert(mTriangleMesh->getSubpart(subPart));
-	return mTriangleMesh->getSubpart(subPart)->getNbTriangles();
+	return mTriangleMesh->getNbTriangles(subPart);
 }
 
 // Compute all the triangles of the mesh that are overlapping with the AABB in parameter
 void ConcaveMeshShape::computeOverlappingTriangles(const AABB& localAABB, Array<Vector3>& triangleVertices,
                                                    Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
+                                                   Array<uint8>& trianglesInternalEdges,
                                                    MemoryAllocator& allocator) const {
 
     RP3D_PROFILE("ConcaveMeshShape::computeOverlappingTriangles()", mProfiler);
@@ -138,32 +234,55 @@ void ConcaveMeshShape::computeOverlappingTriangles(const AABB& localAABB, Array<
     AABB aabb(localAABB);
     aabb.applyScale(Vector3(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z));
 
-    // Compute the nodes of the internal AABB tree that are overlapping with the AABB
-    Array<int> overlappingNodes(allocator, 64);
-    mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+    // Compute the triangles of the internal AABB tree that are overlapping with the AABB
+    Array<int32> overlappingTriangles(allocator, 64);
+    mStaticAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingTriangles);
 
-    const uint32 nbOverlappingNodes = static_cast<uint32>(overlappingNodes.size());
+    const uint32 nbOverlappingTriangles = static_cast<uint32>(overlappingTriangles.size());
 
     // Add space in the array of triangles vertices/normals for the new triangles
-    triangleVertices.addWithoutInit(nbOverlappingNodes * 3);
-    triangleVerticesNormals.addWithoutInit(nbOverlappingNodes * 3);
+    triangleVertices.addWithoutInit(nbOverlappingTriangles * 3);
+    triangleVerticesNormals.addWithoutInit(nbOverlappingTriangles * 3);
+    shapeIds.reserve(shapeIds.size() + nbOverlappingTriangles);
+    trianglesInternalEdges.reserve(trianglesInternalEdges.size() + nbOverlappingTriangles);
+
+    const uint32 firstTriangle = static_cast<uint32>(triangleVertices.size()) / 3 - nbOverlappingTriangles;
+    const CompressedTriangleArray* compressedTriangles = mTriangleMesh->getCompressedTriangles();
 
-    // For each overlapping node
-    for (uint32 i=0; i < nbOverlappingNodes; i++) {
+    // For each overlapping triangle
+    for (uint32 i=0; i < nbOverlappingTriangles; i++) {
 
-        int nodeId = overlappingNodes[i];
+        const uint32 triangleId = static_cast<uint32>(overlappingTriangles[i]);
+        Vector3* vertices = &(triangleVertices[(firstTriangle + i) * 3]);
+        Vector3* verticesNormals = &(triangleVerticesNormals[(firstTriangle + i) * 3]);
 
-        // Get the node data (triangle index and mesh subpart index)
-        int32* data = mDynamicAABBTree.getNodeDataInt(nodeId);
+        if (compressedTriangles != nullptr) {
 
-        // Get the triangle vertices for this node from the concave mesh shape
-        getTriangleVertices(data[0], data[1], &(triangleVertices[i * 3]));
+            // The index of the triangle in the whole mesh is its index in the compressed triangles
+            compressedTriangles->getTriangleVertices(triangleId, vertices);
+            compressedTriangles->getTriangleVerticesNormals(triangleId, verticesNormals);
+        }
+        else {
+
+            // Get the mesh subpart and index of the triangle
+            uint32 subPart, triangleIndex;
+            getTriangleSubpartAndIndex(triangleId, subPart, triangleIndex);
+
+            // Get the triangle vertices and vertices normals from the triangle mesh
+            mTriangleMesh->getTriangleVertices(subPart, triangleIndex, vertices);
+            mTriangleMesh->getTriangleVerticesNormals(subPart, triangleIndex, verticesNormals);
+        }
 
-        // Get the vertices normals of the triangle
-        getTriangleVerticesNormals(data[0], data[1], &(triangleVerticesNormals[i * 3]));
+        // Apply the scaling of the shape
+        vertices[0] = vertices[0] * mScale;
+        vertices[1] = vertices[1] * mScale;
+        vertices[2] = vertices[2] * mScale;
 
-        // Compute the triangle shape ID
-        shapeIds.add(computeTriangleShapeId(data[0], data[1]));
+        // The shape ID of the triangle is its index in the whole mesh
+        shapeIds.add(triangleId);
+
+        // The flat and concave edges of a cooked mesh have been computed when the mesh was cooked
+        trianglesInternalEdges.add(mTriangleMesh->isCooked() ? static_cast<uint8>(~mTriangleMesh->mCookedConvexEdges[triangleId] & 0x7) : 0);
     }
 }
 
@@ -180,7 +299,7 @@ bool ConcaveMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collide
     Ray scaledRay(ray.point1 * inverseScale, ray.point2 * inverseScale, ray.maxFraction);
 
     // Create the callback object that will compute ray casting against triangles
-    ConcaveMeshRaycastCallback raycastCallback(mDynamicAABBTree, *this, collider, raycastInfo, scaledRay, mScale, allocator);
+    ConcaveMeshRaycastCallback raycastCallback(*this, collider, raycastInfo, mScale, allocator);
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -190,95 +309,89 @@ bool ConcaveMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collide
 
 #endif
 
-    // Ask the Dynamic AABB Tree to report all AABB nodes that are hit by the ray.
-    // The raycastCallback object will then compute ray casting against the triangles
-    // in the hit AABBs.
-    mDynamicAABBTree.raycast(scaledRay, raycastCallback);
-
-    raycastCallback.raycastTriangles();
+    // Ask the static AABB tree to report all the leaves that are hit by the ray.
+    // The raycastCallback object will compute ray casting against their triangles
+    // and the ray is shortened each time a closer triangle is hit.
+    mStaticAABBTree.raycast(scaledRay, raycastCallback);
 
     return raycastCallback.getIsHit();
 }
 
-// Compute the shape Id for a given triangle of the mesh
-uint32 ConcaveMeshShape::computeTriangleShapeId(uint32 subPart, uint32 triangleIndex) const {
-
-    RP3D_PROFILE("ConcaveMeshShape::computeTriangleShapeId()", mProfiler);
-
-    uint32 shapeId = 0;
+// Return the sub-part and the index in this sub-part of a triangle of the mesh
+/**
+ * @param triangleId Index of the triangle in the whole mesh (all the sub-parts)
+ * @param[out] outSubPart Index of the sub-part of the mesh that contains the triangle
+ * @param[out] outTriangleIndex Index of the triangle in its sub-part
+ */
+void ConcaveMeshShape::getTriangleSubpartAndIndex(uint32 triangleId, uint32& outSubPart, uint32& outTriangleIndex) const {
 
-    uint32 i=0;
-    while (i < subPart) {
+    uint32 subPart = 0;
+    uint32 nbTrianglesSubpart = mTriangleMesh->getNbTriangles(0);
+    while (triangleId >= nbTrianglesSubpart) {
 
-        shapeId += mTriangleMesh->getSubpart(i)->getNbTriangles();
+        triangleId -= nbTrianglesSubpart;
+        subPart++;
 
-        i++;
+        assert(subPart < mTriangleMesh->getNbSubparts());
+        nbTrianglesSubpart = mTriangleMesh->getNbTriangles(subPart);
     }
 
-    return shapeId + triangleIndex;
-}
-
-// Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
-decimal ConcaveMeshRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
-
-    // Add the id of the hit AABB node into
-    mHitAABBNodes.add(nodeId);
-
-    return ray.maxFraction;
+    outSubPart = subPart;
+    outTriangleIndex = triangleId;
 }
 
-// Raycast all collision shapes that have been collected
-void ConcaveMeshRaycastCallback::raycastTriangles() {
+// Raycast the triangle of a leaf of the tree that is hit by the ray
+/// The method returns the hit fraction if the triangle is hit (to shorten the ray) and
+/// a negative value otherwise.
+decimal ConcaveMeshRaycastCallback::raycastLeaf(int32 triangleId, const Ray& ray) {
 
-    Array<int>::Iterator it;
-    decimal smallestHitFraction = mRay.maxFraction;
+    // Get the mesh subpart and index of the triangle
+    uint32 subPart, triangleIndex;
+    mConcaveMeshShape.getTriangleSubpartAndIndex(static_cast<uint32>(triangleId), subPart, triangleIndex);
 
-    for (it = mHitAABBNodes.begin(); it != mHitAABBNodes.end(); ++it) {
+    // Get the triangle vertices from the concave mesh shape
+    Vector3 trianglePoints[3];
+    mConcaveMeshShape.getTriangleVertices(subPart, triangleIndex, trianglePoints);
 
-        // Get the node data (triangle index and mesh subpart index)
-        int32* data = mDynamicAABBTree.getNodeDataInt(*it);
-
-        // Get the triangle vertices for this node from the concave mesh shape
-        Vector3 trianglePoints[3];
-        mConcaveMeshShape.getTriangleVertices(data[0], data[1], trianglePoints);
+    // Get the vertices normals of the triangle
+    Vector3 verticesNormals[3];
+    mConcaveMeshShape.getTriangleVerticesNormals(subPart, triangleIndex, verticesNormals);
 
-        // Get the vertices normals of the triangle
-        Vector3 verticesNormals[3];
-        mConcaveMeshShape.getTriangleVerticesNormals(data[0], data[1], verticesNormals);
+    // Create a triangle collision shape
+    TriangleShape triangleShape(trianglePoints, verticesNormals, static_cast<uint32>(triangleId), 0, mConcaveMeshShape.mTriangleHalfEdgeStructure, mAllocator);
+    triangleShape.setRaycastTestType(mConcaveMeshShape.getRaycastTestType());
 
-        // Create a triangle collision shape
-        TriangleShape triangleShape(trianglePoints, verticesNormals, mConcaveMeshShape.computeTriangleShapeId(data[0], data[1]), mConcaveMeshShape.mTriangleHalfEdgeStructure, mAllocator);
-        triangleShape.setRaycastTestType(mConcaveMeshShape.getRaycastTestType());
-		
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 
-		// Set the profiler to the triangle shape
-		triangleShape.setProfiler(mProfiler);
+    // Set the profiler to the triangle shape
+    triangleShape.setProfiler(mProfiler);
 
 #endif
 
-        // Ray casting test against the collision shape
-        RaycastInfo raycastInfo;
-        bool isTriangleHit = triangleShape.raycast(mRay, raycastInfo, mCollider, mAllocator);
+    // Ray casting test against the collision shape
+    RaycastInfo raycastInfo;
+    bool isTriangleHit = triangleShape.raycast(ray, raycastInfo, mCollider, mAllocator);
 
-        // If the ray hit the collision shape
-        if (isTriangleHit && raycastInfo.hitFraction <= smallestHitFraction) {
+    // If the ray hit the collision shape
+    if (isTriangleHit && raycastInfo.hitFraction <= ray.maxFraction) {
 
-            assert(raycastInfo.hitFraction >= decimal(0.0));
+        assert(raycastInfo.hitFraction >= decimal(0.0));
 
-            mRaycastInfo.body = raycastInfo.body;
-            mRaycastInfo.collider = raycastInfo.collider;
-            mRaycastInfo.hitFraction = raycastInfo.hitFraction;
-            mRaycastInfo.worldPoint = raycastInfo.worldPoint * mMeshScale;
-            mRaycastInfo.worldNormal = raycastInfo.worldNormal;
-            mRaycastInfo.meshSubpart = data[0];
-            mRaycastInfo.triangleIndex = data[1];
+        mRaycastInfo.body = raycastInfo.body;
+        mRaycastInfo.collider = raycastInfo.collider;
+        mRaycastInfo.hitFraction = raycastInfo.hitFraction;
+        mRaycastInfo.worldPoint = raycastInfo.worldPoint * mMeshScale;
+        mRaycastInfo.worldNormal = raycastInfo.worldNormal;
+        mRaycastInfo.meshSubpart = static_cast<int>(subPart);
+        mRaycastInfo.triangleIndex = static_cast<int>(triangleIndex);
 
-            smallestHitFraction = raycastInfo.hitFraction;
-            mIsHit = true;
-        }
+        mIsHit = true;
+
+        return raycastInfo.hitFraction;
     }
+
+    return decimal(-1.0);
 }
 
 // Return the string representation of the shape
@@ -289,6 +402,32 @@ std::string ConcaveMeshShape::to_string() const {
     ss << "ConcaveMeshShape{" << std::endl;
     ss << "nbSubparts=" << mTriangleMesh->getNbSubparts() << std::endl;
 
+    // The vertices of a compressed mesh are not stored per sub-part
+    if (mTriangleMesh->isCompressed()) {
+
+        ss << "nbVertices=" << mTriangleMesh->getCompressedTriangles()->getNbVertices() << std::endl;
+
+        for (uint32 subPart=0; subPart<mTriangleMesh->getNbSubparts(); subPart++) {
+
+            ss << "subpart" << subPart << "={" << std::endl;
+            ss << "nbTriangles=" << mTriangleMesh->getNbTriangles(subPart) << std::endl;
+            ss << "triangles=[";
+
+            for (uint32 triangleIndex=0; triangleIndex<mTriangleMesh->getNbTriangles(subPart); triangleIndex++) {
+
+                Vector3 vertices[3];
+                mTriangleMesh->getTriangleVertices(subPart, triangleIndex, vertices);
+
+                ss << "(" << vertices[0].to_string() << "," << vertices[1].to_string() << "," << vertices[2].to_string() << "), ";
+            }
+
+            ss << "], " << std::endl;
+            ss << "}" << std::endl;
+        }
+
+        return ss.str();
+    }
+
     // Vertices array
     for (uint32 subPart=0; subPart<mTriangleMesh->getNbSubparts(); subPart++) {
 
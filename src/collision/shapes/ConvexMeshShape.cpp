@@ -41,10 +41,15 @@ using namespace reactphysics3d;
  */
 ConvexMeshShape::ConvexMeshShape(PolyhedronMesh* polyhedronMesh, MemoryAllocator& allocator, const Vector3& scale)
                 : ConvexPolyhedronShape(CollisionShapeName::CONVEX_MESH, allocator), mPolyhedronMesh(polyhedronMesh),
-                  mMinBounds(0, 0, 0), mMaxBounds(0, 0, 0), mScale(scale) {
+                  mMinBounds(0, 0, 0), mMaxBounds(0, 0, 0), mScale(scale),
+                  mFacesPlanes(allocator, 4 * polyhedronMesh->getHalfEdgeStructure().getNbFaces()),
+                  mVerticesCoordinates(allocator, 3 * polyhedronMesh->getNbVertices()) {
 
     // Recalculate the bounds of the mesh
     recalculateBounds();
+
+    // Recalculate the planes of the faces of the mesh
+    recalculateFacesPlanes();
 }
 
 // Return a local support point in a given direction without the object margin.
@@ -103,6 +108,36 @@ void ConvexMeshShape::recalculateBounds() {
     mMinBounds = mMinBounds * mScale;
 }
 
+// Recompute the planes of the faces and the coordinates of the vertices of the scaled mesh
+/// Those structure of arrays are used by the SAT algorithm to test all the faces of a convex mesh
+/// against all the vertices of another convex mesh with contiguous loops
+void ConvexMeshShape::recalculateFacesPlanes() {
+
+    const uint32 nbFaces = getNbFaces();
+    const uint32 nbVertices = getNbVertices();
+
+    mFacesPlanes.clear();
+    mFacesPlanes.addWithoutInit(4 * nbFaces);
+    for (uint32 f=0; f < nbFaces; f++) {
+
+        const Vector3 faceNormal = getFaceNormal(f);
+        mFacesPlanes[f] = faceNormal.x;
+        mFacesPlanes[nbFaces + f] = faceNormal.y;
+        mFacesPlanes[2 * nbFaces + f] = faceNormal.z;
+        mFacesPlanes[3 * nbFaces + f] = faceNormal.dot(getVertexPosition(getFace(f).faceVertices[0]));
+    }
+
+    mVerticesCoordinates.clear();
+    mVerticesCoordinates.addWithoutInit(3 * nbVertices);
+    for (uint32 v=0; v < nbVertices; v++) {
+
+        const Vector3 vertex = getVertexPosition(v);
+        mVerticesCoordinates[v] = vertex.x;
+        mVerticesCoordinates[nbVertices + v] = vertex.y;
+        mVerticesCoordinates[2 * nbVertices + v] = vertex.z;
+    }
+}
+
 // Raycast method with feedback information
 /// This method implements the technique in the book "Real-time Collision Detection" by
 /// Christer Ericson.
@@ -27,10 +27,25 @@
 #include <reactphysics3d/collision/shapes/HeightFieldShape.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/containers/Stack.h>
 #include <iostream>
 
 using namespace reactphysics3d;
 
+// Block of the min/max heights pyramid to visit during a traversal
+struct HeightFieldPyramidStackNode {
+
+    /// Level of the block in the pyramid
+    int level;
+
+    /// Coordinates of the block in its level
+    int blockI;
+    int blockJ;
+
+    /// Fraction of the ray where the ray enters the AABB of the block
+    decimal entryFraction;
+};
+
 // Constructor
 /**
  * @param nbGridColumns Number of columns in the grid of the height field
@@ -38,18 +53,24 @@ using namespace reactphysics3d;
  * @param minHeight Minimum height value of the height field
  * @param maxHeight Maximum height value of the height field
  * @param heightFieldData Pointer to the first height value data (note that values are shared and not copied)
- * @param dataType Data type for the height values (int, float, double)
+ * @param dataType Data type for the height values (int, float, double, uint16, half)
  * @param upAxis Integer representing the up axis direction (0 for x, 1 for y and 2 for z)
  * @param integerHeightScale Scaling factor used to scale the height values (only when height values type is integer)
+ * @param scaling Scaling factor of the shape
+ * @param nbTileCells Number of cells in each direction of a tile for a tiled height field (zero if not tiled)
  */
 HeightFieldShape::HeightFieldShape(int nbGridColumns, int nbGridRows, decimal minHeight, decimal maxHeight,
                                    const void* heightFieldData, HeightDataType dataType, MemoryAllocator& allocator,
                                    HalfEdgeStructure& triangleHalfEdgeStructure, int upAxis,
-                                   decimal integerHeightScale, const Vector3& scaling)
+                                   decimal integerHeightScale, const Vector3& scaling, int nbTileCells)
                  : ConcaveShape(CollisionShapeName::HEIGHTFIELD, allocator, scaling), mNbColumns(nbGridColumns), mNbRows(nbGridRows),
                    mWidth(static_cast<decimal>(nbGridColumns - 1)), mLength(static_cast<decimal>(nbGridRows - 1)), mMinHeight(minHeight),
                    mMaxHeight(maxHeight), mUpAxis(upAxis), mIntegerHeightScale(integerHeightScale),
-                   mHeightDataType(dataType), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+                   mQuantizedHeightScale((maxHeight - minHeight) / decimal(65535.0)),
+                   mHeightDataType(dataType), mHeightFieldData(heightFieldData), mNbTileCells(nbTileCells),
+                   mNbTileColumns(0), mNbTileRows(0), mTilesData(allocator), mReadHeightsFunction(nullptr),
+                   mVerticesNormals(nullptr), mAllocator(allocator), mPyramidLevels(allocator), mPyramidBlocksBounds(allocator),
+                   mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
     assert(nbGridColumns >= 2);
     assert(nbGridRows >= 2);
@@ -57,8 +78,43 @@ HeightFieldShape::HeightFieldShape(int nbGridColumns, int nbGridRows, decimal mi
     assert(mLength >= 1);
     assert(minHeight <= maxHeight);
     assert(upAxis == 0 || upAxis == 1 || upAxis == 2);
+    assert(nbTileCells >= 0);
+
+    if (mNbTileCells > 0) {
+
+        // The tiles must cover the whole grid and contain complete blocks of the pyramid
+        assert((nbGridColumns - 1) % nbTileCells == 0);
+        assert((nbGridRows - 1) % nbTileCells == 0);
+        assert(nbTileCells % PYRAMID_BLOCK_SIZE == 0);
 
-    mHeightFieldData = heightFieldData;
+        // All the tiles are unloaded at the beginning
+        mNbTileColumns = (nbGridColumns - 1) / nbTileCells;
+        mNbTileRows = (nbGridRows - 1) / nbTileCells;
+        for (int t = 0; t < mNbTileColumns * mNbTileRows; t++) {
+            mTilesData.add(nullptr);
+        }
+    }
+
+    // Select the method used to read the height values once for all (to avoid a switch on
+    // the data type for each sample)
+    switch(mHeightDataType) {
+        case HeightDataType::HEIGHT_FLOAT_TYPE : mReadHeightsFunction = mNbTileCells > 0 ? &HeightFieldShape::readTiledHeights<float> :
+                                                                                           &HeightFieldShape::readHeights<float>;
+                                                 break;
+        case HeightDataType::HEIGHT_DOUBLE_TYPE : mReadHeightsFunction = mNbTileCells > 0 ? &HeightFieldShape::readTiledHeights<double> :
+                                                                                            &HeightFieldShape::readHeights<double>;
+                                                  break;
+        case HeightDataType::HEIGHT_INT_TYPE : mReadHeightsFunction = mNbTileCells > 0 ? &HeightFieldShape::readTiledHeights<int> :
+                                                                                         &HeightFieldShape::readHeights<int>;
+                                               break;
+        case HeightDataType::HEIGHT_UINT16_TYPE : mReadHeightsFunction = mNbTileCells > 0 ? &HeightFieldShape::readTiledHeights<uint16> :
+                                                                                            &HeightFieldShape::readHeights<uint16>;
+                                                  break;
+        case HeightDataType::HEIGHT_HALF_TYPE : mReadHeightsFunction = mNbTileCells > 0 ? &HeightFieldShape::readTiledHeights<HeightFieldHalf> :
+                                                                                          &HeightFieldShape::readHeights<HeightFieldHalf>;
+                                                break;
+    }
+    assert(mReadHeightsFunction != nullptr);
 
     decimal halfHeight = (mMaxHeight - mMinHeight) * decimal(0.5);
     assert(halfHeight >= 0);
@@ -76,6 +132,358 @@ HeightFieldShape::HeightFieldShape(int nbGridColumns, int nbGridRows, decimal mi
         mAABB.setMin(Vector3(-mWidth * decimal(0.5), -mLength * decimal(0.5), -halfHeight));
         mAABB.setMax(Vector3(mWidth * decimal(0.5), mLength * decimal(0.5), halfHeight));
     }
+
+    createHeightsPyramid();
+}
+
+// Destructor
+HeightFieldShape::~HeightFieldShape() {
+
+    setIsVerticesNormalsCacheEnabled(false);
+}
+
+// Enable/Disable the precomputed normals of the vertices
+/**
+ * When the cache is enabled, the normal of each vertex of the grid is precomputed
+ * as the area-weighted average of the normals of its neighbor triangles. Those smooth normals are
+ * then used as triangle vertices normals during collision detection instead of the triangle
+ * face normals. This requires extra memory (one Vector3 per grid point). Note that the cache must be
+ * enabled again if the height values of the height field are modified.
+ * @param isEnabled True if the vertices normals must be precomputed
+ */
+void HeightFieldShape::setIsVerticesNormalsCacheEnabled(bool isEnabled) {
+
+    if (isEnabled) {
+
+        if (mVerticesNormals == nullptr) {
+            mVerticesNormals = static_cast<Vector3*>(mAllocator.allocate(static_cast<size_t>(mNbColumns) * mNbRows * sizeof(Vector3)));
+        }
+
+        computeVerticesNormals(0, 0, mNbColumns - 1, mNbRows - 1);
+    }
+    else if (mVerticesNormals != nullptr) {
+
+        mAllocator.release(mVerticesNormals, static_cast<size_t>(mNbColumns) * mNbRows * sizeof(Vector3));
+        mVerticesNormals = nullptr;
+    }
+}
+
+// Compute the normal of each vertex in a region of the grid
+/// The normal of a vertex is the average of the normals of its neighbor triangles weighted by their area.
+/// The normals are computed without scaling. The triangles of the unloaded tiles are ignored.
+void HeightFieldShape::computeVerticesNormals(int columnMin, int rowMin, int columnMax, int rowMax) {
+
+    assert(mVerticesNormals != nullptr);
+    assert(columnMin >= 0 && columnMin <= columnMax && columnMax < mNbColumns);
+    assert(rowMin >= 0 && rowMin <= rowMax && rowMax < mNbRows);
+
+    for (int y = rowMin; y <= rowMax; y++) {
+        for (int x = columnMin; x <= columnMax; x++) {
+            mVerticesNormals[y * mNbColumns + x].setToZero();
+        }
+    }
+
+    // Range of the cells with a vertex in the region
+    const int iMin = std::max(columnMin - 1, 0);
+    const int iMax = std::min(columnMax, mNbColumns - 2);
+    const int jMin = std::max(rowMin - 1, 0);
+    const int jMax = std::min(rowMax, mNbRows - 2);
+    const int nbColumnsInRange = iMax - iMin + 2;
+
+    Array<decimal> heights(mAllocator, 2 * nbColumnsInRange);
+    heights.addWithoutInit(2 * nbColumnsInRange);
+    decimal* rowHeights = &(heights[0]);
+    decimal* nextRowHeights = &(heights[nbColumnsInRange]);
+
+    // Add the normal of a triangle to a vertex if it is in the region
+    auto addNormal = [&](int x, int y, const Vector3& normal) {
+        if (x >= columnMin && x <= columnMax && y >= rowMin && y <= rowMax) {
+            mVerticesNormals[y * mNbColumns + x] += normal;
+        }
+    };
+
+    (this->*mReadHeightsFunction)(jMin, iMin, iMax + 1, rowHeights);
+
+    for (int j = jMin; j <= jMax; j++) {
+
+        (this->*mReadHeightsFunction)(j + 1, iMin, iMax + 1, nextRowHeights);
+
+        for (int i = iMin; i <= iMax; i++) {
+
+            if (!isCellLoaded(i, j)) continue;
+
+            const int k = i - iMin;
+            const Vector3 p1 = computeVertex(i, j, rowHeights[k]);
+            const Vector3 p2 = computeVertex(i, j + 1, nextRowHeights[k]);
+            const Vector3 p3 = computeVertex(i + 1, j, rowHeights[k + 1]);
+            const Vector3 p4 = computeVertex(i + 1, j + 1, nextRowHeights[k + 1]);
+
+            // The length of the (non-normalized) triangle normals is proportional to the triangle area
+            const Vector3 triangle1Normal = (p2 - p1).cross(p3 - p1);
+            const Vector3 triangle2Normal = (p2 - p3).cross(p4 - p3);
+
+            addNormal(i, j, triangle1Normal);
+            addNormal(i, j + 1, triangle1Normal + triangle2Normal);
+            addNormal(i + 1, j, triangle1Normal + triangle2Normal);
+            addNormal(i + 1, j + 1, triangle2Normal);
+        }
+
+        std::swap(rowHeights, nextRowHeights);
+    }
+
+    for (int y = rowMin; y <= rowMax; y++) {
+        for (int x = columnMin; x <= columnMax; x++) {
+
+            // The vertices of unloaded tiles do not have neighbor triangles
+            Vector3& normal = mVerticesNormals[y * mNbColumns + x];
+            if (normal.lengthSquare() > MACHINE_EPSILON) {
+                normal.normalize();
+            }
+        }
+    }
+}
+
+// Notify the height field that the height values of a region of the grid have been modified
+/**
+ * The height values of a height field are shared with the user. This method must be called after
+ * the user has modified some height values in place. Only the data of the height field in the modified
+ * region is updated. The new height values must stay in the range [minHeight, maxHeight] given at the
+ * creation of the height field. The temporal coherence data of the overlapping pairs near the region are
+ * invalidated and the bodies near the region are awakened.
+ * @param columnMin Index of the first modified column of the grid
+ * @param rowMin Index of the first modified row of the grid
+ * @param columnMax Index of the last modified column of the grid (included)
+ * @param rowMax Index of the last modified row of the grid (included)
+ */
+void HeightFieldShape::updateHeights(int columnMin, int rowMin, int columnMax, int rowMax) {
+
+    assert(columnMin >= 0 && columnMin <= columnMax && columnMax < mNbColumns);
+    assert(rowMin >= 0 && rowMin <= rowMax && rowMax < mNbRows);
+
+    // Range of the cells with a modified vertex
+    const int cellIMin = std::max(columnMin - 1, 0);
+    const int cellIMax = std::min(columnMax, mNbColumns - 2);
+    const int cellJMin = std::max(rowMin - 1, 0);
+    const int cellJMax = std::min(rowMax, mNbRows - 2);
+
+    updateHeightsPyramid(cellIMin, cellJMin, cellIMax, cellJMax);
+
+    // The normals of the vertices of those cells must be recomputed
+    if (mVerticesNormals != nullptr) {
+        computeVerticesNormals(cellIMin, cellJMin, cellIMax + 1, cellJMax + 1);
+    }
+
+    // Compute the local AABB of the modified region
+    AABB regionAABB = computeCellsAABB(cellIMin, cellJMin, cellIMax, cellJMax, mMinHeight, mMaxHeight);
+    regionAABB.applyScale(mScale);
+
+    notifyColliderAboutChangedRegion(regionAABB);
+}
+
+// Load (or unload with nullptr) the height values data of a tile
+/**
+ * The height values of a tile are shared and not copied. They are the (nbTileCells + 1) x (nbTileCells + 1)
+ * height values of the vertices of the tile (row after row). The height values of the vertices on the border
+ * between two loaded tiles must be the same in both tiles. The cells of an unloaded tile do not collide.
+ * @param tileColumn Column of the tile
+ * @param tileRow Row of the tile
+ * @param tileData Pointer to the height values of the tile or nullptr to unload the tile
+ */
+void HeightFieldShape::setTileData(int tileColumn, int tileRow, const void* tileData) {
+
+    assert(isTiled());
+    assert(tileColumn >= 0 && tileColumn < mNbTileColumns);
+    assert(tileRow >= 0 && tileRow < mNbTileRows);
+
+    mTilesData[tileRow * mNbTileColumns + tileColumn] = tileData;
+
+    updateHeights(tileColumn * mNbTileCells, tileRow * mNbTileCells, (tileColumn + 1) * mNbTileCells, (tileRow + 1) * mNbTileCells);
+}
+
+// Return the data of the tile where to read the height value of a vertex of a tiled height field
+/// A vertex on the border of a tile is read from a neighbor loaded tile if its own tile is not loaded.
+const void* HeightFieldShape::getVertexTileData(int x, int y, int& outTileColumn, int& outTileRow) const {
+
+    assert(isTiled());
+
+    outTileColumn = std::min(x / mNbTileCells, mNbTileColumns - 1);
+    outTileRow = std::min(y / mNbTileCells, mNbTileRows - 1);
+    const void* tileData = getTileData(outTileColumn, outTileRow);
+
+    if (tileData == nullptr) {
+
+        const bool isOnColumnBorder = x > 0 && x == outTileColumn * mNbTileCells;
+        const bool isOnRowBorder = y > 0 && y == outTileRow * mNbTileCells;
+
+        if (isOnColumnBorder && getTileData(outTileColumn - 1, outTileRow) != nullptr) {
+            outTileColumn--;
+        }
+        else if (isOnRowBorder && getTileData(outTileColumn, outTileRow - 1) != nullptr) {
+            outTileRow--;
+        }
+        else if (isOnColumnBorder && isOnRowBorder && getTileData(outTileColumn - 1, outTileRow - 1) != nullptr) {
+            outTileColumn--;
+            outTileRow--;
+        }
+
+        tileData = getTileData(outTileColumn, outTileRow);
+    }
+
+    return tileData;
+}
+
+// Create the levels of the min/max heights pyramid
+/// Each block of the lowest level contains PYRAMID_BLOCK_SIZE x PYRAMID_BLOCK_SIZE cells and each
+/// block of an upper level contains 2 x 2 blocks of the level below. The top level has a single block.
+void HeightFieldShape::createHeightsPyramid() {
+
+    const int nbCellsI = mNbColumns - 1;
+    const int nbCellsJ = mNbRows - 1;
+
+    int nbBlocksI = (nbCellsI + PYRAMID_BLOCK_SIZE - 1) / PYRAMID_BLOCK_SIZE;
+    int nbBlocksJ = (nbCellsJ + PYRAMID_BLOCK_SIZE - 1) / PYRAMID_BLOCK_SIZE;
+    int blockSize = PYRAMID_BLOCK_SIZE;
+    uint32 nbBlocks = 0;
+
+    while (true) {
+
+        mPyramidLevels.add(HeightFieldPyramidLevel{nbBlocksI, nbBlocksJ, blockSize, nbBlocks});
+        nbBlocks += static_cast<uint32>(nbBlocksI * nbBlocksJ);
+
+        if (nbBlocksI == 1 && nbBlocksJ == 1) break;
+
+        nbBlocksI = (nbBlocksI + 1) / 2;
+        nbBlocksJ = (nbBlocksJ + 1) / 2;
+        blockSize *= 2;
+    }
+
+    mPyramidBlocksBounds.addWithoutInit(nbBlocks);
+
+    updateHeightsPyramid(0, 0, nbCellsI - 1, nbCellsJ - 1);
+}
+
+// Update the min/max heights pyramid for a range of cells
+/**
+ * @param cellIMin Index of the first column of cells to update
+ * @param cellJMin Index of the first row of cells to update
+ * @param cellIMax Index of the last column of cells to update (included)
+ * @param cellJMax Index of the last row of cells to update (included)
+ */
+void HeightFieldShape::updateHeightsPyramid(int cellIMin, int cellJMin, int cellIMax, int cellJMax) {
+
+    const int nbCellsI = mNbColumns - 1;
+    const int nbCellsJ = mNbRows - 1;
+
+    assert(cellIMin >= 0 && cellIMin <= cellIMax && cellIMax < nbCellsI);
+    assert(cellJMin >= 0 && cellJMin <= cellJMax && cellJMax < nbCellsJ);
+
+    int blockIMin = cellIMin / PYRAMID_BLOCK_SIZE;
+    int blockIMax = cellIMax / PYRAMID_BLOCK_SIZE;
+    int blockJMin = cellJMin / PYRAMID_BLOCK_SIZE;
+    int blockJMax = cellJMax / PYRAMID_BLOCK_SIZE;
+
+    // Compute the min/max heights of the blocks of the lowest level from the heights of their vertices
+    decimal heights[PYRAMID_BLOCK_SIZE + 1];
+    const HeightFieldPyramidLevel& lowestLevel = mPyramidLevels[0];
+    for (int blockJ = blockJMin; blockJ <= blockJMax; blockJ++) {
+        for (int blockI = blockIMin; blockI <= blockIMax; blockI++) {
+
+            const int iStart = blockI * PYRAMID_BLOCK_SIZE;
+            const int iEnd = std::min(iStart + PYRAMID_BLOCK_SIZE, nbCellsI);
+            const int jStart = blockJ * PYRAMID_BLOCK_SIZE;
+            const int jEnd = std::min(jStart + PYRAMID_BLOCK_SIZE, nbCellsJ);
+
+            HeightFieldBlockBounds& bounds = mPyramidBlocksBounds[lowestLevel.offset + blockJ * lowestLevel.nbBlocksI + blockI];
+            bounds.minHeight = DECIMAL_LARGEST;
+            bounds.maxHeight = -DECIMAL_LARGEST;
+
+            // The bounds of a block in an unloaded tile stay empty
+            if (!isCellLoaded(iStart, jStart)) continue;
+
+            for (int j = jStart; j <= jEnd; j++) {
+
+                (this->*mReadHeightsFunction)(j, iStart, iEnd, heights);
+                for (int k = 0; k <= iEnd - iStart; k++) {
+                    bounds.minHeight = std::min(bounds.minHeight, heights[k]);
+                    bounds.maxHeight = std::max(bounds.maxHeight, heights[k]);
+                }
+            }
+        }
+    }
+
+    // Propagate the min/max heights to the upper levels
+    for (uint32 level = 1; level < mPyramidLevels.size(); level++) {
+
+        const HeightFieldPyramidLevel& childLevel = mPyramidLevels[level - 1];
+        const HeightFieldPyramidLevel& pyramidLevel = mPyramidLevels[level];
+
+        blockIMin /= 2;
+        blockIMax /= 2;
+        blockJMin /= 2;
+        blockJMax /= 2;
+
+        for (int blockJ = blockJMin; blockJ <= blockJMax; blockJ++) {
+            for (int blockI = blockIMin; blockI <= blockIMax; blockI++) {
+
+                HeightFieldBlockBounds& bounds = mPyramidBlocksBounds[pyramidLevel.offset + blockJ * pyramidLevel.nbBlocksI + blockI];
+                bounds.minHeight = DECIMAL_LARGEST;
+                bounds.maxHeight = -DECIMAL_LARGEST;
+
+                const int childIEnd = std::min(2 * blockI + 1, childLevel.nbBlocksI - 1);
+                const int childJEnd = std::min(2 * blockJ + 1, childLevel.nbBlocksJ - 1);
+                for (int childJ = 2 * blockJ; childJ <= childJEnd; childJ++) {
+                    for (int childI = 2 * blockI; childI <= childIEnd; childI++) {
+
+                        const HeightFieldBlockBounds& childBounds = getBlockBounds(level - 1, childI, childJ);
+                        bounds.minHeight = std::min(bounds.minHeight, childBounds.minHeight);
+                        bounds.maxHeight = std::max(bounds.maxHeight, childBounds.maxHeight);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Return true if some cells in a range have height values in a given interval
+/// The blocks of the pyramid are used to reject whole regions of the range that are above or below
+/// the interval. Note that this test is conservative and might return true even if there is no overlap.
+bool HeightFieldShape::testHeightsOverlap(int cellIMin, int cellJMin, int cellIMax, int cellJMax,
+                                          decimal minHeight, decimal maxHeight, MemoryAllocator& allocator) const {
+
+    Stack<HeightFieldPyramidStackNode> stack(allocator, 64);
+    stack.push(HeightFieldPyramidStackNode{static_cast<int>(mPyramidLevels.size()) - 1, 0, 0, decimal(0.0)});
+
+    while (stack.size() > 0) {
+
+        const HeightFieldPyramidStackNode node = stack.pop();
+
+        const HeightFieldBlockBounds& bounds = getBlockBounds(node.level, node.blockI, node.blockJ);
+        if (bounds.minHeight > maxHeight || bounds.maxHeight < minHeight) continue;
+
+        // If the block is completely inside the range of cells (or is a block of the lowest level)
+        const int blockSize = mPyramidLevels[node.level].blockSize;
+        const int blockCellIMin = node.blockI * blockSize;
+        const int blockCellJMin = node.blockJ * blockSize;
+        if (node.level == 0 || (blockCellIMin >= cellIMin && blockCellIMin + blockSize - 1 <= cellIMax &&
+                                blockCellJMin >= cellJMin && blockCellJMin + blockSize - 1 <= cellJMax)) {
+            return true;
+        }
+
+        // Visit the children blocks that overlap the range of cells
+        const HeightFieldPyramidLevel& childLevel = mPyramidLevels[node.level - 1];
+        const int childSize = childLevel.blockSize;
+        for (int childJ = 2 * node.blockJ; childJ <= std::min(2 * node.blockJ + 1, childLevel.nbBlocksJ - 1); childJ++) {
+            for (int childI = 2 * node.blockI; childI <= std::min(2 * node.blockI + 1, childLevel.nbBlocksI - 1); childI++) {
+
+                if (childI * childSize > cellIMax || (childI + 1) * childSize - 1 < cellIMin) continue;
+                if (childJ * childSize > cellJMax || (childJ + 1) * childSize - 1 < cellJMin) continue;
+
+                stack.push(HeightFieldPyramidStackNode{node.level - 1, childI, childJ, decimal(0.0)});
+            }
+        }
+    }
+
+    return false;
 }
 
 // Return the local bounds of the shape in x, y and z directions.
@@ -95,7 +503,8 @@ void HeightFieldShape::getLocalBounds(Vector3& min, Vector3& max) const {
 // and then for each rectangle in the sub-grid we generate two triangles that we use to test collision.
 void HeightFieldShape::computeOverlappingTriangles(const AABB& localAABB, Array<Vector3>& triangleVertices,
                                                    Array<Vector3>& triangleVerticesNormals, Array<uint32>& shapeIds,
-                                                   MemoryAllocator& /*allocator*/) const {
+                                                   Array<uint8>& trianglesInternalEdges,
+                                                   MemoryAllocator& allocator) const {
 
     RP3D_PROFILE("HeightFieldShape::computeOverlappingTriangles()", mProfiler);
 
@@ -136,60 +545,130 @@ void HeightFieldShape::computeOverlappingTriangles(const AABB& localAABB, Array<
    assert(jMin >= 0 && jMin < mNbRows);
    assert(jMax >= 0 && jMax < mNbRows);
 
-   // For each sub-grid points (except the last ones one each dimension)
-   for (int i = iMin; i < iMax; i++) {
-       for (int j = jMin; j < jMax; j++) {
+   if (iMin >= iMax || jMin >= jMax) return;
+
+   // Range of height values (before translation to the height origin) of the AABB to collide
+   const decimal heightOrigin = -(mMaxHeight - mMinHeight) * decimal(0.5) - mMinHeight;
+   const decimal aabbMinHeight = aabb.getMin()[mUpAxis] - heightOrigin;
+   const decimal aabbMaxHeight = aabb.getMax()[mUpAxis] - heightOrigin;
+
+   // Use the min/max heights pyramid to reject the query if the sub-grid is above or below the AABB
+   if (!testHeightsOverlap(iMin, jMin, iMax - 1, jMax - 1, aabbMinHeight, aabbMaxHeight, allocator)) return;
+
+   const int nbColumnsInRange = iMax - iMin + 1;
+   const int nbQuads = (iMax - iMin) * (jMax - jMin);
+
+   // Buffers for the height values and the vertices of two consecutive rows of the sub-grid
+   Array<decimal> heights(allocator, 2 * nbColumnsInRange);
+   heights.addWithoutInit(2 * nbColumnsInRange);
+   decimal* rowHeights = &(heights[0]);
+   decimal* nextRowHeights = &(heights[nbColumnsInRange]);
+   Array<Vector3> vertices(allocator, 2 * nbColumnsInRange);
+   vertices.addWithoutInit(2 * nbColumnsInRange);
+   Vector3* rowVertices = &(vertices[0]);
+   Vector3* nextRowVertices = &(vertices[nbColumnsInRange]);
+
+   // If the precomputed vertices normals are used with a non-uniform scaling, they need to be transformed
+   const bool isUniformScaling = mScale.x == mScale.y && mScale.y == mScale.z;
+
+   triangleVertices.reserve(triangleVertices.size() + nbQuads * 6);
+   triangleVerticesNormals.reserve(triangleVerticesNormals.size() + nbQuads * 6);
+   shapeIds.reserve(shapeIds.size() + nbQuads * 2);
+   trianglesInternalEdges.reserve(trianglesInternalEdges.size() + nbQuads * 2);
+
+   // Compute the heights and vertices of a row of the sub-grid
+   auto computeRowVertices = [&](int j, decimal* outHeights, Vector3* outVertices) {
+       (this->*mReadHeightsFunction)(j, iMin, iMax, outHeights);
+       for (int k = 0; k < nbColumnsInRange; k++) {
+           outVertices[k] = computeVertex(iMin + k, j, outHeights[k]) * mScale;
+       }
+   };
+
+   // Return the precomputed normal of a vertex
+   auto getVertexNormal = [&](int i, int j) {
+       const Vector3& normal = mVerticesNormals[j * mNbColumns + i];
+       return isUniformScaling ? normal : (normal * inverseScale).getUnit();
+   };
+
+   computeRowVertices(jMin, rowHeights, rowVertices);
+
+   // For each row of quads of the sub-grid
+   for (int j = jMin; j < jMax; j++) {
+
+       computeRowVertices(j + 1, nextRowHeights, nextRowVertices);
+
+       for (int i = iMin; i < iMax; i++) {
+
+           const int k = i - iMin;
+
+           // Skip the quad if it is completely above or below the AABB
+           const decimal quadMinHeight = std::min(std::min(rowHeights[k], rowHeights[k + 1]),
+                                                  std::min(nextRowHeights[k], nextRowHeights[k + 1]));
+           const decimal quadMaxHeight = std::max(std::max(rowHeights[k], rowHeights[k + 1]),
+                                                  std::max(nextRowHeights[k], nextRowHeights[k + 1]));
+           if (quadMinHeight > aabbMaxHeight || quadMaxHeight < aabbMinHeight) continue;
+
+           // Skip the quad if it is in an unloaded tile
+           if (!isCellLoaded(i, j)) continue;
 
            // Compute the four point of the current quad
-           const Vector3 p1 = getVertexAt(i, j);
-           const Vector3 p2 = getVertexAt(i, j + 1);
-           const Vector3 p3 = getVertexAt(i + 1, j);
-           const Vector3 p4 = getVertexAt(i + 1, j + 1);
+           const Vector3& p1 = rowVertices[k];
+           const Vector3& p2 = nextRowVertices[k];
+           const Vector3& p3 = rowVertices[k + 1];
+           const Vector3& p4 = nextRowVertices[k + 1];
 
            // Generate the first triangle for the current grid rectangle
            triangleVertices.add(p1);
            triangleVertices.add(p2);
            triangleVertices.add(p3);
 
-           // Compute the triangle normal
-           Vector3 triangle1Normal = (p2 - p1).cross(p3 - p1).getUnit();
-
-           // Use the triangle face normal as vertices normals (this is an aproximation. The correct
-           // solution would be to compute all the normals of the neighbor triangles and use their
-           // weighted average (with incident angle as weight) at the vertices. However, this solution
-           // seems too expensive (it requires to compute the normal of all neighbor triangles instead
-           // and compute the angle of incident edges with asin(). Maybe we could also precompute the
-           // vertices normal at the HeightFieldShape constructor but it will require extra memory to
-           // store them.
-           triangleVerticesNormals.add(triangle1Normal);
-           triangleVerticesNormals.add(triangle1Normal);
-           triangleVerticesNormals.add(triangle1Normal);
-
-           // Compute the shape ID
-           shapeIds.add(computeTriangleShapeId(i, j, 0));
-
            // Generate the second triangle for the current grid rectangle
            triangleVertices.add(p3);
            triangleVertices.add(p2);
            triangleVertices.add(p4);
 
-           // Compute the triangle normal
-           Vector3 triangle2Normal = (p2 - p3).cross(p4 - p3).getUnit();
-
-           // Use the triangle face normal as vertices normals (this is an aproximation. The correct
-           // solution would be to compute all the normals of the neighbor triangles and use their
-           // weighted average (with incident angle as weight) at the vertices. However, this solution
-           // seems too expensive (it requires to compute the normal of all neighbor triangles instead
-           // and compute the angle of incident edges with asin(). Maybe we could also precompute the
-           // vertices normal at the HeightFieldShape constructor but it will require extra memory to
-           // store them.
-           triangleVerticesNormals.add(triangle2Normal);
-           triangleVerticesNormals.add(triangle2Normal);
-           triangleVerticesNormals.add(triangle2Normal);
-
-           // Compute the shape ID
+           if (mVerticesNormals != nullptr) {
+
+               // Use the precomputed (smooth) vertices normals
+               const Vector3 n1 = getVertexNormal(i, j);
+               const Vector3 n2 = getVertexNormal(i, j + 1);
+               const Vector3 n3 = getVertexNormal(i + 1, j);
+               const Vector3 n4 = getVertexNormal(i + 1, j + 1);
+
+               triangleVerticesNormals.add(n1);
+               triangleVerticesNormals.add(n2);
+               triangleVerticesNormals.add(n3);
+               triangleVerticesNormals.add(n3);
+               triangleVerticesNormals.add(n2);
+               triangleVerticesNormals.add(n4);
+           }
+           else {
+
+               // Use the triangle face normals as vertices normals (this is an aproximation. The
+               // vertices normals cache can be enabled to use the weighted average of the normals
+               // of the neighbor triangles at the vertices instead)
+               const Vector3 triangle1Normal = (p2 - p1).cross(p3 - p1).getUnit();
+               const Vector3 triangle2Normal = (p2 - p3).cross(p4 - p3).getUnit();
+
+               triangleVerticesNormals.add(triangle1Normal);
+               triangleVerticesNormals.add(triangle1Normal);
+               triangleVerticesNormals.add(triangle1Normal);
+               triangleVerticesNormals.add(triangle2Normal);
+               triangleVerticesNormals.add(triangle2Normal);
+               triangleVerticesNormals.add(triangle2Normal);
+           }
+
+           // Compute the shape IDs
+           shapeIds.add(computeTriangleShapeId(i, j, 0));
            shapeIds.add(computeTriangleShapeId(i, j, 1));
+
+           // The convexity of the edges of the height field is not precomputed
+           trianglesInternalEdges.add(0);
+           trianglesInternalEdges.add(0);
        }
+
+       std::swap(rowHeights, nextRowHeights);
+       std::swap(rowVertices, nextRowVertices);
    }
 }
 
@@ -232,7 +711,9 @@ void HeightFieldShape::computeMinMaxGridCoordinates(int* minCoords, int* maxCoor
 
 // Raycast method with feedback information
 /// Note that only the first triangle hit by the ray in the mesh will be returned, even if
-/// the ray hits many triangles.
+/// the ray hits many triangles. The min/max heights pyramid is traversed from the top to skip
+/// the blocks of the height field that are not hit by the ray. The blocks are visited in
+/// front to back order so that the blocks behind the closest hit found so far are skipped.
 bool HeightFieldShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const {
 
     RP3D_PROFILE("HeightFieldShape::raycast()", mProfiler);
@@ -242,88 +723,133 @@ bool HeightFieldShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collide
     const Vector3 inverseScale(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z);
     Ray scaledRay(ray.point1 * inverseScale, ray.point2 * inverseScale, ray.maxFraction);
 
+    const Vector3 rayDirection = scaledRay.point2 - scaledRay.point1;
+    const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
+
+    const int nbCellsI = mNbColumns - 1;
+    const int nbCellsJ = mNbRows - 1;
+
     bool isHit = false;
+    decimal smallestHitFraction = ray.maxFraction;
+
+    // Test the ray against the top block of the pyramid
+    const int topLevel = static_cast<int>(mPyramidLevels.size()) - 1;
+    const HeightFieldBlockBounds& topBounds = getBlockBounds(topLevel, 0, 0);
+    decimal entryFraction;
+    if (topBounds.minHeight > topBounds.maxHeight) return false;
+    if (!computeCellsAABB(0, 0, nbCellsI - 1, nbCellsJ - 1, topBounds.minHeight, topBounds.maxHeight)
+          .testRayIntersect(scaledRay.point1, rayDirectionInverse, smallestHitFraction, entryFraction)) {
+        return false;
+    }
 
-    // Compute the grid coordinates where the ray is entering the AABB of the height field
-    int i, j;
-    Vector3 outHitGridPoint;
-    if (computeEnteringRayGridCoordinates(scaledRay, i, j, outHitGridPoint)) {
-
-        const int nbCellsI = mNbColumns - 1;
-        const int nbCellsJ = mNbRows - 1;
-
-        const Vector3 aabbSize = mAABB.getExtent();
-
-        const Vector3 rayDirection = scaledRay.point2 - scaledRay.point1;
-
-        int stepI, stepJ;
-        decimal tMaxI, tMaxJ, nextI, nextJ, tDeltaI, tDeltaJ, sizeI, sizeJ;
-
-        switch(mUpAxis) {
-            case 0 : stepI = rayDirection.y > 0 ? 1 : (rayDirection.y < 0 ? -1 : 0);
-                     stepJ = rayDirection.z > 0 ? 1 : (rayDirection.z < 0 ? -1 : 0);
-                     nextI = static_cast<decimal>(stepI >= 0 ? i + 1 : i);
-                     nextJ = static_cast<decimal>(stepJ >= 0 ? j + 1 : j);
-                     sizeI = aabbSize.y / nbCellsI;
-                     sizeJ = aabbSize.z / nbCellsJ;
-                     tMaxI = ((nextI * sizeI) - outHitGridPoint.y) / rayDirection.y;
-                     tMaxJ = ((nextJ * sizeJ) - outHitGridPoint.z) / rayDirection.z;
-                     tDeltaI = sizeI / std::abs(rayDirection.y);
-                     tDeltaJ = sizeJ / std::abs(rayDirection.z);
-                     break;
-            case 1 : stepI = rayDirection.x > 0 ? 1 : (rayDirection.x < 0 ? -1 : 0);
-                     stepJ = rayDirection.z > 0 ? 1 : (rayDirection.z < 0 ? -1 : 0);
-                     nextI = static_cast<decimal>(stepI >= 0 ? i + 1 : i);
-                     nextJ = static_cast<decimal>(stepJ >= 0 ? j + 1 : j);
-                     sizeI = aabbSize.x / nbCellsI;
-                     sizeJ = aabbSize.z / nbCellsJ;
-                     tMaxI = ((nextI * sizeI) - outHitGridPoint.x) / rayDirection.x;
-                     tMaxJ = ((nextJ * sizeJ) - outHitGridPoint.z) / rayDirection.z;
-                     tDeltaI = sizeI / std::abs(rayDirection.x);
-                     tDeltaJ = sizeJ / std::abs(rayDirection.z);
-                     break;
-            case 2 : stepI = rayDirection.x > 0 ? 1 : (rayDirection.x < 0 ? -1 : 0);
-                     stepJ = rayDirection.y > 0 ? 1 : (rayDirection.y < 0 ? -1 : 0);
-                     nextI = static_cast<decimal>(stepI >= 0 ? i + 1 : i);
-                     nextJ = static_cast<decimal>(stepJ >= 0 ? j + 1 : j);
-                     sizeI = aabbSize.x / nbCellsI;
-                     sizeJ = aabbSize.y / nbCellsJ;
-                     tMaxI = ((nextI * sizeI) - outHitGridPoint.x) / rayDirection.x;
-                     tMaxJ = ((nextJ * sizeJ) - outHitGridPoint.y) / rayDirection.y;
-                     tDeltaI = sizeI / std::abs(rayDirection.x);
-                     tDeltaJ = sizeJ / std::abs(rayDirection.y);
-                     break;
+    Stack<HeightFieldPyramidStackNode> stack(allocator, 64);
+    stack.push(HeightFieldPyramidStackNode{topLevel, 0, 0, entryFraction});
+
+    while (stack.size() > 0) {
+
+        const HeightFieldPyramidStackNode node = stack.pop();
+
+        // Skip the block if it is behind the closest hit found so far
+        if (node.entryFraction > smallestHitFraction) continue;
+
+        if (node.level == 0) {
+            isHit |= raycastBlockCells(node.blockI, node.blockJ, ray, scaledRay, rayDirectionInverse, collider, raycastInfo,
+                                       smallestHitFraction, allocator);
+            continue;
         }
 
-        decimal smallestHitFraction = ray.maxFraction;
+        // Compute the children blocks hit by the ray
+        const HeightFieldPyramidLevel& childLevel = mPyramidLevels[node.level - 1];
+        const int childSize = childLevel.blockSize;
+        HeightFieldPyramidStackNode children[4];
+        int nbChildren = 0;
+        for (int childJ = 2 * node.blockJ; childJ <= std::min(2 * node.blockJ + 1, childLevel.nbBlocksJ - 1); childJ++) {
+            for (int childI = 2 * node.blockI; childI <= std::min(2 * node.blockI + 1, childLevel.nbBlocksI - 1); childI++) {
+
+                // Skip the empty blocks (in unloaded tiles)
+                const HeightFieldBlockBounds& bounds = getBlockBounds(node.level - 1, childI, childJ);
+                if (bounds.minHeight > bounds.maxHeight) continue;
+
+                const AABB childAABB = computeCellsAABB(childI * childSize, childJ * childSize,
+                                                        std::min((childI + 1) * childSize, nbCellsI) - 1,
+                                                        std::min((childJ + 1) * childSize, nbCellsJ) - 1,
+                                                        bounds.minHeight, bounds.maxHeight);
+                if (childAABB.testRayIntersect(scaledRay.point1, rayDirectionInverse, smallestHitFraction, entryFraction)) {
+
+                    // Insert the child such that the children are sorted by decreasing entry fraction
+                    int index = nbChildren;
+                    while (index > 0 && children[index - 1].entryFraction < entryFraction) {
+                        children[index] = children[index - 1];
+                        index--;
+                    }
+                    children[index] = HeightFieldPyramidStackNode{node.level - 1, childI, childJ, entryFraction};
+                    nbChildren++;
+                }
+            }
+        }
 
-        while (i >= 0 && i < nbCellsI && j >= 0 && j < nbCellsJ) {
+        // Push the children such that the closest one is visited first
+        for (int c = 0; c < nbChildren; c++) {
+            stack.push(children[c]);
+        }
+    }
 
-           // Compute the four point of the current quad
-           const Vector3 p1 = getVertexAt(i, j);
-           const Vector3 p2 = getVertexAt(i, j + 1);
-           const Vector3 p3 = getVertexAt(i + 1, j);
-           const Vector3 p4 = getVertexAt(i + 1, j + 1);
+    return isHit;
+}
 
-           // Raycast against the first triangle of the cell
-           uint32 shapeId = computeTriangleShapeId(i, j, 0);
-           isHit |= raycastTriangle(ray, p1, p2, p3, shapeId, collider, raycastInfo, smallestHitFraction, allocator);
+// Raycast against the triangles of the cells of a block of the lowest level of the pyramid
+bool HeightFieldShape::raycastBlockCells(int blockI, int blockJ, const Ray& ray, const Ray& scaledRay, const Vector3& rayDirectionInverse,
+                                         Collider* collider, RaycastInfo& raycastInfo, decimal& smallestHitFraction,
+                                         MemoryAllocator& allocator) const {
 
-           // Raycast against the second triangle of the cell
-           shapeId = computeTriangleShapeId(i, j, 1);
-           isHit |= raycastTriangle(ray, p3, p2, p4, shapeId, collider, raycastInfo, smallestHitFraction, allocator);
+    const int iStart = blockI * PYRAMID_BLOCK_SIZE;
+    const int iEnd = std::min(iStart + PYRAMID_BLOCK_SIZE, mNbColumns - 1);
+    const int jStart = blockJ * PYRAMID_BLOCK_SIZE;
+    const int jEnd = std::min(jStart + PYRAMID_BLOCK_SIZE, mNbRows - 1);
 
-           if (stepI == 0 && stepJ == 0) break;
+    // Height values of two consecutive rows of vertices of the block
+    decimal heights[2 * (PYRAMID_BLOCK_SIZE + 1)];
+    decimal* rowHeights = &(heights[0]);
+    decimal* nextRowHeights = &(heights[PYRAMID_BLOCK_SIZE + 1]);
 
-           if (tMaxI < tMaxJ) {
-                tMaxI += tDeltaI;
-                i += stepI;
-            }
-            else {
-                tMaxJ += tDeltaJ;
-                j += stepJ;
+    bool isHit = false;
+
+    (this->*mReadHeightsFunction)(jStart, iStart, iEnd, rowHeights);
+
+    for (int j = jStart; j < jEnd; j++) {
+
+        (this->*mReadHeightsFunction)(j + 1, iStart, iEnd, nextRowHeights);
+
+        for (int i = iStart; i < iEnd; i++) {
+
+            const int k = i - iStart;
+
+            // Test the ray against the AABB of the cell
+            const decimal cellMinHeight = std::min(std::min(rowHeights[k], rowHeights[k + 1]),
+                                                   std::min(nextRowHeights[k], nextRowHeights[k + 1]));
+            const decimal cellMaxHeight = std::max(std::max(rowHeights[k], rowHeights[k + 1]),
+                                                   std::max(nextRowHeights[k], nextRowHeights[k + 1]));
+            if (!computeCellsAABB(i, j, i, j, cellMinHeight, cellMaxHeight)
+                  .testRayIntersect(scaledRay.point1, rayDirectionInverse, smallestHitFraction)) {
+                continue;
             }
+
+            // Compute the four point of the current quad
+            const Vector3 p1 = computeVertex(i, j, rowHeights[k]) * mScale;
+            const Vector3 p2 = computeVertex(i, j + 1, nextRowHeights[k]) * mScale;
+            const Vector3 p3 = computeVertex(i + 1, j, rowHeights[k + 1]) * mScale;
+            const Vector3 p4 = computeVertex(i + 1, j + 1, nextRowHeights[k + 1]) * mScale;
+
+            // Raycast against the first triangle of the cell
+            uint32 shapeId = computeTriangleShapeId(i, j, 0);
+            isHit |= raycastTriangle(ray, p1, p2, p3, shapeId, collider, raycastInfo, smallestHitFraction, allocator);
+
+            // Raycast against the second triangle of the cell
+            shapeId = computeTriangleShapeId(i, j, 1);
+            isHit |= raycastTriangle(ray, p3, p2, p4, shapeId, collider, raycastInfo, smallestHitFraction, allocator);
         }
+
+        std::swap(rowHeights, nextRowHeights);
     }
 
     return isHit;
@@ -373,69 +899,10 @@ bool HeightFieldShape::raycastTriangle(const Ray& ray, const Vector3& p1, const
     return false;
 }
 
-// Compute the first grid cell of the heightfield intersected by a ray.
-/// This method returns true if the ray hit the AABB of the height field and false otherwise
-bool HeightFieldShape::computeEnteringRayGridCoordinates(const Ray& ray, int& i, int& j, Vector3& outHitGridPoint) const {
-    
-    decimal stepI, stepJ;
-    const Vector3 aabbSize = mAABB.getExtent();
-
-    assert(mNbColumns > 0);
-    assert(mNbRows > 0);
-
-    const int nbCellsI = mNbColumns - 1;
-    const int nbCellsJ = mNbRows - 1;
-
-    if (mAABB.raycast(ray, outHitGridPoint)) {
-
-        // Map the hit point into the grid range [0, mNbColumns - 1], [0, mNbRows - 1]
-        outHitGridPoint -= mAABB.getMin();
-
-        switch(mUpAxis) {
-            case 0 : stepI = aabbSize.y / nbCellsI;
-                     stepJ = aabbSize.z / nbCellsJ;
-                     i = clamp(int(outHitGridPoint.y / stepI), 0, nbCellsI - 1);
-                     j = clamp(int(outHitGridPoint.z / stepJ), 0, nbCellsJ - 1);
-                     break;
-            case 1 : stepI = aabbSize.x / nbCellsI;
-                     stepJ = aabbSize.z / nbCellsJ;
-                     i = clamp(int(outHitGridPoint.x / stepI), 0, nbCellsI - 1);
-                     j = clamp(int(outHitGridPoint.z / stepJ), 0, nbCellsJ - 1);
-                     break;
-            case 2 : stepI = aabbSize.x / nbCellsI;
-                     stepJ = aabbSize.y / nbCellsJ;
-                     i = clamp(int(outHitGridPoint.x / stepI), 0, nbCellsI - 1);
-                     j = clamp(int(outHitGridPoint.y / stepJ), 0, nbCellsJ - 1);
-                     break;
-        }
-
-        assert(i >= 0 && i < nbCellsI);
-        assert(j >= 0 && j < nbCellsJ);
-        return true;
-    }
-    
-    return false;
-}
-
 // Return the vertex (local-coordinates) of the height field at a given (x,y) position
 Vector3 HeightFieldShape::getVertexAt(int x, int y) const {
 
-    // Get the height value
-    const decimal height = getHeightAt(x, y);
-
-    // Height values origin
-    const decimal heightOrigin = -(mMaxHeight - mMinHeight) * decimal(0.5) - mMinHeight;
-
-    Vector3 vertex;
-    switch (mUpAxis) {
-        case 0: vertex = Vector3(heightOrigin + height, -mWidth * decimal(0.5) + x, -mLength * decimal(0.5) + y);
-                break;
-        case 1: vertex = Vector3(-mWidth * decimal(0.5) + x, heightOrigin + height, -mLength * decimal(0.5) + y);
-                break;
-        case 2: vertex = Vector3(-mWidth * decimal(0.5) + x, -mLength * decimal(0.5) + y, heightOrigin + height);
-                break;
-        default: assert(false);
-    }
+    const Vector3 vertex = computeVertex(x, y, getHeightAt(x, y));
 
     assert(mAABB.contains(vertex));
 
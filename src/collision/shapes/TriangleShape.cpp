@@ -37,8 +37,10 @@ using namespace reactphysics3d;
 
 
 // Constructor
-TriangleShape::TriangleShape(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId, HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator)
-    : ConvexPolyhedronShape(CollisionShapeName::TRIANGLE, allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+TriangleShape::TriangleShape(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId, uint8 internalEdges,
+                             HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator)
+    : ConvexPolyhedronShape(CollisionShapeName::TRIANGLE, allocator), mInternalEdges(internalEdges),
+      mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
     mPoints[0] = vertices[0];
     mPoints[1] = vertices[1];
@@ -59,7 +61,7 @@ TriangleShape::TriangleShape(const Vector3* vertices, const Vector3* verticesNor
 
 // Constructor for raycasting
 TriangleShape::TriangleShape(const Vector3* vertices, uint32 shapeId, HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator)
-    : ConvexPolyhedronShape(CollisionShapeName::TRIANGLE, allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+    : ConvexPolyhedronShape(CollisionShapeName::TRIANGLE, allocator), mInternalEdges(0), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
     mPoints[0] = vertices[0];
     mPoints[1] = vertices[1];
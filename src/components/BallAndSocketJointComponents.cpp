@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/components/BallAndSocketJointComponents.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <reactphysics3d/mathematics/Matrix3x3.h>
 #include <cassert>
@@ -275,3 +276,29 @@ void BallAndSocketJointComponents::destroyComponent(uint32 index) {
     mImpulse[index].~Vector3();
     mConeLimitACrossB[index].~Vector3();
 }
+
+// Write the state of the components into a snapshot
+void BallAndSocketJointComponents::takeSnapshot(SnapshotWriter& writer) const {
+
+    Components::takeSnapshot(writer);
+
+    writer.writeBytes(mImpulse, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mConeLimitImpulse, mNbComponents * sizeof(decimal));
+}
+
+// Check that a snapshot of the components matches the components and skip it
+bool BallAndSocketJointComponents::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!Components::validateSnapshot(reader)) return false;
+
+    return reader.skipBytes(mNbComponents * (sizeof(Vector3) + sizeof(decimal)));
+}
+
+// Restore the state of the components from a snapshot
+void BallAndSocketJointComponents::restoreSnapshot(SnapshotReader& reader) {
+
+    Components::restoreSnapshot(reader);
+
+    reader.readBytes(mImpulse, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mConeLimitImpulse, mNbComponents * sizeof(decimal));
+}
@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/components/ColliderComponents.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <reactphysics3d/collision/Collider.h>
 #include <cassert>
@@ -237,3 +238,85 @@ void ColliderComponents::destroyComponent(uint32 index) {
     mOverlappingPairs[index].~Array<uint64>();
     mMaterials[index].~Material();
 }
+
+// Write the state of the components into a snapshot
+void ColliderComponents::takeSnapshot(SnapshotWriter& writer) const {
+
+    Components::takeSnapshot(writer);
+
+    writer.writeBytes(mLocalToWorldTransforms, mNbComponents * sizeof(Transform));
+
+    // Write the broad-phase id of each collider (a collider that is deactivated and activated
+    // again after the snapshot gets a new node in the broad-phase tree)
+    for (uint32 i=0; i < mNbComponents; i++) {
+        writer.write(mCollidersEntities[i]);
+        writer.write(mBroadPhaseIds[i]);
+    }
+
+    // Write the overlapping pairs of each collider
+    for (uint32 i=0; i < mNbComponents; i++) {
+
+        const uint32 nbOverlappingPairs = static_cast<uint32>(mOverlappingPairs[i].size());
+        writer.write(nbOverlappingPairs);
+        for (uint32 p=0; p < nbOverlappingPairs; p++) {
+            writer.write(mOverlappingPairs[i][p]);
+        }
+    }
+}
+
+// Check that a snapshot of the components matches the components and skip it
+bool ColliderComponents::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!Components::validateSnapshot(reader)) return false;
+
+    reader.skipBytes(mNbComponents * sizeof(Transform));
+
+    // A collider must be in the broad-phase in the snapshot if and only if it is in the broad-phase now
+    for (uint32 i=0; i < mNbComponents; i++) {
+
+        Entity colliderEntity(0, 0);
+        reader.readBytes(&colliderEntity, sizeof(Entity));
+        const int32 broadPhaseId = reader.read<int32>();
+
+        uint32 index;
+        if (reader.hasFailed() || !hasComponentGetIndex(colliderEntity, index) || broadPhaseId < -1 ||
+            (broadPhaseId == -1) != (mBroadPhaseIds[index] == -1)) {
+            return false;
+        }
+    }
+
+    // Skip the overlapping pairs of each collider
+    for (uint32 i=0; i < mNbComponents && !reader.hasFailed(); i++) {
+
+        const uint32 nbOverlappingPairs = reader.read<uint32>();
+        reader.skipBytes(nbOverlappingPairs * sizeof(uint64));
+    }
+
+    return !reader.hasFailed();
+}
+
+// Restore the state of the components from a snapshot
+void ColliderComponents::restoreSnapshot(SnapshotReader& reader) {
+
+    Components::restoreSnapshot(reader);
+
+    reader.readBytes(mLocalToWorldTransforms, mNbComponents * sizeof(Transform));
+
+    // Read the broad-phase id of each collider
+    for (uint32 i=0; i < mNbComponents; i++) {
+
+        Entity colliderEntity(0, 0);
+        reader.readBytes(&colliderEntity, sizeof(Entity));
+        mBroadPhaseIds[mMapEntityToComponentIndex[colliderEntity]] = reader.read<int32>();
+    }
+
+    // Read the overlapping pairs of each collider
+    for (uint32 i=0; i < mNbComponents; i++) {
+
+        mOverlappingPairs[i].clear();
+        const uint32 nbOverlappingPairs = reader.read<uint32>();
+        for (uint32 p=0; p < nbOverlappingPairs; p++) {
+            mOverlappingPairs[i].add(reader.read<uint64>());
+        }
+    }
+}
@@ -25,6 +25,8 @@
 
 // Libraries
 #include <reactphysics3d/components/Components.h>
+#include <reactphysics3d/utils/Snapshot.h>
+#include <reactphysics3d/containers/SmallArray.h>
 #include <cassert>
 
 // We want to use the ReactPhysics3D namespace
@@ -185,3 +187,141 @@ void Components::setIsEntityDisabled(Entity entity, bool isDisabled) {
     assert(mDisabledStartIndex <= mNbComponents);
     assert(mNbComponents == static_cast<uint32>(mMapEntityToComponentIndex.size()));
 }
+
+// Notify if a group of entities are disabled (sleeping) or not
+/// The components of all the entities are moved to the other side of the mDisabledStartIndex
+/// boundary with a single partition pass. The components of the group that already are in the
+/// slots next to the boundary stay in place and only the remaining ones are swapped into the
+/// free slots of that range. Entities that already have the requested state are ignored.
+void Components::setIsEntitiesDisabled(const Array<Entity>& entities, bool isDisabled) {
+
+    const uint32 nbEntities = static_cast<uint32>(entities.size());
+
+    // Indices of the components that need to change side
+    SmallArray<uint32, 64> indices(mMemoryAllocator);
+    indices.reserve(nbEntities);
+    for (uint32 i=0; i < nbEntities; i++) {
+
+        const uint32 index = mMapEntityToComponentIndex[entities[i]];
+        if (isDisabled == (index < mDisabledStartIndex)) {
+            indices.add(index);
+        }
+    }
+
+    const uint32 nbIndices = static_cast<uint32>(indices.size());
+    if (nbIndices == 0) return;
+
+    // Range of slots that the components will occupy at the end of the partition. If we disable
+    // the components, it is the end of the enabled range. Otherwise it is the beginning of the
+    // disabled range.
+    assert(isDisabled ? nbIndices <= mDisabledStartIndex : mDisabledStartIndex + nbIndices <= mNbComponents);
+    const uint32 rangeStart = isDisabled ? mDisabledStartIndex - nbIndices : mDisabledStartIndex;
+    const uint32 rangeEnd = rangeStart + nbIndices;
+
+    // Mark the slots of the range that are already occupied by a component of the group
+    SmallArray<bool, 64> isSlotTaken(mMemoryAllocator);
+    isSlotTaken.reserve(nbIndices);
+    for (uint32 i=0; i < nbIndices; i++) {
+        isSlotTaken.add(false);
+    }
+    for (uint32 i=0; i < nbIndices; i++) {
+        if (indices[i] >= rangeStart && indices[i] < rangeEnd) {
+            isSlotTaken[indices[i] - rangeStart] = true;
+        }
+    }
+
+    // Swap each component of the group that is outside of the range with a free slot of the range
+    uint32 freeSlot = 0;
+    for (uint32 i=0; i < nbIndices; i++) {
+
+        if (indices[i] >= rangeStart && indices[i] < rangeEnd) continue;
+
+        while (isSlotTaken[freeSlot]) {
+            freeSlot++;
+        }
+
+        assert(freeSlot < nbIndices);
+
+        swapComponents(indices[i], rangeStart + freeSlot);
+        isSlotTaken[freeSlot] = true;
+    }
+
+    mDisabledStartIndex = isDisabled ? rangeStart : rangeEnd;
+
+    assert(mDisabledStartIndex <= mNbComponents);
+    assert(mNbComponents == static_cast<uint32>(mMapEntityToComponentIndex.size()));
+}
+
+// Write the state of the components into a snapshot
+/// The base class writes the order of the entities in the components arrays. Derived
+/// classes write the state of their components after it, in the same order.
+void Components::takeSnapshot(SnapshotWriter& writer) const {
+
+    writer.write(mNbComponents);
+    writer.write(mDisabledStartIndex);
+
+    // Write the entities in the order of their components
+    const size_t entitiesOffset = writer.skipBytes(mNbComponents * sizeof(Entity));
+    for (auto it = mMapEntityToComponentIndex.begin(); it != mMapEntityToComponentIndex.end(); ++it) {
+        writer.writeAt(entitiesOffset, it->second, it->first);
+    }
+}
+
+// Check that a snapshot of the components matches the components and skip it
+/// The snapshot must contain each entity of the components exactly once. Derived classes
+/// also skip the state of their components. Nothing is changed in the components.
+/**
+ * @return False if the snapshot does not contain the same entities as the components
+ */
+bool Components::validateSnapshot(SnapshotReader& reader) const {
+
+    const uint32 nbComponents = reader.read<uint32>();
+    const uint32 disabledStartIndex = reader.read<uint32>();
+
+    if (reader.hasFailed() || nbComponents != mNbComponents || disabledStartIndex > nbComponents) return false;
+
+    // Each entity must be found once in the snapshot
+    Array<bool> isEntityFound(mMemoryAllocator, nbComponents);
+    for (uint32 i=0; i < nbComponents; i++) {
+        isEntityFound.add(false);
+    }
+
+    for (uint32 i=0; i < nbComponents; i++) {
+
+        Entity entity(0, 0);
+        if (!reader.readBytes(&entity, sizeof(Entity))) return false;
+
+        uint32 index;
+        if (!hasComponentGetIndex(entity, index) || isEntityFound[index]) return false;
+
+        isEntityFound[index] = true;
+    }
+
+    return true;
+}
+
+// Restore the state of the components from a snapshot
+/// The components are swapped such that they are in the same order as when the snapshot
+/// has been taken. The snapshot must have been checked with validateSnapshot() before.
+void Components::restoreSnapshot(SnapshotReader& reader) {
+
+    const uint32 nbComponents = reader.read<uint32>();
+    const uint32 disabledStartIndex = reader.read<uint32>();
+
+    assert(nbComponents == mNbComponents);
+
+    for (uint32 i=0; i < nbComponents; i++) {
+
+        Entity entity(0, 0);
+        reader.readBytes(&entity, sizeof(Entity));
+
+        const uint32 index = mMapEntityToComponentIndex[entity];
+        if (index != i) {
+            swapComponents(i, index);
+        }
+    }
+
+    mDisabledStartIndex = disabledStartIndex;
+
+    assert(mDisabledStartIndex <= mNbComponents);
+}
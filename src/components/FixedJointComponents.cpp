@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/components/FixedJointComponents.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <reactphysics3d/mathematics/Matrix3x3.h>
 #include <cassert>
@@ -257,3 +258,29 @@ void FixedJointComponents::destroyComponent(uint32 index) {
     mBiasRotation[index].~Vector3();
     mInitOrientationDifferenceInv[index].~Quaternion();
 }
+
+// Write the state of the components into a snapshot
+void FixedJointComponents::takeSnapshot(SnapshotWriter& writer) const {
+
+    Components::takeSnapshot(writer);
+
+    writer.writeBytes(mImpulseTranslation, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mImpulseRotation, mNbComponents * sizeof(Vector3));
+}
+
+// Check that a snapshot of the components matches the components and skip it
+bool FixedJointComponents::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!Components::validateSnapshot(reader)) return false;
+
+    return reader.skipBytes(mNbComponents * (sizeof(Vector3) + sizeof(Vector3)));
+}
+
+// Restore the state of the components from a snapshot
+void FixedJointComponents::restoreSnapshot(SnapshotReader& reader) {
+
+    Components::restoreSnapshot(reader);
+
+    reader.readBytes(mImpulseTranslation, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mImpulseRotation, mNbComponents * sizeof(Vector3));
+}
@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/components/RigidBodyComponents.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <reactphysics3d/body/RigidBody.h>
 #include <cassert>
@@ -43,8 +44,9 @@ RigidBodyComponents::RigidBodyComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + + sizeof(Matrix3x3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Quaternion) + sizeof(Vector3) + sizeof(Vector3) +
-                                sizeof(bool) + sizeof(bool) + sizeof(Array<Entity>) + sizeof(Array<uint>) +
-                                sizeof(Vector3) + sizeof(Vector3)) {
+                                sizeof(bool) + sizeof(bool) + sizeof(Array<Entity>) + sizeof(SmallArray<uint, 4>) +
+                                sizeof(Vector3) + sizeof(Vector3) + sizeof(Entity) + sizeof(Entity) +
+                                sizeof(uint32) + sizeof(bool)) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -91,9 +93,13 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     bool* newIsGravityEnabled = reinterpret_cast<bool*>(newCentersOfMassWorld + nbComponentsToAllocate);
     bool* newIsAlreadyInIsland = reinterpret_cast<bool*>(newIsGravityEnabled + nbComponentsToAllocate);
     Array<Entity>* newJoints = reinterpret_cast<Array<Entity>*>(newIsAlreadyInIsland + nbComponentsToAllocate);
-    Array<uint>* newContactPairs = reinterpret_cast<Array<uint>*>(newJoints + nbComponentsToAllocate);
+    SmallArray<uint, 4>* newContactPairs = reinterpret_cast<SmallArray<uint, 4>*>(newJoints + nbComponentsToAllocate);
     Vector3* newLinearLockAxisFactors = reinterpret_cast<Vector3*>(newContactPairs + nbComponentsToAllocate);
     Vector3* newAngularLockAxisFactors = reinterpret_cast<Vector3*>(newLinearLockAxisFactors + nbComponentsToAllocate);
+    Entity* newPreviousBodiesInSleepingIsland = reinterpret_cast<Entity*>(newAngularLockAxisFactors + nbComponentsToAllocate);
+    Entity* newNextBodiesInSleepingIsland = reinterpret_cast<Entity*>(newPreviousBodiesInSleepingIsland + nbComponentsToAllocate);
+    uint32* newBodyIndicesInWorld = reinterpret_cast<uint32*>(newNextBodiesInSleepingIsland + nbComponentsToAllocate);
+    bool* newHasChangedSinceLastExport = reinterpret_cast<bool*>(newBodyIndicesInWorld + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -127,9 +133,19 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newIsGravityEnabled, mIsGravityEnabled, mNbComponents * sizeof(bool));
         memcpy(newIsAlreadyInIsland, mIsAlreadyInIsland, mNbComponents * sizeof(bool));
         memcpy(newJoints, mJoints, mNbComponents * sizeof(Array<Entity>));
-        memcpy(newContactPairs, mContactPairs, mNbComponents * sizeof(Array<uint>));
+
+        // The arrays of contact pairs cannot be moved with memcpy because they use their own inline buffer
+        for (uint32 i=0; i < mNbComponents; i++) {
+            new (newContactPairs + i) SmallArray<uint, 4>(mContactPairs[i]);
+            mContactPairs[i].~SmallArray<uint, 4>();
+        }
+
         memcpy(newLinearLockAxisFactors, mLinearLockAxisFactors, mNbComponents * sizeof(Vector3));
         memcpy(newAngularLockAxisFactors, mAngularLockAxisFactors, mNbComponents * sizeof(Vector3));
+        memcpy(newPreviousBodiesInSleepingIsland, mPreviousBodiesInSleepingIsland, mNbComponents * sizeof(Entity));
+        memcpy(newNextBodiesInSleepingIsland, mNextBodiesInSleepingIsland, mNbComponents * sizeof(Entity));
+        memcpy(newHasChangedSinceLastExport, mHasChangedSinceLastExport, mNbComponents * sizeof(bool));
+        memcpy(newBodyIndicesInWorld, mBodyIndicesInWorld, mNbComponents * sizeof(uint32));
 
         // Deallocate previous memory
         mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
@@ -168,6 +184,10 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mContactPairs = newContactPairs;
     mLinearLockAxisFactors = newLinearLockAxisFactors;
     mAngularLockAxisFactors = newAngularLockAxisFactors;
+    mPreviousBodiesInSleepingIsland = newPreviousBodiesInSleepingIsland;
+    mNextBodiesInSleepingIsland = newNextBodiesInSleepingIsland;
+    mHasChangedSinceLastExport = newHasChangedSinceLastExport;
+    mBodyIndicesInWorld = newBodyIndicesInWorld;
 }
 
 // Add a component
@@ -205,9 +225,13 @@ void RigidBodyComponents::addComponent(Entity bodyEntity, bool isSleeping, const
     mIsGravityEnabled[index] = true;
     mIsAlreadyInIsland[index] = false;
     new (mJoints + index) Array<Entity>(mMemoryAllocator);
-    new (mContactPairs + index) Array<uint>(mMemoryAllocator);
+    new (mContactPairs + index) SmallArray<uint, 4>(mMemoryAllocator);
     new (mLinearLockAxisFactors + index) Vector3(1, 1, 1);
     new (mAngularLockAxisFactors + index) Vector3(1, 1, 1);
+    new (mPreviousBodiesInSleepingIsland + index) Entity(bodyEntity);
+    new (mNextBodiesInSleepingIsland + index) Entity(bodyEntity);
+    mHasChangedSinceLastExport[index] = true;
+    mBodyIndicesInWorld[index] = 0;
 
     // Map the entity with the new component lookup index
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(bodyEntity, index));
@@ -253,9 +277,13 @@ void RigidBodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex
     mIsGravityEnabled[destIndex] = mIsGravityEnabled[srcIndex];
     mIsAlreadyInIsland[destIndex] = mIsAlreadyInIsland[srcIndex];
     new (mJoints + destIndex) Array<Entity>(mJoints[srcIndex]);
-    new (mContactPairs + destIndex) Array<uint>(mContactPairs[srcIndex]);
+    new (mContactPairs + destIndex) SmallArray<uint, 4>(mContactPairs[srcIndex]);
     new (mLinearLockAxisFactors + destIndex) Vector3(mLinearLockAxisFactors[srcIndex]);
     new (mAngularLockAxisFactors + destIndex) Vector3(mAngularLockAxisFactors[srcIndex]);
+    new (mPreviousBodiesInSleepingIsland + destIndex) Entity(mPreviousBodiesInSleepingIsland[srcIndex]);
+    new (mNextBodiesInSleepingIsland + destIndex) Entity(mNextBodiesInSleepingIsland[srcIndex]);
+    mHasChangedSinceLastExport[destIndex] = mHasChangedSinceLastExport[srcIndex];
+    mBodyIndicesInWorld[destIndex] = mBodyIndicesInWorld[srcIndex];
 
     // Destroy the source component
     destroyComponent(srcIndex);
@@ -300,9 +328,13 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     bool isGravityEnabled1 = mIsGravityEnabled[index1];
     bool isAlreadyInIsland1 = mIsAlreadyInIsland[index1];
     Array<Entity> joints1 = mJoints[index1];
-    Array<uint> contactPairs1 = mContactPairs[index1];
+    SmallArray<uint, 4> contactPairs1 = mContactPairs[index1];
     Vector3 linearLockAxisFactor1(mLinearLockAxisFactors[index1]);
     Vector3 angularLockAxisFactor1(mAngularLockAxisFactors[index1]);
+    Entity previousBodyInSleepingIsland1(mPreviousBodiesInSleepingIsland[index1]);
+    Entity nextBodyInSleepingIsland1(mNextBodiesInSleepingIsland[index1]);
+    bool hasChangedSinceLastExport1 = mHasChangedSinceLastExport[index1];
+    uint32 bodyIndexInWorld1 = mBodyIndicesInWorld[index1];
 
     // Destroy component 1
     destroyComponent(index1);
@@ -338,9 +370,13 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     mIsGravityEnabled[index2] = isGravityEnabled1;
     mIsAlreadyInIsland[index2] = isAlreadyInIsland1;
     new (mJoints + index2) Array<Entity>(joints1);
-    new (mContactPairs + index2) Array<uint>(contactPairs1);
+    new (mContactPairs + index2) SmallArray<uint, 4>(contactPairs1);
     new (mLinearLockAxisFactors + index2) Vector3(linearLockAxisFactor1);
     new (mAngularLockAxisFactors + index2) Vector3(angularLockAxisFactor1);
+    new (mPreviousBodiesInSleepingIsland + index2) Entity(previousBodyInSleepingIsland1);
+    new (mNextBodiesInSleepingIsland + index2) Entity(nextBodyInSleepingIsland1);
+    mHasChangedSinceLastExport[index2] = hasChangedSinceLastExport1;
+    mBodyIndicesInWorld[index2] = bodyIndexInWorld1;
 
     // Update the entity to component index mapping
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(entity1, index2));
@@ -377,7 +413,57 @@ void RigidBodyComponents::destroyComponent(uint32 index) {
     mCentersOfMassLocal[index].~Vector3();
     mCentersOfMassWorld[index].~Vector3();
     mJoints[index].~Array<Entity>();
-    mContactPairs[index].~Array<uint>();
+    mContactPairs[index].~SmallArray<uint, 4>();
     mLinearLockAxisFactors[index].~Vector3();
     mAngularLockAxisFactors[index].~Vector3();
+    mPreviousBodiesInSleepingIsland[index].~Entity();
+    mNextBodiesInSleepingIsland[index].~Entity();
+}
+
+// Write the state of the components into a snapshot
+void RigidBodyComponents::takeSnapshot(SnapshotWriter& writer) const {
+
+    Components::takeSnapshot(writer);
+
+    writer.writeBytes(mIsSleeping, mNbComponents * sizeof(bool));
+    writer.writeBytes(mSleepTimes, mNbComponents * sizeof(decimal));
+    writer.writeBytes(mLinearVelocities, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mAngularVelocities, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mExternalForces, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mExternalTorques, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mInverseInertiaTensorsWorld, mNbComponents * sizeof(Matrix3x3));
+    writer.writeBytes(mCentersOfMassWorld, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mPreviousBodiesInSleepingIsland, mNbComponents * sizeof(Entity));
+    writer.writeBytes(mNextBodiesInSleepingIsland, mNbComponents * sizeof(Entity));
+}
+
+// Check that a snapshot of the components matches the components and skip it
+bool RigidBodyComponents::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!Components::validateSnapshot(reader)) return false;
+
+    return reader.skipBytes(mNbComponents * (sizeof(bool) + sizeof(decimal) + 4 * sizeof(Vector3) + sizeof(Matrix3x3) +
+                                             sizeof(Vector3) + 2 * sizeof(Entity)));
+}
+
+// Restore the state of the components from a snapshot
+void RigidBodyComponents::restoreSnapshot(SnapshotReader& reader) {
+
+    Components::restoreSnapshot(reader);
+
+    reader.readBytes(mIsSleeping, mNbComponents * sizeof(bool));
+    reader.readBytes(mSleepTimes, mNbComponents * sizeof(decimal));
+    reader.readBytes(mLinearVelocities, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mAngularVelocities, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mExternalForces, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mExternalTorques, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mInverseInertiaTensorsWorld, mNbComponents * sizeof(Matrix3x3));
+    reader.readBytes(mCentersOfMassWorld, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mPreviousBodiesInSleepingIsland, mNbComponents * sizeof(Entity));
+    reader.readBytes(mNextBodiesInSleepingIsland, mNbComponents * sizeof(Entity));
+
+    // The state of all the bodies has changed for the next export
+    for (uint32 i=0; i < mNbComponents; i++) {
+        mHasChangedSinceLastExport[i] = true;
+    }
 }
@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/components/SliderJointComponents.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <reactphysics3d/mathematics/Matrix3x3.h>
 #include <cassert>
@@ -449,3 +450,35 @@ void SliderJointComponents::destroyComponent(uint32 index) {
     mR1PlusUCrossN2[index].~Vector3();
     mR1PlusUCrossSliderAxis[index].~Vector3();
 }
+
+// Write the state of the components into a snapshot
+void SliderJointComponents::takeSnapshot(SnapshotWriter& writer) const {
+
+    Components::takeSnapshot(writer);
+
+    writer.writeBytes(mImpulseTranslation, mNbComponents * sizeof(Vector2));
+    writer.writeBytes(mImpulseRotation, mNbComponents * sizeof(Vector3));
+    writer.writeBytes(mImpulseLowerLimit, mNbComponents * sizeof(decimal));
+    writer.writeBytes(mImpulseUpperLimit, mNbComponents * sizeof(decimal));
+    writer.writeBytes(mImpulseMotor, mNbComponents * sizeof(decimal));
+}
+
+// Check that a snapshot of the components matches the components and skip it
+bool SliderJointComponents::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!Components::validateSnapshot(reader)) return false;
+
+    return reader.skipBytes(mNbComponents * (sizeof(Vector2) + sizeof(Vector3) + 3 * sizeof(decimal)));
+}
+
+// Restore the state of the components from a snapshot
+void SliderJointComponents::restoreSnapshot(SnapshotReader& reader) {
+
+    Components::restoreSnapshot(reader);
+
+    reader.readBytes(mImpulseTranslation, mNbComponents * sizeof(Vector2));
+    reader.readBytes(mImpulseRotation, mNbComponents * sizeof(Vector3));
+    reader.readBytes(mImpulseLowerLimit, mNbComponents * sizeof(decimal));
+    reader.readBytes(mImpulseUpperLimit, mNbComponents * sizeof(decimal));
+    reader.readBytes(mImpulseMotor, mNbComponents * sizeof(decimal));
+}
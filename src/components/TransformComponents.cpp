@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/components/TransformComponents.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EntityManager.h>
 #include <cassert>
 #include <random>
@@ -35,7 +36,7 @@ using namespace reactphysics3d;
 
 // Constructor
 TransformComponents::TransformComponents(MemoryAllocator& allocator)
-                    :Components(allocator, sizeof(Entity) + sizeof(Transform)) {
+                    :Components(allocator, sizeof(Entity) + sizeof(Transform) + sizeof(Transform) + sizeof(bool)) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -56,12 +57,16 @@ void TransformComponents::allocate(uint32 nbComponentsToAllocate) {
     // New pointers to components data
     Entity* newEntities = static_cast<Entity*>(newBuffer);
     Transform* newTransforms = reinterpret_cast<Transform*>(newEntities + nbComponentsToAllocate);
+    Transform* newPreviousTransforms = reinterpret_cast<Transform*>(newTransforms + nbComponentsToAllocate);
+    bool* newIsMovedSinceLastStep = reinterpret_cast<bool*>(newPreviousTransforms + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
 
         // Copy component data from the previous buffer to the new one
         memcpy(newTransforms, mTransforms, mNbComponents * sizeof(Transform));
+        memcpy(newPreviousTransforms, mPreviousTransforms, mNbComponents * sizeof(Transform));
+        memcpy(newIsMovedSinceLastStep, mIsMovedSinceLastStep, mNbComponents * sizeof(bool));
         memcpy(newEntities, mBodies, mNbComponents * sizeof(Entity));
 
         // Deallocate previous memory
@@ -71,6 +76,8 @@ void TransformComponents::allocate(uint32 nbComponentsToAllocate) {
     mBuffer = newBuffer;
     mBodies = newEntities;
     mTransforms = newTransforms;
+    mPreviousTransforms = newPreviousTransforms;
+    mIsMovedSinceLastStep = newIsMovedSinceLastStep;
     mNbAllocatedComponents = nbComponentsToAllocate;
 }
 
@@ -83,6 +90,8 @@ void TransformComponents::addComponent(Entity bodyEntity, bool isSleeping, const
     // Insert the new component data
     new (mBodies + index) Entity(bodyEntity);
     new (mTransforms + index) Transform(component.transform);
+    new (mPreviousTransforms + index) Transform(component.transform);
+    mIsMovedSinceLastStep[index] = false;
 
     // Map the entity with the new component lookup index
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(bodyEntity, index));
@@ -102,6 +111,8 @@ void TransformComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex
     // Copy the data of the source component to the destination location
     new (mBodies + destIndex) Entity(mBodies[srcIndex]);
     new (mTransforms + destIndex) Transform(mTransforms[srcIndex]);
+    new (mPreviousTransforms + destIndex) Transform(mPreviousTransforms[srcIndex]);
+    mIsMovedSinceLastStep[destIndex] = mIsMovedSinceLastStep[srcIndex];
 
     // Destroy the source component
     destroyComponent(srcIndex);
@@ -120,6 +131,8 @@ void TransformComponents::swapComponents(uint32 index1, uint32 index2) {
     // Copy component 1 data
     Entity entity1(mBodies[index1]);
     Transform transform1(mTransforms[index1]);
+    Transform previousTransform1(mPreviousTransforms[index1]);
+    const bool isMovedSinceLastStep1 = mIsMovedSinceLastStep[index1];
 
     // Destroy component 1
     destroyComponent(index1);
@@ -129,6 +142,8 @@ void TransformComponents::swapComponents(uint32 index1, uint32 index2) {
     // Reconstruct component 1 at component 2 location
     new (mBodies + index2) Entity(entity1);
     new (mTransforms + index2) Transform(transform1);
+    new (mPreviousTransforms + index2) Transform(previousTransform1);
+    mIsMovedSinceLastStep[index2] = isMovedSinceLastStep1;
 
     // Update the entity to component index mapping
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(entity1, index2));
@@ -149,4 +164,33 @@ void TransformComponents::destroyComponent(uint32 index) {
 
     mBodies[index].~Entity();
     mTransforms[index].~Transform();
+    mPreviousTransforms[index].~Transform();
+}
+
+// Write the state of the components into a snapshot
+void TransformComponents::takeSnapshot(SnapshotWriter& writer) const {
+
+    Components::takeSnapshot(writer);
+
+    writer.writeBytes(mTransforms, mNbComponents * sizeof(Transform));
+    writer.writeBytes(mPreviousTransforms, mNbComponents * sizeof(Transform));
+    writer.writeBytes(mIsMovedSinceLastStep, mNbComponents * sizeof(bool));
+}
+
+// Check that a snapshot of the components matches the components and skip it
+bool TransformComponents::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!Components::validateSnapshot(reader)) return false;
+
+    return reader.skipBytes(mNbComponents * (2 * sizeof(Transform) + sizeof(bool)));
+}
+
+// Restore the state of the components from a snapshot
+void TransformComponents::restoreSnapshot(SnapshotReader& reader) {
+
+    Components::restoreSnapshot(reader);
+
+    reader.readBytes(mTransforms, mNbComponents * sizeof(Transform));
+    reader.readBytes(mPreviousTransforms, mNbComponents * sizeof(Transform));
+    reader.readBytes(mIsMovedSinceLastStep, mNbComponents * sizeof(bool));
 }
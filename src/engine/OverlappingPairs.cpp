@@ -31,12 +31,13 @@
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/utils/Snapshot.h>
 
 using namespace reactphysics3d;
 
 // Constructor
 OverlappingPairs::OverlappingPairs(MemoryManager& memoryManager, ColliderComponents& colliderComponents,
-                                   CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents, Set<bodypair> &noCollisionPairs, CollisionDispatch &collisionDispatch)
+                                   CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents, FlatSet<bodypair> &noCollisionPairs, CollisionDispatch &collisionDispatch)
                 : mPoolAllocator(memoryManager.getPoolAllocator()), mHeapAllocator(memoryManager.getHeapAllocator()), mConvexPairs(memoryManager.getHeapAllocator()),
                   mConcavePairs(memoryManager.getHeapAllocator()), mMapConvexPairIdToPairIndex(memoryManager.getHeapAllocator()), mMapConcavePairIdToPairIndex(memoryManager.getHeapAllocator()),
                   mColliderComponents(colliderComponents), mCollisionBodyComponents(collisionBodyComponents),
@@ -86,10 +87,7 @@ void OverlappingPairs::removePair(uint64 pairIndex, bool isConvexVsConvex) {
         assert(pairIndex < nbConvexPairs);
 
         // Remove the involved overlapping pair from the two colliders
-        assert(mColliderComponents.getOverlappingPairs(mConvexPairs[pairIndex].collider1).find(mConvexPairs[pairIndex].pairID) != mColliderComponents.getOverlappingPairs(mConvexPairs[pairIndex].collider1).end());
-        assert(mColliderComponents.getOverlappingPairs(mConvexPairs[pairIndex].collider2).find(mConvexPairs[pairIndex].pairID) != mColliderComponents.getOverlappingPairs(mConvexPairs[pairIndex].collider2).end());
-        mColliderComponents.getOverlappingPairs(mConvexPairs[pairIndex].collider1).remove(mConvexPairs[pairIndex].pairID);
-        mColliderComponents.getOverlappingPairs(mConvexPairs[pairIndex].collider2).remove(mConvexPairs[pairIndex].pairID);
+        removePairFromColliders(mConvexPairs[pairIndex]);
 
         assert(mMapConvexPairIdToPairIndex[mConvexPairs[pairIndex].pairID] == pairIndex);
         mMapConvexPairIdToPairIndex.remove(mConvexPairs[pairIndex].pairID);
@@ -111,10 +109,7 @@ void OverlappingPairs::removePair(uint64 pairIndex, bool isConvexVsConvex) {
         assert(pairIndex < nbConcavePairs);
 
         // Remove the involved overlapping pair to the two colliders
-        assert(mColliderComponents.getOverlappingPairs(mConcavePairs[pairIndex].collider1).find(mConcavePairs[pairIndex].pairID) != mColliderComponents.getOverlappingPairs(mConcavePairs[pairIndex].collider1).end());
-        assert(mColliderComponents.getOverlappingPairs(mConcavePairs[pairIndex].collider2).find(mConcavePairs[pairIndex].pairID) != mColliderComponents.getOverlappingPairs(mConcavePairs[pairIndex].collider2).end());
-        mColliderComponents.getOverlappingPairs(mConcavePairs[pairIndex].collider1).remove(mConcavePairs[pairIndex].pairID);
-        mColliderComponents.getOverlappingPairs(mConcavePairs[pairIndex].collider2).remove(mConcavePairs[pairIndex].pairID);
+        removePairFromColliders(mConcavePairs[pairIndex]);
 
         assert(mMapConcavePairIdToPairIndex[mConcavePairs[pairIndex].pairID] == pairIndex);
         mMapConcavePairIdToPairIndex.remove(mConcavePairs[pairIndex].pairID);
@@ -134,6 +129,108 @@ void OverlappingPairs::removePair(uint64 pairIndex, bool isConvexVsConvex) {
     }
 }
 
+// Remove all the pairs whose index is set in a bit set of pairs
+/// This method removes many pairs at once. The removed pairs are detached from their colliders,
+/// the array of pairs is compacted in a single pass from the first removed pair and the map from
+/// pair ids to pair indices is only updated for the pairs that are removed or moved.
+void OverlappingPairs::removePairs(const Array<uint64>& pairsToRemove, bool isConvexVsConvex) {
+
+    RP3D_PROFILE("OverlappingPairs::removePairs()", mProfiler);
+
+    if (isConvexVsConvex) {
+
+        const uint64 nbConvexPairs = mConvexPairs.size();
+        assert(pairsToRemove.size() * 64 >= nbConvexPairs);
+
+        // Find the first pair to remove (the pairs before it keep their index)
+        uint64 firstHoleIndex = 0;
+        while (firstHoleIndex < nbConvexPairs && !isPairInBitSet(pairsToRemove, firstHoleIndex)) {
+            firstHoleIndex++;
+        }
+
+        if (firstHoleIndex == nbConvexPairs) return;
+
+        // Compact the array in a stable way from the first hole (the remaining pairs keep their relative
+        // order) and only update the mapping of the pairs that are removed or moved
+        uint64 nbKeptPairs = firstHoleIndex;
+        for (uint64 i=firstHoleIndex; i < nbConvexPairs; i++) {
+
+            if (isPairInBitSet(pairsToRemove, i)) {
+
+                // Remove the involved overlapping pair from the two colliders
+                removePairFromColliders(mConvexPairs[i]);
+
+                mMapConvexPairIdToPairIndex.remove(mConvexPairs[i].pairID);
+            }
+            else {
+
+                mConvexPairs[nbKeptPairs] = mConvexPairs[i];
+                mMapConvexPairIdToPairIndex[mConvexPairs[nbKeptPairs].pairID] = nbKeptPairs;
+
+                nbKeptPairs++;
+            }
+        }
+
+        // Destroy the remaining pairs at the end of the array
+        while (mConvexPairs.size() > nbKeptPairs) {
+            mConvexPairs.removeAt(mConvexPairs.size() - 1);
+        }
+    }
+    else {
+
+        const uint64 nbConcavePairs = mConcavePairs.size();
+        assert(pairsToRemove.size() * 64 >= nbConcavePairs);
+
+        // Copying a concave pair also copies its map of last frame collision infos. Therefore, the
+        // holes of the array are filled with the last remaining pairs so that we only copy one pair
+        // for each removed pair.
+        uint64 endIndex = nbConcavePairs;
+        for (uint64 i=0; i < endIndex; i++) {
+
+            if (!isPairInBitSet(pairsToRemove, i)) continue;
+
+            // Remove the involved overlapping pair to the two colliders
+            removePairFromColliders(mConcavePairs[i]);
+
+            mMapConcavePairIdToPairIndex.remove(mConcavePairs[i].pairID);
+
+            // Destroy all the LastFrameCollisionInfo objects
+            mConcavePairs[i].destroyLastFrameCollisionInfos();
+
+            // Find the last pair of the array that is not removed
+            while (endIndex > i + 1 && isPairInBitSet(pairsToRemove, endIndex - 1)) {
+
+                endIndex--;
+
+                removePairFromColliders(mConcavePairs[endIndex]);
+                mMapConcavePairIdToPairIndex.remove(mConcavePairs[endIndex].pairID);
+                mConcavePairs[endIndex].destroyLastFrameCollisionInfos();
+            }
+            endIndex--;
+
+            // Move this pair into the hole
+            if (endIndex > i) {
+                mConcavePairs[i] = mConcavePairs[endIndex];
+                mMapConcavePairIdToPairIndex[mConcavePairs[i].pairID] = i;
+            }
+        }
+
+        // Destroy the remaining pairs at the end of the array
+        while (mConcavePairs.size() > endIndex) {
+            mConcavePairs.removeAt(mConcavePairs.size() - 1);
+        }
+    }
+}
+
+// Remove an overlapping pair from the arrays of pairs of its two colliders
+void OverlappingPairs::removePairFromColliders(const OverlappingPair& pair) {
+
+    assert(mColliderComponents.getOverlappingPairs(pair.collider1).find(pair.pairID) != mColliderComponents.getOverlappingPairs(pair.collider1).end());
+    assert(mColliderComponents.getOverlappingPairs(pair.collider2).find(pair.pairID) != mColliderComponents.getOverlappingPairs(pair.collider2).end());
+    mColliderComponents.getOverlappingPairs(pair.collider1).remove(pair.pairID);
+    mColliderComponents.getOverlappingPairs(pair.collider2).remove(pair.pairID);
+}
+
 // Add an overlapping pair
 uint64 OverlappingPairs::addPair(uint32 collider1Index, uint32 collider2Index, bool isConvexVsConvex) {
 
@@ -157,7 +254,7 @@ uint64 OverlappingPairs::addPair(uint32 collider1Index, uint32 collider2Index, b
     if (isConvexVsConvex) {
 
         assert(!mMapConvexPairIdToPairIndex.containsKey(pairId));
-        NarrowPhaseAlgorithmType algorithmType = mCollisionDispatch.selectNarrowPhaseAlgorithm(collisionShape1->getType(), collisionShape2->getType());
+        NarrowPhaseAlgorithmType algorithmType = mCollisionDispatch.selectNarrowPhaseAlgorithm(collisionShape1, collisionShape2);
 
         // Map the entity with the new component lookup index
         mMapConvexPairIdToPairIndex.add(Pair<uint64, uint64>(pairId, mConvexPairs.size()));
@@ -221,3 +318,147 @@ void OverlappingPairs::updateCollidingInPreviousFrame() {
         mConcavePairs[i].collidingInPreviousFrame = mConcavePairs[i].collidingInCurrentFrame;
     }
 }
+
+// Write the overlapping pairs into a snapshot
+void OverlappingPairs::takeSnapshot(SnapshotWriter& writer) const {
+
+    // Write the convex pairs
+    const uint32 nbConvexPairs = static_cast<uint32>(mConvexPairs.size());
+    writer.write(nbConvexPairs);
+    for (uint32 i=0; i < nbConvexPairs; i++) {
+
+        const ConvexOverlappingPair& pair = mConvexPairs[i];
+        writer.write(pair.pairID);
+        writer.write(pair.broadPhaseId1);
+        writer.write(pair.broadPhaseId2);
+        writer.write(pair.collider1);
+        writer.write(pair.collider2);
+        writer.write(pair.needToTestOverlap);
+        writer.write(pair.narrowPhaseAlgorithmType);
+        writer.write(pair.collidingInPreviousFrame);
+        writer.write(pair.collidingInCurrentFrame);
+        writer.write(pair.lastFrameCollisionInfo);
+    }
+
+    // Write the concave pairs
+    const uint32 nbConcavePairs = static_cast<uint32>(mConcavePairs.size());
+    writer.write(nbConcavePairs);
+    for (uint32 i=0; i < nbConcavePairs; i++) {
+
+        const ConcaveOverlappingPair& pair = mConcavePairs[i];
+        writer.write(pair.pairID);
+        writer.write(pair.broadPhaseId1);
+        writer.write(pair.broadPhaseId2);
+        writer.write(pair.collider1);
+        writer.write(pair.collider2);
+        writer.write(pair.needToTestOverlap);
+        writer.write(pair.narrowPhaseAlgorithmType);
+        writer.write(pair.collidingInPreviousFrame);
+        writer.write(pair.collidingInCurrentFrame);
+        writer.write(pair.isShape1Convex);
+
+        writer.write(static_cast<uint32>(pair.lastFrameCollisionInfos.size()));
+        for (auto it = pair.lastFrameCollisionInfos.begin(); it != pair.lastFrameCollisionInfos.end(); ++it) {
+            writer.write(it->first);
+            writer.write(*(it->second));
+        }
+    }
+}
+
+// Check that a snapshot of the overlapping pairs is complete and skip it
+bool OverlappingPairs::validateSnapshot(SnapshotReader& reader) const {
+
+    // Size of the state of a pair that is common to the convex and concave pairs
+    const size_t pairSize = sizeof(uint64) + 2 * sizeof(int32) + 2 * sizeof(Entity) + sizeof(bool) +
+                            sizeof(NarrowPhaseAlgorithmType) + 2 * sizeof(bool);
+
+    // Skip the convex pairs
+    const uint32 nbConvexPairs = reader.read<uint32>();
+    reader.skipBytes(nbConvexPairs * (pairSize + sizeof(LastFrameCollisionInfo)));
+
+    // Skip the concave pairs
+    const uint32 nbConcavePairs = reader.read<uint32>();
+    for (uint32 i=0; i < nbConcavePairs && !reader.hasFailed(); i++) {
+
+        reader.skipBytes(pairSize + sizeof(bool));
+
+        const uint32 nbLastFrameInfos = reader.read<uint32>();
+        reader.skipBytes(nbLastFrameInfos * (sizeof(uint64) + sizeof(LastFrameCollisionInfo)));
+    }
+
+    return !reader.hasFailed();
+}
+
+// Restore the overlapping pairs from a snapshot
+/// The arrays of overlapping pairs of the colliders are restored with the collider components.
+void OverlappingPairs::restoreSnapshot(SnapshotReader& reader) {
+
+    // Destroy the current pairs
+    for (uint64 i=0; i < mConcavePairs.size(); i++) {
+        mConcavePairs[i].destroyLastFrameCollisionInfos();
+    }
+    mConvexPairs.clear();
+    mConcavePairs.clear();
+    mMapConvexPairIdToPairIndex.clear();
+    mMapConcavePairIdToPairIndex.clear();
+
+    // Read the convex pairs
+    const uint32 nbConvexPairs = reader.read<uint32>();
+    mConvexPairs.reserve(nbConvexPairs);
+    for (uint32 i=0; i < nbConvexPairs; i++) {
+
+        const uint64 pairId = reader.read<uint64>();
+        const int32 broadPhaseId1 = reader.read<int32>();
+        const int32 broadPhaseId2 = reader.read<int32>();
+        Entity collider1(0, 0), collider2(0, 0);
+        reader.readBytes(&collider1, sizeof(Entity));
+        reader.readBytes(&collider2, sizeof(Entity));
+        const bool needToTestOverlap = reader.read<bool>();
+        const NarrowPhaseAlgorithmType algorithmType = reader.read<NarrowPhaseAlgorithmType>();
+
+        mMapConvexPairIdToPairIndex.add(Pair<uint64, uint64>(pairId, mConvexPairs.size()));
+        mConvexPairs.emplace(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, algorithmType);
+
+        ConvexOverlappingPair& pair = mConvexPairs[mConvexPairs.size() - 1];
+        pair.needToTestOverlap = needToTestOverlap;
+        pair.collidingInPreviousFrame = reader.read<bool>();
+        pair.collidingInCurrentFrame = reader.read<bool>();
+        pair.lastFrameCollisionInfo = reader.read<LastFrameCollisionInfo>();
+    }
+
+    // Read the concave pairs
+    const uint32 nbConcavePairs = reader.read<uint32>();
+    mConcavePairs.reserve(nbConcavePairs);
+    for (uint32 i=0; i < nbConcavePairs; i++) {
+
+        const uint64 pairId = reader.read<uint64>();
+        const int32 broadPhaseId1 = reader.read<int32>();
+        const int32 broadPhaseId2 = reader.read<int32>();
+        Entity collider1(0, 0), collider2(0, 0);
+        reader.readBytes(&collider1, sizeof(Entity));
+        reader.readBytes(&collider2, sizeof(Entity));
+        const bool needToTestOverlap = reader.read<bool>();
+        const NarrowPhaseAlgorithmType algorithmType = reader.read<NarrowPhaseAlgorithmType>();
+        const bool collidingInPreviousFrame = reader.read<bool>();
+        const bool collidingInCurrentFrame = reader.read<bool>();
+        const bool isShape1Convex = reader.read<bool>();
+
+        mMapConcavePairIdToPairIndex.add(Pair<uint64, uint64>(pairId, mConcavePairs.size()));
+        mConcavePairs.emplace(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, algorithmType,
+                              isShape1Convex, mPoolAllocator, mHeapAllocator);
+
+        ConcaveOverlappingPair& pair = mConcavePairs[mConcavePairs.size() - 1];
+        pair.needToTestOverlap = needToTestOverlap;
+        pair.collidingInPreviousFrame = collidingInPreviousFrame;
+        pair.collidingInCurrentFrame = collidingInCurrentFrame;
+
+        const uint32 nbLastFrameInfos = reader.read<uint32>();
+        for (uint32 f=0; f < nbLastFrameInfos; f++) {
+
+            const uint64 shapesId = reader.read<uint64>();
+            LastFrameCollisionInfo* lastFrameInfo = new (mPoolAllocator.allocate(sizeof(LastFrameCollisionInfo))) LastFrameCollisionInfo();
+            reader.readBytes(lastFrameInfo, sizeof(LastFrameCollisionInfo));
+            pair.lastFrameCollisionInfos.add(Pair<uint64, LastFrameCollisionInfo*>(shapesId, lastFrameInfo));
+        }
+    }
+}
@@ -465,7 +465,7 @@ void PhysicsCommon::deleteConvexMeshShape(ConvexMeshShape* convexMeshShape) {
  * @param minHeight Minimum height value of the height field
  * @param maxHeight Maximum height value of the height field
  * @param heightFieldData Pointer to the first height value data (note that values are shared and not copied)
- * @param dataType Data type for the height values (int, float, double)
+ * @param dataType Data type for the height values (int, float, double, uint16, half)
  * @param upAxis Integer representing the up axis direction (0 for x, 1 for y and 2 for z)
  * @param integerHeightScale Scaling factor used to scale the height values (only when height values type is integer)
  * @return A pointer to the created height field shape
@@ -482,6 +482,41 @@ HeightFieldShape* PhysicsCommon::createHeightFieldShape(int nbGridColumns, int n
     return shape;
 }
 
+// Create and return a tiled height-field shape
+/**
+ * The grid of the height field is split into square tiles of nbTileCells x nbTileCells cells. All the
+ * tiles are unloaded when the shape is created. Use the HeightFieldShape::setTileData() method to load
+ * or unload a tile.
+ * @param nbGridColumns Number of columns in the grid of the height field (nbGridColumns - 1 must be a multiple of nbTileCells)
+ * @param nbGridRows Number of rows in the grid of the height field (nbGridRows - 1 must be a multiple of nbTileCells)
+ * @param nbTileCells Number of cells in each direction of a tile (must be a multiple of 4)
+ * @param minHeight Minimum height value of the height field
+ * @param maxHeight Maximum height value of the height field
+ * @param dataType Data type for the height values (int, float, double, uint16, half)
+ * @param upAxis Integer representing the up axis direction (0 for x, 1 for y and 2 for z)
+ * @param integerHeightScale Scaling factor used to scale the height values (only when height values type is integer)
+ * @return A pointer to the created height field shape
+ */
+HeightFieldShape* PhysicsCommon::createTiledHeightFieldShape(int nbGridColumns, int nbGridRows, int nbTileCells,
+                                         decimal minHeight, decimal maxHeight, HeightFieldShape::HeightDataType dataType,
+                                         int upAxis, decimal integerHeightScale, const Vector3& scaling) {
+
+    if (nbTileCells <= 0 || nbTileCells % HeightFieldShape::PYRAMID_BLOCK_SIZE != 0 || (nbGridColumns - 1) % nbTileCells != 0 || (nbGridRows - 1) % nbTileCells != 0) {
+
+        RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                 "Error when creating a tiled HeightFieldShape: invalid number of cells in a tile",  __FILE__, __LINE__);
+        return nullptr;
+    }
+
+    HeightFieldShape* shape = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(HeightFieldShape))) HeightFieldShape(nbGridColumns, nbGridRows, minHeight, maxHeight,
+                                         nullptr, dataType, mMemoryManager.getHeapAllocator(), mTriangleShapeHalfEdgeStructure, upAxis, integerHeightScale, scaling,
+                                         nbTileCells);
+
+    mHeightFieldShapes.add(shape);
+
+    return shape;
+}
+
 // Destroy a height-field shape
 /**
  * @param heightFieldShape A pointer to the height field shape to destroy
@@ -529,6 +564,37 @@ ConcaveMeshShape* PhysicsCommon::createConcaveMeshShape(TriangleMesh* triangleMe
     return shape;
 }
 
+// Create and return a concave mesh shape using a BVH that has been built offline
+/// The BVH data must have been written with ConcaveMeshShape::writeBVHData() for the same
+/// triangle mesh. The data is used directly without any copy or parsing (it can be a
+/// memory-mapped file for instance) and must remain valid until the shape is destroyed.
+/// If the data is not valid for this mesh, an error is logged and the BVH is built.
+/**
+ * @param triangleMesh A pointer to the triangle mesh to use to create the concave mesh shape
+ * @param bvhData A pointer to the serialized BVH data of the triangle mesh
+ * @param bvhDataSize Size (in bytes) of the BVH data
+ * @param scaling An optional scaling factor to scale the triangle mesh
+ * @return A pointer to the created concave mesh shape
+ */
+ConcaveMeshShape* PhysicsCommon::createConcaveMeshShape(TriangleMesh* triangleMesh, const void* bvhData, size_t bvhDataSize,
+                                                        const Vector3& scaling) {
+
+    if (!ConcaveMeshShape::isBVHDataValid(triangleMesh, bvhData, bvhDataSize)) {
+
+        RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                 "Error when creating a ConcaveMeshShape: the BVH data is not valid for this triangle mesh (the BVH will be built)",  __FILE__, __LINE__);
+
+        bvhData = nullptr;
+    }
+
+    ConcaveMeshShape* shape = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(ConcaveMeshShape))) ConcaveMeshShape(triangleMesh,
+                                                                                                                                            mMemoryManager.getHeapAllocator(), mTriangleShapeHalfEdgeStructure, scaling, bvhData);
+
+    mConcaveMeshShapes.add(shape);
+
+    return shape;
+}
+
 // Destroy a concave mesh shape
 /**
  * @param concaveMeshShape A pointer to the concave mesh shape to destroy
@@ -616,6 +682,80 @@ TriangleMesh* PhysicsCommon::createTriangleMesh() {
     return mesh;
 }
 
+// Create and return a compressed copy of a triangle mesh
+/// The triangles of the mesh are stored in a compact format owned by the engine (see
+/// CompressedTriangleArray). The vertices are welded and quantized on 16 bits and the
+/// normals are encoded on 32 bits (see CompressedTriangleArray::getMaxPositionError() for the
+/// resulting precision of the vertices). The returned mesh does not reference the original mesh
+/// and its triangle vertex arrays which can be destroyed after this call. The compressed
+/// mesh must be destroyed with the destroyTriangleMesh() method.
+/**
+ * @param triangleMesh A pointer to the triangle mesh to compress
+ * @return A pointer to the created compressed triangle mesh
+ */
+TriangleMesh* PhysicsCommon::createCompressedTriangleMesh(const TriangleMesh* triangleMesh) {
+
+    TriangleMesh* mesh = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(TriangleMesh))) TriangleMesh(mMemoryManager.getHeapAllocator());
+
+    mesh->compress(*triangleMesh);
+
+    mTriangleMeshes.add(mesh);
+
+    return mesh;
+}
+
+// Create and return a cooked copy of a triangle mesh (compressed triangles with their BVH)
+/// Cooking prepares all the data needed for collision detection with the mesh at once. The
+/// triangles are compressed (see createCompressedTriangleMesh()) and the BVH of the triangles
+/// is built. The adjacency and the convexity of the edges of the triangles are also computed
+/// so that the contacts on the flat and concave edges of the mesh use the triangle normal
+/// instead of the interpolated vertices normals. A ConcaveMeshShape created with a cooked mesh
+/// uses the BVH of the mesh and is therefore created without any processing. The cooked data can be written with
+/// TriangleMesh::writeCookedData() and loaded later with createTriangleMeshFromCookedData().
+/// The returned mesh does not reference the original mesh and its triangle vertex arrays.
+/**
+ * @param triangleMesh A pointer to the triangle mesh to cook
+ * @return A pointer to the created cooked triangle mesh
+ */
+TriangleMesh* PhysicsCommon::createCookedTriangleMesh(const TriangleMesh* triangleMesh) {
+
+    TriangleMesh* mesh = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(TriangleMesh))) TriangleMesh(mMemoryManager.getHeapAllocator());
+
+    mesh->cook(*triangleMesh);
+
+    mTriangleMeshes.add(mesh);
+
+    return mesh;
+}
+
+// Create and return a cooked triangle mesh from cooked data
+/// The data must have been written by TriangleMesh::writeCookedData() with the same version of the
+/// library, on the same platform and with the same decimal precision. The data is copied and does
+/// not need to remain valid after this call.
+/**
+ * @param cookedData A pointer to the cooked data
+ * @param cookedDataSize Size (in bytes) of the cooked data
+ * @return A pointer to the created cooked triangle mesh or nullptr if the data is not valid
+ */
+TriangleMesh* PhysicsCommon::createTriangleMeshFromCookedData(const void* cookedData, size_t cookedDataSize) {
+
+    TriangleMesh* mesh = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(TriangleMesh))) TriangleMesh(mMemoryManager.getHeapAllocator());
+
+    if (!mesh->loadCookedData(cookedData, cookedDataSize)) {
+
+        RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                 "Error when creating a TriangleMesh: the cooked data is not valid",  __FILE__, __LINE__);
+
+        deleteTriangleMesh(mesh);
+
+        return nullptr;
+    }
+
+    mTriangleMeshes.add(mesh);
+
+    return mesh;
+}
+
 // Destroy a triangle mesh
 /**
  * @param A pointer to the triangle mesh to destroy
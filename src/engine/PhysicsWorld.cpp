@@ -31,10 +31,12 @@
 #include <reactphysics3d/constraint/HingeJoint.h>
 #include <reactphysics3d/constraint/FixedJoint.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/engine/Island.h>
 #include <reactphysics3d/collision/ContactManifold.h>
 #include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/containers/SmallArray.h>
 
 // Namespaces
 using namespace reactphysics3d;
@@ -43,6 +45,7 @@ using namespace std;
 // Static initializations
 
 uint32 PhysicsWorld::mNbWorlds = 0;
+const uint32 PhysicsWorld::SNAPSHOT_MAGIC_NUMBER = 0x52503353;
 
 // Constructor
 /**
@@ -75,7 +78,11 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
                 mNbPositionSolverIterations(mConfig.defaultPositionSolverNbIterations), 
                 mIsSleepingEnabled(mConfig.isSleepingEnabled), mRigidBodies(mMemoryManager.getPoolAllocator()),
                 mIsGravityEnabled(true), mSleepLinearVelocity(mConfig.defaultSleepLinearVelocity),
-                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep) {
+                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep),
+                mFixedTimeStep(mConfig.fixedTimeStep), mMaxNbFixedTimeSteps(mConfig.maxNbFixedTimeSteps), mTimeAccumulator(decimal(0.0)),
+                mBodiesChangingSleepingState(mMemoryManager.getHeapAllocator()),
+                mCollidersOfBodiesChangingState(mMemoryManager.getHeapAllocator()),
+                mKinematicBodiesToWakeUp(mMemoryManager.getHeapAllocator()) {
 
     // Automatically generate a name for the world
     if (mName == "") {
@@ -255,6 +262,99 @@ void PhysicsWorld::setBodyDisabled(Entity bodyEntity, bool isDisabled) {
     }
 }
 
+// Notify the world if a group of bodies are disabled (sleeping) or not
+/// The components of all the bodies (and of their colliders) are moved with a single
+/// partition pass per type of components instead of one swap sequence per body.
+void PhysicsWorld::setBodiesDisabled(const Array<Entity>& bodyEntities, bool isDisabled) {
+
+    const uint32 nbBodies = static_cast<uint32>(bodyEntities.size());
+
+    // Gather the colliders of all the bodies
+    Array<Entity>& collidersEntities = mCollidersOfBodiesChangingState;
+    collidersEntities.clear();
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        assert(mRigidBodyComponents.hasComponent(bodyEntities[i]));
+
+        collidersEntities.addRange(mCollisionBodyComponents.getColliders(bodyEntities[i]));
+    }
+
+    // Notify all the components
+    mCollisionBodyComponents.setIsEntitiesDisabled(bodyEntities, isDisabled);
+    mTransformComponents.setIsEntitiesDisabled(bodyEntities, isDisabled);
+    mRigidBodyComponents.setIsEntitiesDisabled(bodyEntities, isDisabled);
+    mCollidersComponents.setIsEntitiesDisabled(collidersEntities, isDisabled);
+}
+
+// Put a group of bodies to sleep or wake them up
+/// This is the batched version of RigidBody::setIsSleeping() used to change the state of
+/// a whole island at once. Bodies that already are in the requested state or that are
+/// inactive are ignored. The bodies put to sleep are not linked into a sleeping island here.
+void PhysicsWorld::setBodiesSleeping(const Array<Entity>& bodyEntities, bool isSleeping) {
+
+    const uint32 nbBodies = static_cast<uint32>(bodyEntities.size());
+
+    // Bodies for which the sleeping state changes
+    Array<Entity>& bodiesToUpdate = mBodiesChangingSleepingState;
+    bodiesToUpdate.clear();
+
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        const Entity bodyEntity = bodyEntities[i];
+        const uint32 bodyIndex = mRigidBodyComponents.getEntityIndex(bodyEntity);
+
+        if (mRigidBodyComponents.mIsSleeping[bodyIndex] == isSleeping) continue;
+
+        // If the body is not active, do nothing (it is sleeping)
+        if (!mCollisionBodyComponents.getIsActive(bodyEntity)) continue;
+
+        mRigidBodyComponents.mIsSleeping[bodyIndex] = isSleeping;
+        mRigidBodyComponents.mSleepTimes[bodyIndex] = decimal(0.0);
+
+        if (isSleeping) {
+
+            mRigidBodyComponents.mLinearVelocities[bodyIndex].setToZero();
+            mRigidBodyComponents.mAngularVelocities[bodyIndex].setToZero();
+            mRigidBodyComponents.mExternalForces[bodyIndex].setToZero();
+            mRigidBodyComponents.mExternalTorques[bodyIndex].setToZero();
+            mRigidBodyComponents.mHasChangedSinceLastExport[bodyIndex] = true;
+        }
+        else {
+            mRigidBodyComponents.removeBodyFromSleepingIsland(bodyEntity);
+        }
+
+        bodiesToUpdate.add(bodyEntity);
+    }
+
+    if (bodiesToUpdate.size() == 0) return;
+
+    // Notify all the components
+    setBodiesDisabled(bodiesToUpdate, isSleeping);
+
+    // Remove the currently overlapping pairs of the bodies and make sure the
+    // broad-phase recomputes the pairs of those bodies in the next frame
+    const uint32 nbBodiesToUpdate = static_cast<uint32>(bodiesToUpdate.size());
+    for (uint32 i=0; i < nbBodiesToUpdate; i++) {
+
+        const Array<Entity>& colliderEntities = mCollisionBodyComponents.getColliders(bodiesToUpdate[i]);
+        const uint32 nbColliders = static_cast<uint32>(colliderEntities.size());
+        for (uint32 c=0; c < nbColliders; c++) {
+
+            // Removing a pair also removes it from the array of pairs of the collider
+            Array<uint64>& overlappingPairs = mCollidersComponents.getOverlappingPairs(colliderEntities[c]);
+            while (overlappingPairs.size() > 0) {
+                mCollisionDetection.mOverlappingPairs.removePair(overlappingPairs[overlappingPairs.size() - 1]);
+            }
+
+            mCollisionDetection.askForBroadPhaseCollisionCheck(mCollidersComponents.getCollider(colliderEntities[c]));
+        }
+    }
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: Set isSleeping=" + (isSleeping ? std::string("true") : std::string("false")) +
+             " for " + std::to_string(nbBodiesToUpdate) + " bodies",  __FILE__, __LINE__);
+}
+
 // Notify the world whether a joint is disabled or not
 void PhysicsWorld::setJointDisabled(Entity jointEntity, bool isDisabled) {
 
@@ -303,6 +403,8 @@ AABB PhysicsWorld::getWorldAABB(const Collider* collider) const {
 }
 
 // Update the physics simulation
+/// The transforms of the bodies at the beginning of the step are kept for the interpolation
+/// of getInterpolatedTransforms() and the bodies moved by the user are flagged again from here.
 /**
  * @param timeStep The amount of time to step the simulation by (in seconds)
  */
@@ -321,6 +423,10 @@ void PhysicsWorld::update(decimal timeStep) {
         mDebugRenderer.reset();
     }
 
+    // Keep the transforms at the beginning of the step for the interpolation (this also
+    // clears the flags of the bodies moved by the user since the previous step)
+    mTransformComponents.storePreviousTransforms();
+
     // Compute the collision detection
     mCollisionDetection.computeCollisionDetection();
 
@@ -376,6 +482,345 @@ void PhysicsWorld::update(decimal timeStep) {
     mMemoryManager.resetFrameAllocator();
 }
 
+// Update the physics simulation with fixed time steps covering the elapsed time
+/// The elapsed time is accumulated and the simulation is advanced by as many fixed time steps
+/// as possible (but not more than the maximum number of fixed time steps). The remaining time is
+/// kept for the next call and gives the interpolation factor that can be used with
+/// getInterpolatedTransforms() to render the bodies between the two last simulation steps.
+/// If the maximum number of steps is reached, the time that could not be simulated is dropped
+/// so that a slow frame cannot make the following frames even slower.
+/**
+ * @param elapsedTime The real time elapsed since the last call (in seconds)
+ * @return The number of fixed time steps that have been simulated
+ */
+uint32 PhysicsWorld::updateWithFixedTimeStep(decimal elapsedTime) {
+
+    assert(elapsedTime >= decimal(0.0));
+
+    mTimeAccumulator += elapsedTime;
+
+    uint32 nbSteps = 0;
+    while (mTimeAccumulator >= mFixedTimeStep && nbSteps < mMaxNbFixedTimeSteps) {
+
+        update(mFixedTimeStep);
+
+        mTimeAccumulator -= mFixedTimeStep;
+        nbSteps++;
+    }
+
+    // If the simulation cannot keep up with the elapsed time
+    if (mTimeAccumulator >= mFixedTimeStep) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Warning, Logger::Category::World,
+                 "Physics World: The maximum number of fixed time steps has been reached, " +
+                 std::to_string(mTimeAccumulator) + " seconds of simulation time have been dropped",  __FILE__, __LINE__);
+
+        mTimeAccumulator = std::fmod(mTimeAccumulator, mFixedTimeStep);
+    }
+
+    return nbSteps;
+}
+
+// Compute the interpolated transforms of all the rigid bodies of the world
+/// The transform of each body is interpolated between its transform at the beginning and at
+/// the end of the last fixed time step using the current interpolation factor. The transforms
+/// are written in the same order as the bodies returned by getRigidBody().
+/**
+ * @param outTransforms Pointer to an array of at least getNbRigidBodies() transforms
+ *                      where the interpolated transforms are written
+ */
+void PhysicsWorld::getInterpolatedTransforms(Transform* outTransforms) const {
+
+    RP3D_PROFILE("PhysicsWorld::getInterpolatedTransforms()", mProfiler);
+
+    const decimal interpolationFactor = getInterpolationFactor();
+
+    // We iterate over the rigid body components directly and write each transform at the
+    // index of its body in the world
+    const uint32 nbComponents = mRigidBodyComponents.getNbComponents();
+    for (uint32 i=0; i < nbComponents; i++) {
+
+        const uint32 index = mTransformComponents.getEntityIndex(mRigidBodyComponents.mBodiesEntities[i]);
+
+        outTransforms[mRigidBodyComponents.mBodyIndicesInWorld[i]] =
+                Transform::interpolateTransforms(mTransformComponents.mPreviousTransforms[index],
+                                                 mTransformComponents.mTransforms[index], interpolationFactor);
+    }
+}
+
+// Copy the positions, orientations and velocities of the rigid bodies into contiguous arrays
+/// The state of the bodies is written in the same order as the bodies returned by getRigidBody().
+/// If onlyChangedBodies is true, only the bodies whose transform or velocities have changed since
+/// the previous export are written (in no particular order) and their indices are written into
+/// the outBodyIndices array.
+/// Any of the output arrays can be nullptr if the caller is not interested in this data.
+/**
+ * @param outPositions Array of at least getNbRigidBodies() positions (can be nullptr)
+ * @param outOrientations Array of at least getNbRigidBodies() orientations (can be nullptr)
+ * @param outLinearVelocities Array of at least getNbRigidBodies() linear velocities (can be nullptr)
+ * @param outAngularVelocities Array of at least getNbRigidBodies() angular velocities (can be nullptr)
+ * @param outBodyIndices Array of at least getNbRigidBodies() indices where the index of each
+ *                       exported body is written (can be nullptr)
+ * @param onlyChangedBodies True if only the bodies that have changed since the last export must be exported
+ * @return The number of bodies that have been exported
+ */
+uint32 PhysicsWorld::exportRigidBodiesState(Vector3* outPositions, Quaternion* outOrientations,
+                                            Vector3* outLinearVelocities, Vector3* outAngularVelocities,
+                                            uint32* outBodyIndices, bool onlyChangedBodies) {
+
+    RP3D_PROFILE("PhysicsWorld::exportRigidBodiesState()", mProfiler);
+
+    uint32 nbExportedBodies = 0;
+
+    // We iterate over the rigid body components directly. The enabled components come first. The
+    // components of the sleeping bodies are also visited because their velocities have been reset
+    // when they have been put to sleep but they are skipped after the check of their flag.
+    const uint32 nbComponents = mRigidBodyComponents.getNbComponents();
+    for (uint32 i=0; i < nbComponents; i++) {
+
+        if (onlyChangedBodies && !mRigidBodyComponents.mHasChangedSinceLastExport[i]) continue;
+
+        mRigidBodyComponents.mHasChangedSinceLastExport[i] = false;
+
+        const uint32 bodyIndexInWorld = mRigidBodyComponents.mBodyIndicesInWorld[i];
+        const uint32 outIndex = onlyChangedBodies ? nbExportedBodies : bodyIndexInWorld;
+
+        const Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
+
+        if (outPositions != nullptr) outPositions[outIndex] = transform.getPosition();
+        if (outOrientations != nullptr) outOrientations[outIndex] = transform.getOrientation();
+        if (outLinearVelocities != nullptr) outLinearVelocities[outIndex] = mRigidBodyComponents.mLinearVelocities[i];
+        if (outAngularVelocities != nullptr) outAngularVelocities[outIndex] = mRigidBodyComponents.mAngularVelocities[i];
+        if (outBodyIndices != nullptr) outBodyIndices[outIndex] = bodyIndexInWorld;
+
+        nbExportedBodies++;
+    }
+
+    return nbExportedBodies;
+}
+
+// Set the positions, orientations and velocities of a group of kinematic rigid bodies
+/// This is equivalent to calling RigidBody::setTransform(), RigidBody::setLinearVelocity() and
+/// RigidBody::setAngularVelocity() for each body but the bodies are woken up in a single batch.
+/// The velocity arrays can be nullptr if the velocities of the bodies must not be changed.
+/**
+ * @param bodyIndices Array with the indices (as in getRigidBody()) of the kinematic bodies to update
+ * @param nbBodies Number of bodies to update
+ * @param positions Array with the new position of each body
+ * @param orientations Array with the new orientation of each body
+ * @param linearVelocities Array with the new linear velocity of each body (can be nullptr)
+ * @param angularVelocities Array with the new angular velocity of each body (can be nullptr)
+ */
+void PhysicsWorld::setKinematicBodiesState(const uint32* bodyIndices, uint32 nbBodies,
+                                           const Vector3* positions, const Quaternion* orientations,
+                                           const Vector3* linearVelocities, const Vector3* angularVelocities) {
+
+    RP3D_PROFILE("PhysicsWorld::setKinematicBodiesState()", mProfiler);
+
+    assert(positions != nullptr && orientations != nullptr);
+
+    Array<Entity>& bodiesToWakeUp = mKinematicBodiesToWakeUp;
+    bodiesToWakeUp.clear();
+
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        assert(bodyIndices[i] < mRigidBodies.size());
+
+        RigidBody* body = mRigidBodies[bodyIndices[i]];
+        const Entity bodyEntity = body->getEntity();
+        const uint32 bodyIndex = mRigidBodyComponents.getEntityIndex(bodyEntity);
+
+        if (mRigidBodyComponents.mBodyTypes[bodyIndex] != BodyType::KINEMATIC) {
+
+            RP3D_LOG(mConfig.worldName, Logger::Level::Warning, Logger::Category::World,
+                     "Physics World: Body " + std::to_string(bodyEntity.id) + " is not kinematic, its state is not changed",  __FILE__, __LINE__);
+            continue;
+        }
+
+        const Transform transform(positions[i], orientations[i]);
+
+        // Update the center of mass and the linear velocity of the center of mass
+        const Vector3 oldCenterOfMass = mRigidBodyComponents.mCentersOfMassWorld[bodyIndex];
+        mRigidBodyComponents.mCentersOfMassWorld[bodyIndex] = transform * mRigidBodyComponents.mCentersOfMassLocal[bodyIndex];
+        if (angularVelocities != nullptr) mRigidBodyComponents.mAngularVelocities[bodyIndex] = angularVelocities[i];
+        if (linearVelocities != nullptr) {
+            mRigidBodyComponents.mLinearVelocities[bodyIndex] = linearVelocities[i];
+        }
+        else {
+            mRigidBodyComponents.mLinearVelocities[bodyIndex] += mRigidBodyComponents.mAngularVelocities[bodyIndex].cross(
+                        mRigidBodyComponents.mCentersOfMassWorld[bodyIndex] - oldCenterOfMass);
+        }
+        mRigidBodyComponents.mHasChangedSinceLastExport[bodyIndex] = true;
+
+        mTransformComponents.setTransform(bodyEntity, transform);
+
+        // Update the broad-phase state of the body
+        body->updateBroadPhaseState();
+
+        bodiesToWakeUp.add(bodyEntity);
+    }
+
+    // Awake the bodies that are sleeping
+    setBodiesSleeping(bodiesToWakeUp, false);
+}
+
+// Write the simulation state of the world into a snapshot
+void PhysicsWorld::writeSnapshot(SnapshotWriter& writer) const {
+
+    writer.write(SNAPSHOT_MAGIC_NUMBER);
+
+    mCollisionBodyComponents.takeSnapshot(writer);
+    mRigidBodyComponents.takeSnapshot(writer);
+    mTransformComponents.takeSnapshot(writer);
+    mCollidersComponents.takeSnapshot(writer);
+    mJointsComponents.takeSnapshot(writer);
+    mBallAndSocketJointsComponents.takeSnapshot(writer);
+    mFixedJointsComponents.takeSnapshot(writer);
+    mHingeJointsComponents.takeSnapshot(writer);
+    mSliderJointsComponents.takeSnapshot(writer);
+
+    mCollisionDetection.takeSnapshot(writer);
+
+    writer.write(mTimeAccumulator);
+}
+
+// Return the size (in bytes) of a snapshot of the current simulation state of the world
+/// The size of a snapshot depends on the number of overlapping pairs and contacts. Therefore,
+/// it can change from one frame to another.
+/**
+ * @return The number of bytes needed to store a snapshot of the world
+ */
+size_t PhysicsWorld::getSnapshotSize() const {
+
+    SnapshotWriter writer(nullptr);
+    writeSnapshot(writer);
+
+    return writer.getSize();
+}
+
+// Write a snapshot of the simulation state of the world into a buffer
+/// The snapshot contains the state of the components (transforms, velocities, sleeping state and
+/// joint impulses), the overlapping pairs, the broad-phase tree and the contacts with their
+/// cached impulses. A snapshot can only be restored into the same world and the world must
+/// contain the same bodies, colliders and joints as when the snapshot was taken. The settings of
+/// the bodies and colliders (mass, material, collision shape, ...) are not part of the snapshot.
+/**
+ * @param buffer Pointer to the buffer where the snapshot is written
+ * @param bufferSize Size (in bytes) of the buffer
+ * @return The number of bytes written or zero if the buffer is too small
+ */
+size_t PhysicsWorld::takeSnapshot(void* buffer, size_t bufferSize) const {
+
+    RP3D_PROFILE("PhysicsWorld::takeSnapshot()", mProfiler);
+
+    const size_t snapshotSize = getSnapshotSize();
+    if (snapshotSize > bufferSize) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Physics World: The buffer is too small to take a snapshot (" + std::to_string(snapshotSize) +
+                 " bytes are needed)",  __FILE__, __LINE__);
+        return 0;
+    }
+
+    SnapshotWriter writer(static_cast<uint8*>(buffer));
+    writeSnapshot(writer);
+
+    assert(writer.getSize() == snapshotSize);
+
+    return snapshotSize;
+}
+
+// Restore the simulation state of the world from a snapshot
+/// If the collision detection must give exactly the same results after the restoration, the
+/// WorldSettings::isDeterministic setting must be enabled.
+/**
+ * @param buffer Pointer to a buffer with a snapshot written by takeSnapshot()
+ * @param bufferSize Size (in bytes) of the snapshot
+ * @return True if the snapshot has been restored and false if the snapshot does not match the world
+ */
+bool PhysicsWorld::restoreSnapshot(const void* buffer, size_t bufferSize) {
+
+    RP3D_PROFILE("PhysicsWorld::restoreSnapshot()", mProfiler);
+
+    // Check the whole snapshot against the world before changing anything such that an
+    // invalid snapshot leaves the world untouched
+    SnapshotReader validationReader(static_cast<const uint8*>(buffer), bufferSize);
+
+    bool isValid = validationReader.read<uint32>() == SNAPSHOT_MAGIC_NUMBER;
+
+    isValid = isValid && mCollisionBodyComponents.validateSnapshot(validationReader);
+    isValid = isValid && mRigidBodyComponents.validateSnapshot(validationReader);
+    isValid = isValid && mTransformComponents.validateSnapshot(validationReader);
+    isValid = isValid && mCollidersComponents.validateSnapshot(validationReader);
+    isValid = isValid && mJointsComponents.validateSnapshot(validationReader);
+    isValid = isValid && mBallAndSocketJointsComponents.validateSnapshot(validationReader);
+    isValid = isValid && mFixedJointsComponents.validateSnapshot(validationReader);
+    isValid = isValid && mHingeJointsComponents.validateSnapshot(validationReader);
+    isValid = isValid && mSliderJointsComponents.validateSnapshot(validationReader);
+    isValid = isValid && mCollisionDetection.validateSnapshot(validationReader);
+    isValid = isValid && validationReader.skipBytes(sizeof(decimal));
+    isValid = isValid && validationReader.getNbRemainingBytes() == 0;
+
+    if (!isValid) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Physics World: The snapshot does not match the bodies, colliders and joints of the world",  __FILE__, __LINE__);
+        return false;
+    }
+
+    // Restore the state of the world
+    SnapshotReader reader(static_cast<const uint8*>(buffer), bufferSize);
+
+    reader.read<uint32>();
+
+    mCollisionBodyComponents.restoreSnapshot(reader);
+    mRigidBodyComponents.restoreSnapshot(reader);
+    mTransformComponents.restoreSnapshot(reader);
+    mCollidersComponents.restoreSnapshot(reader);
+    mJointsComponents.restoreSnapshot(reader);
+    mBallAndSocketJointsComponents.restoreSnapshot(reader);
+    mFixedJointsComponents.restoreSnapshot(reader);
+    mHingeJointsComponents.restoreSnapshot(reader);
+    mSliderJointsComponents.restoreSnapshot(reader);
+
+    mCollisionDetection.restoreSnapshot(reader);
+
+    mTimeAccumulator = reader.read<decimal>();
+
+    assert(!reader.hasFailed() && reader.getNbRemainingBytes() == 0);
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: Restore a snapshot of " + std::to_string(bufferSize) + " bytes",  __FILE__, __LINE__);
+
+    return true;
+}
+
+// Set the time step of the fixed time step simulation
+/**
+ * @param fixedTimeStep The time step (in seconds) used by updateWithFixedTimeStep()
+ */
+void PhysicsWorld::setFixedTimeStep(decimal fixedTimeStep) {
+
+    assert(fixedTimeStep > decimal(0.0));
+    mFixedTimeStep = fixedTimeStep;
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: fixedTimeStep= " + std::to_string(fixedTimeStep),  __FILE__, __LINE__);
+}
+
+// Set the maximum number of fixed time steps run in a single update
+/**
+ * @param maxNbFixedTimeSteps The maximum number of steps run by a single call to updateWithFixedTimeStep()
+ */
+void PhysicsWorld::setMaxNbFixedTimeSteps(uint32 maxNbFixedTimeSteps) {
+
+    assert(maxNbFixedTimeSteps > 0);
+    mMaxNbFixedTimeSteps = maxNbFixedTimeSteps;
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: maxNbFixedTimeSteps= " + std::to_string(maxNbFixedTimeSteps),  __FILE__, __LINE__);
+}
+
 // Update the world inverse inertia tensors of rigid bodies
 void PhysicsWorld::updateBodiesInverseWorldInertiaTensors() {
 
@@ -498,6 +943,7 @@ RigidBody* PhysicsWorld::createRigidBody(const Transform& transform) {
 
     // Add the rigid body to the physics world
     mRigidBodies.add(rigidBody);
+    mRigidBodyComponents.setBodyIndexInWorld(entity, static_cast<uint32>(mRigidBodies.size() - 1));
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -529,6 +975,11 @@ void PhysicsWorld::destroyRigidBody(RigidBody* rigidBody) {
         destroyJoint(mJointsComponents.getJoint(joints[0]));
     }
 
+    // Remove the body from its sleeping island (if any)
+    mRigidBodyComponents.removeBodyFromSleepingIsland(rigidBody->getEntity());
+
+    const uint32 bodyIndexInWorld = mRigidBodyComponents.getBodyIndexInWorld(rigidBody->getEntity());
+
     // Destroy the corresponding entity and its components
     mCollisionBodyComponents.removeComponent(rigidBody->getEntity());
     mRigidBodyComponents.removeComponent(rigidBody->getEntity());
@@ -539,7 +990,13 @@ void PhysicsWorld::destroyRigidBody(RigidBody* rigidBody) {
     rigidBody->~RigidBody();
 
     // Remove the rigid body from the array of rigid bodies
-    mRigidBodies.remove(rigidBody);
+    assert(mRigidBodies[bodyIndexInWorld] == rigidBody);
+    mRigidBodies.removeAt(bodyIndexInWorld);
+
+    // Update the indices of the bodies that have been moved in the array of rigid bodies
+    for (uint32 i = bodyIndexInWorld; i < mRigidBodies.size(); i++) {
+        mRigidBodyComponents.setBodyIndexInWorld(mRigidBodies[i]->getEntity(), i);
+    }
 
     // Free the object from the memory allocator
     mMemoryManager.release(MemoryManager::AllocationType::Pool, rigidBody, sizeof(RigidBody));
@@ -785,7 +1242,10 @@ void PhysicsWorld::createIslands() {
     Stack<Entity> bodyEntitiesToVisit(mMemoryManager.getSingleFrameAllocator(), mIslands.getNbMaxBodiesInIslandPreviousFrame());
 
     // Array of static bodies added to the current island (used to reset the isAlreadyInIsland variable of static bodies)
-    Array<Entity> staticBodiesAddedToIsland(mMemoryManager.getSingleFrameAllocator(), 16);
+    SmallArray<Entity, 16> staticBodiesAddedToIsland(mMemoryManager.getSingleFrameAllocator());
+
+    // Bodies of a sleeping island that is woken up during the search
+    SmallArray<Entity, 16> sleepingIslandBodies(mMemoryManager.getSingleFrameAllocator());
 
     uint32 nbTotalManifolds = 0;
 
@@ -819,10 +1279,28 @@ void PhysicsWorld::createIslands() {
 
             RigidBody* rigidBodyToVisit = mRigidBodyComponents.getRigidBody(bodyToVisitEntity);
 
-            // Awake the body if it is sleeping (note that this called might change the body index in the mRigidBodyComponents array)
-            rigidBodyToVisit->setIsSleeping(false);
+            // If the body is sleeping, we wake up its whole sleeping island at once (note that this
+            // call might change the body index in the mRigidBodyComponents array)
+            if (mRigidBodyComponents.getIsSleeping(bodyToVisitEntity)) {
+
+                sleepingIslandBodies.clear();
+                mRigidBodyComponents.getSleepingIslandBodies(bodyToVisitEntity, sleepingIslandBodies);
+                setBodiesSleeping(sleepingIslandBodies, false);
+
+                // The other bodies of the sleeping island are added to the current island. Their
+                // contacts will be computed in the next frame.
+                const uint32 nbSleepingIslandBodies = static_cast<uint32>(sleepingIslandBodies.size());
+                for (uint32 s=1; s < nbSleepingIslandBodies; s++) {
+
+                    const uint32 otherBodyIndex = mRigidBodyComponents.getEntityIndex(sleepingIslandBodies[s]);
+                    if (mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex]) continue;
+
+                    bodyEntitiesToVisit.push(sleepingIslandBodies[s]);
+                    mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex] = true;
+                }
+            }
 
-            // Compute the body index in the array (Note that it could have changed because of the previous call to rigidBodyToVisit->setIsSleeping(false))
+            // Compute the body index in the array (Note that it could have changed because the body has been woken up)
             const uint32 bodyToVisitIndex = mRigidBodyComponents.getEntityIndex(bodyToVisitEntity);
 
             // If the current body is static, we do not want to perform the DFS search across that body
@@ -924,7 +1402,11 @@ void PhysicsWorld::createIslands() {
 
 // Put bodies to sleep if needed.
 /// For each island, if all the bodies have been almost still for a long enough period of
-/// time, we put all the bodies of the island to sleep.
+/// time, we put all the bodies of the island to sleep. The bodies of all the islands that fall
+/// asleep in this frame are disabled together at the end, with a single partition of the
+/// components arrays. The non-static bodies of each of those islands are then linked together
+/// into a sleeping island so that the island can be woken up at once when one of its bodies
+/// is hit. Static bodies are never put to sleep because they can be part of several islands.
 void PhysicsWorld::updateSleepingBodies(decimal timeStep) {
 
     RP3D_PROFILE("PhysicsWorld::updateSleepingBodies()", mProfiler);
@@ -932,6 +1414,13 @@ void PhysicsWorld::updateSleepingBodies(decimal timeStep) {
     const decimal sleepLinearVelocitySquare = mSleepLinearVelocity * mSleepLinearVelocity;
     const decimal sleepAngularVelocitySquare = mSleepAngularVelocity * mSleepAngularVelocity;
 
+    // Bodies of all the islands to put to sleep (the bodies of a given island are contiguous)
+    Array<Entity> bodiesToSleep(mMemoryManager.getSingleFrameAllocator());
+
+    // Start index (in the bodiesToSleep array) and number of bodies of each island to put to sleep
+    Array<uint32> sleepingIslandsStartIndex(mMemoryManager.getSingleFrameAllocator());
+    Array<uint32> sleepingIslandsNbBodies(mMemoryManager.getSingleFrameAllocator());
+
     // For each island of the world
     const uint32 nbIslands = mIslands.getNbIslands();
     for (uint32 i=0; i < nbIslands; i++) {
@@ -971,15 +1460,35 @@ void PhysicsWorld::updateSleepingBodies(decimal timeStep) {
         // the time required to become a sleeping body
         if (minSleepTime >= mTimeBeforeSleep) {
 
-            // Put all the bodies of the island to sleep
+            const uint32 startIndex = static_cast<uint32>(bodiesToSleep.size());
+
+            // Add all the non-static bodies of the island to the bodies to put to sleep
             for (uint32 b=0; b < mIslands.nbBodiesInIsland[i]; b++) {
 
                 const Entity bodyEntity = mIslands.bodyEntities[mIslands.startBodyEntitiesIndex[i] + b];
-                RigidBody* body = mRigidBodyComponents.getRigidBody(bodyEntity);
-                body->setIsSleeping(true);
+                if (mRigidBodyComponents.getBodyType(bodyEntity) != BodyType::STATIC) {
+                    bodiesToSleep.add(bodyEntity);
+                }
+            }
+
+            const uint32 nbBodies = static_cast<uint32>(bodiesToSleep.size()) - startIndex;
+            if (nbBodies > 0) {
+                sleepingIslandsStartIndex.add(startIndex);
+                sleepingIslandsNbBodies.add(nbBodies);
             }
         }
     }
+
+    if (bodiesToSleep.size() == 0) return;
+
+    // Put all the bodies to sleep at once
+    setBodiesSleeping(bodiesToSleep, true);
+
+    // Link the bodies of each island into a sleeping island
+    const uint32 nbSleepingIslands = static_cast<uint32>(sleepingIslandsStartIndex.size());
+    for (uint32 i=0; i < nbSleepingIslands; i++) {
+        mRigidBodyComponents.setSleepingIsland(bodiesToSleep, sleepingIslandsStartIndex[i], sleepingIslandsNbBodies[i]);
+    }
 }
 
 // Enable/Disable the sleeping technique.
@@ -994,13 +1503,16 @@ void PhysicsWorld::enableSleeping(bool isSleepingEnabled) {
 
     if (!mIsSleepingEnabled) {
 
-        // For each body of the world
-        Array<RigidBody*>::Iterator it;
-        for (it = mRigidBodies.begin(); it != mRigidBodies.end(); ++it) {
-
-            // Wake up the rigid body
-            (*it)->setIsSleeping(false);
+        // Wake up all the sleeping bodies of the world at once
+        Array<Entity> sleepingBodies(mMemoryManager.getHeapAllocator());
+        const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbComponents();
+        for (uint32 i = mRigidBodyComponents.getNbEnabledComponents(); i < nbRigidBodyComponents; i++) {
+            if (mRigidBodyComponents.mIsSleeping[i]) {
+                sleepingBodies.add(mRigidBodyComponents.mBodiesEntities[i]);
+            }
         }
+
+        setBodiesSleeping(sleepingBodies, false);
     }
 
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
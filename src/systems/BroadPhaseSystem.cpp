@@ -30,6 +30,7 @@
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/utils/Snapshot.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -224,6 +225,39 @@ void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, Arr
     mMovedShapes.clear();
 }
 
+// Write the state of the broad-phase into a snapshot
+void BroadPhaseSystem::takeSnapshot(SnapshotWriter& writer) const {
+
+    mDynamicAABBTree.takeSnapshot(writer);
+
+    // Write the shapes that have moved since the last broad-phase computation
+    writer.write(static_cast<uint32>(mMovedShapes.size()));
+    for (auto it = mMovedShapes.begin(); it != mMovedShapes.end(); ++it) {
+        writer.write(*it);
+    }
+}
+
+// Check that a snapshot of the broad-phase is valid and skip it
+bool BroadPhaseSystem::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!mDynamicAABBTree.validateSnapshot(reader)) return false;
+
+    const uint32 nbMovedShapes = reader.read<uint32>();
+    return reader.skipBytes(nbMovedShapes * sizeof(int));
+}
+
+// Restore the state of the broad-phase from a snapshot
+void BroadPhaseSystem::restoreSnapshot(SnapshotReader& reader) {
+
+    mDynamicAABBTree.restoreSnapshot(reader);
+
+    mMovedShapes.clear();
+    const uint32 nbMovedShapes = reader.read<uint32>();
+    for (uint32 i=0; i < nbMovedShapes; i++) {
+        mMovedShapes.add(reader.read<int>());
+    }
+}
+
 // Called when a overlapping node has been found during the call to
 // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
 void AABBOverlapCallback::notifyOverlappingNode(int nodeId) {
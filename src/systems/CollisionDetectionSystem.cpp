@@ -41,8 +41,11 @@
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/containers/Pair.h>
+#include <reactphysics3d/containers/SmallArray.h>
+#include <reactphysics3d/utils/Snapshot.h>
 #include <cassert>
 #include <iostream>
+#include <algorithm>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -57,6 +60,7 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
                      mNoCollisionPairs(mMemoryManager.getPoolAllocator()),
                      mOverlappingPairs(mMemoryManager, mCollidersComponents, collisionBodyComponents, rigidBodyComponents,
                                        mNoCollisionPairs, mCollisionDispatch),
+                     mConvexPairsToRemove(mMemoryManager.getHeapAllocator()), mConcavePairsToRemove(mMemoryManager.getHeapAllocator()),
                      mBroadPhaseOverlappingNodes(mMemoryManager.getHeapAllocator(), 32),
                      mBroadPhaseSystem(*this, mCollidersComponents, transformComponents, rigidBodyComponents),
                      mMapBroadPhaseIdToColliderEntity(memoryManager.getPoolAllocator()),
@@ -108,6 +112,12 @@ void CollisionDetectionSystem::computeBroadPhase() {
     // overlapping pairs in the collision detection.
     mBroadPhaseSystem.computeOverlappingPairs(mMemoryManager, mBroadPhaseOverlappingNodes);
 
+    // In deterministic mode, the new pairs are created in a canonical order that does not
+    // depend on the iteration order of the set of moved shapes or on the AABB tree traversal
+    if (mWorld->mConfig.isDeterministic) {
+        sortOverlappingNodes(mBroadPhaseOverlappingNodes);
+    }
+
     // Create new overlapping pairs if necessary
     updateOverlappingPairs(mBroadPhaseOverlappingNodes);
 
@@ -117,13 +127,44 @@ void CollisionDetectionSystem::computeBroadPhase() {
     mBroadPhaseOverlappingNodes.clear();
 }
 
+// Sort the pairs of overlapping broad-phase nodes in a canonical order
+/// Each pair is stored with the smallest broad-phase id first and the pairs are sorted
+/// in lexicographic order of their ids.
+void CollisionDetectionSystem::sortOverlappingNodes(Array<Pair<int32, int32>>& overlappingNodes) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::sortOverlappingNodes()", mProfiler);
+
+    const uint32 nbOverlappingNodes = static_cast<uint32>(overlappingNodes.size());
+    if (nbOverlappingNodes == 0) return;
+
+    for (uint32 i=0; i < nbOverlappingNodes; i++) {
+
+        Pair<int32, int32>& nodePair = overlappingNodes[i];
+        if (nodePair.first > nodePair.second) {
+            std::swap(nodePair.first, nodePair.second);
+        }
+    }
+
+    std::sort(&overlappingNodes[0], &overlappingNodes[0] + nbOverlappingNodes,
+              [](const Pair<int32, int32>& pair1, const Pair<int32, int32>& pair2) {
+        return pair1.first < pair2.first || (pair1.first == pair2.first && pair1.second < pair2.second);
+    });
+}
+
 // Remove pairs that are not overlapping anymore
 void CollisionDetectionSystem::removeNonOverlappingPairs() {
 
     RP3D_PROFILE("CollisionDetectionSystem::removeNonOverlappingPairs()", mProfiler);
 
+    // The pairs to remove are set in bit sets and are removed all at once at the end. A bit set
+    // is only reset when the first pair to remove is found.
+    const uint64 nbConvexPairs = mOverlappingPairs.mConvexPairs.size();
+    const uint64 nbConcavePairs = mOverlappingPairs.mConcavePairs.size();
+    bool hasConvexPairsToRemove = false;
+    bool hasConcavePairsToRemove = false;
+
     // For each convex pairs
-    for (uint64 i=0; i < mOverlappingPairs.mConvexPairs.size(); i++) {
+    for (uint64 i=0; i < nbConvexPairs; i++) {
 
         OverlappingPairs::ConvexOverlappingPair& overlappingPair = mOverlappingPairs.mConvexPairs[i];
 
@@ -143,14 +184,18 @@ void CollisionDetectionSystem::removeNonOverlappingPairs() {
                     addLostContactPair(overlappingPair);
                 }
 
-                mOverlappingPairs.removePair(i, true);
-                i--;
+                if (!hasConvexPairsToRemove) {
+                    resetPairsBitSet(mConvexPairsToRemove, nbConvexPairs);
+                    hasConvexPairsToRemove = true;
+                }
+
+                mConvexPairsToRemove[i >> 6] |= uint64(1) << (i & 63);
             }
         }
     }
 
     // For each concave pairs
-    for (uint64 i=0; i < mOverlappingPairs.mConcavePairs.size(); i++) {
+    for (uint64 i=0; i < nbConcavePairs; i++) {
 
         OverlappingPairs::ConcaveOverlappingPair& overlappingPair = mOverlappingPairs.mConcavePairs[i];
 
@@ -170,11 +215,36 @@ void CollisionDetectionSystem::removeNonOverlappingPairs() {
                     addLostContactPair(overlappingPair);
                 }
 
-                mOverlappingPairs.removePair(i, false);
-                i--;
+                if (!hasConcavePairsToRemove) {
+                    resetPairsBitSet(mConcavePairsToRemove, nbConcavePairs);
+                    hasConcavePairsToRemove = true;
+                }
+
+                mConcavePairsToRemove[i >> 6] |= uint64(1) << (i & 63);
             }
         }
     }
+
+    // Remove the pairs that are not overlapping anymore
+    if (hasConvexPairsToRemove) {
+        mOverlappingPairs.removePairs(mConvexPairsToRemove, true);
+    }
+    if (hasConcavePairsToRemove) {
+        mOverlappingPairs.removePairs(mConcavePairsToRemove, false);
+    }
+}
+
+// Reset a bit set of pairs with enough bits for a given number of pairs
+/// The memory of the bit set is kept between two frames and is only allocated when the number of pairs grows
+void CollisionDetectionSystem::resetPairsBitSet(Array<uint64>& pairsBitSet, uint64 nbPairs) {
+
+    const uint64 nbWords = (nbPairs + 63) / 64;
+
+    pairsBitSet.clear();
+    pairsBitSet.addWithoutInit(nbWords);
+    for (uint64 i=0; i < nbWords; i++) {
+        pairsBitSet[i] = 0;
+    }
 }
 
 // Add a lost contact pair (pair of colliders that are not in contact anymore)
@@ -227,6 +297,57 @@ void CollisionDetectionSystem::addNoCollisionPair(Entity body1Entity, Entity bod
     }
 }
 
+// Invalidate the temporal coherence data of the overlapping pairs of a collider near a modified region
+/// This method is called when a region of the concave collision shape of a collider has been modified.
+/// The last frame collision data of the pairs with the colliders overlapping the region are destroyed and
+/// the bodies of those colliders are awakened. The other pairs of the collider are not modified.
+void CollisionDetectionSystem::invalidateCachedCollisionData(Entity colliderEntity, const AABB& worldRegionAABB) {
+
+    RP3D_PROFILE("CollisionDetectionSystem::invalidateCachedCollisionData()", mProfiler);
+
+    // Destroy the last frame collision infos of the concave pairs near the modified region
+    const Array<uint64>& overlappingPairs = mCollidersComponents.getOverlappingPairs(colliderEntity);
+    for (uint64 i = 0; i < overlappingPairs.size(); i++) {
+
+        auto it = mOverlappingPairs.mMapConcavePairIdToPairIndex.find(overlappingPairs[i]);
+        if (it == mOverlappingPairs.mMapConcavePairIdToPairIndex.end()) continue;
+
+        OverlappingPairs::ConcaveOverlappingPair& pair = mOverlappingPairs.mConcavePairs[it->second];
+
+        // Get the other collider of the pair
+        const Entity otherColliderEntity = pair.collider1 == colliderEntity ? pair.collider2 : pair.collider1;
+        const int32 otherBroadPhaseId = mCollidersComponents.getBroadPhaseId(otherColliderEntity);
+        if (mBroadPhaseSystem.getFatAABB(otherBroadPhaseId).testCollision(worldRegionAABB)) {
+            pair.destroyLastFrameCollisionInfos();
+        }
+    }
+
+    // Wake up the dynamic bodies near the modified region. A sleeping body does not have
+    // overlapping pairs anymore and therefore we need to query the broad-phase here.
+    Array<int32> overlappingNodes(mMemoryManager.getHeapAllocator());
+    mBroadPhaseSystem.reportAllShapesOverlappingWithAABB(worldRegionAABB, overlappingNodes);
+
+    const unsigned short categoryBits = mCollidersComponents.getCollisionCategoryBits(colliderEntity);
+    const unsigned short collideWithMaskBits = mCollidersComponents.getCollideWithMaskBits(colliderEntity);
+    for (uint64 i = 0; i < overlappingNodes.size(); i++) {
+
+        const Entity otherColliderEntity = mMapBroadPhaseIdToColliderEntity[overlappingNodes[i]];
+        if (otherColliderEntity == colliderEntity) continue;
+
+        // Ignore the colliders that cannot collide with the modified collider
+        if ((collideWithMaskBits & mCollidersComponents.getCollisionCategoryBits(otherColliderEntity)) == 0 ||
+            (categoryBits & mCollidersComponents.getCollideWithMaskBits(otherColliderEntity)) == 0) {
+            continue;
+        }
+
+        const Entity otherBodyEntity = mCollidersComponents.getBody(otherColliderEntity);
+        if (mRigidBodyComponents.hasComponent(otherBodyEntity) &&
+            mRigidBodyComponents.getBodyType(otherBodyEntity) == BodyType::DYNAMIC) {
+            mRigidBodyComponents.getRigidBody(otherBodyEntity)->setIsSleeping(false);
+        }
+    }
+}
+
 // Take an array of overlapping nodes in the broad-phase and create new overlapping pairs if necessary
 void CollisionDetectionSystem::updateOverlappingPairs(const Array<Pair<int32, int32>>& overlappingNodes) {
 
@@ -333,6 +454,9 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
     // Remove the obsolete last frame collision infos and mark all the others as obsolete
     mOverlappingPairs.clearObsoleteLastFrameCollisionInfos();
 
+    uint32 nbSeparatingAxisTests = 0;
+    uint32 nbSeparatingAxisHits = 0;
+
     // For each possible convex vs convex pair of bodies
     const uint64 nbConvexVsConvexPairs = mOverlappingPairs.mConvexPairs.size();
     for (uint64 i=0; i < nbConvexVsConvexPairs; i++) {
@@ -359,6 +483,25 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
         const bool isCollider2Trigger = mCollidersComponents.mIsTrigger[collider2Index];
         const bool reportContacts = needToReportContacts && !isCollider1Trigger && !isCollider2Trigger;
 
+        overlappingPair.collidingInCurrentFrame = false;
+
+        // If the shapes are still separated along the separating axis of the previous frame, they
+        // cannot collide and we do not need to run the narrow-phase collision detection for them
+        const LastFrameCollisionInfo& lastFrameInfo = overlappingPair.lastFrameCollisionInfo;
+        if (lastFrameInfo.isValid && lastFrameInfo.isSeparatingAxisValid) {
+
+            nbSeparatingAxisTests++;
+
+            if (NarrowPhaseAlgorithm::isSeparatedAlongLastFrameAxis(static_cast<const ConvexShape*>(collisionShape1),
+                                                                    static_cast<const ConvexShape*>(collisionShape2),
+                                                                    mCollidersComponents.mLocalToWorldTransforms[collider1Index],
+                                                                    mCollidersComponents.mLocalToWorldTransforms[collider2Index],
+                                                                    lastFrameInfo)) {
+                nbSeparatingAxisHits++;
+                continue;
+            }
+        }
+
         // No middle-phase is necessary, simply create a narrow phase info
         // for the narrow-phase collision detection
         narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
@@ -366,10 +509,10 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
                                             mCollidersComponents.mLocalToWorldTransforms[collider2Index],
                                             algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo,
                                             mMemoryManager.getSingleFrameAllocator());
-
-        overlappingPair.collidingInCurrentFrame = false;
     }
 
+    RP3D_PROFILE_HIT_COUNTER("Separating axis of the previous frame (convex pairs)", nbSeparatingAxisTests, nbSeparatingAxisHits, mProfiler);
+
     // For each possible convex vs concave pair of bodies
     const uint64 nbConcavePairs = mOverlappingPairs.mConcavePairs.size();
     for (uint64 i=0; i < nbConcavePairs; i++) {
@@ -485,13 +628,15 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
     convexShape->computeAABB(aabb, convexToConcaveTransform);
 
     // Compute the concave shape triangles that are overlapping with the convex mesh AABB
-    Array<Vector3> triangleVertices(allocator, 64);
-    Array<Vector3> triangleVerticesNormals(allocator, 64);
-    Array<uint> shapeIds(allocator, 64);
-    concaveShape->computeOverlappingTriangles(aabb, triangleVertices, triangleVerticesNormals, shapeIds, allocator);
+    SmallArray<Vector3, 64> triangleVertices(allocator);
+    SmallArray<Vector3, 64> triangleVerticesNormals(allocator);
+    SmallArray<uint, 64> shapeIds(allocator);
+    SmallArray<uint8, 64> trianglesInternalEdges(allocator);
+    concaveShape->computeOverlappingTriangles(aabb, triangleVertices, triangleVerticesNormals, shapeIds, trianglesInternalEdges, allocator);
 
     assert(triangleVertices.size() == triangleVerticesNormals.size());
     assert(shapeIds.size() == triangleVertices.size() / 3);
+    assert(trianglesInternalEdges.size() == shapeIds.size());
     assert(triangleVertices.size() % 3 == 0);
     assert(triangleVerticesNormals.size() % 3 == 0);
 
@@ -509,14 +654,67 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
         shape2 = convexShape;
     }
 
-    // For each overlapping triangle
     const uint32 nbShapeIds = static_cast<uint32>(shapeIds.size());
+    const uint32 convexShapeId = convexShape->getId();
+
+    // The sphere vs triangle collision is computed directly from the triangles data without
+    // creating a TriangleShape for each overlapping triangle
+    if (overlappingPair.narrowPhaseAlgorithmType == NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron) {
+
+        // For each overlapping triangle
+        for (uint32 i=0; i < nbShapeIds; i++) {
+
+            // Add a collision info for the two collision shapes into the overlapping pair (if not present yet)
+            LastFrameCollisionInfo* lastFrameInfo = overlappingPair.isShape1Convex ?
+                                                    overlappingPair.addLastFrameInfoIfNecessary(convexShapeId, shapeIds[i]) :
+                                                    overlappingPair.addLastFrameInfoIfNecessary(shapeIds[i], convexShapeId);
+
+            // Create a narrow phase info for the narrow-phase collision detection
+            narrowPhaseInput.addSphereVsTriangleTest(overlappingPair.pairID, collider1, collider2, shape1, shape2,
+                                                     &(triangleVertices[i * 3]), &(triangleVerticesNormals[i * 3]), trianglesInternalEdges[i],
+                                                     shape1LocalToWorldTransform, shape2LocalToWorldTransform, reportContacts,
+                                                     lastFrameInfo, allocator);
+        }
+
+        return;
+    }
+
+    uint32 nbSeparatingAxisTests = 0;
+    uint32 nbSeparatingAxisHits = 0;
+
+    // For each overlapping triangle
     for (uint32 i=0; i < nbShapeIds; i++) {
 
+        // Add a collision info for the two collision shapes into the overlapping pair (if not present yet)
+        LastFrameCollisionInfo* lastFrameInfo = overlappingPair.isShape1Convex ?
+                                                overlappingPair.addLastFrameInfoIfNecessary(convexShapeId, shapeIds[i]) :
+                                                overlappingPair.addLastFrameInfoIfNecessary(shapeIds[i], convexShapeId);
+
+        // If the convex shape and the triangle are still separated along the separating axis of the previous frame,
+        // we do not need to run the narrow-phase collision detection for this triangle
+        if (lastFrameInfo->isValid && lastFrameInfo->isSeparatingAxisValid) {
+
+            nbSeparatingAxisTests++;
+
+            // Temporary triangle shape that is only used to compute the support points of the triangle
+            const TriangleShape separationTestTriangle(&(triangleVertices[i * 3]), shapeIds[i], mTriangleHalfEdgeStructure, allocator);
+            const ConvexShape* separationTestShape1 = overlappingPair.isShape1Convex ? convexShape : &separationTestTriangle;
+            const ConvexShape* separationTestShape2 = overlappingPair.isShape1Convex ? &separationTestTriangle : convexShape;
+
+            if (NarrowPhaseAlgorithm::isSeparatedAlongLastFrameAxis(separationTestShape1, separationTestShape2,
+                                                                    shape1LocalToWorldTransform, shape2LocalToWorldTransform, *lastFrameInfo)) {
+
+                nbSeparatingAxisHits++;
+
+                continue;
+            }
+        }
+
         // Create a triangle collision shape (the allocated memory for the TriangleShape will be released in the
         // destructor of the corresponding NarrowPhaseInfo.
         TriangleShape* triangleShape = new (allocator.allocate(sizeof(TriangleShape)))
-                                       TriangleShape(&(triangleVertices[i * 3]), &(triangleVerticesNormals[i * 3]), shapeIds[i], mTriangleHalfEdgeStructure, allocator);
+                                       TriangleShape(&(triangleVertices[i * 3]), &(triangleVerticesNormals[i * 3]), shapeIds[i], trianglesInternalEdges[i],
+                                                     mTriangleHalfEdgeStructure, allocator);
 
     #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -533,14 +731,13 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
             shape1 = triangleShape;
         }
 
-        // Add a collision info for the two collision shapes into the overlapping pair (if not present yet)
-        LastFrameCollisionInfo* lastFrameInfo = overlappingPair.addLastFrameInfoIfNecessary(shape1->getId(), shape2->getId());
-
         // Create a narrow phase info for the narrow-phase collision detection
         narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1, collider2, shape1, shape2,
                                             shape1LocalToWorldTransform, shape2LocalToWorldTransform,
                                             overlappingPair.narrowPhaseAlgorithmType, reportContacts, lastFrameInfo, allocator);
     }
+
+    RP3D_PROFILE_HIT_COUNTER("Separating axis of the previous frame (triangles)", nbSeparatingAxisTests, nbSeparatingAxisHits, mProfiler);
 }
 
 // Execute the narrow-phase collision detection algorithm on batches
@@ -556,12 +753,16 @@ bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrow
     SphereVsConvexPolyhedronAlgorithm* sphereVsConvexPolyAlgo = mCollisionDispatch.getSphereVsConvexPolyhedronAlgorithm();
     CapsuleVsConvexPolyhedronAlgorithm* capsuleVsConvexPolyAlgo = mCollisionDispatch.getCapsuleVsConvexPolyhedronAlgorithm();
     ConvexPolyhedronVsConvexPolyhedronAlgorithm* convexPolyVsConvexPolyAlgo = mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm();
+    BoxVsBoxAlgorithm* boxVsBoxAlgo = mCollisionDispatch.getBoxVsBoxAlgorithm();
 
     // get the narrow-phase batches to test for collision for contacts
     NarrowPhaseInfoBatch& sphereVsSphereBatchContacts = narrowPhaseInput.getSphereVsSphereBatch();
     NarrowPhaseInfoBatch& sphereVsCapsuleBatchContacts = narrowPhaseInput.getSphereVsCapsuleBatch();
     NarrowPhaseInfoBatch& capsuleVsCapsuleBatchContacts = narrowPhaseInput.getCapsuleVsCapsuleBatch();
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatchContacts = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& sphereVsTriangleBatchContacts = narrowPhaseInput.getSphereVsTriangleBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatchContacts = narrowPhaseInput.getBoxVsBoxBatch();
+    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronEPABatchContacts = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronEPABatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatchContacts = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatchContacts = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
 
@@ -578,12 +779,21 @@ bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrow
     if (sphereVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
         contactFound |= sphereVsConvexPolyAlgo->testCollision(sphereVsConvexPolyhedronBatchContacts, 0, sphereVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
     }
+    if (sphereVsTriangleBatchContacts.getNbObjects() > 0) {
+        contactFound |= sphereVsConvexPolyAlgo->testCollisionVsTriangles(sphereVsTriangleBatchContacts, 0, sphereVsTriangleBatchContacts.getNbObjects());
+    }
     if (capsuleVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
         contactFound |= capsuleVsConvexPolyAlgo->testCollision(capsuleVsConvexPolyhedronBatchContacts, 0, capsuleVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
     }
     if (convexPolyhedronVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
         contactFound |= convexPolyVsConvexPolyAlgo->testCollision(convexPolyhedronVsConvexPolyhedronBatchContacts, 0, convexPolyhedronVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
     }
+    if (boxVsBoxBatchContacts.getNbObjects() > 0) {
+        contactFound |= boxVsBoxAlgo->testCollision(boxVsBoxBatchContacts, 0, boxVsBoxBatchContacts.getNbObjects());
+    }
+    if (convexPolyhedronVsConvexPolyhedronEPABatchContacts.getNbObjects() > 0) {
+        contactFound |= convexPolyVsConvexPolyAlgo->testCollisionUsingEPA(convexPolyhedronVsConvexPolyhedronEPABatchContacts, 0, convexPolyhedronVsConvexPolyhedronEPABatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+    }
 
     return contactFound;
 }
@@ -596,13 +806,16 @@ void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& nar
 
     assert(contactPairs->size() == 0);
 
-    Map<uint64, uint> mapPairIdToContactPairIndex(mMemoryManager.getHeapAllocator(), mPreviousMapPairIdToContactPairIndex.size());
+    FlatMap<uint64, uint, Uint64Hash> mapPairIdToContactPairIndex(mMemoryManager.getHeapAllocator(), mPreviousMapPairIdToContactPairIndex.size());
 
     // get the narrow-phase batches to test for collision
     NarrowPhaseInfoBatch& sphereVsSphereBatch = narrowPhaseInput.getSphereVsSphereBatch();
     NarrowPhaseInfoBatch& sphereVsCapsuleBatch = narrowPhaseInput.getSphereVsCapsuleBatch();
     NarrowPhaseInfoBatch& capsuleVsCapsuleBatch = narrowPhaseInput.getCapsuleVsCapsuleBatch();
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatch = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& sphereVsTriangleBatch = narrowPhaseInput.getSphereVsTriangleBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatch = narrowPhaseInput.getBoxVsBoxBatch();
+    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronEPABatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronEPABatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatch = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
 
@@ -611,9 +824,13 @@ void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& nar
     processPotentialContacts(sphereVsCapsuleBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
     processPotentialContacts(capsuleVsCapsuleBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
     processPotentialContacts(sphereVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
+    processPotentialContacts(sphereVsTriangleBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
     processPotentialContacts(capsuleVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
     processPotentialContacts(convexPolyhedronVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints,
                              potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
+    processPotentialContacts(boxVsBoxBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
+    processPotentialContacts(convexPolyhedronVsConvexPolyhedronEPABatch, updateLastFrameInfo, potentialContactPoints,
+                             potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
 }
 
 // Compute the narrow-phase collision detection
@@ -719,6 +936,9 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInp
     NarrowPhaseInfoBatch& sphereVsCapsuleBatch = narrowPhaseInput.getSphereVsCapsuleBatch();
     NarrowPhaseInfoBatch& capsuleVsCapsuleBatch = narrowPhaseInput.getCapsuleVsCapsuleBatch();
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatch = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& sphereVsTriangleBatch = narrowPhaseInput.getSphereVsTriangleBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatch = narrowPhaseInput.getBoxVsBoxBatch();
+    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronEPABatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronEPABatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatch = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
 
@@ -727,8 +947,11 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInp
     computeOverlapSnapshotContactPairs(sphereVsCapsuleBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(capsuleVsCapsuleBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(sphereVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
+    computeOverlapSnapshotContactPairs(sphereVsTriangleBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(capsuleVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(convexPolyhedronVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
+    computeOverlapSnapshotContactPairs(boxVsBoxBatch, contactPairs, setOverlapContactPairId);
+    computeOverlapSnapshotContactPairs(convexPolyhedronVsConvexPolyhedronEPABatch, contactPairs, setOverlapContactPairId);
 }
 
 // Notify that the overlapping pairs where a given collider is involved need to be tested for overlap
@@ -989,7 +1212,7 @@ void CollisionDetectionSystem::createSnapshotContacts(Array<ContactPair>& contac
 
             // Start index and number of contact points for this manifold
             const uint32 contactPointsIndex = static_cast<uint32>(contactPoints.size());
-            const uint8 nbContactPoints = potentialManifold.nbPotentialContactPoints;
+            const uint8 nbContactPoints = static_cast<uint8>(potentialManifold.nbPotentialContactPoints);
             contactPair.nbToTalContactPoints += nbContactPoints;
 
             // Create and add the contact manifold
@@ -1147,7 +1370,7 @@ void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback, const R
 void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, bool updateLastFrameInfo,
                                                         Array<ContactPointInfo>& potentialContactPoints,
                                                         Array<ContactManifoldInfo>& potentialContactManifolds,
-                                                        Map<uint64, uint>& mapPairIdToContactPairIndex,
+                                                        FlatMap<uint64, uint, Uint64Hash>& mapPairIdToContactPairIndex,
                                                         Array<ContactPair>* contactPairs) {
 
     RP3D_PROFILE("CollisionDetectionSystem::processPotentialContacts()", mProfiler);
@@ -1161,6 +1384,11 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
 
             narrowPhaseInfoBatch.narrowPhaseInfos[i].lastFrameCollisionInfo->wasColliding = narrowPhaseInfoBatch.narrowPhaseInfos[i].isColliding;
 
+            // The shapes are not separated anymore along the previous separating axis
+            if (narrowPhaseInfoBatch.narrowPhaseInfos[i].isColliding) {
+                narrowPhaseInfoBatch.narrowPhaseInfos[i].lastFrameCollisionInfo->isSeparatingAxisValid = false;
+            }
+
             // The previous frame collision info is now valid
             narrowPhaseInfoBatch.narrowPhaseInfos[i].lastFrameCollisionInfo->isValid = true;
         }
@@ -1336,61 +1564,66 @@ void CollisionDetectionSystem::reducePotentialContactManifolds(Array<ContactPair
 
     RP3D_PROFILE("CollisionDetectionSystem::reducePotentialContactManifolds()", mProfiler);
 
-    // Reduce the number of potential contact manifolds in a contact pair
+    // The reduction of a contact pair only reads and writes the manifolds of this pair. Therefore,
+    // the contact pairs are independent and could be reduced in any order.
     const uint32 nbContactPairs = static_cast<uint32>(contactPairs->size());
     for (uint32 i=0; i < nbContactPairs; i++) {
 
-        ContactPair& contactPair = (*contactPairs)[i];
+        reduceContactPairManifolds((*contactPairs)[i], potentialContactManifolds, potentialContactPoints);
+    }
+}
 
-        // While there are too many manifolds in the contact pair
-        while(contactPair.nbPotentialContactManifolds > NB_MAX_CONTACT_MANIFOLDS) {
+// Reduce the potential contact manifolds and contact points of a single contact pair
+void CollisionDetectionSystem::reduceContactPairManifolds(ContactPair& contactPair, Array<ContactManifoldInfo>& potentialContactManifolds,
+                                                          const Array<ContactPointInfo>& potentialContactPoints) const {
 
-            // Look for a manifold with the smallest contact penetration depth.
-            decimal minDepth = DECIMAL_LARGEST;
-            int minDepthManifoldIndex = -1;
-            for (uint32 j=0; j < contactPair.nbPotentialContactManifolds; j++) {
+    // If there are too many manifolds in the contact pair
+    if (contactPair.nbPotentialContactManifolds > NB_MAX_CONTACT_MANIFOLDS) {
 
-                ContactManifoldInfo& manifold = potentialContactManifolds[contactPair.potentialContactManifoldsIndices[j]];
+        // Compute the largest contact penetration depth of each manifold (only once)
+        decimal manifoldsDepths[NB_MAX_POTENTIAL_CONTACT_MANIFOLDS];
+        for (uint32 j=0; j < contactPair.nbPotentialContactManifolds; j++) {
+            const ContactManifoldInfo& manifold = potentialContactManifolds[contactPair.potentialContactManifoldsIndices[j]];
+            manifoldsDepths[j] = computePotentialManifoldLargestContactDepth(manifold, potentialContactPoints);
+        }
 
-                // Get the largest contact point penetration depth of the manifold
-                const decimal depth = computePotentialManifoldLargestContactDepth(manifold, potentialContactPoints);
+        // While there are too many manifolds in the contact pair
+        while(contactPair.nbPotentialContactManifolds > NB_MAX_CONTACT_MANIFOLDS) {
 
-                if (depth < minDepth) {
-                    minDepth = depth;
-                    minDepthManifoldIndex = static_cast<int>(j);
+            // Look for a manifold with the smallest contact penetration depth
+            uint32 minDepthManifoldIndex = 0;
+            for (uint32 j=1; j < contactPair.nbPotentialContactManifolds; j++) {
+                if (manifoldsDepths[j] < manifoldsDepths[minDepthManifoldIndex]) {
+                    minDepthManifoldIndex = j;
                 }
             }
 
-            // Remove the non optimal manifold
-            assert(minDepthManifoldIndex >= 0);
+            // Remove the non optimal manifold (the last manifold takes its place)
             contactPair.removePotentialManifoldAtIndex(minDepthManifoldIndex);
+            manifoldsDepths[minDepthManifoldIndex] = manifoldsDepths[contactPair.nbPotentialContactManifolds];
         }
     }
 
-    // Reduce the number of potential contact points in the manifolds
-    for (uint32 i=0; i < nbContactPairs; i++) {
+    // For each potential contact manifold
+    for (uint32 j=0; j < contactPair.nbPotentialContactManifolds; j++) {
 
-        const ContactPair& pairContact = (*contactPairs)[i];
+        ContactManifoldInfo& manifold = potentialContactManifolds[contactPair.potentialContactManifoldsIndices[j]];
 
-        // For each potential contact manifold
-        for (uint32 j=0; j < pairContact.nbPotentialContactManifolds; j++) {
+        // If there are two many contact points in the manifold
+        if (manifold.nbPotentialContactPoints > MAX_CONTACT_POINTS_IN_MANIFOLD) {
 
-            ContactManifoldInfo& manifold = potentialContactManifolds[pairContact.potentialContactManifoldsIndices[j]];
+            const Transform& shape1LocalToWorldTransform = mCollidersComponents.getLocalToWorldTransform(contactPair.collider1Entity);
 
-            // If there are two many contact points in the manifold
-            if (manifold.nbPotentialContactPoints > MAX_CONTACT_POINTS_IN_MANIFOLD) {
-
-                Transform shape1LocalToWorldTransoform = mCollidersComponents.getLocalToWorldTransform(pairContact.collider1Entity);
-
-                // Reduce the number of contact points in the manifold
-                reduceContactPoints(manifold, shape1LocalToWorldTransoform, potentialContactPoints);
-            }
-
-            assert(manifold.nbPotentialContactPoints <= MAX_CONTACT_POINTS_IN_MANIFOLD);
+            // Reduce the number of contact points in the manifold (this also removes the duplicated points)
+            reduceContactPoints(manifold, shape1LocalToWorldTransform, potentialContactPoints);
+        }
+        else {
 
             // Remove the duplicated contact points in the manifold (if any)
             removeDuplicatedContactPointsInManifold(manifold, potentialContactPoints);
         }
+
+        assert(manifold.nbPotentialContactPoints <= MAX_CONTACT_POINTS_IN_MANIFOLD);
     }
 }
 
@@ -1416,7 +1649,9 @@ decimal CollisionDetectionSystem::computePotentialManifoldLargestContactDepth(co
 // Reduce the number of contact points of a potential contact manifold
 // This is based on the technique described by Dirk Gregorius in his
 // "Contacts Creation" GDC presentation. This method will reduce the number of
-// contact points to a maximum of 4 points (but it can be less).
+// contact points to a maximum of 4 points (but it can be less). The candidates
+// that are closer than SAME_CONTACT_POINT_DISTANCE_THRESHOLD to a kept point are
+// discarded along the way so that the kept points are never duplicated.
 void CollisionDetectionSystem::reduceContactPoints(ContactManifoldInfo& manifold, const Transform& shape1ToWorldTransform,
                                              const Array<ContactPointInfo>& potentialContactPoints) const {
 
@@ -1425,185 +1660,162 @@ void CollisionDetectionSystem::reduceContactPoints(ContactManifoldInfo& manifold
     // The following algorithm only works to reduce to a maximum of 4 contact points
     assert(MAX_CONTACT_POINTS_IN_MANIFOLD == 4);
 
-    // Array of the candidate contact points indices in the manifold. Every time that we have found a
-    // point we want to keep, we will remove it from this array
-    uint candidatePointsIndices[NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD];
-    uint8 nbCandidatePoints = manifold.nbPotentialContactPoints;
-    for (uint8 i=0 ; i < manifold.nbPotentialContactPoints; i++) {
-        candidatePointsIndices[i] = manifold.potentialContactPointsIndices[i];
-    }
-
-    int8 nbReducedPoints = 0;
+    const decimal distThresholdSqr = SAME_CONTACT_POINT_DISTANCE_THRESHOLD * SAME_CONTACT_POINT_DISTANCE_THRESHOLD;
 
-    uint32 pointsToKeepIndices[MAX_CONTACT_POINTS_IN_MANIFOLD];
-    for (int8 i=0; i<MAX_CONTACT_POINTS_IN_MANIFOLD; i++) {
-        pointsToKeepIndices[i] = 0;
+    // Gather the candidate points. Every time that we have found a point we want
+    // to keep, we remove it (and its duplicates) from the candidates
+    ContactPointCandidates candidates;
+    candidates.nbCandidates = manifold.nbPotentialContactPoints;
+    for (uint16 i=0; i < candidates.nbCandidates; i++) {
+        const uint32 pointIndex = manifold.potentialContactPointsIndices[i];
+        const Vector3& localPoint1 = potentialContactPoints[pointIndex].localPoint1;
+        candidates.x[i] = localPoint1.x;
+        candidates.y[i] = localPoint1.y;
+        candidates.z[i] = localPoint1.z;
+        candidates.indices[i] = pointIndex;
     }
+    const uint16 nbCandidates = candidates.nbCandidates;
 
-    //  Compute the initial contact point we need to keep.
-    // The first point we keep is always the point in a given
-    // constant direction (in order to always have same contact points
-    // between frames for better stability)
+    uint32 pointsToKeepIndices[MAX_CONTACT_POINTS_IN_MANIFOLD];
+    uint8 nbPointsToKeep = 0;
 
     const Transform worldToShape1Transform = shape1ToWorldTransform.getInverse();
 
     // Compute the contact normal of the manifold (we use the first contact point)
     // in the local-space of the first collision shape
-    const Vector3 contactNormalShape1Space = worldToShape1Transform.getOrientation() * potentialContactPoints[candidatePointsIndices[0]].normal;
-
-    // Compute a search direction
-    const Vector3 searchDirection(1, 1, 1);
-    decimal maxDotProduct = DECIMAL_SMALLEST;
-    uint32 elementIndexToKeep = 0;
-    for (uint32 i=0; i < nbCandidatePoints; i++) {
-
-        const ContactPointInfo& element = potentialContactPoints[candidatePointsIndices[i]];
-        decimal dotProduct = searchDirection.dot(element.localPoint1);
-        if (dotProduct > maxDotProduct) {
-            maxDotProduct = dotProduct;
-            elementIndexToKeep = i;
-            nbReducedPoints = 1;
-        }
+    const Vector3 contactNormalShape1Space = worldToShape1Transform.getOrientation() * potentialContactPoints[manifold.potentialContactPointsIndices[0]].normal;
+
+    //  Compute the initial contact point we need to keep.
+    // The first point we keep is always the point in a given
+    // constant direction (1, 1, 1) (in order to always have same contact points
+    // between frames for better stability)
+    for (uint16 i=0; i < nbCandidates; i++) {
+        candidates.scores[i] = candidates.x[i] + candidates.y[i] + candidates.z[i];
+    }
+    uint16 candidateToKeep = findLargestScoreCandidate(candidates);
+    pointsToKeepIndices[nbPointsToKeep++] = candidates.indices[candidateToKeep];
+
+    // From now on, the candidates are expressed relative to the first kept point. This way, the
+    // triangle areas below are computed with small coordinates even far from the shape origin
+    const Vector3 firstPoint(candidates.x[candidateToKeep], candidates.y[candidateToKeep], candidates.z[candidateToKeep]);
+    for (uint16 i=0; i < nbCandidates; i++) {
+        candidates.x[i] -= firstPoint.x;
+        candidates.y[i] -= firstPoint.y;
+        candidates.z[i] -= firstPoint.z;
     }
-    pointsToKeepIndices[0] = candidatePointsIndices[elementIndexToKeep];
-    removeItemAtInArray(candidatePointsIndices, elementIndexToKeep, nbCandidatePoints);
-    //candidatePointsIndices.removeAt(elementIndexToKeep);
-    assert(nbReducedPoints == 1);
+    const Vector3 pointToKeep0(0, 0, 0);
 
     // Compute the second contact point we need to keep.
     // The second point we keep is the one farthest away from the first point.
+    // The squared distances to the first point are the scores left by the removal of its duplicates.
+    removeCandidatesCloseToPoint(candidates, pointToKeep0, distThresholdSqr);
+    if (candidates.nbCandidates > 0) {
+
+        candidateToKeep = findLargestScoreCandidate(candidates);
+        pointsToKeepIndices[nbPointsToKeep++] = candidates.indices[candidateToKeep];
+        const Vector3 pointToKeep1(candidates.x[candidateToKeep], candidates.y[candidateToKeep], candidates.z[candidateToKeep]);
+        removeCandidatesCloseToPoint(candidates, pointToKeep1, distThresholdSqr);
+
+        // Compute the third contact point we need to keep.
+        // The third point is the one producing the triangle with the larger area
+        // with first and second point. The signed area of the triangle (a, b, p) along the normal n is
+        // ((a - p) x (b - p)).n = (a x b).n + p.((a - b) x n), an affine function of p.
+        if (candidates.nbCandidates > 0) {
+
+            const Vector3 areaGradient = (pointToKeep0 - pointToKeep1).cross(contactNormalShape1Space);
+            for (uint16 i=0; i < candidates.nbCandidates; i++) {
+                candidates.scores[i] = candidates.x[i] * areaGradient.x + candidates.y[i] * areaGradient.y + candidates.z[i] * areaGradient.z;
+            }
 
-    decimal maxDistance = decimal(0.0);
-    elementIndexToKeep = 0;
-    for (uint32 i=0; i < nbCandidatePoints; i++) {
-
-        const ContactPointInfo& element = potentialContactPoints[candidatePointsIndices[i]];
-        const ContactPointInfo& pointToKeep0 = potentialContactPoints[pointsToKeepIndices[0]];
-
-        assert(candidatePointsIndices[i] != pointsToKeepIndices[0]);
-
-        const decimal distance = (pointToKeep0.localPoint1 - element.localPoint1).lengthSquare();
-        if (distance >= maxDistance) {
-            maxDistance = distance;
-            elementIndexToKeep = i;
-            nbReducedPoints = 2;
+            // We compute the most positive or most negative triangle area (depending on winding)
+            uint16 thirdPointMaxAreaIndex = 0;
+            uint16 thirdPointMinAreaIndex = 0;
+            for (uint16 i=1; i < candidates.nbCandidates; i++) {
+                if (candidates.scores[i] > candidates.scores[thirdPointMaxAreaIndex]) {
+                    thirdPointMaxAreaIndex = i;
+                }
+                if (candidates.scores[i] < candidates.scores[thirdPointMinAreaIndex]) {
+                    thirdPointMinAreaIndex = i;
+                }
+            }
+            const bool isPreviousAreaPositive = candidates.scores[thirdPointMaxAreaIndex] > -candidates.scores[thirdPointMinAreaIndex];
+            candidateToKeep = isPreviousAreaPositive ? thirdPointMaxAreaIndex : thirdPointMinAreaIndex;
+            pointsToKeepIndices[nbPointsToKeep++] = candidates.indices[candidateToKeep];
+            const Vector3 pointToKeep2(candidates.x[candidateToKeep], candidates.y[candidateToKeep], candidates.z[candidateToKeep]);
+            removeCandidatesCloseToPoint(candidates, pointToKeep2, distThresholdSqr);
+
+            // Compute the 4th point by choosing the triangle that adds the most
+            // triangle area to the previous triangle and has opposite sign area (opposite winding)
+            if (candidates.nbCandidates > 0) {
+
+                // Area functions of the triangles made by each edge of the first triangle and a candidate.
+                // If the previous area is positive, we are looking at negative areas now (and the
+                // opposite), so we negate the areas in order to always look for the largest score.
+                const decimal sign = isPreviousAreaPositive ? decimal(-1.0) : decimal(1.0);
+                const Vector3 gradient01 = sign * (pointToKeep0 - pointToKeep1).cross(contactNormalShape1Space);
+                const Vector3 gradient12 = sign * (pointToKeep1 - pointToKeep2).cross(contactNormalShape1Space);
+                const Vector3 gradient20 = sign * (pointToKeep2 - pointToKeep0).cross(contactNormalShape1Space);
+                const decimal constant12 = sign * pointToKeep1.cross(pointToKeep2).dot(contactNormalShape1Space);
+
+                for (uint16 i=0; i < candidates.nbCandidates; i++) {
+                    const decimal area01 = candidates.x[i] * gradient01.x + candidates.y[i] * gradient01.y + candidates.z[i] * gradient01.z;
+                    const decimal area12 = constant12 + candidates.x[i] * gradient12.x + candidates.y[i] * gradient12.y + candidates.z[i] * gradient12.z;
+                    const decimal area20 = candidates.x[i] * gradient20.x + candidates.y[i] * gradient20.y + candidates.z[i] * gradient20.z;
+                    candidates.scores[i] = std::max(area01, std::max(area12, area20));
+                }
+                candidateToKeep = findLargestScoreCandidate(candidates);
+                pointsToKeepIndices[nbPointsToKeep++] = candidates.indices[candidateToKeep];
+            }
         }
-
     }
-    pointsToKeepIndices[1] = candidatePointsIndices[elementIndexToKeep];
-    removeItemAtInArray(candidatePointsIndices, elementIndexToKeep, nbCandidatePoints);
-    assert(nbReducedPoints == 2);
 
-    // Compute the third contact point we need to keep.
-    // The third point is the one producing the triangle with the larger area
-    // with first and second point.
-
-    // We compute the most positive or most negative triangle area (depending on winding)
-    uint32 thirdPointMaxAreaIndex = 0;
-    uint32 thirdPointMinAreaIndex = 0;
-    decimal minArea = decimal(0.0);
-    decimal maxArea = decimal(0.0);
-    bool isPreviousAreaPositive = true;
-    for (uint32 i=0; i < nbCandidatePoints; i++) {
-
-        const ContactPointInfo& element = potentialContactPoints[candidatePointsIndices[i]];
-        const ContactPointInfo& pointToKeep0 = potentialContactPoints[pointsToKeepIndices[0]];
-        const ContactPointInfo& pointToKeep1 = potentialContactPoints[pointsToKeepIndices[1]];
-
-        assert(candidatePointsIndices[i] != pointsToKeepIndices[0]);
-        assert(candidatePointsIndices[i] != pointsToKeepIndices[1]);
+    // Only keep the selected contact points in the manifold
+    for (uint8 i=0; i < nbPointsToKeep; i++) {
+        manifold.potentialContactPointsIndices[i] = pointsToKeepIndices[i];
+    }
+    manifold.nbPotentialContactPoints = nbPointsToKeep;
+}
 
-        const Vector3 newToFirst = pointToKeep0.localPoint1 - element.localPoint1;
-        const Vector3 newToSecond = pointToKeep1.localPoint1 - element.localPoint1;
+// Return the index of the candidate contact point with the largest score
+uint16 CollisionDetectionSystem::findLargestScoreCandidate(const ContactPointCandidates& candidates) {
 
-        // Compute the triangle area
-        decimal area = newToFirst.cross(newToSecond).dot(contactNormalShape1Space);
+    assert(candidates.nbCandidates > 0);
 
-        if (area >= maxArea) {
-            maxArea = area;
-            thirdPointMaxAreaIndex = i;
-        }
-        if (area <= minArea) {
-            minArea = area;
-            thirdPointMinAreaIndex = i;
+    uint16 largestScoreIndex = 0;
+    for (uint16 i=1; i < candidates.nbCandidates; i++) {
+        if (candidates.scores[i] > candidates.scores[largestScoreIndex]) {
+            largestScoreIndex = i;
         }
     }
-    assert(minArea <= decimal(0.0));
-    assert(maxArea >= decimal(0.0));
-    if (maxArea > (-minArea)) {
-        isPreviousAreaPositive = true;
-        pointsToKeepIndices[2] = candidatePointsIndices[thirdPointMaxAreaIndex];
-        removeItemAtInArray(candidatePointsIndices, thirdPointMaxAreaIndex, nbCandidatePoints);
-    }
-    else {
-        isPreviousAreaPositive = false;
-        pointsToKeepIndices[2] = candidatePointsIndices[thirdPointMinAreaIndex];
-        removeItemAtInArray(candidatePointsIndices, thirdPointMinAreaIndex, nbCandidatePoints);
-    }
-    nbReducedPoints = 3;
-
-    // Compute the 4th point by choosing the triangle that adds the most
-    // triangle area to the previous triangle and has opposite sign area (opposite winding)
-
-    decimal largestArea = decimal(0.0); // Largest area (positive or negative)
-    elementIndexToKeep = 0;
-    nbReducedPoints = 4;
-    decimal area;
 
-    // For each remaining candidate points
-    for (uint32 i=0; i < nbCandidatePoints; i++) {
-
-        const ContactPointInfo& element = potentialContactPoints[candidatePointsIndices[i]];
-
-        assert(candidatePointsIndices[i] != pointsToKeepIndices[0]);
-        assert(candidatePointsIndices[i] != pointsToKeepIndices[1]);
-        assert(candidatePointsIndices[i] != pointsToKeepIndices[2]);
-
-        // For each edge of the triangle made by the first three points
-        for (uint32 j=0; j<3; j++) {
-
-            uint32 edgeVertex1Index = j;
-            uint32 edgeVertex2Index = j < 2 ? j + 1 : 0;
-
-            const ContactPointInfo& pointToKeepEdgeV1 = potentialContactPoints[pointsToKeepIndices[edgeVertex1Index]];
-            const ContactPointInfo& pointToKeepEdgeV2 = potentialContactPoints[pointsToKeepIndices[edgeVertex2Index]];
+    return largestScoreIndex;
+}
 
-            const Vector3 newToFirst = pointToKeepEdgeV1.localPoint1 - element.localPoint1;
-            const Vector3 newToSecond = pointToKeepEdgeV2.localPoint1 - element.localPoint1;
+// Remove the candidate contact points that are closer than a distance threshold to a given point.
+// The squared distances of the remaining candidates to the point are left in their scores.
+void CollisionDetectionSystem::removeCandidatesCloseToPoint(ContactPointCandidates& candidates, const Vector3& point,
+                                                            decimal distThresholdSqr) {
 
-            // Compute the triangle area
-            area = newToFirst.cross(newToSecond).dot(contactNormalShape1Space);
+    for (uint16 i=0; i < candidates.nbCandidates; i++) {
+        const decimal dx = candidates.x[i] - point.x;
+        const decimal dy = candidates.y[i] - point.y;
+        const decimal dz = candidates.z[i] - point.z;
+        candidates.scores[i] = dx * dx + dy * dy + dz * dz;
+    }
 
-            // We are looking at the triangle with maximal area (positive or negative).
-            // If the previous area is positive, we are looking at negative area now.
-            // If the previous area is negative, we are looking at the positive area now.
-            if (isPreviousAreaPositive && area <= largestArea) {
-                largestArea = area;
-                elementIndexToKeep = i;
-            }
-            else if (!isPreviousAreaPositive && area >= largestArea) {
-                largestArea = area;
-                elementIndexToKeep = i;
-            }
+    // Compact the remaining candidates (this keeps their order)
+    uint16 nbRemainingCandidates = 0;
+    for (uint16 i=0; i < candidates.nbCandidates; i++) {
+        if (candidates.scores[i] >= distThresholdSqr) {
+            candidates.x[nbRemainingCandidates] = candidates.x[i];
+            candidates.y[nbRemainingCandidates] = candidates.y[i];
+            candidates.z[nbRemainingCandidates] = candidates.z[i];
+            candidates.scores[nbRemainingCandidates] = candidates.scores[i];
+            candidates.indices[nbRemainingCandidates] = candidates.indices[i];
+            nbRemainingCandidates++;
         }
     }
-    pointsToKeepIndices[3] = candidatePointsIndices[elementIndexToKeep];
-    removeItemAtInArray(candidatePointsIndices, elementIndexToKeep, nbCandidatePoints);
-
-    // Only keep the four selected contact points in the manifold
-    manifold.potentialContactPointsIndices[0] = pointsToKeepIndices[0];
-    manifold.potentialContactPointsIndices[1] = pointsToKeepIndices[1];
-    manifold.potentialContactPointsIndices[2] = pointsToKeepIndices[2];
-    manifold.potentialContactPointsIndices[3] = pointsToKeepIndices[3];
-    manifold.nbPotentialContactPoints = 4;
-}
-
-// Remove an element in an array (and replace it by the last one in the array)
-void CollisionDetectionSystem::removeItemAtInArray(uint array[], uint8 index, uint8& arraySize) const {
-    assert(index < arraySize);
-    assert(arraySize > 0);
-    array[index] = array[arraySize - 1];
-    arraySize--;
+    candidates.nbCandidates = nbRemainingCandidates;
 }
 
 // Remove the duplicated contact points in a given contact manifold
@@ -1896,3 +2108,70 @@ const AABB CollisionDetectionSystem::getWorldAABB(const Collider* collider) cons
     assert(collider->getBroadPhaseId() > -1);
     return mBroadPhaseSystem.getFatAABB(collider->getBroadPhaseId());
 }
+
+// Write the state of the collision detection into a snapshot
+/// The snapshot contains the overlapping pairs, the broad-phase state and the contacts of the
+/// last frame (with their impulses used for warm starting).
+void CollisionDetectionSystem::takeSnapshot(SnapshotWriter& writer) const {
+
+    mOverlappingPairs.takeSnapshot(writer);
+    mBroadPhaseSystem.takeSnapshot(writer);
+
+    const uint32 nbContactPairs = static_cast<uint32>(mCurrentContactPairs->size());
+    const uint32 nbContactManifolds = static_cast<uint32>(mCurrentContactManifolds->size());
+    const uint32 nbContactPoints = static_cast<uint32>(mCurrentContactPoints->size());
+    writer.write(nbContactPairs);
+    writer.write(nbContactManifolds);
+    writer.write(nbContactPoints);
+    if (nbContactPairs > 0) writer.writeBytes(&(*mCurrentContactPairs)[0], nbContactPairs * sizeof(ContactPair));
+    if (nbContactManifolds > 0) writer.writeBytes(&(*mCurrentContactManifolds)[0], nbContactManifolds * sizeof(ContactManifold));
+    if (nbContactPoints > 0) writer.writeBytes(&(*mCurrentContactPoints)[0], nbContactPoints * sizeof(ContactPoint));
+}
+
+// Check that a snapshot of the collision detection is valid and skip it
+bool CollisionDetectionSystem::validateSnapshot(SnapshotReader& reader) const {
+
+    if (!mOverlappingPairs.validateSnapshot(reader)) return false;
+    if (!mBroadPhaseSystem.validateSnapshot(reader)) return false;
+
+    const uint32 nbContactPairs = reader.read<uint32>();
+    const uint32 nbContactManifolds = reader.read<uint32>();
+    const uint32 nbContactPoints = reader.read<uint32>();
+    reader.skipBytes(nbContactPairs * sizeof(ContactPair));
+    reader.skipBytes(nbContactManifolds * sizeof(ContactManifold));
+    reader.skipBytes(nbContactPoints * sizeof(ContactPoint));
+
+    return !reader.hasFailed();
+}
+
+// Restore the state of the collision detection from a snapshot
+void CollisionDetectionSystem::restoreSnapshot(SnapshotReader& reader) {
+
+    mOverlappingPairs.restoreSnapshot(reader);
+    mBroadPhaseSystem.restoreSnapshot(reader);
+
+    // The broad-phase ids of the colliders have been restored with the colliders components
+    mMapBroadPhaseIdToColliderEntity.clear();
+    for (uint32 i=0; i < mCollidersComponents.getNbComponents(); i++) {
+        if (mCollidersComponents.mBroadPhaseIds[i] != -1) {
+            mMapBroadPhaseIdToColliderEntity.add(Pair<int, Entity>(mCollidersComponents.mBroadPhaseIds[i], mCollidersComponents.mCollidersEntities[i]));
+        }
+    }
+
+    const uint32 nbContactPairs = reader.read<uint32>();
+    const uint32 nbContactManifolds = reader.read<uint32>();
+    const uint32 nbContactPoints = reader.read<uint32>();
+
+    mCurrentContactPairs->clear();
+    mCurrentContactManifolds->clear();
+    mCurrentContactPoints->clear();
+    mCurrentContactPairs->addWithoutInit(nbContactPairs);
+    mCurrentContactManifolds->addWithoutInit(nbContactManifolds);
+    mCurrentContactPoints->addWithoutInit(nbContactPoints);
+    if (nbContactPairs > 0) reader.readBytes(&(*mCurrentContactPairs)[0], nbContactPairs * sizeof(ContactPair));
+    if (nbContactManifolds > 0) reader.readBytes(&(*mCurrentContactManifolds)[0], nbContactManifolds * sizeof(ContactManifold));
+    if (nbContactPoints > 0) reader.readBytes(&(*mCurrentContactPoints)[0], nbContactPoints * sizeof(ContactPoint));
+
+    // The contacts of the snapshot are used for warm starting in the next frame
+    computeMapPreviousContactPairs();
+}
@@ -78,6 +78,18 @@ void DynamicsSystem::updateBodiesState() {
     const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbRigidBodyComponents; i++) {
 
+        // The state of the body has changed since the last export only if its velocities, its center of mass
+        // or its orientation are different (a body at rest keeps the same state)
+        const Quaternion orientation = mRigidBodyComponents.mConstrainedOrientations[i].getUnit();
+        Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
+        if (mRigidBodyComponents.mLinearVelocities[i] != mRigidBodyComponents.mConstrainedLinearVelocities[i] ||
+            mRigidBodyComponents.mAngularVelocities[i] != mRigidBodyComponents.mConstrainedAngularVelocities[i] ||
+            mRigidBodyComponents.mCentersOfMassWorld[i] != mRigidBodyComponents.mConstrainedPositions[i] ||
+            !(transform.getOrientation() == orientation)) {
+
+            mRigidBodyComponents.mHasChangedSinceLastExport[i] = true;
+        }
+
         // Update the linear and angular velocity of the body
         mRigidBodyComponents.mLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i];
         mRigidBodyComponents.mAngularVelocities[i] = mRigidBodyComponents.mConstrainedAngularVelocities[i];
@@ -86,8 +98,7 @@ void DynamicsSystem::updateBodiesState() {
         mRigidBodyComponents.mCentersOfMassWorld[i] = mRigidBodyComponents.mConstrainedPositions[i];
 
         // Update the orientation of the body
-        const Quaternion& constrainedOrientation = mRigidBodyComponents.mConstrainedOrientations[i];
-        mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).setOrientation(constrainedOrientation.getUnit());
+        transform.setOrientation(orientation);
     }
 
     // Update the position of the body (using the new center of mass and new orientation)
@@ -163,6 +163,7 @@ Profiler::Profiler() :mRootNode("Root", nullptr) {
     mNbAllocatedDestinations = 0;
     mProfilingStartTime = clock::now();
 	mFrameCounter = 0;
+    mNbHitCounters = 0;
 
     allocatedDestinations(1);
 }
@@ -216,6 +217,36 @@ void Profiler::reset() {
     mRootNode.enterBlockOfCode();
     mFrameCounter = 0;
     mProfilingStartTime = clock::now();
+
+    for (uint i=0; i < mNbHitCounters; i++) {
+        mHitCounters[i].nbTests = 0;
+        mHitCounters[i].nbHits = 0;
+    }
+}
+
+// Add a number of tests and successful tests to a hit counter
+/// As for the profiling blocks, the counters are identified by the address of their name
+void Profiler::addHitCounterSamples(const char* name, uint64 nbTests, uint64 nbHits) {
+
+    // Look for the counter
+    uint index = 0;
+    while (index < mNbHitCounters && mHitCounters[index].name != name) {
+        index++;
+    }
+
+    // If the counter does not exist yet, we create it
+    if (index == mNbHitCounters) {
+
+        if (mNbHitCounters == MAX_NB_HIT_COUNTERS) return;
+
+        mHitCounters[index].name = name;
+        mHitCounters[index].nbTests = 0;
+        mHitCounters[index].nbHits = 0;
+        mNbHitCounters++;
+    }
+
+    mHitCounters[index].nbTests += nbTests;
+    mHitCounters[index].nbHits += nbHits;
 }
 
 // Print the report of the profiler in a given output stream
@@ -231,6 +262,9 @@ void Profiler::printReport() {
 
         // Destroy the iterator
         destroyIterator(iterator);
+
+        // Print the hit counters
+        printHitCountersReport(mDestinations[i]->getOutputStream());
     }
 }
 
@@ -324,4 +358,20 @@ void Profiler::printRecursiveNodeReport(ProfileNodeIterator* iterator,
     }
 }
 
+// Print the report of the hit counters
+void Profiler::printHitCountersReport(std::ostream& outputStream) {
+
+    if (mNbHitCounters == 0) return;
+
+    outputStream << "---------------" << std::endl;
+    outputStream << "| Hit counters ---" << std::endl;
+
+    for (uint i=0; i < mNbHitCounters; i++) {
+        const long double hitRate = mHitCounters[i].nbTests > 0 ?
+                                    (mHitCounters[i].nbHits / (long double) (mHitCounters[i].nbTests)) * 100.0L : 0.0L;
+        outputStream << "|   " << i << " -- " << mHitCounters[i].name << " : " << mHitCounters[i].nbHits << " hits / " <<
+                        mHitCounters[i].nbTests << " tests (" << hitRate << " %)" << std::endl;
+    }
+}
+
 #endif
@@ -35,16 +35,28 @@
 #include "tests/collision/TestPointInside.h"
 #include "tests/collision/TestRaycast.h"
 #include "tests/collision/TestCollisionWorld.h"
+#include "tests/collision/TestBoxVsBox.h"
+#include "tests/collision/TestEPAAlgorithm.h"
+#include "tests/collision/TestGJKAlgorithm.h"
+#include "tests/collision/TestSphereVsTriangleAlgorithm.h"
 #include "tests/collision/TestAABB.h"
 #include "tests/collision/TestDynamicAABBTree.h"
+#include "tests/collision/TestStaticAABBTree.h"
 #include "tests/collision/TestHalfEdgeStructure.h"
+#include "tests/collision/TestHeightFieldShape.h"
+#include "tests/collision/TestCompressedTriangleMesh.h"
 #include "tests/collision/TestTriangleVertexArray.h"
 #include "tests/containers/TestArray.h"
+#include "tests/containers/TestSmallArray.h"
 #include "tests/containers/TestMap.h"
+#include "tests/containers/TestFlatMap.h"
 #include "tests/containers/TestSet.h"
+#include "tests/containers/TestFlatSet.h"
+#include "tests/containers/TestHashContainersBenchmark.h"
 #include "tests/containers/TestDeque.h"
 #include "tests/containers/TestStack.h"
 #include "tests/engine/TestRigidBody.h"
+#include "tests/engine/TestPhysicsWorld.h"
 
 using namespace reactphysics3d;
 
@@ -55,10 +67,14 @@ int main() {
     // ---------- Containers tests ---------- //
 
     testSuite.addTest(new TestSet("Set"));
+    testSuite.addTest(new TestFlatSet("FlatSet"));
     testSuite.addTest(new TestArray("Array"));
+    testSuite.addTest(new TestSmallArray("SmallArray"));
     testSuite.addTest(new TestMap("Map"));
+    testSuite.addTest(new TestFlatMap("FlatMap"));
     testSuite.addTest(new TestDeque("Deque"));
     testSuite.addTest(new TestStack("Stack"));
+    testSuite.addTest(new TestHashContainersBenchmark("HashContainersBenchmark"));
 
     // ---------- Mathematics tests ---------- //
 
@@ -77,13 +93,21 @@ int main() {
     testSuite.addTest(new TestTriangleVertexArray("TriangleVertexArray"));
     testSuite.addTest(new TestRaycast("Raycasting"));
     testSuite.addTest(new TestCollisionWorld("CollisionWorld"));
+    testSuite.addTest(new TestBoxVsBox("BoxVsBox"));
+    testSuite.addTest(new TestEPAAlgorithm("EPAAlgorithm"));
+    testSuite.addTest(new TestGJKAlgorithm("GJKAlgorithm"));
+    testSuite.addTest(new TestSphereVsTriangleAlgorithm("SphereVsTriangleAlgorithm"));
     testSuite.addTest(new TestDynamicAABBTree("DynamicAABBTree"));
+    testSuite.addTest(new TestStaticAABBTree("StaticAABBTree"));
     testSuite.addTest(new TestHalfEdgeStructure("HalfEdgeStructure"));
+    testSuite.addTest(new TestHeightFieldShape("HeightFieldShape"));
+    testSuite.addTest(new TestCompressedTriangleMesh("CompressedTriangleMesh"));
 
 
     // ---------- Engine tests ---------- //
 
     testSuite.addTest(new TestRigidBody("RigidBody"));
+    testSuite.addTest(new TestPhysicsWorld("PhysicsWorld"));
 
     // Run the tests
     testSuite.run();
@@ -0,0 +1,270 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_BOX_VS_BOX_H
+#define TEST_BOX_VS_BOX_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <cmath>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestBoxVsBox
+/**
+ * Unit test for the box vs box narrow-phase collision detection algorithm
+ */
+class TestBoxVsBox : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// Unit cube used to test the same configurations with the convex meshes algorithm
+        float mCubeVertices[24] = {-1, -1, 1,   1, -1, 1,   1, -1, -1,   -1, -1, -1,
+                                   -1, 1, 1,    1, 1, 1,    1, 1, -1,    -1, 1, -1};
+        int mCubeIndices[24] = {0, 3, 2, 1,   4, 5, 6, 7,   0, 1, 5, 4,   1, 2, 6, 5,   2, 3, 7, 6,   0, 4, 7, 3};
+        PolygonVertexArray::PolygonFace mCubeFaces[6];
+        PolygonVertexArray* mCubePolygonVertexArray;
+        PolyhedronMesh* mCubePolyhedronMesh;
+
+        /// Callback that stores the contact points of a collision test
+        class ContactPointsCallback : public CollisionCallback {
+
+            public:
+
+                std::vector<Vector3> contactNormals;
+                std::vector<decimal> penetrationDepths;
+                std::vector<Vector3> contactPoints1;
+                std::vector<Vector3> contactPoints2;
+
+                virtual void onContact(const CallbackData& callbackData) override {
+                    for (uint32 p = 0; p < callbackData.getNbContactPairs(); p++) {
+                        ContactPair contactPair = callbackData.getContactPair(p);
+                        for (uint32 c = 0; c < contactPair.getNbContactPoints(); c++) {
+                            const ContactPoint contactPoint = contactPair.getContactPoint(c);
+                            contactNormals.push_back(contactPoint.getWorldNormal());
+                            penetrationDepths.push_back(contactPoint.getPenetrationDepth());
+                            contactPoints1.push_back(contactPair.getCollider1()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider1());
+                            contactPoints2.push_back(contactPair.getCollider2()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider2());
+                        }
+                    }
+                }
+        };
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestBoxVsBox(const std::string& name) : Test(name) {
+
+            for (int f = 0; f < 6; f++) {
+                mCubeFaces[f].indexBase = f * 4;
+                mCubeFaces[f].nbVertices = 4;
+            }
+            mCubePolygonVertexArray = new PolygonVertexArray(8, mCubeVertices, 3 * sizeof(float), mCubeIndices, sizeof(int), 6, mCubeFaces,
+                                                             PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                             PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            mCubePolyhedronMesh = mPhysicsCommon.createPolyhedronMesh(mCubePolygonVertexArray);
+        }
+
+        /// Destructor
+        virtual ~TestBoxVsBox() {
+            mPhysicsCommon.destroyPolyhedronMesh(mCubePolyhedronMesh);
+            delete mCubePolygonVertexArray;
+        }
+
+        /// Run the tests
+        void run() {
+            testFaceContact();
+            testEdgeContact();
+            testSameOverlapAsConvexMeshes();
+        }
+
+        void testFaceContact() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            BoxShape* boxShape1 = mPhysicsCommon.createBoxShape(Vector3(1, 1, 1));
+            BoxShape* boxShape2 = mPhysicsCommon.createBoxShape(Vector3(2, decimal(0.5), 2));
+
+            // Small box below a large flat box
+            CollisionBody* body1 = world->createCollisionBody(Transform::identity());
+            body1->addCollider(boxShape1, Transform::identity());
+            CollisionBody* body2 = world->createCollisionBody(Transform(Vector3(decimal(0.3), decimal(1.4), decimal(-0.2)), Quaternion::identity()));
+            body2->addCollider(boxShape2, Transform::identity());
+
+            rp3d_test(world->testOverlap(body1, body2));
+
+            // The four corners of the top face of the small box are in contact
+            ContactPointsCallback callback;
+            world->testCollision(body1, body2, callback);
+            rp3d_test(callback.contactNormals.size() == 4);
+            for (uint32 i = 0; i < callback.contactNormals.size(); i++) {
+                rp3d_test(approxEqual(std::abs(callback.contactNormals[i].y), decimal(1.0), decimal(0.0001)));
+                rp3d_test(approxEqual(callback.penetrationDepths[i], decimal(0.1), decimal(0.0001)));
+                const Vector3 smallBoxPoint = std::abs(callback.contactPoints1[i].y - decimal(1.0)) < decimal(0.0001) ?
+                                              callback.contactPoints1[i] : callback.contactPoints2[i];
+                rp3d_test(approxEqual(smallBoxPoint.y, decimal(1.0), decimal(0.0001)));
+                rp3d_test(approxEqual(std::abs(smallBoxPoint.x), decimal(1.0), decimal(0.0001)));
+                rp3d_test(approxEqual(std::abs(smallBoxPoint.z), decimal(1.0), decimal(0.0001)));
+            }
+
+            // Rotated large box resting on a face of the small box
+            body2->setTransform(Transform(Vector3(decimal(0.3), decimal(1.4), decimal(-0.2)), Quaternion::fromEulerAngles(0, decimal(0.7), 0)));
+            ContactPointsCallback callback2;
+            world->testCollision(body1, body2, callback2);
+            rp3d_test(callback2.contactNormals.size() == 4);
+            for (uint32 i = 0; i < callback2.contactNormals.size(); i++) {
+                rp3d_test(approxEqual(std::abs(callback2.contactNormals[i].y), decimal(1.0), decimal(0.0001)));
+                rp3d_test(approxEqual(callback2.penetrationDepths[i], decimal(0.1), decimal(0.0001)));
+            }
+
+            // Separated boxes
+            body2->setTransform(Transform(Vector3(decimal(0.3), decimal(1.6), decimal(-0.2)), Quaternion::identity()));
+            rp3d_test(!world->testOverlap(body1, body2));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape1);
+            mPhysicsCommon.destroyBoxShape(boxShape2);
+        }
+
+        void testEdgeContact() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(1, 1, 1));
+
+            // The top edge of the first box (along the z axis) crosses the bottom edge of the second box (along the x axis)
+            const decimal pi = decimal(3.14159265358979);
+            const decimal sqrt2 = std::sqrt(decimal(2.0));
+            CollisionBody* body1 = world->createCollisionBody(Transform(Vector3::zero(), Quaternion::fromEulerAngles(0, 0, pi / 4)));
+            body1->addCollider(boxShape, Transform::identity());
+            CollisionBody* body2 = world->createCollisionBody(Transform(Vector3(0, 2 * sqrt2 - decimal(0.1), 0),
+                                                                        Quaternion::fromEulerAngles(pi / 4, 0, 0)));
+            body2->addCollider(boxShape, Transform::identity());
+
+            ContactPointsCallback callback;
+            world->testCollision(body1, body2, callback);
+            rp3d_test(callback.contactNormals.size() == 1);
+            rp3d_test(approxEqual(std::abs(callback.contactNormals[0].y), decimal(1.0), decimal(0.0001)));
+            rp3d_test(approxEqual(callback.penetrationDepths[0], decimal(0.1), decimal(0.0001)));
+
+            // The contact points are on the two edges
+            const Vector3 edge1Point(0, sqrt2, 0);
+            const Vector3 edge2Point(0, sqrt2 - decimal(0.1), 0);
+            rp3d_test(approxEqual(callback.contactPoints1[0], edge1Point, decimal(0.0001)) ||
+                      approxEqual(callback.contactPoints1[0], edge2Point, decimal(0.0001)));
+            rp3d_test(approxEqual(callback.contactPoints2[0], edge1Point, decimal(0.0001)) ||
+                      approxEqual(callback.contactPoints2[0], edge2Point, decimal(0.0001)));
+
+            // Separated edges
+            body2->setTransform(Transform(Vector3(0, 2 * sqrt2 + decimal(0.1), 0), Quaternion::fromEulerAngles(pi / 4, 0, 0)));
+            rp3d_test(!world->testOverlap(body1, body2));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        void testSameOverlapAsConvexMeshes() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            const Vector3 halfExtents1(1, decimal(0.5), decimal(1.5));
+            const Vector3 halfExtents2(decimal(0.7), decimal(1.2), decimal(0.4));
+            BoxShape* boxShape1 = mPhysicsCommon.createBoxShape(halfExtents1);
+            BoxShape* boxShape2 = mPhysicsCommon.createBoxShape(halfExtents2);
+            ConvexMeshShape* meshShape1 = mPhysicsCommon.createConvexMeshShape(mCubePolyhedronMesh, halfExtents1);
+            ConvexMeshShape* meshShape2 = mPhysicsCommon.createConvexMeshShape(mCubePolyhedronMesh, halfExtents2);
+
+            CollisionBody* boxBody1 = world->createCollisionBody(Transform::identity());
+            boxBody1->addCollider(boxShape1, Transform::identity());
+            CollisionBody* boxBody2 = world->createCollisionBody(Transform::identity());
+            boxBody2->addCollider(boxShape2, Transform::identity());
+            CollisionBody* meshBody1 = world->createCollisionBody(Transform::identity());
+            meshBody1->addCollider(meshShape1, Transform::identity());
+            CollisionBody* meshBody2 = world->createCollisionBody(Transform::identity());
+            meshBody2->addCollider(meshShape2, Transform::identity());
+
+            // Same random configurations for the two boxes and the two convex meshes
+            uint32 seed = 12345;
+            auto random = [&seed](decimal min, decimal max) {
+                seed = seed * 1664525u + 1013904223u;
+                return min + (max - min) * decimal(seed >> 8) / decimal(1 << 24);
+            };
+
+            int nbOverlaps = 0;
+            for (int i = 0; i < 300; i++) {
+
+                const Transform transform1(Vector3(random(-1, 1), random(-1, 1), random(-1, 1)),
+                                           Quaternion::fromEulerAngles(random(-3, 3), random(-3, 3), random(-3, 3)));
+                const Transform transform2(Vector3(random(-1, 1), random(-1, 1), random(-1, 1)) * decimal(2.0),
+                                           Quaternion::fromEulerAngles(random(-3, 3), random(-3, 3), random(-3, 3)));
+
+                // Move the convex meshes away from the boxes
+                const Transform meshesOffset(Vector3(100, 0, 0), Quaternion::identity());
+                boxBody1->setTransform(transform1);
+                boxBody2->setTransform(transform2);
+                meshBody1->setTransform(meshesOffset * transform1);
+                meshBody2->setTransform(meshesOffset * transform2);
+
+                // The convex meshes algorithm only misses some edge-edge overlaps
+                const bool isBoxesOverlap = world->testOverlap(boxBody1, boxBody2);
+                rp3d_test(isBoxesOverlap || !world->testOverlap(meshBody1, meshBody2));
+
+                if (isBoxesOverlap) {
+
+                    nbOverlaps++;
+
+                    // The two points of a contact are separated by the penetration depth along the normal
+                    ContactPointsCallback callback;
+                    world->testCollision(boxBody1, boxBody2, callback);
+                    rp3d_test(callback.contactNormals.size() > 0);
+                    for (uint32 c = 0; c < callback.contactNormals.size(); c++) {
+                        rp3d_test(approxEqual(callback.contactNormals[c].length(), decimal(1.0), decimal(0.0001)));
+                        rp3d_test(callback.penetrationDepths[c] > decimal(0.0));
+                        rp3d_test(approxEqual(callback.contactPoints1[c], callback.contactPoints2[c] + callback.contactNormals[c] * callback.penetrationDepths[c],
+                                              decimal(0.0001)));
+                    }
+                }
+            }
+
+            // Make sure that the random configurations test both cases
+            rp3d_test(nbOverlaps > 10 && nbOverlaps < 290);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape1);
+            mPhysicsCommon.destroyBoxShape(boxShape2);
+            mPhysicsCommon.destroyConvexMeshShape(meshShape1);
+            mPhysicsCommon.destroyConvexMeshShape(meshShape2);
+        }
+};
+
+}
+
+#endif
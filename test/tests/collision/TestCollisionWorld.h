@@ -50,11 +50,13 @@ struct CollisionPointData {
 	Vector3 localPointBody1;
 	Vector3 localPointBody2;
 	decimal penetrationDepth;
+	Vector3 worldNormal;
 
-	CollisionPointData(const Vector3& point1, const Vector3& point2, decimal penDepth) {
+	CollisionPointData(const Vector3& point1, const Vector3& point2, decimal penDepth, const Vector3& normal) {
 		localPointBody1 = point1;
 		localPointBody2 = point2;
 		penetrationDepth = penDepth;
+		worldNormal = normal;
 	}
 
 	bool isContactPointSimilarTo(const Vector3& pointBody1, const Vector3& pointBody2, decimal penDepth, decimal epsilon = 0.001) const {
@@ -134,6 +136,21 @@ struct CollisionData {
 		return false;
 	}
 
+	bool haveAllContactPointsNormal(const Vector3& normal, decimal epsilon = 0.001) const {
+
+        std::vector<ContactPairData>::const_iterator it;
+        for (it = contactPairs.cbegin(); it != contactPairs.cend(); ++it) {
+
+            for (uint32 c=0; c < it->contactPoints.size(); c++) {
+                if (!approxEqual(it->contactPoints[c].worldNormal, normal, epsilon)) {
+                    return false;
+                }
+            }
+		}
+
+		return true;
+	}
+
 };
 
 // Class
@@ -201,7 +218,8 @@ class WorldCollisionCallback : public CollisionCallback
 
                     ContactPoint contactPoint = contactPair.getContactPoint(c);
 
-                    CollisionPointData collisionPoint(contactPoint.getLocalPointOnCollider1(), contactPoint.getLocalPointOnCollider2(), contactPoint.getPenetrationDepth());
+                    CollisionPointData collisionPoint(contactPoint.getLocalPointOnCollider1(), contactPoint.getLocalPointOnCollider2(),
+                                                      contactPoint.getPenetrationDepth(), contactPoint.getWorldNormal());
                     contactPairData.contactPoints.push_back(collisionPoint);
                 }
 
@@ -512,6 +530,8 @@ class TestCollisionWorld : public Test {
             testCapsuleVsConcaveMeshCollision();
 
             testConvexMeshVsConvexMeshCollision();
+            testConvexMeshVsConvexMeshSAT();
+            testContactPointsReduction();
             testConvexMeshVsCapsuleCollision();
             testConvexMeshVsConcaveMeshCollision();
         }
@@ -2306,6 +2326,239 @@ class TestCollisionWorld : public Test {
             mCapsuleBody1->setTransform(initTransform2);
         }
 
+        /// Test the contact between two convex mesh cubes for a configuration and return the collision data
+        /// (nullptr if there is no contact). The collision data is valid until the next collision test.
+        const CollisionData* testCubesCollision(CollisionBody* cube1, CollisionBody* cube2, const Collider* collider1,
+                                                const Collider* collider2, const Transform& transform1, const Transform& transform2,
+                                                bool& isOverlapping, bool& swappedBodies) {
+
+            cube1->setTransform(transform1);
+            cube2->setTransform(transform2);
+
+            isOverlapping = mWorld->testOverlap(cube1, cube2);
+
+            mCollisionCallback.reset();
+            mWorld->testCollision(cube1, cube2, mCollisionCallback);
+
+            const CollisionData* collisionData = mCollisionCallback.getCollisionData(collider1, collider2);
+            swappedBodies = collisionData != nullptr && collisionData->getBody1()->getEntity() != cube1->getEntity();
+
+            return collisionData;
+        }
+
+        void testConvexMeshVsConvexMeshSAT() {
+
+            // Two cubes (half extent of 3) far away from the other bodies of the world
+            const Vector3 origin(200, 200, 200);
+            CollisionBody* cube1 = mWorld->createCollisionBody(Transform(origin, Quaternion::identity()));
+            CollisionBody* cube2 = mWorld->createCollisionBody(Transform(origin + Vector3(0, 20, 0), Quaternion::identity()));
+            Collider* collider1 = cube1->addCollider(mConvexMeshShape1, Transform::identity());
+            Collider* collider2 = cube2->addCollider(mConvexMeshShape1, Transform::identity());
+
+            bool isOverlapping;
+            bool swapped;
+
+            /********************************************************************************
+            * Face contact                                                                  *
+            *********************************************************************************/
+
+            // The bottom face of cube 2 penetrates the top face of cube 1 (depth of 0.5)
+            const CollisionData* collisionData = testCubesCollision(cube1, cube2, collider1, collider2,
+                                                                     Transform(origin, Quaternion::identity()),
+                                                                     Transform(origin + Vector3(1, decimal(5.5), 0), Quaternion::identity()),
+                                                                     isOverlapping, swapped);
+            rp3d_test(isOverlapping);
+            rp3d_test(collisionData != nullptr);
+            rp3d_test(collisionData->getNbContactPairs() == 1);
+            rp3d_test(collisionData->getTotalNbContactPoints() == 4);
+            rp3d_test(collisionData->haveAllContactPointsNormal(swapped ? Vector3(0, -1, 0) : Vector3(0, 1, 0)));
+
+            const Vector3 facePoints1[4] = {Vector3(-2, 3, -3), Vector3(-2, 3, 3), Vector3(3, 3, -3), Vector3(3, 3, 3)};
+            const Vector3 facePoints2[4] = {Vector3(-3, -3, -3), Vector3(-3, -3, 3), Vector3(2, -3, -3), Vector3(2, -3, 3)};
+            for (int i = 0; i < 4; i++) {
+                rp3d_test(collisionData->hasContactPointSimilarTo(swapped ? facePoints2[i] : facePoints1[i],
+                                                                  swapped ? facePoints1[i] : facePoints2[i], decimal(0.5)));
+            }
+
+            /********************************************************************************
+            * Edge-edge contact                                                             *
+            *********************************************************************************/
+
+            // Cube 1 is rotated around the z axis and cube 2 around the x axis such that the top edge of
+            // cube 1 (along z) crosses the bottom edge of cube 2 (along x) with a depth of 0.2
+            const decimal halfDiagonal = decimal(3.0) * std::sqrt(decimal(2.0));
+            const Quaternion rotationZ = Quaternion::fromEulerAngles(0, 0, PI_RP3D / decimal(4.0));
+            const Quaternion rotationX = Quaternion::fromEulerAngles(PI_RP3D / decimal(4.0), 0, 0);
+            collisionData = testCubesCollision(cube1, cube2, collider1, collider2, Transform(origin, rotationZ),
+                                               Transform(origin + Vector3(0, 2 * halfDiagonal - decimal(0.2), 0), rotationX),
+                                               isOverlapping, swapped);
+            rp3d_test(isOverlapping);
+            rp3d_test(collisionData != nullptr);
+            rp3d_test(collisionData->getNbContactPairs() == 1);
+            rp3d_test(collisionData->getTotalNbContactPoints() == 1);
+            rp3d_test(collisionData->haveAllContactPointsNormal(swapped ? Vector3(0, -1, 0) : Vector3(0, 1, 0)));
+
+            const Vector3 edgePoint1(3, 3, 0);
+            const Vector3 edgePoint2(0, -3, 3);
+            rp3d_test(collisionData->hasContactPointSimilarTo(swapped ? edgePoint2 : edgePoint1,
+                                                              swapped ? edgePoint1 : edgePoint2, decimal(0.2)));
+
+            /********************************************************************************
+            * Separated cubes                                                               *
+            *********************************************************************************/
+
+            // Separated along a face normal
+            collisionData = testCubesCollision(cube1, cube2, collider1, collider2,
+                                               Transform(origin, Quaternion::identity()),
+                                               Transform(origin + Vector3(1, decimal(6.5), 0), Quaternion::identity()),
+                                               isOverlapping, swapped);
+            rp3d_test(!isOverlapping);
+            rp3d_test(collisionData == nullptr);
+
+            // Separated only along the cross product of two edges (the AABBs and the face
+            // normals of the cubes overlap)
+            collisionData = testCubesCollision(cube1, cube2, collider1, collider2, Transform(origin, rotationZ),
+                                               Transform(origin + Vector3(0, 2 * halfDiagonal + decimal(0.2), 0), rotationX),
+                                               isOverlapping, swapped);
+            rp3d_test(!isOverlapping);
+            rp3d_test(collisionData == nullptr);
+
+            mWorld->destroyCollisionBody(cube1);
+            mWorld->destroyCollisionBody(cube2);
+        }
+
+        /// Test the collision of a box lying on a flat grid mesh (nbCells x nbCells cells of a given size
+        /// centered at a given point). The box is a convex mesh whose vertices are also centered at this
+        /// point. This way, the contact points are close to this point in the local-space of both shapes.
+        /// The contact points are returned in the local-space of the grid mesh.
+        std::vector<Vector3> testBoxOnGridMeshCollision(uint32 nbCells, decimal cellSize, const Vector3& center) {
+
+            // Vertices and indices of the grid
+            std::vector<float> gridVertices;
+            std::vector<uint32> gridIndices;
+            const decimal halfSize = decimal(0.5) * nbCells * cellSize;
+            for (uint32 i=0; i <= nbCells; i++) {
+                for (uint32 j=0; j <= nbCells; j++) {
+                    gridVertices.push_back(static_cast<float>(center.x - halfSize + i * cellSize));
+                    gridVertices.push_back(static_cast<float>(center.y));
+                    gridVertices.push_back(static_cast<float>(center.z - halfSize + j * cellSize));
+                }
+            }
+            for (uint32 i=0; i < nbCells; i++) {
+                for (uint32 j=0; j < nbCells; j++) {
+                    const uint32 v = i * (nbCells + 1) + j;
+                    gridIndices.push_back(v); gridIndices.push_back(v + 1); gridIndices.push_back(v + nbCells + 1);
+                    gridIndices.push_back(v + 1); gridIndices.push_back(v + nbCells + 2); gridIndices.push_back(v + nbCells + 1);
+                }
+            }
+            TriangleVertexArray triangleVertexArray(static_cast<uint32>(gridVertices.size() / 3), gridVertices.data(), 3 * sizeof(float),
+                                                    nbCells * nbCells * 2, gridIndices.data(), 3 * sizeof(uint32),
+                                                    TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                    TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            TriangleMesh* triangleMesh = mPhysicsCommon.createTriangleMesh();
+            triangleMesh->addSubpart(&triangleVertexArray);
+            ConcaveMeshShape* gridShape = mPhysicsCommon.createConcaveMeshShape(triangleMesh);
+
+            // Vertices of the box (larger than the grid) with the same layout as the other convex meshes
+            const float boxHalfSize = static_cast<float>(halfSize + 1);
+            const float boxSigns[8][3] = {{-1, -1, 1}, {1, -1, 1}, {1, -1, -1}, {-1, -1, -1},
+                                          {-1, 1, 1}, {1, 1, 1}, {1, 1, -1}, {-1, 1, -1}};
+            float boxVertices[8 * 3];
+            for (int v=0; v < 8; v++) {
+                boxVertices[v * 3] = static_cast<float>(center.x) + boxSigns[v][0] * boxHalfSize;
+                boxVertices[v * 3 + 1] = static_cast<float>(center.y) + boxSigns[v][1];
+                boxVertices[v * 3 + 2] = static_cast<float>(center.z) + boxSigns[v][2] * boxHalfSize;
+            }
+            PolygonVertexArray polygonVertexArray(8, boxVertices, 3 * sizeof(float), &(mConvexMeshCubeIndices[0]), sizeof(int), 6,
+                                                  mConvexMeshPolygonFaces, PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                  PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            PolyhedronMesh* polyhedronMesh = mPhysicsCommon.createPolyhedronMesh(&polygonVertexArray);
+            ConvexMeshShape* boxShape = mPhysicsCommon.createConvexMeshShape(polyhedronMesh);
+
+            // The box penetrates the grid with a depth of 0.1 (the bodies are far away from the
+            // other bodies of the world)
+            const Vector3 origin(-200, 200, 200);
+            CollisionBody* gridBody = mWorld->createCollisionBody(Transform(origin, Quaternion::identity()));
+            CollisionBody* boxBody = mWorld->createCollisionBody(Transform(origin + Vector3(0, decimal(0.9), 0), Quaternion::identity()));
+            Collider* gridCollider = gridBody->addCollider(gridShape, Transform::identity());
+            Collider* boxCollider = boxBody->addCollider(boxShape, Transform::identity());
+
+            mCollisionCallback.reset();
+            mWorld->testCollision(gridBody, boxBody, mCollisionCallback);
+
+            std::vector<Vector3> gridPoints;
+            const CollisionData* collisionData = mCollisionCallback.getCollisionData(gridCollider, boxCollider);
+            rp3d_test(collisionData != nullptr);
+            if (collisionData != nullptr) {
+                rp3d_test(collisionData->getNbContactPairs() == 1);
+                const bool isGridBody1 = collisionData->getBody1()->getEntity() == gridBody->getEntity();
+                for (const CollisionPointData& point : collisionData->contactPairs[0].contactPoints) {
+                    rp3d_test(approxEqual(point.penetrationDepth, decimal(0.1), decimal(0.001)));
+                    gridPoints.push_back(isGridBody1 ? point.localPointBody1 : point.localPointBody2);
+                }
+            }
+
+            mWorld->destroyCollisionBody(gridBody);
+            mWorld->destroyCollisionBody(boxBody);
+            mPhysicsCommon.destroyConvexMeshShape(boxShape);
+            mPhysicsCommon.destroyPolyhedronMesh(polyhedronMesh);
+            mPhysicsCommon.destroyConcaveMeshShape(gridShape);
+            mPhysicsCommon.destroyTriangleMesh(triangleMesh);
+
+            return gridPoints;
+        }
+
+        /// Return true if an array of points contains a given point
+        static bool containsPoint(const std::vector<Vector3>& points, const Vector3& point, decimal epsilon) {
+            for (const Vector3& p : points) {
+                if (approxEqual(p, point, epsilon)) return true;
+            }
+            return false;
+        }
+
+        void testContactPointsReduction() {
+
+            const decimal cellSize = decimal(0.25);
+
+            // The contact points are reduced in the local-space of the first shape of the pair. We test
+            // grids at the origin and far away from the origin of the local-space of both shapes.
+            const Vector3 centers[2] = {Vector3(0, 0, 0), Vector3(10000, 0, 10000)};
+
+            for (uint32 c=0; c < 2; c++) {
+
+                // A 4 x 4 grid gives 96 contact points (3 for each triangle) in a single manifold.
+                // The manifold keeps the four corners of the grid (the largest area).
+                const decimal halfSize4 = decimal(0.5) * 4 * cellSize;
+                std::vector<Vector3> points = testBoxOnGridMeshCollision(4, cellSize, centers[c]);
+                rp3d_test(points.size() == 4);
+                for (int i=-1; i <= 1; i += 2) {
+                    for (int j=-1; j <= 1; j += 2) {
+                        rp3d_test(containsPoint(points, centers[c] + Vector3(i * halfSize4, 0, j * halfSize4), decimal(0.01)));
+                    }
+                }
+
+                // A 7 x 7 grid gives 294 contact points. The first manifold is full (256 points) and the
+                // other points are in a second manifold. Both manifolds are reduced to four points and
+                // the corners of the grid are kept.
+                const decimal halfSize7 = decimal(0.5) * 7 * cellSize;
+                points = testBoxOnGridMeshCollision(7, cellSize, centers[c]);
+                rp3d_test(points.size() == 8);
+                for (int i=-1; i <= 1; i += 2) {
+                    for (int j=-1; j <= 1; j += 2) {
+                        rp3d_test(containsPoint(points, centers[c] + Vector3(i * halfSize7, 0, j * halfSize7), decimal(0.01)));
+                    }
+                }
+
+                // The first two points kept in a manifold are the farthest apart and the last two points
+                // are on both sides of them. Therefore, the four points span a quadrilateral.
+                for (uint32 m=0; m < 2 && points.size() == 8; m++) {
+                    const Vector3* p = &(points[4 * m]);
+                    const decimal area = decimal(0.5) * std::abs(((p[1] - p[0]).cross(p[3] - p[2])).y);
+                    rp3d_test(area >= cellSize * cellSize);
+                }
+            }
+        }
+
         void testConvexMeshVsCapsuleCollision() {
 
             Transform initTransform1 = mConvexMeshBody1->getTransform();
@@ -2462,6 +2715,15 @@ class TestCollisionWorld : public Test {
                 rp3d_test(approxEqual(collisionData->contactPairs[0].contactPoints[i].penetrationDepth, 1.0f));
             }
 
+            // The contact points kept among the contacts with all the triangles must be distinct
+            for (size_t i=0; i<collisionData->contactPairs[0].contactPoints.size(); i++) {
+                for (size_t j=i+1; j<collisionData->contactPairs[0].contactPoints.size(); j++) {
+                    const Vector3 pointIToPointJ = collisionData->contactPairs[0].contactPoints[j].localPointBody1 -
+                                                   collisionData->contactPairs[0].contactPoints[i].localPointBody1;
+                    rp3d_test(pointIToPointJ.length() > SAME_CONTACT_POINT_DISTANCE_THRESHOLD);
+                }
+            }
+
             // ----- Test collision against body 1 only ----- //
 
             mCollisionCallback.reset();
@@ -0,0 +1,575 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_COMPRESSED_TRIANGLE_MESH_H
+#define TEST_COMPRESSED_TRIANGLE_MESH_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestCompressedTriangleMesh
+/**
+ * Unit test for the compressed triangle meshes (CompressedTriangleArray class)
+ */
+class TestCompressedTriangleMesh : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        static const int NB_CELLS = 24;
+
+        /// Indexed grid with shared vertices (first sub-part)
+        std::vector<float> mGridVertices;
+        std::vector<uint32> mGridIndices;
+
+        /// Grid where each cell has its own four vertices and normals (second sub-part)
+        std::vector<float> mQuadsVertices;
+        std::vector<float> mQuadsNormals;
+        std::vector<uint32> mQuadsIndices;
+
+        TriangleVertexArray* mGridVertexArray;
+        TriangleVertexArray* mQuadsVertexArray;
+        TriangleMesh* mTriangleMesh;
+
+        /// Callback that stores the contact normals of a collision test
+        class ContactNormalsCallback : public CollisionCallback {
+
+            public:
+
+                std::vector<Vector3> contactNormals;
+
+                virtual void onContact(const CallbackData& callbackData) override {
+                    for (uint32 p = 0; p < callbackData.getNbContactPairs(); p++) {
+                        ContactPair contactPair = callbackData.getContactPair(p);
+                        for (uint32 c = 0; c < contactPair.getNbContactPoints(); c++) {
+                            contactNormals.push_back(contactPair.getContactPoint(c).getWorldNormal());
+                        }
+                    }
+                }
+        };
+
+        /// Height of the surface of the test meshes
+        static float computeHeight(float x, float z) {
+            return std::sin(x * 0.3f) * std::cos(z * 0.2f) * 2.0f;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestCompressedTriangleMesh(const std::string& name) : Test(name) {
+
+            for (int j = 0; j <= NB_CELLS; j++) {
+                for (int i = 0; i <= NB_CELLS; i++) {
+                    mGridVertices.push_back(float(i));
+                    mGridVertices.push_back(computeHeight(float(i), float(j)));
+                    mGridVertices.push_back(float(j));
+                }
+            }
+            for (int j = 0; j < NB_CELLS; j++) {
+                for (int i = 0; i < NB_CELLS; i++) {
+                    const uint32 v = uint32(j * (NB_CELLS + 1) + i);
+                    mGridIndices.insert(mGridIndices.end(), {v, v + NB_CELLS + 1, v + 1, v + 1, v + NB_CELLS + 1, v + NB_CELLS + 2});
+                }
+            }
+
+            // The second grid is next to the first one and is flat
+            for (int j = 0; j < NB_CELLS; j++) {
+                for (int i = 0; i < NB_CELLS; i++) {
+                    const uint32 v = uint32(mQuadsVertices.size() / 3);
+                    const float corners[4][2] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+                    for (int k = 0; k < 4; k++) {
+                        mQuadsVertices.insert(mQuadsVertices.end(), {float(i) + corners[k][0] + NB_CELLS, 1.0f, float(j) + corners[k][1]});
+                        mQuadsNormals.insert(mQuadsNormals.end(), {0.0f, 1.0f, 0.0f});
+                    }
+                    mQuadsIndices.insert(mQuadsIndices.end(), {v, v + 1, v + 2, v + 2, v + 1, v + 3});
+                }
+            }
+
+            mGridVertexArray = new TriangleVertexArray(uint32(mGridVertices.size() / 3), &(mGridVertices[0]), 3 * sizeof(float),
+                                                       uint32(mGridIndices.size() / 3), &(mGridIndices[0]), 3 * sizeof(uint32),
+                                                       TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                       TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            mQuadsVertexArray = new TriangleVertexArray(uint32(mQuadsVertices.size() / 3), &(mQuadsVertices[0]), 3 * sizeof(float),
+                                                        &(mQuadsNormals[0]), 3 * sizeof(float),
+                                                        uint32(mQuadsIndices.size() / 3), &(mQuadsIndices[0]), 3 * sizeof(uint32),
+                                                        TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                        TriangleVertexArray::NormalDataType::NORMAL_FLOAT_TYPE,
+                                                        TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+            mTriangleMesh = mPhysicsCommon.createTriangleMesh();
+            mTriangleMesh->addSubpart(mGridVertexArray);
+            mTriangleMesh->addSubpart(mQuadsVertexArray);
+        }
+
+        /// Destructor
+        virtual ~TestCompressedTriangleMesh() {
+            delete mGridVertexArray;
+            delete mQuadsVertexArray;
+        }
+
+        /// Run the tests
+        void run() {
+
+            testNormalEncoding();
+            testCompressedTriangles();
+            testScatteredTriangles();
+            testConcaveMeshShape();
+            testCookedTriangleMesh();
+            testEdgesAdjacency();
+            testSmoothContactOnFlatEdge();
+        }
+
+        void testNormalEncoding() {
+
+            const Vector3 normals[] = {Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(1, 0, 0), Vector3(0, 0, -1),
+                                       Vector3(1, 2, 3), Vector3(-4, 1, -2), Vector3(3, -7, -1), Vector3(-1, -1, 5)};
+
+            for (const Vector3& n : normals) {
+                const Vector3 normal = n.getUnit();
+                const Vector3 decodedNormal = CompressedTriangleArray::decodeNormal(CompressedTriangleArray::encodeNormal(normal));
+                rp3d_test(approxEqual(decodedNormal.length(), decimal(1.0), decimal(0.00001)));
+                rp3d_test(decodedNormal.dot(normal) > decimal(0.99999));
+            }
+        }
+
+        void testCompressedTriangles() {
+
+            TriangleMesh* compressedMesh = mPhysicsCommon.createCompressedTriangleMesh(mTriangleMesh);
+
+            rp3d_test(compressedMesh->isCompressed());
+            rp3d_test(!mTriangleMesh->isCompressed());
+            rp3d_test(compressedMesh->getNbSubparts() == 2);
+            rp3d_test(compressedMesh->getNbTriangles(0) == mTriangleMesh->getNbTriangles(0));
+            rp3d_test(compressedMesh->getNbTriangles(1) == mTriangleMesh->getNbTriangles(1));
+            rp3d_test(compressedMesh->getNbTriangles() == uint32(4 * NB_CELLS * NB_CELLS));
+
+            const CompressedTriangleArray* compressedTriangles = compressedMesh->getCompressedTriangles();
+
+            // The consecutive triangles of the grids are close to each other and fill the clusters
+            rp3d_test(compressedTriangles->getNbClusters() == compressedMesh->getNbTriangles() / CompressedTriangleArray::NB_TRIANGLES_PER_CLUSTER);
+
+            // The duplicated vertices of a cluster are welded
+            rp3d_test(compressedTriangles->getNbVertices() < compressedMesh->getNbTriangles() * 3 / 2);
+
+            // The compressed data is smaller than the original vertices, normals and indices
+            const size_t originalSize = (mGridVertices.size() + mQuadsVertices.size() + mQuadsNormals.size() +
+                                         3 * mGridVertices.size()) * sizeof(float) +
+                                        (mGridIndices.size() + mQuadsIndices.size()) * sizeof(uint32);
+            rp3d_test(compressedTriangles->getSizeInBytes() < originalSize / 2);
+
+            // The decoded triangles must be close to the original ones and the vertices at the
+            // same original position must have the same decoded position (no crack between clusters)
+            std::map<std::tuple<decimal, decimal, decimal>, Vector3> decodedPositions;
+            for (uint32 subPart = 0; subPart < 2; subPart++) {
+                for (uint32 t = 0; t < mTriangleMesh->getNbTriangles(subPart); t++) {
+
+                    Vector3 vertices[3], decodedVertices[3];
+                    Vector3 normals[3], decodedNormals[3];
+                    mTriangleMesh->getTriangleVertices(subPart, t, vertices);
+                    mTriangleMesh->getTriangleVerticesNormals(subPart, t, normals);
+                    compressedMesh->getTriangleVertices(subPart, t, decodedVertices);
+                    compressedMesh->getTriangleVerticesNormals(subPart, t, decodedNormals);
+
+                    for (int k = 0; k < 3; k++) {
+
+                        rp3d_test(approxEqual(vertices[k], decodedVertices[k], decimal(0.001)));
+                        rp3d_test(decodedNormals[k].dot(normals[k]) > decimal(0.9999));
+
+                        const std::tuple<decimal, decimal, decimal> key(vertices[k].x, vertices[k].y, vertices[k].z);
+                        auto it = decodedPositions.find(key);
+                        if (it == decodedPositions.end()) {
+                            decodedPositions[key] = decodedVertices[k];
+                        }
+                        else {
+                            rp3d_test(it->second == decodedVertices[k]);
+                        }
+                    }
+                }
+            }
+
+            mPhysicsCommon.destroyTriangleMesh(compressedMesh);
+        }
+
+        void testScatteredTriangles() {
+
+            // Large grid whose triangles are not in a spatially coherent order
+            const int nbCells = 100;
+            const float cellSize = 10.0f;
+            std::vector<float> vertices;
+            for (int j = 0; j <= nbCells; j++) {
+                for (int i = 0; i <= nbCells; i++) {
+                    vertices.insert(vertices.end(), {float(i) * cellSize, computeHeight(float(i), float(j)), float(j) * cellSize});
+                }
+            }
+            std::vector<uint32> gridIndices;
+            for (int j = 0; j < nbCells; j++) {
+                for (int i = 0; i < nbCells; i++) {
+                    const uint32 v = uint32(j * (nbCells + 1) + i);
+                    gridIndices.insert(gridIndices.end(), {v, v + nbCells + 1, v + 1, v + 1, v + nbCells + 1, v + nbCells + 2});
+                }
+            }
+            const uint32 nbTriangles = uint32(gridIndices.size() / 3);
+            std::vector<uint32> indices(gridIndices.size());
+            for (uint32 t = 0; t < nbTriangles; t++) {
+                const uint32 shuffledTriangle = (t * 7919) % nbTriangles;
+                for (int k = 0; k < 3; k++) {
+                    indices[t * 3 + k] = gridIndices[shuffledTriangle * 3 + k];
+                }
+            }
+
+            TriangleVertexArray vertexArray(uint32(vertices.size() / 3), &(vertices[0]), 3 * sizeof(float),
+                                            nbTriangles, &(indices[0]), 3 * sizeof(uint32),
+                                            TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                            TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            TriangleMesh* triangleMesh = mPhysicsCommon.createTriangleMesh();
+            triangleMesh->addSubpart(&vertexArray);
+            TriangleMesh* cookedMesh = mPhysicsCommon.createCookedTriangleMesh(triangleMesh);
+            const CompressedTriangleArray* compressedTriangles = cookedMesh->getCompressedTriangles();
+
+            // The scattered triangles are split into more clusters but the quantization step only depends on
+            // the size of the triangles and not on the size of the whole mesh
+            rp3d_test(compressedTriangles->getNbClusters() > nbTriangles / CompressedTriangleArray::NB_TRIANGLES_PER_CLUSTER);
+            const decimal maxPositionError = compressedTriangles->getMaxPositionError();
+            rp3d_test(maxPositionError > decimal(0.0));
+            rp3d_test(maxPositionError < decimal(CompressedTriangleArray::MAX_CLUSTER_SIZE_IN_TRIANGLES) * cellSize / decimal(65534.0));
+
+            for (uint32 t = 0; t < nbTriangles; t++) {
+
+                Vector3 triangleVertices[3], decodedVertices[3];
+                triangleMesh->getTriangleVertices(0, t, triangleVertices);
+                cookedMesh->getTriangleVertices(0, t, decodedVertices);
+                for (int k = 0; k < 3; k++) {
+                    rp3d_test((decodedVertices[k] - triangleVertices[k]).length() <= maxPositionError * decimal(1.001));
+                }
+            }
+
+            // The cooked data with clusters of different sizes can be loaded
+            std::vector<uint8> cookedData(cookedMesh->getCookedDataSize());
+            cookedMesh->writeCookedData(&(cookedData[0]), cookedData.size());
+            TriangleMesh* loadedMesh = mPhysicsCommon.createTriangleMeshFromCookedData(&(cookedData[0]), cookedData.size());
+            rp3d_test(loadedMesh != nullptr);
+            rp3d_test(loadedMesh->getCompressedTriangles()->getNbClusters() == compressedTriangles->getNbClusters());
+            for (uint32 t = 0; t < nbTriangles; t++) {
+
+                Vector3 cookedVertices[3], loadedVertices[3];
+                cookedMesh->getTriangleVertices(0, t, cookedVertices);
+                loadedMesh->getTriangleVertices(0, t, loadedVertices);
+                for (int k = 0; k < 3; k++) {
+                    rp3d_test(loadedVertices[k] == cookedVertices[k]);
+                }
+            }
+
+            mPhysicsCommon.destroyTriangleMesh(loadedMesh);
+            mPhysicsCommon.destroyTriangleMesh(cookedMesh);
+            mPhysicsCommon.destroyTriangleMesh(triangleMesh);
+        }
+
+        void testCookedTriangleMesh() {
+
+            TriangleMesh* compressedMesh = mPhysicsCommon.createCompressedTriangleMesh(mTriangleMesh);
+            TriangleMesh* cookedMesh = mPhysicsCommon.createCookedTriangleMesh(mTriangleMesh);
+
+            rp3d_test(cookedMesh->isCooked());
+            rp3d_test(cookedMesh->isCompressed());
+            rp3d_test(!compressedMesh->isCooked());
+            rp3d_test(compressedMesh->getCookedDataSize() == 0);
+            rp3d_test(mTriangleMesh->getCookedDataSize() == 0);
+
+            // Write the cooked data and load it again
+            std::vector<uint8> cookedData(cookedMesh->getCookedDataSize());
+            rp3d_test(cookedMesh->writeCookedData(&(cookedData[0]), cookedData.size() - 1) == 0);
+            rp3d_test(cookedMesh->writeCookedData(&(cookedData[0]), cookedData.size()) == cookedData.size());
+            TriangleMesh* loadedMesh = mPhysicsCommon.createTriangleMeshFromCookedData(&(cookedData[0]), cookedData.size());
+            rp3d_test(loadedMesh != nullptr);
+            rp3d_test(loadedMesh->isCooked());
+            rp3d_test(loadedMesh->getNbSubparts() == 2);
+            rp3d_test(loadedMesh->getNbTriangles(0) == mTriangleMesh->getNbTriangles(0));
+            rp3d_test(loadedMesh->getNbTriangles(1) == mTriangleMesh->getNbTriangles(1));
+
+            // The triangles of the cooked, loaded and compressed meshes must be the same
+            for (uint32 subPart = 0; subPart < 2; subPart++) {
+                for (uint32 t = 0; t < mTriangleMesh->getNbTriangles(subPart); t++) {
+
+                    Vector3 compressedVertices[3], cookedVertices[3], loadedVertices[3];
+                    Vector3 cookedNormals[3], loadedNormals[3];
+                    compressedMesh->getTriangleVertices(subPart, t, compressedVertices);
+                    cookedMesh->getTriangleVertices(subPart, t, cookedVertices);
+                    loadedMesh->getTriangleVertices(subPart, t, loadedVertices);
+                    cookedMesh->getTriangleVerticesNormals(subPart, t, cookedNormals);
+                    loadedMesh->getTriangleVerticesNormals(subPart, t, loadedNormals);
+                    for (int k = 0; k < 3; k++) {
+                        rp3d_test(compressedVertices[k] == cookedVertices[k]);
+                        rp3d_test(loadedVertices[k] == cookedVertices[k]);
+                        rp3d_test(loadedNormals[k] == cookedNormals[k]);
+                    }
+                }
+            }
+
+            // A concave mesh shape created with a cooked mesh uses the BVH of the mesh
+            ConcaveMeshShape* cookedShape = mPhysicsCommon.createConcaveMeshShape(cookedMesh);
+            ConcaveMeshShape* loadedShape = mPhysicsCommon.createConcaveMeshShape(loadedMesh);
+            ConcaveMeshShape* compressedShape = mPhysicsCommon.createConcaveMeshShape(compressedMesh);
+            rp3d_test(cookedShape->getBVHDataSize() == compressedShape->getBVHDataSize());
+            std::vector<uint8> cookedBVHData(cookedShape->getBVHDataSize());
+            std::vector<uint8> loadedBVHData(loadedShape->getBVHDataSize());
+            std::vector<uint8> compressedBVHData(compressedShape->getBVHDataSize());
+            cookedShape->writeBVHData(&(cookedBVHData[0]), cookedBVHData.size());
+            loadedShape->writeBVHData(&(loadedBVHData[0]), loadedBVHData.size());
+            compressedShape->writeBVHData(&(compressedBVHData[0]), compressedBVHData.size());
+            rp3d_test(cookedBVHData == compressedBVHData);
+            rp3d_test(loadedBVHData == compressedBVHData);
+
+            Vector3 min, max, compressedMin, compressedMax;
+            loadedShape->getLocalBounds(min, max);
+            compressedShape->getLocalBounds(compressedMin, compressedMax);
+            rp3d_test(min == compressedMin && max == compressedMax);
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(Transform::identity());
+            Collider* collider = body->addCollider(loadedShape, Transform::identity());
+            const Ray ray(Vector3(decimal(NB_CELLS) + decimal(4.3), 10, decimal(3.5)), Vector3(decimal(NB_CELLS) + decimal(4.3), -10, decimal(3.5)));
+            RaycastInfo raycastInfo;
+            rp3d_test(collider->raycast(ray, raycastInfo));
+            rp3d_test(approxEqual(raycastInfo.worldPoint.y, decimal(1.0), decimal(0.001)));
+            rp3d_test(raycastInfo.meshSubpart == 1);
+            mPhysicsCommon.destroyPhysicsWorld(world);
+
+            // Invalid cooked data cannot be loaded
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(&(cookedData[0]), cookedData.size() - 1) == nullptr);
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(nullptr, 0) == nullptr);
+            std::vector<uint8> corruptedData = cookedData;
+            corruptedData[0] ^= 0xff;
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(&(corruptedData[0]), corruptedData.size()) == nullptr);
+            corruptedData = cookedData;
+            corruptedData[corruptedData.size() - 1] ^= 0x40;
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(&(corruptedData[0]), corruptedData.size()) == nullptr);
+
+            mPhysicsCommon.destroyConcaveMeshShape(cookedShape);
+            mPhysicsCommon.destroyConcaveMeshShape(loadedShape);
+            mPhysicsCommon.destroyConcaveMeshShape(compressedShape);
+            mPhysicsCommon.destroyTriangleMesh(compressedMesh);
+            mPhysicsCommon.destroyTriangleMesh(cookedMesh);
+            mPhysicsCommon.destroyTriangleMesh(loadedMesh);
+        }
+
+        void testConcaveMeshShape() {
+
+            TriangleMesh* compressedMesh = mPhysicsCommon.createCompressedTriangleMesh(mTriangleMesh);
+
+            ConcaveMeshShape* shape = mPhysicsCommon.createConcaveMeshShape(mTriangleMesh);
+            ConcaveMeshShape* compressedShape = mPhysicsCommon.createConcaveMeshShape(compressedMesh);
+
+            rp3d_test(compressedShape->getNbSubparts() == 2);
+            rp3d_test(compressedShape->getNbTriangles(1) == shape->getNbTriangles(1));
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(Transform::identity());
+            Collider* collider = body->addCollider(shape, Transform::identity());
+            CollisionBody* compressedBody = world->createCollisionBody(Transform::identity());
+            Collider* compressedCollider = compressedBody->addCollider(compressedShape, Transform::identity());
+
+            // Vertical rays must hit both meshes at the same position
+            for (int i = 0; i < 2 * NB_CELLS * 3; i++) {
+                for (int j = 0; j < NB_CELLS * 3; j++) {
+
+                    const decimal x = decimal(0.17) + decimal(i) / decimal(3.0);
+                    const decimal z = decimal(0.23) + decimal(j) / decimal(3.0);
+                    const Ray ray(Vector3(x, 10, z), Vector3(x, -10, z));
+
+                    RaycastInfo raycastInfo, compressedRaycastInfo;
+                    const bool isHit = collider->raycast(ray, raycastInfo);
+                    const bool isCompressedHit = compressedCollider->raycast(ray, compressedRaycastInfo);
+                    rp3d_test(isHit && isCompressedHit);
+                    rp3d_test(approxEqual(raycastInfo.worldPoint, compressedRaycastInfo.worldPoint, decimal(0.001)));
+                    rp3d_test(raycastInfo.meshSubpart == compressedRaycastInfo.meshSubpart);
+                    rp3d_test(raycastInfo.triangleIndex == compressedRaycastInfo.triangleIndex);
+                }
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyConcaveMeshShape(shape);
+            mPhysicsCommon.destroyConcaveMeshShape(compressedShape);
+            mPhysicsCommon.destroyTriangleMesh(compressedMesh);
+        }
+        void testEdgesAdjacency() {
+
+            TriangleMesh* cookedMesh = mPhysicsCommon.createCookedTriangleMesh(mTriangleMesh);
+
+            std::vector<uint8> cookedData(cookedMesh->getCookedDataSize());
+            cookedMesh->writeCookedData(&(cookedData[0]), cookedData.size());
+            TriangleMesh* loadedMesh = mPhysicsCommon.createTriangleMeshFromCookedData(&(cookedData[0]), cookedData.size());
+
+            const uint32 nbGridTriangles = cookedMesh->getNbTriangles(0);
+
+            for (uint32 subPart = 0; subPart < 2; subPart++) {
+
+                uint32 nbBoundaryEdges = 0;
+
+                for (uint32 t = 0; t < cookedMesh->getNbTriangles(subPart); t++) {
+
+                    uint32 adjacentTriangles[3], loadedAdjacentTriangles[3];
+                    cookedMesh->getTriangleAdjacentTriangles(subPart, t, adjacentTriangles);
+                    loadedMesh->getTriangleAdjacentTriangles(subPart, t, loadedAdjacentTriangles);
+                    const uint8 convexEdges = cookedMesh->getTriangleConvexEdges(subPart, t);
+                    rp3d_test(loadedMesh->getTriangleConvexEdges(subPart, t) == convexEdges);
+
+                    const uint32 triangleId = subPart * nbGridTriangles + t;
+
+                    for (int i = 0; i < 3; i++) {
+
+                        rp3d_test(loadedAdjacentTriangles[i] == adjacentTriangles[i]);
+
+                        if (adjacentTriangles[i] == TriangleMesh::NO_ADJACENT_TRIANGLE) {
+
+                            // An edge without adjacent triangle is a convex edge
+                            nbBoundaryEdges++;
+                            rp3d_test(convexEdges & (1 << i));
+                            continue;
+                        }
+
+                        // The two sub-parts are not connected
+                        rp3d_test(adjacentTriangles[i] / nbGridTriangles == subPart);
+
+                        // The adjacency is symmetric and the edge has the same convexity in both triangles
+                        const uint32 adjacentIndex = adjacentTriangles[i] - subPart * nbGridTriangles;
+                        uint32 adjacentOfAdjacent[3];
+                        cookedMesh->getTriangleAdjacentTriangles(subPart, adjacentIndex, adjacentOfAdjacent);
+                        const uint8 adjacentConvexEdges = cookedMesh->getTriangleConvexEdges(subPart, adjacentIndex);
+                        bool isFound = false;
+                        for (int k = 0; k < 3; k++) {
+                            if (adjacentOfAdjacent[k] == triangleId) {
+                                isFound = true;
+                                rp3d_test(((adjacentConvexEdges >> k) & 1) == ((convexEdges >> i) & 1));
+                            }
+                        }
+                        rp3d_test(isFound);
+
+                        // All the edges of the flat sub-part are flat
+                        if (subPart == 1) {
+                            rp3d_test((convexEdges & (1 << i)) == 0);
+                        }
+                    }
+                }
+
+                // Only the edges on the border of the grids do not have an adjacent triangle
+                rp3d_test(nbBoundaryEdges == 4 * NB_CELLS);
+            }
+
+            // The first and second triangles of a cell of the first grid share the diagonal of the cell
+            // and the first triangle of a cell shares its first edge with the second triangle of the previous cell
+            auto firstTriangle = [](int i, int j) { return uint32(2 * (j * NB_CELLS + i)); };
+            uint32 adjacentTriangles[3];
+            cookedMesh->getTriangleAdjacentTriangles(0, firstTriangle(5, 0), adjacentTriangles);
+            rp3d_test(adjacentTriangles[0] == firstTriangle(4, 0) + 1);
+            rp3d_test(adjacentTriangles[1] == firstTriangle(5, 0) + 1);
+
+            // The edges along the z axis are convex near a top of the surface and concave near a bottom
+            rp3d_test(cookedMesh->getTriangleConvexEdges(0, firstTriangle(5, 0)) & 1);
+            rp3d_test((cookedMesh->getTriangleConvexEdges(0, firstTriangle(16, 0)) & 1) == 0);
+
+            // The convexity of the diagonals depends on the sign of the cross derivative of the surface
+            rp3d_test(cookedMesh->getTriangleConvexEdges(0, firstTriangle(0, 7)) & 2);
+            rp3d_test((cookedMesh->getTriangleConvexEdges(0, firstTriangle(10, 7)) & 2) == 0);
+
+            mPhysicsCommon.destroyTriangleMesh(cookedMesh);
+            mPhysicsCommon.destroyTriangleMesh(loadedMesh);
+        }
+
+        void testSmoothContactOnFlatEdge() {
+
+            // Flat square made of two triangles with a convex ridge with a third triangle sloping down. The
+            // smooth normals of the vertices of the ridge are tilted but the diagonal of the square is flat
+            const float vertices[] = {0, 0, 0,   0, 0, 2,   2, 0, 0,   2, 0, 2,   4, -2, 1};
+            const uint32 indices[] = {0, 1, 2,   2, 1, 3,   2, 3, 4};
+            TriangleVertexArray vertexArray(5, vertices, 3 * sizeof(float), 3, indices, 3 * sizeof(uint32),
+                                            TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                            TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            TriangleMesh* triangleMesh = mPhysicsCommon.createTriangleMesh();
+            triangleMesh->addSubpart(&vertexArray);
+            TriangleMesh* cookedMesh = mPhysicsCommon.createCookedTriangleMesh(triangleMesh);
+
+            rp3d_test(cookedMesh->getTriangleConvexEdges(0, 0) == (1 | 4));
+            rp3d_test(cookedMesh->getTriangleConvexEdges(0, 1) == (2 | 4));
+            rp3d_test(cookedMesh->getTriangleConvexEdges(0, 2) == 7);
+
+            ConcaveMeshShape* shape = mPhysicsCommon.createConcaveMeshShape(triangleMesh);
+            ConcaveMeshShape* cookedShape = mPhysicsCommon.createConcaveMeshShape(cookedMesh);
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* meshBody = world->createCollisionBody(Transform::identity());
+            meshBody->addCollider(shape, Transform::identity());
+            CollisionBody* cookedMeshBody = world->createCollisionBody(Transform(Vector3(0, 0, 10), Quaternion::identity()));
+            cookedMeshBody->addCollider(cookedShape, Transform::identity());
+
+            // Sphere touching the middle of the flat diagonal of the square of each mesh
+            CollisionBody* sphereBody = world->createCollisionBody(Transform(Vector3(1, decimal(0.4), 1), Quaternion::identity()));
+            sphereBody->addCollider(sphereShape, Transform::identity());
+            CollisionBody* cookedSphereBody = world->createCollisionBody(Transform(Vector3(1, decimal(0.4), 11), Quaternion::identity()));
+            cookedSphereBody->addCollider(sphereShape, Transform::identity());
+
+            // The interpolated vertices normals give a tilted contact normal on the flat edge
+            ContactNormalsCallback callback;
+            world->testCollision(meshBody, sphereBody, callback);
+            rp3d_test(callback.contactNormals.size() > 0);
+            bool isTilted = false;
+            for (const Vector3& normal : callback.contactNormals) {
+                isTilted = isTilted || std::abs(normal.x) > decimal(0.01);
+            }
+            rp3d_test(isTilted);
+
+            // The normal of the cooked mesh is the face normal because the edge is flat
+            ContactNormalsCallback cookedCallback;
+            world->testCollision(cookedMeshBody, cookedSphereBody, cookedCallback);
+            rp3d_test(cookedCallback.contactNormals.size() > 0);
+            for (const Vector3& normal : cookedCallback.contactNormals) {
+                rp3d_test(approxEqual(std::abs(normal.y), decimal(1.0), decimal(0.0001)));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroySphereShape(sphereShape);
+            mPhysicsCommon.destroyConcaveMeshShape(shape);
+            mPhysicsCommon.destroyConcaveMeshShape(cookedShape);
+            mPhysicsCommon.destroyTriangleMesh(triangleMesh);
+            mPhysicsCommon.destroyTriangleMesh(cookedMesh);
+        }
+};
+
+}
+
+#endif
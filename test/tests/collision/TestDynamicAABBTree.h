@@ -33,6 +33,7 @@
 #include <reactphysics3d/engine/PhysicsCommon.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <vector>
+#include <algorithm>
 
 /// Reactphysics3D namespace
 namespace reactphysics3d {
@@ -136,6 +137,7 @@ class TestDynamicAABBTree : public Test {
             testBasicsMethods();
             testOverlapping();
             testRaycast();
+            testBuildTopDown();
 
         }
 
@@ -560,6 +562,70 @@ class TestDynamicAABBTree : public Test {
             rp3d_test(mRaycastCallback.isHit(object4Id));
 
         }
+
+        void testBuildTopDown() {
+
+            // Create random boxes
+            const int32 nbLeaves = 500;
+            std::vector<AABB> leafAABBs;
+            std::vector<int32> leafData;
+            uint32 seed = 12345;
+            const auto random = [&seed](decimal min, decimal max) {
+                seed = seed * 1664525u + 1013904223u;
+                return min + (max - min) * decimal(seed >> 8) / decimal(1 << 24);
+            };
+            for (int32 i = 0; i < nbLeaves; i++) {
+                const Vector3 min(random(-50, 50), random(-50, 50), random(-50, 50));
+                leafAABBs.push_back(AABB(min, min + Vector3(random(decimal(0.1), 4), random(decimal(0.1), 4), random(decimal(0.1), 4))));
+                leafData.push_back(i);
+                leafData.push_back(2 * i);
+            }
+
+            DynamicAABBTree tree(mAllocator);
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+
+            tree.buildTopDown(&(leafAABBs[0]), &(leafData[0]), nbLeaves);
+
+            rp3d_test(tree.getNbAllocatedNodes() == 2 * nbLeaves - 1);
+            rp3d_test(tree.getRootNodeID() == 0);
+
+            // The tree must be balanced enough
+            rp3d_test(tree.getNodes()[tree.getRootNodeID()].height < 40);
+
+            // Compare the AABB overlap queries with a brute-force test
+            for (int i = 0; i < 50; i++) {
+
+                const Vector3 min(random(-60, 60), random(-60, 60), random(-60, 60));
+                const AABB queryAABB(min, min + Vector3(10, 10, 10));
+
+                std::vector<int32> expectedLeaves;
+                for (int32 j = 0; j < nbLeaves; j++) {
+                    if (leafAABBs[j].testCollision(queryAABB)) expectedLeaves.push_back(j);
+                }
+
+                Array<int> overlappingNodes(mAllocator);
+                tree.reportAllShapesOverlappingWithAABB(queryAABB, overlappingNodes);
+
+                std::vector<int32> foundLeaves;
+                for (uint32 j = 0; j < overlappingNodes.size(); j++) {
+                    const int32* data = tree.getNodeDataInt(overlappingNodes[j]);
+                    rp3d_test(data[1] == 2 * data[0]);
+                    foundLeaves.push_back(data[0]);
+                }
+                std::sort(foundLeaves.begin(), foundLeaves.end());
+                rp3d_test(foundLeaves == expectedLeaves);
+            }
+
+            // Objects can still be added into a tree built top-down
+            int32 nodeId = tree.addObject(AABB(Vector3(100, 100, 100), Vector3(101, 101, 101)), 1000, 2000);
+            Array<int> overlappingNodes(mAllocator);
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(99, 99, 99), Vector3(102, 102, 102)), overlappingNodes);
+            rp3d_test(overlappingNodes.size() == 1);
+            rp3d_test(overlappingNodes[0] == nodeId);
+        }
  };
 
 }
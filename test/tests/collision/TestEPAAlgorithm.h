@@ -0,0 +1,344 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_EPA_ALGORITHM_H
+#define TEST_EPA_ALGORITHM_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestEPAAlgorithm
+/**
+ * Unit test for the EPA narrow-phase collision detection between convex polyhedra with many edges
+ */
+class TestEPAAlgorithm : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// Number of sides of the prism
+        static const int NB_SIDES = 64;
+
+        /// Prism with many sides (radius 1 and half-height 1 along the y axis)
+        std::vector<float> mPrismVertices;
+        std::vector<int> mPrismIndices;
+        std::vector<PolygonVertexArray::PolygonFace> mPrismFaces;
+        PolygonVertexArray* mPrismPolygonVertexArray;
+        PolyhedronMesh* mPrismPolyhedronMesh;
+
+        /// Callback that stores the contact points of a collision test
+        class ContactPointsCallback : public CollisionCallback {
+
+            public:
+
+                std::vector<Vector3> contactNormals;
+                std::vector<decimal> penetrationDepths;
+                std::vector<Vector3> contactPoints1;
+                std::vector<Vector3> contactPoints2;
+
+                virtual void onContact(const CallbackData& callbackData) override {
+                    for (uint32 p = 0; p < callbackData.getNbContactPairs(); p++) {
+                        ContactPair contactPair = callbackData.getContactPair(p);
+                        for (uint32 c = 0; c < contactPair.getNbContactPoints(); c++) {
+                            const ContactPoint contactPoint = contactPair.getContactPoint(c);
+                            contactNormals.push_back(contactPoint.getWorldNormal());
+                            penetrationDepths.push_back(contactPoint.getPenetrationDepth());
+                            contactPoints1.push_back(contactPair.getCollider1()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider1());
+                            contactPoints2.push_back(contactPair.getCollider2()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider2());
+                        }
+                    }
+                }
+
+                decimal getMaxPenetrationDepth() const {
+                    decimal maxPenetrationDepth = 0;
+                    for (uint32 i = 0; i < penetrationDepths.size(); i++) {
+                        maxPenetrationDepth = std::max(maxPenetrationDepth, penetrationDepths[i]);
+                    }
+                    return maxPenetrationDepth;
+                }
+        };
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestEPAAlgorithm(const std::string& name) : Test(name) {
+
+            const float pi = 3.14159265358979f;
+
+            // Vertices of the bottom and top polygons
+            for (int i = 0; i < 2 * NB_SIDES; i++) {
+                const float angle = 2.0f * pi * float(i % NB_SIDES) / float(NB_SIDES);
+                mPrismVertices.push_back(std::cos(angle));
+                mPrismVertices.push_back(i < NB_SIDES ? -1.0f : 1.0f);
+                mPrismVertices.push_back(std::sin(angle));
+            }
+
+            // Bottom and top faces
+            PolygonVertexArray::PolygonFace face;
+            face.nbVertices = NB_SIDES;
+            face.indexBase = 0;
+            mPrismFaces.push_back(face);
+            for (int i = 0; i < NB_SIDES; i++) {
+                mPrismIndices.push_back(i);
+            }
+            face.indexBase = NB_SIDES;
+            mPrismFaces.push_back(face);
+            for (int i = 0; i < NB_SIDES; i++) {
+                mPrismIndices.push_back(2 * NB_SIDES - 1 - i);
+            }
+
+            // Side faces
+            for (int i = 0; i < NB_SIDES; i++) {
+                face.nbVertices = 4;
+                face.indexBase = static_cast<uint32>(mPrismIndices.size());
+                mPrismFaces.push_back(face);
+                mPrismIndices.push_back(i);
+                mPrismIndices.push_back(NB_SIDES + i);
+                mPrismIndices.push_back(NB_SIDES + (i + 1) % NB_SIDES);
+                mPrismIndices.push_back((i + 1) % NB_SIDES);
+            }
+
+            mPrismPolygonVertexArray = new PolygonVertexArray(2 * NB_SIDES, mPrismVertices.data(), 3 * sizeof(float), mPrismIndices.data(), sizeof(int),
+                                                              static_cast<uint32>(mPrismFaces.size()), mPrismFaces.data(),
+                                                              PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                              PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            mPrismPolyhedronMesh = mPhysicsCommon.createPolyhedronMesh(mPrismPolygonVertexArray);
+        }
+
+        /// Destructor
+        virtual ~TestEPAAlgorithm() {
+            mPhysicsCommon.destroyPolyhedronMesh(mPrismPolyhedronMesh);
+            delete mPrismPolygonVertexArray;
+        }
+
+        /// Return the overlap of two scaled prisms along an axis
+        decimal computeOverlapAlongAxis(const Transform& transform1, const Vector3& scale1,
+                                        const Transform& transform2, const Vector3& scale2, const Vector3& axis) const {
+
+            decimal maxProjection1 = -DECIMAL_LARGEST;
+            decimal minProjection2 = DECIMAL_LARGEST;
+            for (int v = 0; v < 2 * NB_SIDES; v++) {
+                const Vector3 vertex(mPrismVertices[3 * v], mPrismVertices[3 * v + 1], mPrismVertices[3 * v + 2]);
+                maxProjection1 = std::max(maxProjection1, axis.dot(transform1 * (vertex * scale1)));
+                minProjection2 = std::min(minProjection2, axis.dot(transform2 * (vertex * scale2)));
+            }
+
+            return maxProjection1 - minProjection2;
+        }
+
+        /// Run the tests
+        void run() {
+            testAlgorithmSelection();
+            testFaceContact();
+            testSideContact();
+            testSameResultsAsSAT();
+        }
+
+        void testAlgorithmSelection() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            ConvexMeshShape* prismShape = mPhysicsCommon.createConvexMeshShape(mPrismPolyhedronMesh);
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(1, 1, 1));
+
+            CollisionDispatch& collisionDispatch = world->getCollisionDispatch();
+
+            // Two prisms with many edges use the EPA algorithm but a prism and a box use the SAT algorithm
+            rp3d_test(collisionDispatch.selectNarrowPhaseAlgorithm(prismShape, prismShape) == NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronEPA);
+            rp3d_test(collisionDispatch.selectNarrowPhaseAlgorithm(prismShape, boxShape) == NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron);
+
+            // Change the minimum number of pairs of edges for the EPA algorithm
+            const uint32 minNbEdgePairs = collisionDispatch.getMinNbEdgePairsForEPA();
+            collisionDispatch.setMinNbEdgePairsForEPA(NB_SIDES * 3 * 12);
+            rp3d_test(collisionDispatch.selectNarrowPhaseAlgorithm(prismShape, boxShape) == NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronEPA);
+            collisionDispatch.setMinNbEdgePairsForEPA(std::numeric_limits<uint32>::max());
+            rp3d_test(collisionDispatch.selectNarrowPhaseAlgorithm(prismShape, prismShape) == NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron);
+            collisionDispatch.setMinNbEdgePairsForEPA(minNbEdgePairs);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyConvexMeshShape(prismShape);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        void testFaceContact() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            ConvexMeshShape* prismShape = mPhysicsCommon.createConvexMeshShape(mPrismPolyhedronMesh);
+
+            // Prism resting on the top face of another prism
+            CollisionBody* body1 = world->createCollisionBody(Transform::identity());
+            body1->addCollider(prismShape, Transform::identity());
+            CollisionBody* body2 = world->createCollisionBody(Transform(Vector3(decimal(0.1), decimal(1.9), decimal(0.05)), Quaternion::identity()));
+            body2->addCollider(prismShape, Transform::identity());
+
+            rp3d_test(world->testOverlap(body1, body2));
+
+            // The contact points are computed by clipping the faces
+            ContactPointsCallback callback;
+            world->testCollision(body1, body2, callback);
+            rp3d_test(callback.contactNormals.size() >= 3);
+            for (uint32 i = 0; i < callback.contactNormals.size(); i++) {
+                rp3d_test(approxEqual(std::abs(callback.contactNormals[i].y), decimal(1.0), decimal(0.0001)));
+                rp3d_test(approxEqual(callback.penetrationDepths[i], decimal(0.1), decimal(0.0001)));
+            }
+
+            // Separated prisms
+            body2->setTransform(Transform(Vector3(decimal(0.1), decimal(2.1), decimal(0.05)), Quaternion::identity()));
+            rp3d_test(!world->testOverlap(body1, body2));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyConvexMeshShape(prismShape);
+        }
+
+        void testSideContact() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            ConvexMeshShape* prismShape = mPhysicsCommon.createConvexMeshShape(mPrismPolyhedronMesh);
+
+            // Two prisms side by side with a vertical edge of each prism inside the other prism
+            CollisionBody* body1 = world->createCollisionBody(Transform::identity());
+            body1->addCollider(prismShape, Transform::identity());
+            CollisionBody* body2 = world->createCollisionBody(Transform(Vector3(decimal(1.9), decimal(0.5), 0), Quaternion::identity()));
+            body2->addCollider(prismShape, Transform::identity());
+
+            ContactPointsCallback callback;
+            world->testCollision(body1, body2, callback);
+            rp3d_test(callback.contactNormals.size() > 0);
+            const decimal expectedPenetrationDepth = decimal(0.1) * std::cos(decimal(3.14159265358979) / NB_SIDES);
+            for (uint32 i = 0; i < callback.contactNormals.size(); i++) {
+                rp3d_test(std::abs(callback.contactNormals[i].x) > decimal(0.99));
+                rp3d_test(approxEqual(callback.contactNormals[i].y, decimal(0.0), decimal(0.0001)));
+                rp3d_test(callback.penetrationDepths[i] > decimal(0.0));
+                rp3d_test(callback.penetrationDepths[i] < decimal(0.1) + decimal(0.0001));
+            }
+            rp3d_test(approxEqual(callback.getMaxPenetrationDepth(), expectedPenetrationDepth, decimal(0.001)));
+
+            // Separated prisms
+            body2->setTransform(Transform(Vector3(decimal(2.1), decimal(0.5), 0), Quaternion::identity()));
+            rp3d_test(!world->testOverlap(body1, body2));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyConvexMeshShape(prismShape);
+        }
+
+        void testSameResultsAsSAT() {
+
+            // The second world always uses the SAT algorithm
+            PhysicsWorld* worldEPA = mPhysicsCommon.createPhysicsWorld();
+            PhysicsWorld* worldSAT = mPhysicsCommon.createPhysicsWorld();
+            worldSAT->getCollisionDispatch().setMinNbEdgePairsForEPA(std::numeric_limits<uint32>::max());
+
+            const Vector3 scale1(1, decimal(0.5), 1);
+            const Vector3 scale2(decimal(0.6), decimal(1.5), decimal(0.6));
+            ConvexMeshShape* prismShape1 = mPhysicsCommon.createConvexMeshShape(mPrismPolyhedronMesh, scale1);
+            ConvexMeshShape* prismShape2 = mPhysicsCommon.createConvexMeshShape(mPrismPolyhedronMesh, scale2);
+
+            CollisionBody* bodyEPA1 = worldEPA->createCollisionBody(Transform::identity());
+            bodyEPA1->addCollider(prismShape1, Transform::identity());
+            CollisionBody* bodyEPA2 = worldEPA->createCollisionBody(Transform::identity());
+            bodyEPA2->addCollider(prismShape2, Transform::identity());
+            CollisionBody* bodySAT1 = worldSAT->createCollisionBody(Transform::identity());
+            bodySAT1->addCollider(prismShape1, Transform::identity());
+            CollisionBody* bodySAT2 = worldSAT->createCollisionBody(Transform::identity());
+            bodySAT2->addCollider(prismShape2, Transform::identity());
+
+            uint32 seed = 4321;
+            auto random = [&seed](decimal min, decimal max) {
+                seed = seed * 1664525u + 1013904223u;
+                return min + (max - min) * decimal(seed >> 8) / decimal(1 << 24);
+            };
+
+            int nbOverlaps = 0;
+            for (int i = 0; i < 200; i++) {
+
+                const Transform transform1(Vector3(random(-1, 1), random(-1, 1), random(-1, 1)),
+                                           Quaternion::fromEulerAngles(random(-3, 3), random(-3, 3), random(-3, 3)));
+                const Transform transform2(Vector3(random(-1, 1), random(-1, 1), random(-1, 1)) * decimal(2.0),
+                                           Quaternion::fromEulerAngles(random(-3, 3), random(-3, 3), random(-3, 3)));
+                bodyEPA1->setTransform(transform1);
+                bodyEPA2->setTransform(transform2);
+                bodySAT1->setTransform(transform1);
+                bodySAT2->setTransform(transform2);
+
+                ContactPointsCallback callbackEPA;
+                ContactPointsCallback callbackSAT;
+                worldEPA->testCollision(bodyEPA1, bodyEPA2, callbackEPA);
+                worldSAT->testCollision(bodySAT1, bodySAT2, callbackSAT);
+
+                // The convex polyhedra SAT algorithm misses some overlaps
+                const bool isOverlapEPA = callbackEPA.contactNormals.size() > 0;
+                const bool isOverlapSAT = callbackSAT.contactNormals.size() > 0;
+                rp3d_test(isOverlapEPA || !isOverlapSAT);
+
+                if (isOverlapEPA) {
+
+                    nbOverlaps++;
+
+                    // The contact normal is the axis of minimum overlap of the two prisms. The penetration depth of a single
+                    // contact point is the overlap along this axis and the clipped points of a face contact are not deeper
+                    const decimal overlapEPA = computeOverlapAlongAxis(transform1, scale1, transform2, scale2, callbackEPA.contactNormals[0]);
+                    rp3d_test(callbackEPA.getMaxPenetrationDepth() < overlapEPA + decimal(0.001));
+                    if (callbackEPA.contactNormals.size() == 1) {
+                        rp3d_test(approxEqual(callbackEPA.penetrationDepths[0], overlapEPA, decimal(0.001)));
+                    }
+                    if (isOverlapSAT) {
+                        const decimal overlapSAT = computeOverlapAlongAxis(transform1, scale1, transform2, scale2, callbackSAT.contactNormals[0]);
+                        rp3d_test(overlapEPA < overlapSAT + decimal(0.001));
+                    }
+
+                    // The two points of a contact are separated by the penetration depth along the normal
+                    for (uint32 c = 0; c < callbackEPA.contactNormals.size(); c++) {
+                        rp3d_test(approxEqual(callbackEPA.contactNormals[c].length(), decimal(1.0), decimal(0.0001)));
+                        rp3d_test(callbackEPA.penetrationDepths[c] > decimal(0.0));
+                        rp3d_test(approxEqual(callbackEPA.contactPoints1[c], callbackEPA.contactPoints2[c] + callbackEPA.contactNormals[c] * callbackEPA.penetrationDepths[c],
+                                              decimal(0.001)));
+                    }
+                }
+            }
+
+            // Make sure that the random configurations test both cases
+            rp3d_test(nbOverlaps > 10 && nbOverlaps < 190);
+
+            mPhysicsCommon.destroyPhysicsWorld(worldEPA);
+            mPhysicsCommon.destroyPhysicsWorld(worldSAT);
+            mPhysicsCommon.destroyConvexMeshShape(prismShape1);
+            mPhysicsCommon.destroyConvexMeshShape(prismShape2);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,264 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_GJK_ALGORITHM_H
+#define TEST_GJK_ALGORITHM_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
+#include <reactphysics3d/collision/shapes/SphereShape.h>
+#include <reactphysics3d/collision/shapes/CapsuleShape.h>
+#include <reactphysics3d/collision/shapes/BoxShape.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/collision/HalfEdgeStructure.h>
+#include <reactphysics3d/collision/ContactPointInfo.h>
+#include <reactphysics3d/components/ColliderComponents.h>
+#include <reactphysics3d/components/CollisionBodyComponents.h>
+#include <reactphysics3d/components/RigidBodyComponents.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <reactphysics3d/engine/PhysicsCommon.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+/// Triangle shape that can be created outside of the middle-phase collision detection
+class GJKTestTriangleShape : public TriangleShape {
+
+    public:
+
+        /// Constructor
+        GJKTestTriangleShape(const Vector3* vertices, const Vector3* verticesNormals,
+                             HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator)
+            : TriangleShape(vertices, verticesNormals, 0, 0, triangleHalfEdgeStructure, allocator) {
+
+        }
+};
+
+// Class TestGJKAlgorithm
+/**
+ * Unit test for the GJK narrow-phase collision detection algorithm
+ */
+class TestGJKAlgorithm : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mBaseAllocator;
+
+        MemoryManager mMemoryManager;
+
+        PhysicsCommon mPhysicsCommon;
+
+        SphereShape* mSphereShape;
+        CapsuleShape* mCapsuleShape;
+        BoxShape* mBoxShape;
+
+        /// Half-edge structure of the triangles (not used by the GJK algorithm)
+        HalfEdgeStructure mTriangleHalfEdgeStructure;
+
+        // Overlapping pairs (only needed to create the narrow-phase batches)
+        ColliderComponents mColliderComponents;
+        CollisionBodyComponents mCollisionBodyComponents;
+        RigidBodyComponents mRigidBodyComponents;
+        FlatSet<bodypair> mNoCollisionPairs;
+        CollisionDispatch mCollisionDispatch;
+        OverlappingPairs mOverlappingPairs;
+
+        GJKAlgorithm mGJKAlgorithm;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        Profiler* mProfiler;
+#endif
+
+        enum class ShapeType {Sphere, Capsule, Box, Triangle};
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestGJKAlgorithm(const std::string& name)
+            : Test(name), mMemoryManager(&mBaseAllocator),
+              mTriangleHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 2, 3, 6),
+              mColliderComponents(mMemoryManager.getHeapAllocator()), mCollisionBodyComponents(mMemoryManager.getHeapAllocator()),
+              mRigidBodyComponents(mMemoryManager.getHeapAllocator()), mNoCollisionPairs(mMemoryManager.getHeapAllocator()),
+              mCollisionDispatch(mMemoryManager.getPoolAllocator()),
+              mOverlappingPairs(mMemoryManager, mColliderComponents, mCollisionBodyComponents, mRigidBodyComponents,
+                                mNoCollisionPairs, mCollisionDispatch) {
+
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(1.0));
+            mCapsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.5), decimal(2.0));
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(1, decimal(0.5), decimal(0.75)));
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            mProfiler = new Profiler();
+            mGJKAlgorithm.setProfiler(mProfiler);
+#endif
+
+        }
+
+        /// Destructor
+        virtual ~TestGJKAlgorithm() {
+
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+            mPhysicsCommon.destroyCapsuleShape(mCapsuleShape);
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            delete mProfiler;
+#endif
+
+        }
+
+        /// Return a shape of a given type to test. A new triangle is allocated each time
+        /// because the narrow-phase batch releases its triangles when it is cleared.
+        CollisionShape* createShape(ShapeType type) {
+
+            switch (type) {
+                case ShapeType::Sphere: return mSphereShape;
+                case ShapeType::Capsule: return mCapsuleShape;
+                case ShapeType::Box: return mBoxShape;
+                case ShapeType::Triangle: {
+
+                    const Vector3 vertices[3] = {Vector3(-2, 0, -2), Vector3(2, 0, -2), Vector3(0, 0, 2)};
+                    const Vector3 normals[3] = {Vector3(0, 1, 0), Vector3(0, 1, 0), Vector3(0, 1, 0)};
+
+                    // The batch releases the memory of a triangle using the size of a TriangleShape
+                    void* allocatedMemory = mMemoryManager.getHeapAllocator().allocate(sizeof(TriangleShape));
+                    return new (allocatedMemory) GJKTestTriangleShape(vertices, normals, mTriangleHalfEdgeStructure,
+                                                                      mMemoryManager.getHeapAllocator());
+                }
+            }
+
+            return nullptr;
+        }
+
+        /// Run the tests
+        void run() {
+            testSpecializedKernelsMatchGenericKernel();
+        }
+
+        void testSpecializedKernelsMatchGenericKernel() {
+
+            const ShapeType shapeTypes[4] = {ShapeType::Sphere, ShapeType::Capsule, ShapeType::Box, ShapeType::Triangle};
+
+            // Relative positions of the second shape (some are separated, some overlap only in
+            // the margins and some interpenetrate)
+            const Vector3 directions[6] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1), Vector3(1, 1, 0).getUnit(),
+                                           Vector3(decimal(0.3), -1, decimal(0.5)).getUnit(), Vector3(-1, decimal(0.2), decimal(0.7)).getUnit()};
+            const decimal distances[6] = {decimal(0.2), decimal(1.0), decimal(1.5), decimal(2.0), decimal(2.6), decimal(4.0)};
+            const uint32 nbConfigurations = 6 * 6;
+
+            const Transform transform1(Vector3(1, 2, 3), Quaternion::fromEulerAngles(decimal(0.3), decimal(0.2), decimal(0.1)));
+            const Quaternion orientation2 = Quaternion::fromEulerAngles(decimal(0.5), decimal(-0.4), decimal(0.9));
+
+            MemoryAllocator& allocator = mMemoryManager.getHeapAllocator();
+
+            uint32 nbSeparated = 0;
+            uint32 nbCollideInMargin = 0;
+            uint32 nbInterpenetrate = 0;
+
+            for (uint32 s1 = 0; s1 < 4; s1++) {
+                for (uint32 s2 = 0; s2 < 4; s2++) {
+
+                    // The GJK algorithm is only used when one of the shapes has a margin (sphere or capsule)
+                    if (shapeTypes[s1] != ShapeType::Sphere && shapeTypes[s1] != ShapeType::Capsule &&
+                        shapeTypes[s2] != ShapeType::Sphere && shapeTypes[s2] != ShapeType::Capsule) {
+                        continue;
+                    }
+
+                    NarrowPhaseInfoBatch batchSpecialized(mOverlappingPairs, allocator);
+                    NarrowPhaseInfoBatch batchGeneric(mOverlappingPairs, allocator);
+                    std::vector<LastFrameCollisionInfo> lastFrameInfosSpecialized(nbConfigurations);
+                    std::vector<LastFrameCollisionInfo> lastFrameInfosGeneric(nbConfigurations);
+
+                    for (uint32 d = 0; d < 6; d++) {
+                        for (uint32 i = 0; i < 6; i++) {
+
+                            const uint32 c = d * 6 + i;
+                            const Transform transform2(transform1.getPosition() + distances[i] * directions[d], orientation2);
+
+                            batchSpecialized.addNarrowPhaseInfo(c, Entity(0, 0), Entity(1, 0), createShape(shapeTypes[s1]), createShape(shapeTypes[s2]),
+                                                                transform1, transform2, true, &lastFrameInfosSpecialized[c], allocator);
+                            batchGeneric.addNarrowPhaseInfo(c, Entity(0, 0), Entity(1, 0), createShape(shapeTypes[s1]), createShape(shapeTypes[s2]),
+                                                            transform1, transform2, true, &lastFrameInfosGeneric[c], allocator);
+                        }
+                    }
+
+                    Array<GJKAlgorithm::GJKResult> resultsSpecialized(allocator);
+                    Array<GJKAlgorithm::GJKResult> resultsGeneric(allocator);
+                    mGJKAlgorithm.testCollision(batchSpecialized, 0, nbConfigurations, resultsSpecialized);
+                    mGJKAlgorithm.testCollisionGeneric(batchGeneric, 0, nbConfigurations, resultsGeneric);
+
+                    for (uint32 c = 0; c < nbConfigurations; c++) {
+
+                        rp3d_test(resultsSpecialized[c] == resultsGeneric[c]);
+
+                        const NarrowPhaseInfoBatch::NarrowPhaseInfo& infoSpecialized = batchSpecialized.narrowPhaseInfos[c];
+                        const NarrowPhaseInfoBatch::NarrowPhaseInfo& infoGeneric = batchGeneric.narrowPhaseInfos[c];
+                        rp3d_test(infoSpecialized.nbContactPoints == infoGeneric.nbContactPoints);
+
+                        for (uint32 p = 0; p < infoSpecialized.nbContactPoints && p < infoGeneric.nbContactPoints; p++) {
+                            const ContactPointInfo& pointSpecialized = infoSpecialized.contactPoints[p];
+                            const ContactPointInfo& pointGeneric = infoGeneric.contactPoints[p];
+                            rp3d_test(approxEqual(pointSpecialized.normal, pointGeneric.normal, decimal(0.00001)));
+                            rp3d_test(approxEqual(pointSpecialized.penetrationDepth, pointGeneric.penetrationDepth, decimal(0.00001)));
+                            rp3d_test(approxEqual(pointSpecialized.localPoint1, pointGeneric.localPoint1, decimal(0.00001)));
+                            rp3d_test(approxEqual(pointSpecialized.localPoint2, pointGeneric.localPoint2, decimal(0.00001)));
+                        }
+
+                        switch (resultsSpecialized[c]) {
+                            case GJKAlgorithm::GJKResult::SEPARATED: nbSeparated++; break;
+                            case GJKAlgorithm::GJKResult::COLLIDE_IN_MARGIN: nbCollideInMargin++; break;
+                            case GJKAlgorithm::GJKResult::INTERPENETRATE: nbInterpenetrate++; break;
+                        }
+
+                        batchSpecialized.resetContactPoints(c);
+                        batchGeneric.resetContactPoints(c);
+                    }
+                }
+            }
+
+            // Make sure that the configurations cover all the results of the algorithm
+            rp3d_test(nbSeparated > 0);
+            rp3d_test(nbCollideInMargin > 0);
+            rp3d_test(nbInterpenetrate > 0);
+        }
+};
+
+}
+
+#endif
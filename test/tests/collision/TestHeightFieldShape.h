@@ -0,0 +1,717 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_HEIGHT_FIELD_SHAPE_H
+#define TEST_HEIGHT_FIELD_SHAPE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/collision/shapes/HeightFieldShape.h>
+#include <reactphysics3d/engine/PhysicsCommon.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <cstring>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestHeightFieldShape
+/**
+ * Unit test for the HeightFieldShape class
+ */
+class TestHeightFieldShape : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        MemoryManager mMemoryManager;
+
+        static const int NB_COLUMNS = 12;
+        static const int NB_ROWS = 9;
+
+        std::vector<float> mFloatHeights;
+        std::vector<double> mDoubleHeights;
+        std::vector<int> mIntHeights;
+        std::vector<uint16> mUint16Heights;
+        std::vector<HeightFieldHalf> mHalfHeights;
+
+        HeightFieldShape* mFloatHeightField;
+        HeightFieldShape* mDoubleHeightField;
+        HeightFieldShape* mIntHeightField;
+        HeightFieldShape* mUint16HeightField;
+        HeightFieldShape* mHalfHeightField;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        Profiler* mProfiler;
+#endif
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestHeightFieldShape(const std::string& name) : Test(name), mMemoryManager(nullptr, 0) {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            mProfiler = new Profiler();
+#endif
+
+            for (int j = 0; j < NB_ROWS; j++) {
+                for (int i = 0; i < NB_COLUMNS; i++) {
+                    const int height = (i * 7 + j * 3) % 11;
+                    mFloatHeights.push_back(float(height));
+                    mDoubleHeights.push_back(double(height));
+                    mIntHeights.push_back(height * 2);
+                    mUint16Heights.push_back(uint16(height * 6553));
+                    mHalfHeights.push_back(toHalf(float(height)));
+                }
+            }
+
+            mFloatHeightField = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(mFloatHeights[0]),
+                                                                      HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE));
+            mDoubleHeightField = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(mDoubleHeights[0]),
+                                                                       HeightFieldShape::HeightDataType::HEIGHT_DOUBLE_TYPE));
+            mIntHeightField = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(mIntHeights[0]),
+                                                                    HeightFieldShape::HeightDataType::HEIGHT_INT_TYPE, 1,
+                                                                    decimal(0.5)));
+            mUint16HeightField = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(mUint16Heights[0]),
+                                                                       HeightFieldShape::HeightDataType::HEIGHT_UINT16_TYPE));
+            mHalfHeightField = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(mHalfHeights[0]),
+                                                                     HeightFieldShape::HeightDataType::HEIGHT_HALF_TYPE));
+        }
+
+        /// Destructor
+        ~TestHeightFieldShape() {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            delete mProfiler;
+#endif
+        }
+
+        /// Set the profiler of a height field shape that is used outside of a physics world
+        HeightFieldShape* withProfiler(HeightFieldShape* shape) {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            if (shape != nullptr) {
+                shape->setProfiler(mProfiler);
+            }
+#endif
+            return shape;
+        }
+
+        /// Return the half-precision representation of a float value (normal numbers and zero only)
+        static HeightFieldHalf toHalf(float value) {
+
+            uint32 bits;
+            std::memcpy(&bits, &value, sizeof(float));
+
+            HeightFieldHalf half;
+            const uint32 exponent = (bits >> 23) & 0xffu;
+            half.bits = uint16((bits >> 16) & 0x8000u);
+            if (exponent != 0) {
+                half.bits = uint16(half.bits | ((exponent - 112u) << 10) | ((bits >> 13) & 0x3ffu));
+            }
+            return half;
+        }
+
+        /// Run the tests
+        void run() {
+
+            testOverlappingTriangles();
+            testVerticesNormalsCache();
+            testHeightsPyramid();
+            testUpdateHeights();
+            testTiledHeightField();
+            testSixteenBitsHeights();
+        }
+
+        /// Return the smallest hit fraction of a ray with a triangle (both sides) or a negative value if there is no hit
+        static decimal raycastTriangle(const Ray& ray, const Vector3& p1, const Vector3& p2, const Vector3& p3) {
+
+            const Vector3 direction = ray.point2 - ray.point1;
+            const Vector3 edge1 = p2 - p1;
+            const Vector3 edge2 = p3 - p1;
+            const Vector3 p = direction.cross(edge2);
+            const decimal det = edge1.dot(p);
+            if (std::abs(det) < MACHINE_EPSILON) return decimal(-1.0);
+            const Vector3 s = ray.point1 - p1;
+            const decimal u = s.dot(p) / det;
+            if (u < decimal(0.0) || u > decimal(1.0)) return decimal(-1.0);
+            const Vector3 q = s.cross(edge1);
+            const decimal v = direction.dot(q) / det;
+            if (v < decimal(0.0) || u + v > decimal(1.0)) return decimal(-1.0);
+            const decimal t = edge2.dot(q) / det;
+            return (t >= decimal(0.0) && t <= ray.maxFraction) ? t : decimal(-1.0);
+        }
+
+        /// Return true if a vertex returned by a query is the grid vertex (i, j)
+        bool isGridVertex(const HeightFieldShape* shape, const Vector3& vertex, int i, int j) const {
+            return approxEqual(vertex, shape->getVertexAt(i, j), decimal(0.0001));
+        }
+
+        /// Compute the area-weighted average of the normals of the triangles sharing the grid vertex (i, j)
+        Vector3 computeSmoothNormal(const HeightFieldShape* shape, int i, int j) const {
+
+            Vector3 normal(0, 0, 0);
+            const Vector3 vertex = shape->getVertexAt(i, j);
+            for (int y = 0; y < NB_ROWS - 1; y++) {
+                for (int x = 0; x < NB_COLUMNS - 1; x++) {
+                    const Vector3 p1 = shape->getVertexAt(x, y);
+                    const Vector3 p2 = shape->getVertexAt(x, y + 1);
+                    const Vector3 p3 = shape->getVertexAt(x + 1, y);
+                    const Vector3 p4 = shape->getVertexAt(x + 1, y + 1);
+                    if (vertex == p1 || vertex == p2 || vertex == p3) normal += (p2 - p1).cross(p3 - p1);
+                    if (vertex == p3 || vertex == p2 || vertex == p4) normal += (p2 - p3).cross(p4 - p3);
+                }
+            }
+
+            return normal.getUnit();
+        }
+
+        /// Check that the triangles of a query are the two triangles of each quad of the whole grid
+        void checkAllTriangles(const HeightFieldShape* shape) {
+
+            Array<Vector3> vertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> normals(mMemoryManager.getHeapAllocator());
+            Array<uint32> shapeIds(mMemoryManager.getHeapAllocator());
+            Array<uint8> internalEdges(mMemoryManager.getHeapAllocator());
+
+            Vector3 min, max;
+            shape->getLocalBounds(min, max);
+            shape->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges,
+                                               mMemoryManager.getHeapAllocator());
+
+            const uint64 nbTriangles = 2 * (NB_COLUMNS - 1) * (NB_ROWS - 1);
+            rp3d_test(shapeIds.size() == nbTriangles);
+            rp3d_test(vertices.size() == 3 * nbTriangles);
+            rp3d_test(normals.size() == 3 * nbTriangles);
+
+            // Each quad must appear once with its two triangles
+            std::vector<int> nbFoundTriangles((NB_COLUMNS - 1) * (NB_ROWS - 1), 0);
+            for (uint64 t = 0; t < vertices.size(); t += 6) {
+
+                bool isFound = false;
+                for (int j = 0; j < NB_ROWS - 1 && !isFound; j++) {
+                    for (int i = 0; i < NB_COLUMNS - 1 && !isFound; i++) {
+                        if (isGridVertex(shape, vertices[t], i, j) && isGridVertex(shape, vertices[t + 1], i, j + 1) &&
+                            isGridVertex(shape, vertices[t + 2], i + 1, j) && isGridVertex(shape, vertices[t + 3], i + 1, j) &&
+                            isGridVertex(shape, vertices[t + 4], i, j + 1) && isGridVertex(shape, vertices[t + 5], i + 1, j + 1)) {
+                            nbFoundTriangles[j * (NB_COLUMNS - 1) + i]++;
+                            isFound = true;
+                        }
+                    }
+                }
+                rp3d_test(isFound);
+            }
+            for (size_t q = 0; q < nbFoundTriangles.size(); q++) {
+                rp3d_test(nbFoundTriangles[q] == 1);
+            }
+
+            // The normals must be unit vectors pointing upward
+            for (uint64 n = 0; n < normals.size(); n++) {
+                rp3d_test(approxEqual(normals[n].length(), decimal(1.0), decimal(0.0001)));
+                rp3d_test(normals[n].y > decimal(0.0));
+            }
+        }
+
+        void testOverlappingTriangles() {
+
+            checkAllTriangles(mFloatHeightField);
+            checkAllTriangles(mDoubleHeightField);
+            checkAllTriangles(mIntHeightField);
+
+            rp3d_test(approxEqual(mIntHeightField->getHeightAt(3, 2), decimal(mIntHeights[2 * NB_COLUMNS + 3]) * decimal(0.5)));
+            rp3d_test(approxEqual(mDoubleHeightField->getHeightAt(5, 7), decimal(mDoubleHeights[7 * NB_COLUMNS + 5])));
+
+            // Query a small part of the grid
+            Array<Vector3> vertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> normals(mMemoryManager.getHeapAllocator());
+            Array<uint32> shapeIds(mMemoryManager.getHeapAllocator());
+            Array<uint8> internalEdges(mMemoryManager.getHeapAllocator());
+            const Vector3 center = mFloatHeightField->getVertexAt(5, 4);
+            mFloatHeightField->computeOverlappingTriangles(AABB(center - Vector3(0.2, 20, 0.2), center + Vector3(0.2, 20, 0.2)),
+                                                           vertices, normals, shapeIds, internalEdges,
+                                                           mMemoryManager.getHeapAllocator());
+            rp3d_test(shapeIds.size() > 0);
+            rp3d_test(shapeIds.size() < 2 * (NB_COLUMNS - 1) * (NB_ROWS - 1));
+            rp3d_test(vertices.size() == 3 * shapeIds.size());
+        }
+
+        void testSixteenBitsHeights() {
+
+            checkAllTriangles(mUint16HeightField);
+            checkAllTriangles(mHalfHeightField);
+
+            // The height values must be the same as with the float height values
+            for (int j = 0; j < NB_ROWS; j++) {
+                for (int i = 0; i < NB_COLUMNS; i++) {
+                    rp3d_test(approxEqual(mUint16HeightField->getHeightAt(i, j), mFloatHeightField->getHeightAt(i, j), decimal(0.001)));
+                    rp3d_test(approxEqual(mHalfHeightField->getHeightAt(i, j), mFloatHeightField->getHeightAt(i, j)));
+                }
+            }
+
+            // The quantized values are distributed between the min and max heights
+            std::vector<uint16> quantizedHeights = {0, 65535, 32768, 1};
+            HeightFieldShape* quantizedShape = withProfiler(mPhysicsCommon.createHeightFieldShape(2, 2, -4, 12, &(quantizedHeights[0]),
+                                                                                     HeightFieldShape::HeightDataType::HEIGHT_UINT16_TYPE));
+            rp3d_test(approxEqual(quantizedShape->getHeightAt(0, 0), decimal(-4.0)));
+            rp3d_test(approxEqual(quantizedShape->getHeightAt(1, 0), decimal(12.0)));
+            rp3d_test(approxEqual(quantizedShape->getHeightAt(0, 1), decimal(-4.0 + 32768.0 * 16.0 / 65535.0)));
+            rp3d_test(approxEqual(quantizedShape->getHeightAt(1, 1), decimal(-4.0 + 16.0 / 65535.0), decimal(0.0000001)));
+            mPhysicsCommon.destroyHeightFieldShape(quantizedShape);
+
+            // Special half-precision values (negative, largest, smallest normal and denormal numbers)
+            std::vector<HeightFieldHalf> halfHeights = {{0xb800}, {0x7bff}, {0x0400}, {0x0001}};
+            HeightFieldShape* halfShape = withProfiler(mPhysicsCommon.createHeightFieldShape(2, 2, -1, 65504, &(halfHeights[0]),
+                                                                                HeightFieldShape::HeightDataType::HEIGHT_HALF_TYPE));
+            rp3d_test(approxEqual(halfShape->getHeightAt(0, 0), decimal(-0.5)));
+            rp3d_test(approxEqual(halfShape->getHeightAt(1, 0), decimal(65504.0)));
+            rp3d_test(approxEqual(halfShape->getHeightAt(0, 1), decimal(6.103515625e-05), decimal(1e-12)));
+            rp3d_test(approxEqual(halfShape->getHeightAt(1, 1), decimal(5.9604644775390625e-08), decimal(1e-14)));
+            mPhysicsCommon.destroyHeightFieldShape(halfShape);
+
+            // Tiled height field with half-precision values
+            std::vector<HeightFieldHalf> tileHeights;
+            for (int k = 0; k < 25; k++) {
+                tileHeights.push_back(toHalf(float(k % 7) * 0.25f));
+            }
+            HeightFieldShape* tiledShape = withProfiler(mPhysicsCommon.createTiledHeightFieldShape(5, 5, 4, 0, 2,
+                                                                                      HeightFieldShape::HeightDataType::HEIGHT_HALF_TYPE));
+            tiledShape->setTileData(0, 0, &(tileHeights[0]));
+            for (int k = 0; k < 25; k++) {
+                rp3d_test(approxEqual(tiledShape->getHeightAt(k % 5, k / 5), decimal(k % 7) * decimal(0.25)));
+            }
+            mPhysicsCommon.destroyHeightFieldShape(tiledShape);
+        }
+
+        void testHeightsPyramid() {
+
+            uint32 seed = 1234;
+            const auto random = [&seed](decimal min, decimal max) {
+                seed = seed * 1664525u + 1013904223u;
+                return min + (max - min) * decimal(seed >> 8) / decimal(1 << 24);
+            };
+
+            // Create a height field with a number of cells that is not a multiple of the blocks size
+            const int nbColumns = 38;
+            const int nbRows = 27;
+            std::vector<float> heights;
+            for (int j = 0; j < nbRows; j++) {
+                for (int i = 0; i < nbColumns; i++) {
+                    heights.push_back(float(random(0, 3) + ((i > 20 && j > 10) ? 15 : 0)));
+                }
+            }
+            HeightFieldShape* shape = withProfiler(mPhysicsCommon.createHeightFieldShape(nbColumns, nbRows, 0, 18, &(heights[0]),
+                                                                            HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE,
+                                                                            1, 1, Vector3(2, decimal(0.5), 3)));
+            shape->setRaycastTestType(TriangleRaycastSide::FRONT_AND_BACK);
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(Transform::identity());
+            Collider* collider = body->addCollider(shape, Transform::identity());
+
+            Vector3 min, max;
+            shape->getLocalBounds(min, max);
+
+            // Compare the raycasts with a brute-force raycast against all the triangles (the rays start above
+            // the height field because the triangle raycast also reports the hits behind the origin of the ray)
+            for (int r = 0; r < 500; r++) {
+
+                const Vector3 point1(random(min.x - 10, max.x + 10), random(max.y, max.y + 5), random(min.z - 10, max.z + 10));
+                const Vector3 point2 = (r % 5 == 0) ? Vector3(point1.x, min.y - 1, point1.z) :
+                                       Vector3(random(min.x, max.x), random(min.y, max.y), random(min.z, max.z));
+                const Ray ray(point1, point2, random(decimal(0.2), decimal(1.5)));
+
+                decimal expectedFraction = decimal(-1.0);
+                for (int j = 0; j < nbRows - 1; j++) {
+                    for (int i = 0; i < nbColumns - 1; i++) {
+                        const Vector3 p1 = shape->getVertexAt(i, j);
+                        const Vector3 p2 = shape->getVertexAt(i, j + 1);
+                        const Vector3 p3 = shape->getVertexAt(i + 1, j);
+                        const Vector3 p4 = shape->getVertexAt(i + 1, j + 1);
+                        for (decimal t : {raycastTriangle(ray, p1, p2, p3), raycastTriangle(ray, p3, p2, p4)}) {
+                            if (t >= decimal(0.0) && (expectedFraction < decimal(0.0) || t < expectedFraction)) {
+                                expectedFraction = t;
+                            }
+                        }
+                    }
+                }
+
+                RaycastInfo raycastInfo;
+                const bool isHit = collider->raycast(ray, raycastInfo);
+                rp3d_test(isHit == (expectedFraction >= decimal(0.0)));
+                if (isHit) {
+                    rp3d_test(approxEqual(raycastInfo.hitFraction, expectedFraction, decimal(0.0001)));
+                }
+            }
+
+            // Query an AABB above the terrain
+            Array<Vector3> vertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> normals(mMemoryManager.getHeapAllocator());
+            Array<uint32> shapeIds(mMemoryManager.getHeapAllocator());
+            Array<uint8> internalEdges(mMemoryManager.getHeapAllocator());
+            shape->computeOverlappingTriangles(AABB(Vector3(min.x, max.y + 1, min.z), Vector3(max.x, max.y + 2, max.z)),
+                                               vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+            rp3d_test(shapeIds.size() == 0);
+
+            // Query AABBs intersecting the terrain. All the triangles overlapping the AABB must be reported
+            for (int q = 0; q < 50; q++) {
+
+                const Vector3 center(random(min.x, max.x), random(min.y, max.y), random(min.z, max.z));
+                const Vector3 halfExtent(random(1, 8), random(decimal(0.1), 3), random(1, 8));
+                const AABB aabb(center - halfExtent, center + halfExtent);
+
+                vertices.clear();
+                normals.clear();
+                shapeIds.clear();
+                internalEdges.clear();
+                shape->computeOverlappingTriangles(aabb, vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+                rp3d_test(vertices.size() == 3 * shapeIds.size());
+
+                for (int j = 0; j < nbRows - 1; j++) {
+                    for (int i = 0; i < nbColumns - 1; i++) {
+
+                        const Vector3 p1 = shape->getVertexAt(i, j);
+                        const Vector3 p2 = shape->getVertexAt(i, j + 1);
+                        const Vector3 p3 = shape->getVertexAt(i + 1, j);
+                        const Vector3 p4 = shape->getVertexAt(i + 1, j + 1);
+                        const Vector3 triangle1[3] = {p1, p2, p3};
+                        const Vector3 triangle2[3] = {p3, p2, p4};
+                        if (!aabb.testCollision(AABB::createAABBForTriangle(triangle1)) &&
+                            !aabb.testCollision(AABB::createAABBForTriangle(triangle2))) {
+                            continue;
+                        }
+
+                        bool isFound = false;
+                        for (uint64 v = 0; v < vertices.size(); v += 3) {
+                            if (vertices[v] == p1 && vertices[v + 1] == p2 && vertices[v + 2] == p3) {
+                                isFound = true;
+                                break;
+                            }
+                        }
+                        rp3d_test(isFound);
+                    }
+                }
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyHeightFieldShape(shape);
+        }
+
+        /// Return the hit fraction of a vertical ray through the middle of a cell or -1 if there is no hit
+        static decimal raycastCell(Collider* collider, const HeightFieldShape* shape, int i, int j) {
+
+            const Vector3 center = (shape->getVertexAt(i, j) + shape->getVertexAt(i + 1, j + 1)) * decimal(0.5);
+            RaycastInfo raycastInfo;
+            if (collider->raycast(Ray(Vector3(center.x, 100, center.z), Vector3(center.x, -100, center.z)), raycastInfo)) {
+                return raycastInfo.hitFraction;
+            }
+            return decimal(-1.0);
+        }
+
+        void testUpdateHeights() {
+
+            std::vector<float> heights(NB_COLUMNS * NB_ROWS, 2.0f);
+            HeightFieldShape* shape = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(heights[0]),
+                                                                            HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE));
+            shape->setIsVerticesNormalsCacheEnabled(true);
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* terrainBody = world->createCollisionBody(Transform::identity());
+            Collider* terrainCollider = terrainBody->addCollider(shape, Transform::identity());
+
+            // Create a box resting on the terrain near the grid vertex (2, 2)
+            const Vector3 boxPosition = shape->getVertexAt(2, 2) + Vector3(0, decimal(0.45), 0);
+            RigidBody* box = world->createRigidBody(Transform(boxPosition, Quaternion::identity()));
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            box->addCollider(boxShape, Transform::identity());
+            world->update(decimal(1.0) / decimal(60.0));
+
+            const decimal initialFraction = raycastCell(terrainCollider, shape, 7, 5);
+
+            // Modify a region of the height field in place
+            for (int j = 4; j <= 7; j++) {
+                for (int i = 6; i <= 9; i++) {
+                    heights[j * NB_COLUMNS + i] = 8.0f;
+                }
+            }
+
+            // Modify another region far from the box
+            box->setIsSleeping(true);
+            shape->updateHeights(6, 4, 9, 7);
+            rp3d_test(box->isSleeping());
+
+            // The raycasts and the overlap queries must use the new height values
+            rp3d_test(raycastCell(terrainCollider, shape, 7, 5) < initialFraction);
+            rp3d_test(approxEqual(raycastCell(terrainCollider, shape, 7, 5), decimal(0.5) - decimal(3.0) / decimal(200.0), decimal(0.0001)));
+
+            Array<Vector3> vertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> normals(mMemoryManager.getHeapAllocator());
+            Array<uint32> shapeIds(mMemoryManager.getHeapAllocator());
+            Array<uint8> internalEdges(mMemoryManager.getHeapAllocator());
+            const Vector3 top = shape->getVertexAt(7, 5);
+            shape->computeOverlappingTriangles(AABB(top - Vector3(decimal(0.1), decimal(0.1), decimal(0.1)), top + Vector3(decimal(0.1), decimal(0.1), decimal(0.1))),
+                                               vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+            rp3d_test(shapeIds.size() > 0);
+
+            // The cached vertices normals must be the same as the normals of a new height field with the same heights
+            HeightFieldShape* referenceShape = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 10, &(heights[0]),
+                                                                                     HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE));
+            referenceShape->setIsVerticesNormalsCacheEnabled(true);
+            Array<Vector3> referenceVertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> referenceNormals(mMemoryManager.getHeapAllocator());
+            vertices.clear();
+            normals.clear();
+            shapeIds.clear();
+            internalEdges.clear();
+            Vector3 min, max;
+            shape->getLocalBounds(min, max);
+            shape->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+            shapeIds.clear();
+            internalEdges.clear();
+            referenceShape->computeOverlappingTriangles(AABB(min, max), referenceVertices, referenceNormals, shapeIds, internalEdges,
+                                                        mMemoryManager.getHeapAllocator());
+            rp3d_test(vertices.size() == referenceVertices.size());
+            for (uint64 v = 0; v < vertices.size(); v++) {
+                rp3d_test(approxEqual(vertices[v], referenceVertices[v], decimal(0.0001)));
+                rp3d_test(approxEqual(normals[v], referenceNormals[v], decimal(0.0001)));
+            }
+            mPhysicsCommon.destroyHeightFieldShape(referenceShape);
+
+            // Modify the region under the box: the box must be awakened
+            heights[2 * NB_COLUMNS + 2] = 1.0f;
+            shape->updateHeights(2, 2, 2, 2);
+            rp3d_test(!box->isSleeping());
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+            mPhysicsCommon.destroyHeightFieldShape(shape);
+        }
+
+        void testTiledHeightField() {
+
+            const int nbTileCells = 8;
+            const int nbTileColumns = 3;
+            const int nbTileRows = 2;
+            const int nbColumns = nbTileColumns * nbTileCells + 1;
+            const int nbRows = nbTileRows * nbTileCells + 1;
+
+            // Height values of the whole grid and of each tile
+            std::vector<int> heights(nbColumns * nbRows);
+            for (int j = 0; j < nbRows; j++) {
+                for (int i = 0; i < nbColumns; i++) {
+                    heights[j * nbColumns + i] = (i * 5 + j * 7) % 9;
+                }
+            }
+            std::vector<std::vector<int>> tilesHeights(nbTileColumns * nbTileRows);
+            for (int tileRow = 0; tileRow < nbTileRows; tileRow++) {
+                for (int tileColumn = 0; tileColumn < nbTileColumns; tileColumn++) {
+                    std::vector<int>& tileHeights = tilesHeights[tileRow * nbTileColumns + tileColumn];
+                    for (int y = 0; y <= nbTileCells; y++) {
+                        for (int x = 0; x <= nbTileCells; x++) {
+                            tileHeights.push_back(heights[(tileRow * nbTileCells + y) * nbColumns + tileColumn * nbTileCells + x]);
+                        }
+                    }
+                }
+            }
+
+            rp3d_test(withProfiler(mPhysicsCommon.createTiledHeightFieldShape(nbColumns, nbRows, 6, 0, 10,
+                                                                 HeightFieldShape::HeightDataType::HEIGHT_INT_TYPE)) == nullptr);
+
+            HeightFieldShape* shape = withProfiler(mPhysicsCommon.createTiledHeightFieldShape(nbColumns, nbRows, nbTileCells, 0, 10,
+                                                                                 HeightFieldShape::HeightDataType::HEIGHT_INT_TYPE));
+            HeightFieldShape* referenceShape = withProfiler(mPhysicsCommon.createHeightFieldShape(nbColumns, nbRows, 0, 10, &(heights[0]),
+                                                                                     HeightFieldShape::HeightDataType::HEIGHT_INT_TYPE));
+            rp3d_test(shape->isTiled());
+            rp3d_test(!referenceShape->isTiled());
+            rp3d_test(shape->getNbTileColumns() == nbTileColumns);
+            rp3d_test(shape->getNbTileRows() == nbTileRows);
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(Transform::identity());
+            Collider* collider = body->addCollider(shape, Transform::identity());
+            Collider* referenceCollider = body->addCollider(referenceShape, Transform(Vector3(0, 0, 0), Quaternion::identity()));
+            referenceCollider->setCollisionCategoryBits(0x0002);
+
+            Vector3 min, max;
+            shape->getLocalBounds(min, max);
+            Array<Vector3> vertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> normals(mMemoryManager.getHeapAllocator());
+            Array<uint32> shapeIds(mMemoryManager.getHeapAllocator());
+            Array<uint8> internalEdges(mMemoryManager.getHeapAllocator());
+
+            // No tile is loaded
+            rp3d_test(raycastCell(collider, shape, 3, 3) < decimal(0.0));
+            shape->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+            rp3d_test(shapeIds.size() == 0);
+
+            // Load all the tiles
+            for (int tileRow = 0; tileRow < nbTileRows; tileRow++) {
+                for (int tileColumn = 0; tileColumn < nbTileColumns; tileColumn++) {
+                    shape->setTileData(tileColumn, tileRow, &(tilesHeights[tileRow * nbTileColumns + tileColumn][0]));
+                }
+            }
+
+            for (int j = 0; j < nbRows; j++) {
+                for (int i = 0; i < nbColumns; i++) {
+                    rp3d_test(approxEqual(shape->getHeightAt(i, j), referenceShape->getHeightAt(i, j)));
+                }
+            }
+
+            Array<Vector3> referenceVertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> referenceNormals(mMemoryManager.getHeapAllocator());
+            shape->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+            referenceShape->computeOverlappingTriangles(AABB(min, max), referenceVertices, referenceNormals, shapeIds, internalEdges,
+                                                        mMemoryManager.getHeapAllocator());
+            rp3d_test(vertices.size() == referenceVertices.size());
+            for (uint64 v = 0; v < vertices.size(); v++) {
+                rp3d_test(approxEqual(vertices[v], referenceVertices[v], decimal(0.0001)));
+            }
+
+            for (int j = 0; j < nbRows - 1; j++) {
+                for (int i = 0; i < nbColumns - 1; i++) {
+                    rp3d_test(approxEqual(raycastCell(collider, shape, i, j), raycastCell(referenceCollider, referenceShape, i, j), decimal(0.0001)));
+                }
+            }
+
+            // Unload the tile in the middle of the first row of tiles
+            shape->setTileData(1, 0, nullptr);
+            rp3d_test(shape->getTileData(1, 0) == nullptr);
+            for (int j = 0; j < nbRows - 1; j++) {
+                for (int i = 0; i < nbColumns - 1; i++) {
+                    const bool isInUnloadedTile = i / nbTileCells == 1 && j / nbTileCells == 0;
+                    if (isInUnloadedTile) {
+                        rp3d_test(raycastCell(collider, shape, i, j) < decimal(0.0));
+                    }
+                    else {
+                        rp3d_test(approxEqual(raycastCell(collider, shape, i, j), raycastCell(referenceCollider, referenceShape, i, j), decimal(0.0001)));
+                    }
+                }
+            }
+
+            // The height values of the border vertices of the unloaded tile are read in the neighbor tiles
+            rp3d_test(approxEqual(shape->getHeightAt(nbTileCells, 3), referenceShape->getHeightAt(nbTileCells, 3)));
+            rp3d_test(approxEqual(shape->getHeightAt(2 * nbTileCells, 5), referenceShape->getHeightAt(2 * nbTileCells, 5)));
+            rp3d_test(approxEqual(shape->getHeightAt(12, nbTileCells), referenceShape->getHeightAt(12, nbTileCells)));
+
+            vertices.clear();
+            normals.clear();
+            shapeIds.clear();
+            internalEdges.clear();
+            shape->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges, mMemoryManager.getHeapAllocator());
+            rp3d_test(shapeIds.size() == static_cast<uint64>(2 * ((nbColumns - 1) * (nbRows - 1) - nbTileCells * nbTileCells)));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyHeightFieldShape(shape);
+            mPhysicsCommon.destroyHeightFieldShape(referenceShape);
+        }
+
+        void testVerticesNormalsCache() {
+
+            rp3d_test(!mFloatHeightField->isVerticesNormalsCacheEnabled());
+            mFloatHeightField->setIsVerticesNormalsCacheEnabled(true);
+            rp3d_test(mFloatHeightField->isVerticesNormalsCacheEnabled());
+
+            checkAllTriangles(mFloatHeightField);
+
+            Array<Vector3> vertices(mMemoryManager.getHeapAllocator());
+            Array<Vector3> normals(mMemoryManager.getHeapAllocator());
+            Array<uint32> shapeIds(mMemoryManager.getHeapAllocator());
+            Array<uint8> internalEdges(mMemoryManager.getHeapAllocator());
+
+            // The normal of a vertex must be the same in all the triangles sharing this vertex
+            Vector3 min, max;
+            mFloatHeightField->getLocalBounds(min, max);
+            mFloatHeightField->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges,
+                                                           mMemoryManager.getHeapAllocator());
+            for (uint64 a = 0; a < vertices.size(); a++) {
+                for (uint64 b = a + 1; b < vertices.size(); b++) {
+                    if (approxEqual(vertices[a], vertices[b], decimal(0.0001))) {
+                        rp3d_test(approxEqual(normals[a], normals[b], decimal(0.0001)));
+                    }
+                }
+            }
+
+            // Flat height field: the vertices normals are the up axis (with a non-uniform scaling)
+            std::vector<float> flatHeights(NB_COLUMNS * NB_ROWS, 3.0f);
+            HeightFieldShape* flatHeightField = withProfiler(mPhysicsCommon.createHeightFieldShape(NB_COLUMNS, NB_ROWS, 0, 5, &(flatHeights[0]),
+                                                                  HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE, 1, 1,
+                                                                  Vector3(2, 3, 4)));
+            flatHeightField->setIsVerticesNormalsCacheEnabled(true);
+            vertices.clear();
+            normals.clear();
+            shapeIds.clear();
+            internalEdges.clear();
+            flatHeightField->getLocalBounds(min, max);
+            flatHeightField->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges,
+                                                         mMemoryManager.getHeapAllocator());
+            rp3d_test(normals.size() == 6 * (NB_COLUMNS - 1) * (NB_ROWS - 1));
+            for (uint64 n = 0; n < normals.size(); n++) {
+                rp3d_test(approxEqual(normals[n], Vector3(0, 1, 0), decimal(0.0001)));
+            }
+            mPhysicsCommon.destroyHeightFieldShape(flatHeightField);
+
+            // With a non-uniform scaling, the cached normals must be the smooth normals of the scaled vertices
+            mFloatHeightField->setScale(Vector3(1, 2, 3));
+            vertices.clear();
+            normals.clear();
+            shapeIds.clear();
+            internalEdges.clear();
+            mFloatHeightField->getLocalBounds(min, max);
+            mFloatHeightField->computeOverlappingTriangles(AABB(min, max), vertices, normals, shapeIds, internalEdges,
+                                                           mMemoryManager.getHeapAllocator());
+            int nbCheckedVertices = 0;
+            for (int j = 0; j < NB_ROWS; j++) {
+                for (int i = 0; i < NB_COLUMNS; i++) {
+                    const Vector3 vertex = mFloatHeightField->getVertexAt(i, j);
+                    const Vector3 expectedNormal = computeSmoothNormal(mFloatHeightField, i, j);
+                    for (uint64 a = 0; a < vertices.size(); a++) {
+                        if (approxEqual(vertices[a], vertex, decimal(0.0001))) {
+                            rp3d_test(approxEqual(normals[a], expectedNormal, decimal(0.0001)));
+                            nbCheckedVertices++;
+                        }
+                    }
+                }
+            }
+            rp3d_test(nbCheckedVertices == static_cast<int>(vertices.size()));
+            mFloatHeightField->setScale(Vector3(1, 1, 1));
+
+            mFloatHeightField->setIsVerticesNormalsCacheEnabled(false);
+            rp3d_test(!mFloatHeightField->isVerticesNormalsCacheEnabled());
+            checkAllTriangles(mFloatHeightField);
+        }
+};
+
+}
+
+#endif
@@ -38,6 +38,7 @@
 #include <reactphysics3d/collision/shapes/TriangleShape.h>
 #include <reactphysics3d/collision/shapes/ConcaveMeshShape.h>
 #include <reactphysics3d/collision/shapes/HeightFieldShape.h>
+#include <reactphysics3d/collision/broadphase/StaticAABBTree.h>
 #include <reactphysics3d/collision/TriangleMesh.h>
 #include <reactphysics3d/collision/TriangleVertexArray.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
@@ -326,6 +327,7 @@ class TestRaycast : public Test {
             testConvexMesh();
             testCompound();
             testConcaveMesh();
+            testConcaveMeshBVHData();
             testHeightField();
         }
 
@@ -1569,6 +1571,81 @@ class TestRaycast : public Test {
             rp3d_test(mCallback.isHit);
         }
 
+        /// Test the creation of a concave mesh shape using serialized BVH data
+        void testConcaveMeshBVHData() {
+
+            // Serialize the BVH of the concave mesh (use 64-bits integers for memory alignment)
+            const size_t bvhDataSize = mConcaveMeshShape->getBVHDataSize();
+            rp3d_test(mConcaveMeshShape->writeBVHData(nullptr, bvhDataSize) == 0);
+            std::vector<uint64> bvhData(bvhDataSize / sizeof(uint64) + 1);
+            rp3d_test(mConcaveMeshShape->writeBVHData(bvhData.data(), bvhDataSize - 1) == 0);
+            rp3d_test(mConcaveMeshShape->writeBVHData(bvhData.data(), bvhDataSize) == bvhDataSize);
+
+            // Create a concave mesh shape using the BVH data
+            ConcaveMeshShape* shape = mPhysicsCommon.createConcaveMeshShape(mConcaveTriangleMesh, bvhData.data(), bvhDataSize);
+
+            Vector3 min1, max1, min2, max2;
+            mConcaveMeshShape->getLocalBounds(min1, max1);
+            shape->getLocalBounds(min2, max2);
+            rp3d_test(min1 == min2);
+            rp3d_test(max1 == max2);
+
+            // BVH data with nodes that reference an invalid triangle or an invalid child node
+            const int32 nbNodes = static_cast<int32>(2 * mConcaveTriangleMesh->getNbTriangles() - 1);
+            const size_t nodesOffset = bvhDataSize - static_cast<size_t>(nbNodes) * sizeof(QuantizedTreeNode);
+            const int32 nbTriangles = static_cast<int32>(mConcaveTriangleMesh->getNbTriangles());
+            rp3d_test(StaticAABBTree::areNodesValid(reinterpret_cast<uint8*>(bvhData.data()) + nodesOffset, nbNodes, nbTriangles));
+            std::vector<uint64> invalidLeafBVHData(bvhData);
+            QuantizedTreeNode* invalidLeafNodes = reinterpret_cast<QuantizedTreeNode*>(reinterpret_cast<uint8*>(invalidLeafBVHData.data()) + nodesOffset);
+            rp3d_test(invalidLeafNodes[nbNodes - 1].isLeaf());
+            invalidLeafNodes[nbNodes - 1].rightChildOrData = -nbTriangles - 1;
+            rp3d_test(!StaticAABBTree::areNodesValid(invalidLeafNodes, nbNodes, nbTriangles));
+            std::vector<uint64> invalidChildBVHData(bvhData);
+            QuantizedTreeNode* invalidChildNodes = reinterpret_cast<QuantizedTreeNode*>(reinterpret_cast<uint8*>(invalidChildBVHData.data()) + nodesOffset);
+            rp3d_test(!invalidChildNodes[0].isLeaf());
+            invalidChildNodes[0].rightChildOrData = 0;
+            rp3d_test(!StaticAABBTree::areNodesValid(invalidChildNodes, nbNodes, nbTriangles));
+
+            // Create a shape with invalid BVH data (the BVH is built instead)
+            ConcaveMeshShape* shape2 = mPhysicsCommon.createConcaveMeshShape(mConcaveTriangleMesh, bvhData.data(), bvhDataSize / 2);
+            ConcaveMeshShape* shape3 = mPhysicsCommon.createConcaveMeshShape(mConcaveTriangleMesh, invalidLeafBVHData.data(), bvhDataSize);
+            ConcaveMeshShape* shape4 = mPhysicsCommon.createConcaveMeshShape(mConcaveTriangleMesh, invalidChildBVHData.data(), bvhDataSize);
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            CollisionBody* body = world->createCollisionBody(mBodyTransform);
+            Collider* collider = body->addCollider(shape, mShapeTransform);
+            CollisionBody* body2 = world->createCollisionBody(mBodyTransform);
+            Collider* collider2 = body2->addCollider(shape2, mShapeTransform);
+            CollisionBody* body3 = world->createCollisionBody(mBodyTransform);
+            Collider* collider3 = body3->addCollider(shape3, mShapeTransform);
+            CollisionBody* body4 = world->createCollisionBody(mBodyTransform);
+            Collider* collider4 = body4->addCollider(shape4, mShapeTransform);
+
+            Vector3 point1 = mLocalShapeToWorld * Vector3(1 , 2, 6);
+            Vector3 point2 = mLocalShapeToWorld * Vector3(1, 2, -4);
+            Ray ray(point1, point2);
+            Vector3 hitPoint = mLocalShapeToWorld * Vector3(1, 2, 4);
+
+            for (Collider* testedCollider : {collider, collider2, collider3, collider4}) {
+
+                RaycastInfo raycastInfo;
+                rp3d_test(testedCollider->raycast(ray, raycastInfo));
+                rp3d_test(approxEqual(raycastInfo.hitFraction, decimal(0.2), epsilon));
+                rp3d_test(approxEqual(raycastInfo.worldPoint.x, hitPoint.x, epsilon));
+                rp3d_test(approxEqual(raycastInfo.worldPoint.y, hitPoint.y, epsilon));
+                rp3d_test(approxEqual(raycastInfo.worldPoint.z, hitPoint.z, epsilon));
+
+                Ray rayMiss(mLocalShapeToWorld * Vector3(5, 2, 6), mLocalShapeToWorld * Vector3(5, 2, -4));
+                rp3d_test(!testedCollider->raycast(rayMiss, raycastInfo));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyConcaveMeshShape(shape);
+            mPhysicsCommon.destroyConcaveMeshShape(shape2);
+            mPhysicsCommon.destroyConcaveMeshShape(shape3);
+            mPhysicsCommon.destroyConcaveMeshShape(shape4);
+        }
+
         void testHeightField() {
 
             // ----- Test feedback data ----- //
@@ -0,0 +1,262 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SPHERE_VS_TRIANGLE_ALGORITHM_H
+#define TEST_SPHERE_VS_TRIANGLE_ALGORITHM_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/collision/narrowphase/SphereVsConvexPolyhedronAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
+#include <reactphysics3d/collision/shapes/SphereShape.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/collision/HalfEdgeStructure.h>
+#include <reactphysics3d/collision/ContactPointInfo.h>
+#include <reactphysics3d/components/ColliderComponents.h>
+#include <reactphysics3d/components/CollisionBodyComponents.h>
+#include <reactphysics3d/components/RigidBodyComponents.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <reactphysics3d/engine/PhysicsCommon.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+/// Triangle shape that can be created outside of the middle-phase collision detection
+class SphereVsTriangleTestTriangleShape : public TriangleShape {
+
+    public:
+
+        /// Constructor
+        SphereVsTriangleTestTriangleShape(const Vector3* vertices, const Vector3* verticesNormals,
+                                          HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator)
+            : TriangleShape(vertices, verticesNormals, 0, 0, triangleHalfEdgeStructure, allocator) {
+
+        }
+};
+
+// Class TestSphereVsTriangleAlgorithm
+/**
+ * Unit test for the narrow-phase collision detection between a sphere and the triangles
+ * of a concave shape that are stored directly in the narrow-phase batch
+ */
+class TestSphereVsTriangleAlgorithm : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mBaseAllocator;
+
+        MemoryManager mMemoryManager;
+
+        PhysicsCommon mPhysicsCommon;
+
+        SphereShape* mSphereShape;
+
+        /// Half-edge structure of the triangle shapes (not used because the center of the sphere is never
+        /// inside of a triangle and therefore the SAT algorithm is never used)
+        HalfEdgeStructure mTriangleHalfEdgeStructure;
+
+        // Overlapping pairs (only needed to create the narrow-phase batches)
+        ColliderComponents mColliderComponents;
+        CollisionBodyComponents mCollisionBodyComponents;
+        RigidBodyComponents mRigidBodyComponents;
+        FlatSet<bodypair> mNoCollisionPairs;
+        CollisionDispatch mCollisionDispatch;
+        OverlappingPairs mOverlappingPairs;
+
+        SphereVsConvexPolyhedronAlgorithm mAlgorithm;
+
+        /// Vertices of the triangle (its face normal is along the +y axis)
+        Vector3 mVertices[3];
+
+        /// Vertices normals of the triangle
+        Vector3 mVerticesNormals[3];
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        Profiler* mProfiler;
+#endif
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSphereVsTriangleAlgorithm(const std::string& name)
+            : Test(name), mMemoryManager(&mBaseAllocator),
+              mTriangleHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 2, 3, 6),
+              mColliderComponents(mMemoryManager.getHeapAllocator()), mCollisionBodyComponents(mMemoryManager.getHeapAllocator()),
+              mRigidBodyComponents(mMemoryManager.getHeapAllocator()), mNoCollisionPairs(mMemoryManager.getHeapAllocator()),
+              mCollisionDispatch(mMemoryManager.getPoolAllocator()),
+              mOverlappingPairs(mMemoryManager, mColliderComponents, mCollisionBodyComponents, mRigidBodyComponents,
+                                mNoCollisionPairs, mCollisionDispatch) {
+
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+
+            mVertices[0] = Vector3(0, 0, 0);
+            mVertices[1] = Vector3(0, 0, 2);
+            mVertices[2] = Vector3(2, 0, 0);
+            mVerticesNormals[0] = Vector3(0, 1, 0);
+            mVerticesNormals[1] = Vector3(0, 1, 0);
+            mVerticesNormals[2] = Vector3(0, 1, 0);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            mProfiler = new Profiler();
+            mAlgorithm.setProfiler(mProfiler);
+#endif
+
+        }
+
+        /// Destructor
+        virtual ~TestSphereVsTriangleAlgorithm() {
+
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            delete mProfiler;
+#endif
+
+        }
+
+        /// Return a new triangle shape (the narrow-phase batch releases it when it is cleared)
+        TriangleShape* createTriangleShape() {
+
+            // The batch releases the memory of a triangle using the size of a TriangleShape
+            void* allocatedMemory = mMemoryManager.getHeapAllocator().allocate(sizeof(TriangleShape));
+            return new (allocatedMemory) SphereVsTriangleTestTriangleShape(mVertices, mVerticesNormals, mTriangleHalfEdgeStructure,
+                                                                           mMemoryManager.getHeapAllocator());
+        }
+
+        /// Run the tests
+        void run() {
+            testSphereVsTriangles();
+        }
+
+        void testSphereVsTriangles() {
+
+            // Centers of the sphere in the local-space of the triangle (above the face, below the face,
+            // near an edge, below another edge, near a vertex and outside of an edge)
+            const Vector3 sphereCenters[6] = {Vector3(decimal(0.5), decimal(0.3), decimal(0.5)), Vector3(decimal(0.5), decimal(-0.2), decimal(0.5)),
+                                              Vector3(decimal(-0.3), decimal(0.1), decimal(1.0)), Vector3(decimal(1.2), decimal(-0.1), decimal(1.2)),
+                                              Vector3(decimal(-0.3), decimal(0.2), decimal(-0.3)), Vector3(decimal(-0.6), 0, decimal(0.5))};
+
+            // Expected closest points on the triangle, contact normals (from the triangle to the sphere
+            // in the local-space of the triangle) and penetration depths
+            const Vector3 closestPoints[6] = {Vector3(decimal(0.5), 0, decimal(0.5)), Vector3(decimal(0.5), 0, decimal(0.5)),
+                                              Vector3(0, 0, decimal(1.0)), Vector3(decimal(1.0), 0, decimal(1.0)),
+                                              Vector3(0, 0, 0), Vector3(0, 0, 0)};
+            const Vector3 normals[6] = {Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(0, 1, 0), Vector3(0, 0, 0)};
+            const decimal depths[6] = {decimal(0.2), decimal(0.3), decimal(0.5) - std::sqrt(decimal(0.1)), decimal(0.2),
+                                       decimal(0.5) - std::sqrt(decimal(0.22)), 0};
+            const bool isColliding[6] = {true, true, true, true, true, false};
+            const uint32 nbConfigurations = 6;
+
+            const Transform triangleTransform(Vector3(1, 2, 3), Quaternion::fromEulerAngles(decimal(0.3), decimal(0.5), decimal(0.1)));
+            const Quaternion sphereOrientation = Quaternion::fromEulerAngles(decimal(0.5), decimal(-0.4), decimal(0.9));
+
+            MemoryAllocator& allocator = mMemoryManager.getHeapAllocator();
+
+            // Test with the sphere as the first and as the second shape of the pair
+            for (uint32 order = 0; order < 2; order++) {
+
+                const bool isSphereShape1 = order == 0;
+
+                NarrowPhaseInfoBatch batchTriangles(mOverlappingPairs, allocator);
+                NarrowPhaseInfoBatch batchTriangleShapes(mOverlappingPairs, allocator);
+                std::vector<LastFrameCollisionInfo> lastFrameInfosTriangles(nbConfigurations);
+                std::vector<LastFrameCollisionInfo> lastFrameInfosTriangleShapes(nbConfigurations);
+
+                for (uint32 c = 0; c < nbConfigurations; c++) {
+
+                    const Transform sphereTransform(triangleTransform * sphereCenters[c], sphereOrientation);
+                    const Transform& transform1 = isSphereShape1 ? sphereTransform : triangleTransform;
+                    const Transform& transform2 = isSphereShape1 ? triangleTransform : sphereTransform;
+
+                    batchTriangles.addNarrowPhaseInfoWithTriangle(c, Entity(0, 0), Entity(1, 0), isSphereShape1 ? mSphereShape : nullptr,
+                                                                  isSphereShape1 ? nullptr : mSphereShape, mVertices, mVerticesNormals, 0,
+                                                                  transform1, transform2, true, &lastFrameInfosTriangles[c], allocator);
+
+                    CollisionShape* triangleShape = createTriangleShape();
+                    batchTriangleShapes.addNarrowPhaseInfo(c, Entity(0, 0), Entity(1, 0), isSphereShape1 ? mSphereShape : triangleShape,
+                                                           isSphereShape1 ? triangleShape : mSphereShape, transform1, transform2, true,
+                                                           &lastFrameInfosTriangleShapes[c], allocator);
+                }
+
+                // Compute the collisions with the triangles of the batch and with the GJK/SAT algorithms on triangle shapes
+                mAlgorithm.testCollisionVsTriangles(batchTriangles, 0, nbConfigurations);
+                mAlgorithm.testCollision(batchTriangleShapes, 0, nbConfigurations, false, allocator);
+
+                for (uint32 c = 0; c < nbConfigurations; c++) {
+
+                    const NarrowPhaseInfoBatch::NarrowPhaseInfo& info = batchTriangles.narrowPhaseInfos[c];
+                    const NarrowPhaseInfoBatch::NarrowPhaseInfo& infoTriangleShape = batchTriangleShapes.narrowPhaseInfos[c];
+
+                    rp3d_test(info.isColliding == isColliding[c]);
+                    rp3d_test(infoTriangleShape.isColliding == isColliding[c]);
+                    rp3d_test(info.nbContactPoints == (isColliding[c] ? 1 : 0));
+                    rp3d_test(infoTriangleShape.nbContactPoints == info.nbContactPoints);
+
+                    if (info.nbContactPoints == 1) {
+
+                        // Expected contact normal (from the shape 1 to the shape 2) and local contact points
+                        const Vector3 worldNormal = triangleTransform.getOrientation() * normals[c];
+                        const Vector3 spherePoint = Transform(triangleTransform * sphereCenters[c], sphereOrientation).getInverse() *
+                                                    (triangleTransform * (closestPoints[c] - normals[c] * depths[c]));
+                        const Vector3 expectedNormal = isSphereShape1 ? -worldNormal : worldNormal;
+                        const Vector3 expectedLocalPoint1 = isSphereShape1 ? spherePoint : closestPoints[c];
+                        const Vector3 expectedLocalPoint2 = isSphereShape1 ? closestPoints[c] : spherePoint;
+
+                        const ContactPointInfo& point = info.contactPoints[0];
+                        rp3d_test(approxEqual(point.normal, expectedNormal, decimal(0.0001)));
+                        rp3d_test(approxEqual(point.penetrationDepth, depths[c], decimal(0.0001)));
+                        rp3d_test(approxEqual(point.localPoint1, expectedLocalPoint1, decimal(0.0001)));
+                        rp3d_test(approxEqual(point.localPoint2, expectedLocalPoint2, decimal(0.0001)));
+
+                        // The contact must be the same as the one computed with a triangle shape
+                        const ContactPointInfo& pointTriangleShape = infoTriangleShape.contactPoints[0];
+                        rp3d_test(approxEqual(point.normal, pointTriangleShape.normal, decimal(0.0001)));
+                        rp3d_test(approxEqual(point.penetrationDepth, pointTriangleShape.penetrationDepth, decimal(0.0001)));
+                        rp3d_test(approxEqual(point.localPoint1, pointTriangleShape.localPoint1, decimal(0.0001)));
+                        rp3d_test(approxEqual(point.localPoint2, pointTriangleShape.localPoint2, decimal(0.0001)));
+                    }
+
+                    batchTriangles.resetContactPoints(c);
+                    batchTriangleShapes.resetContactPoints(c);
+                }
+            }
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_STATIC_AABB_TREE_H
+#define TEST_STATIC_AABB_TREE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/collision/broadphase/StaticAABBTree.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <vector>
+#include <algorithm>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+class StaticTreeRaycastCallback : public StaticAABBTreeRaycastCallback {
+
+    public:
+
+        std::vector<int32> mHitLeaves;
+
+        // Called when the AABB of a leaf node is hit by a ray
+        virtual decimal raycastLeaf(int32 leafData, const Ray& /*ray*/) override {
+            mHitLeaves.push_back(leafData);
+            return 1.0;
+        }
+};
+
+// Class TestStaticAABBTree
+/**
+ * Unit test for the static AABB tree
+ */
+class TestStaticAABBTree : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        MemoryManager mMemoryManager;
+
+        std::vector<AABB> mLeafAABBs;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        Profiler* mProfiler;
+#endif
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestStaticAABBTree(const std::string& name): Test(name), mMemoryManager(nullptr, 0)  {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            mProfiler = new Profiler();
+#endif
+
+            // Create random boxes
+            uint32 seed = 4321;
+            const auto random = [&seed](decimal min, decimal max) {
+                seed = seed * 1664525u + 1013904223u;
+                return min + (max - min) * decimal(seed >> 8) / decimal(1 << 24);
+            };
+            for (int i = 0; i < 1000; i++) {
+                const Vector3 min(random(-100, 100), random(-5, 5), random(-100, 100));
+                mLeafAABBs.push_back(AABB(min, min + Vector3(random(0, 3), random(0, decimal(0.5)), random(0, 3))));
+            }
+        }
+
+        /// Destructor
+        ~TestStaticAABBTree() {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            delete mProfiler;
+#endif
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testQuantization();
+            testOverlapping();
+            testRaycast();
+        }
+
+        void testQuantization() {
+
+            StaticAABBTree tree(mMemoryManager.getHeapAllocator());
+            tree.build(&(mLeafAABBs[0]), static_cast<int32>(mLeafAABBs.size()));
+
+            rp3d_test(tree.getNbNodes() == static_cast<int32>(2 * mLeafAABBs.size() - 1));
+            rp3d_test(sizeof(QuantizedTreeNode) == 16);
+
+            // The dequantized AABB of each node must contain the AABBs of all its leaves
+            std::vector<AABB> aabbs(tree.getNbNodes());
+            std::vector<int32> parents(tree.getNbNodes(), -1);
+            const QuantizedTreeNode* nodes = tree.getNodes();
+            aabbs[0] = tree.getRootAABB();
+            for (int32 i = 0; i < tree.getNbNodes(); i++) {
+
+                if (i > 0) {
+                    aabbs[i] = nodes[i].computeAABB(aabbs[parents[i]], QuantizedTreeNode::computeQuantizationStep(aabbs[parents[i]]));
+                }
+
+                if (nodes[i].isLeaf()) {
+
+                    // Check that the leaf AABB is contained in the AABBs of all its ancestors
+                    const AABB& leafAABB = mLeafAABBs[nodes[i].getData()];
+                    for (int32 node = i; node != -1; node = parents[node]) {
+                        rp3d_test(aabbs[node].contains(leafAABB));
+                    }
+                }
+                else {
+                    parents[i + 1] = i;
+                    parents[nodes[i].rightChildOrData] = i;
+                }
+            }
+        }
+
+        void testOverlapping() {
+
+            StaticAABBTree tree(mMemoryManager.getHeapAllocator());
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+            tree.build(&(mLeafAABBs[0]), static_cast<int32>(mLeafAABBs.size()));
+
+            // Use the nodes of the tree as external nodes of another tree
+            StaticAABBTree externalTree(mMemoryManager.getHeapAllocator());
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            externalTree.setProfiler(mProfiler);
+#endif
+            externalTree.setExternalNodes(tree.getNodes(), tree.getNbNodes(), tree.getRootAABB());
+
+            for (int i = 0; i < 20; i++) {
+
+                const AABB queryAABB(Vector3(-110 + i * 10, -1, -20), Vector3(-100 + i * 10, 1, 20));
+
+                for (const StaticAABBTree* testedTree : {&tree, &externalTree}) {
+
+                    Array<int32> overlappingLeaves(mMemoryManager.getHeapAllocator());
+                    testedTree->reportAllShapesOverlappingWithAABB(queryAABB, overlappingLeaves);
+
+                    // All the overlapping leaves must be reported (leaves with overlapping
+                    // quantized AABB might also be reported)
+                    for (uint32 j = 0; j < mLeafAABBs.size(); j++) {
+                        if (mLeafAABBs[j].testCollision(queryAABB)) {
+                            rp3d_test(std::find(overlappingLeaves.begin(), overlappingLeaves.end(), static_cast<int32>(j)) != overlappingLeaves.end());
+                        }
+                    }
+                }
+            }
+
+            // Empty tree
+            StaticAABBTree emptyTree(mMemoryManager.getHeapAllocator());
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            emptyTree.setProfiler(mProfiler);
+#endif
+            emptyTree.build(nullptr, 0);
+            Array<int32> overlappingLeaves(mMemoryManager.getHeapAllocator());
+            emptyTree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-1, -1, -1), Vector3(1, 1, 1)), overlappingLeaves);
+            rp3d_test(overlappingLeaves.size() == 0);
+        }
+
+        void testRaycast() {
+
+            StaticAABBTree tree(mMemoryManager.getHeapAllocator());
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            tree.setProfiler(mProfiler);
+#endif
+            tree.build(&(mLeafAABBs[0]), static_cast<int32>(mLeafAABBs.size()));
+
+            for (int i = 0; i < 20; i++) {
+
+                const Ray ray(Vector3(-100 + i * 10, 10, -100), Vector3(-90 + i * 10, -10, 100));
+                const Vector3 rayDirection = ray.point2 - ray.point1;
+                const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
+
+                StaticTreeRaycastCallback callback;
+                tree.raycast(ray, callback);
+
+                // All the leaves hit by the ray must be reported
+                for (uint32 j = 0; j < mLeafAABBs.size(); j++) {
+                    if (mLeafAABBs[j].testRayIntersect(ray.point1, rayDirectionInverse, ray.maxFraction)) {
+                        rp3d_test(std::find(callback.mHitLeaves.begin(), callback.mHitLeaves.end(), static_cast<int32>(j)) != callback.mHitLeaves.end());
+                    }
+                }
+            }
+        }
+ };
+
+}
+
+#endif
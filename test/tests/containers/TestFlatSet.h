@@ -0,0 +1,480 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_FLAT_SET_H
+#define TEST_FLAT_SET_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/containers/FlatSet.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <reactphysics3d/engine/Entity.h>
+
+// Value to test flat set with always same hash values
+namespace reactphysics3d {
+    struct TestValueFlatSet {
+        int key;
+
+        TestValueFlatSet(int k) :key(k) {}
+
+        bool operator==(const TestValueFlatSet& testValue) const {
+            return key == testValue.key;
+        }
+    };
+}
+
+// Hash function for struct TestValueFlatSet
+namespace std {
+
+  template <> struct hash<reactphysics3d::TestValueFlatSet> {
+
+    size_t operator()(const reactphysics3d::TestValueFlatSet& /*value*/) const {
+        return 1;
+    }
+  };
+}
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestFlatSet
+/**
+ * Unit test for the FlatSet class
+ */
+class TestFlatSet : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestFlatSet(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testConstructors();
+            testReserve();
+            testAddRemoveClear();
+            testContains();
+            testFind();
+            testEquality();
+            testAssignment();
+            testIterators();
+            testConverters();
+            testEntityHash();
+        }
+
+        void testConstructors() {
+
+            // ----- Constructors ----- //
+
+            FlatSet<std::string> set1(mAllocator);
+            rp3d_test(set1.capacity() == 0);
+            rp3d_test(set1.size() == 0);
+
+            FlatSet<std::string> set2(mAllocator, 100);
+            rp3d_test(set2.capacity() >= 100);
+            rp3d_test(set2.size() == 0);
+
+            // ----- Copy Constructors ----- //
+            FlatSet<std::string> set3(set1);
+            rp3d_test(set3.capacity() == set1.capacity());
+            rp3d_test(set3.size() == set1.size());
+
+            FlatSet<int> set4(mAllocator);
+            set4.add(10);
+            set4.add(20);
+            set4.add(30);
+            rp3d_test(set4.capacity() >= 3);
+            rp3d_test(set4.size() == 3);
+            set4.add(30);
+            rp3d_test(set4.size() == 3);
+
+            FlatSet<int> set5(set4);
+            rp3d_test(set5.capacity() == set4.capacity());
+            rp3d_test(set5.size() == set4.size());
+            rp3d_test(set5.contains(10));
+            rp3d_test(set5.contains(20));
+            rp3d_test(set5.contains(30));
+        }
+
+        void testReserve() {
+
+            FlatSet<std::string> set1(mAllocator);
+            set1.reserve(15);
+            rp3d_test(set1.capacity() >= 15);
+            set1.add("test1");
+            set1.add("test2");
+            rp3d_test(set1.capacity() >= 15);
+
+            set1.reserve(10);
+            rp3d_test(set1.capacity() >= 15);
+
+            set1.reserve(100);
+            rp3d_test(set1.capacity() >= 100);
+            rp3d_test(set1.contains("test1"));
+            rp3d_test(set1.contains("test2"));
+        }
+
+        void testAddRemoveClear() {
+
+            // ----- Test add() ----- //
+
+            FlatSet<int> set1(mAllocator);
+            bool add1 = set1.add(10);
+            bool add2 = set1.add(80);
+            bool add3 = set1.add(130);
+            rp3d_test(add1);
+            rp3d_test(add2);
+            rp3d_test(add3);
+            rp3d_test(set1.contains(10));
+            rp3d_test(set1.contains(80));
+            rp3d_test(set1.contains(130));
+            rp3d_test(set1.size() == 3);
+
+            bool add4 = set1.add(80);
+            rp3d_test(!add4);
+            rp3d_test(set1.contains(80));
+            rp3d_test(set1.size() == 3);
+
+            FlatSet<int> set2(mAllocator, 15);
+            for (int i = 0; i < 1000000; i++) {
+                set2.add(i);
+            }
+            bool isValid = true;
+            for (int i = 0; i < 1000000; i++) {
+                if (!set2.contains(i)) isValid = false;
+            }
+            rp3d_test(isValid);
+
+            set1.remove(10);
+            bool add = set1.add(10);
+            rp3d_test(add);
+            rp3d_test(set1.size() == 3);
+            rp3d_test(set1.contains(10));
+
+            set1.add(34);
+            rp3d_test(set1.contains(34));
+            rp3d_test(set1.size() == 4);
+
+            // ----- Test remove() ----- //
+
+            set1.remove(10);
+            rp3d_test(!set1.contains(10));
+            rp3d_test(set1.contains(80));
+            rp3d_test(set1.contains(130));
+            rp3d_test(set1.contains(34));
+            rp3d_test(set1.size() == 3);
+
+            set1.remove(80);
+            rp3d_test(!set1.contains(80));
+            rp3d_test(set1.contains(130));
+            rp3d_test(set1.contains(34));
+            rp3d_test(set1.size() == 2);
+
+            set1.remove(130);
+            rp3d_test(!set1.contains(130));
+            rp3d_test(set1.contains(34));
+            rp3d_test(set1.size() == 1);
+
+            set1.remove(34);
+            rp3d_test(!set1.contains(34));
+            rp3d_test(set1.size() == 0);
+
+            isValid = true;
+            for (int i = 0; i < 1000000; i++) {
+                set2.remove(i);
+            }
+            for (int i = 0; i < 1000000; i++) {
+                if (set2.contains(i)) isValid = false;
+            }
+            rp3d_test(isValid);
+            rp3d_test(set2.size() == 0);
+
+            FlatSet<int> set3(mAllocator);
+            for (int i=0; i < 1000000; i++) {
+                set3.add(i);
+                set3.remove(i);
+            }
+
+            set3.add(1);
+            set3.add(2);
+            set3.add(3);
+            rp3d_test(set3.size() == 3);
+            auto it = set3.begin();
+            it = set3.remove(it);
+            rp3d_test(set3.size() == 2);
+            it = set3.remove(it);
+            rp3d_test(set3.size() == 1);
+            it = set3.remove(it);
+            rp3d_test(set3.size() == 0);
+
+            set3.add(6);
+            set3.add(7);
+            set3.add(8);
+            for (it = set3.begin(); it != set3.end();) {
+               it = set3.remove(it);
+            }
+            rp3d_test(set3.size() == 0);
+
+            // ----- Test clear() ----- //
+
+            FlatSet<int> set4(mAllocator);
+            set4.add(2);
+            set4.add(4);
+            set4.add(6);
+            set4.clear();
+            rp3d_test(set4.size() == 0);
+            set4.add(2);
+            rp3d_test(set4.size() == 1);
+            rp3d_test(set4.contains(2));
+            set4.clear();
+            rp3d_test(set4.size() == 0);
+
+            FlatSet<int> set5(mAllocator);
+            set5.clear();
+            rp3d_test(set5.size() == 0);
+
+            // ----- Test map with always same hash value for keys ----- //
+
+            FlatSet<TestValueFlatSet> set6(mAllocator);
+            for (int i=0; i < 1000; i++) {
+                set6.add(TestValueFlatSet(i));
+            }
+            bool isTestValid = true;
+            for (int i=0; i < 1000; i++) {
+                if (!set6.contains(TestValueFlatSet(i))) {
+                    isTestValid = false;
+                }
+            }
+            rp3d_test(isTestValid);
+            for (int i=0; i < 1000; i++) {
+                set6.remove(TestValueFlatSet(i));
+            }
+            rp3d_test(set6.size() == 0);
+        }
+
+        void testContains() {
+
+            FlatSet<int> set1(mAllocator);
+
+            rp3d_test(!set1.contains(2));
+            rp3d_test(!set1.contains(4));
+            rp3d_test(!set1.contains(6));
+
+            set1.add(2);
+            set1.add(4);
+            set1.add(6);
+
+            rp3d_test(set1.contains(2));
+            rp3d_test(set1.contains(4));
+            rp3d_test(set1.contains(6));
+
+            set1.remove(4);
+            rp3d_test(!set1.contains(4));
+            rp3d_test(set1.contains(2));
+            rp3d_test(set1.contains(6));
+
+            set1.clear();
+            rp3d_test(!set1.contains(2));
+            rp3d_test(!set1.contains(6));
+        }
+
+        void testFind() {
+
+            FlatSet<int> set1(mAllocator);
+            set1.add(2);
+            set1.add(4);
+            set1.add(6);
+            rp3d_test(set1.find(2) != set1.end());
+            rp3d_test(set1.find(4) != set1.end());
+            rp3d_test(set1.find(6) != set1.end());
+            rp3d_test(set1.find(45) == set1.end());
+
+            set1.remove(2);
+
+            rp3d_test(set1.find(2) == set1.end());
+        }
+
+        void testEquality() {
+
+            FlatSet<std::string> set1(mAllocator, 10);
+            FlatSet<std::string> set2(mAllocator, 2);
+
+            rp3d_test(set1 == set2);
+
+            set1.add("a");
+            set1.add("b");
+            set1.add("c");
+
+            set2.add("a");
+            set2.add("b");
+            set2.add("h");
+
+            rp3d_test(set1 == set1);
+            rp3d_test(set2 == set2);
+            rp3d_test(set1 != set2);
+            rp3d_test(set2 != set1);
+
+            set1.add("a");
+            set2.remove("h");
+            set2.add("c");
+
+            rp3d_test(set1 == set2);
+            rp3d_test(set2 == set1);
+
+            FlatSet<std::string> set3(mAllocator);
+            set3.add("a");
+
+            rp3d_test(set1 != set3);
+            rp3d_test(set2 != set3);
+            rp3d_test(set3 != set1);
+            rp3d_test(set3 != set2);
+        }
+
+        void testAssignment() {
+
+           FlatSet<int> set1(mAllocator);
+           set1.add(1);
+           set1.add(2);
+           set1.add(10);
+
+           FlatSet<int> set2(mAllocator);
+           set2 = set1;
+           rp3d_test(set2.size() == set1.size());
+           rp3d_test(set2.contains(1));
+           rp3d_test(set2.contains(2));
+           rp3d_test(set2.contains(10));
+           rp3d_test(set1 == set2);
+
+           FlatSet<int> set3(mAllocator, 100);
+           set3 = set1;
+           rp3d_test(set3.size() == set1.size());
+           rp3d_test(set3 == set1);
+           rp3d_test(set3.contains(1));
+           rp3d_test(set3.contains(2));
+           rp3d_test(set3.contains(10));
+
+           FlatSet<int> set4(mAllocator);
+           set3 = set4;
+           rp3d_test(set3.size() == 0);
+           rp3d_test(set3 == set4);
+
+           FlatSet<int> set5(mAllocator);
+           set5.add(7);
+           set5.add(19);
+           set1 = set5;
+           rp3d_test(set5.size() == set1.size());
+           rp3d_test(set1 == set5);
+           rp3d_test(set1.contains(7));
+           rp3d_test(set1.contains(19));
+        }
+
+        void testIterators() {
+
+            FlatSet<int> set1(mAllocator);
+
+            rp3d_test(set1.begin() == set1.end());
+
+            set1.add(1);
+            set1.add(2);
+            set1.add(3);
+            set1.add(4);
+
+            FlatSet<int>::Iterator itBegin = set1.begin();
+            FlatSet<int>::Iterator it = set1.begin();
+
+            rp3d_test(itBegin == it);
+
+            size_t size = 0;
+            for (auto it = set1.begin(); it != set1.end(); ++it) {
+                rp3d_test(set1.contains(*it));
+                size++;
+            }
+            rp3d_test(set1.size() == size);
+        }
+
+        void testConverters() {
+
+            FlatSet<int> set1(mAllocator);
+
+            rp3d_test(set1.begin() == set1.end());
+
+            set1.add(1);
+            set1.add(2);
+            set1.add(3);
+            set1.add(4);
+
+            Array<int> array1 = set1.toArray(mAllocator);
+            rp3d_test(array1.size() == 4);
+            rp3d_test(array1.find(1) != array1.end());
+            rp3d_test(array1.find(2) != array1.end());
+            rp3d_test(array1.find(3) != array1.end());
+            rp3d_test(array1.find(4) != array1.end());
+            rp3d_test(array1.find(5) == array1.end());
+            rp3d_test(array1.find(6) == array1.end());
+
+            FlatSet<int> set2(mAllocator);
+            Array<int> array2 = set2.toArray(mAllocator);
+            rp3d_test(array2.size() == 0);
+        }
+
+        void testEntityHash() {
+
+            // Set of entities with the specialized hash function
+            FlatSet<Entity, EntityHash> set1(mAllocator);
+            for (uint32 i=0; i < 1000; i++) {
+                set1.add(Entity(i, i % 4));
+            }
+            rp3d_test(set1.size() == 1000);
+
+            bool isValid = true;
+            for (uint32 i=0; i < 1000; i++) {
+                if (!set1.contains(Entity(i, i % 4))) isValid = false;
+                if (set1.contains(Entity(i, (i + 1) % 4))) isValid = false;
+            }
+            rp3d_test(isValid);
+
+            for (uint32 i=0; i < 1000; i += 2) {
+                set1.remove(Entity(i, i % 4));
+            }
+            rp3d_test(set1.size() == 500);
+            rp3d_test(!set1.contains(Entity(10, 2)));
+            rp3d_test(set1.contains(Entity(11, 3)));
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,235 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_HASH_CONTAINERS_BENCHMARK_H
+#define TEST_HASH_CONTAINERS_BENCHMARK_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/containers/Set.h>
+#include <reactphysics3d/containers/FlatMap.h>
+#include <reactphysics3d/containers/FlatSet.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/engine/Entity.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <chrono>
+#include <iomanip>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestHashContainersBenchmark
+/**
+ * Benchmark of the open-addressing containers (FlatMap and FlatSet) against the
+ * chained containers (Map and Set) with the keys used by the engine (pair ids, entities
+ * and pairs of bodies). The two kinds of containers must give the same results. The
+ * timings are printed but they are not tested.
+ */
+class TestHashContainersBenchmark : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of keys in the containers
+        static constexpr uint32 NB_KEYS = 20000;
+
+        /// Number of times all the keys are looked up
+        static constexpr uint32 NB_LOOKUP_ROUNDS = 20;
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        /// Pair ids of the benchmark (in random order)
+        Array<uint64> mPairIds;
+
+        /// Entities of the benchmark
+        Array<Entity> mEntities;
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number (deterministic linear congruential generator)
+        static uint32 nextRandom(uint32& state) {
+            state = state * 1664525u + 1013904223u;
+            return state >> 8;
+        }
+
+        /// Add all the keys, look them up (and some missing keys) and then remove and add half of them.
+        /// Return the time in milliseconds and the sum of the values found
+        template<class MapType, typename K>
+        double benchmarkMap(const Array<K>& keys, const Array<K>& missingKeys, uint64& sum) {
+
+            auto start = std::chrono::high_resolution_clock::now();
+
+            MapType map(mAllocator);
+            for (uint32 i=0; i < keys.size(); i++) {
+                map.add(Pair<K, uint64>(keys[i], i));
+            }
+
+            sum = 0;
+            for (uint32 r=0; r < NB_LOOKUP_ROUNDS; r++) {
+                for (uint32 i=0; i < keys.size(); i++) {
+                    auto it = map.find(keys[i]);
+                    if (it != map.end()) sum += it->second;
+                    if (map.containsKey(missingKeys[i])) sum++;
+                }
+            }
+
+            for (uint32 i=0; i < keys.size(); i += 2) {
+                map.remove(keys[i]);
+            }
+            for (uint32 i=0; i < keys.size(); i += 2) {
+                map.add(Pair<K, uint64>(keys[i], i));
+            }
+            sum += map.size();
+
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        /// Add all the values, test if they are in the set (and some missing values) and remove them.
+        /// Return the time in milliseconds and the number of values found
+        template<class SetType, typename V>
+        double benchmarkSet(const Array<V>& values, const Array<V>& missingValues, uint64& nbFound) {
+
+            auto start = std::chrono::high_resolution_clock::now();
+
+            SetType set(mAllocator);
+            for (uint32 i=0; i < values.size(); i++) {
+                set.add(values[i]);
+            }
+
+            nbFound = 0;
+            for (uint32 r=0; r < NB_LOOKUP_ROUNDS; r++) {
+                for (uint32 i=0; i < values.size(); i++) {
+                    if (set.contains(values[i])) nbFound++;
+                    if (set.contains(missingValues[i])) nbFound++;
+                }
+            }
+
+            for (uint32 i=0; i < values.size(); i++) {
+                set.remove(values[i]);
+            }
+            nbFound += set.size();
+
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        /// Print the timings of a benchmark
+        static void printTimings(const std::string& name, double chainedTime, double flatTime) {
+            std::cout << "Benchmark " << std::left << std::setw(32) << name << std::fixed << std::setprecision(2)
+                      << "chained: " << std::setw(8) << chainedTime << "ms  flat: " << std::setw(8) << flatTime << "ms"
+                      << std::endl;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestHashContainersBenchmark(const std::string& name)
+            : Test(name), mPairIds(mAllocator), mEntities(mAllocator) {
+
+            // Pair ids of random pairs of broad-phase ids
+            uint32 randomState = 1;
+            FlatSet<uint64, Uint64Hash> pairIds(mAllocator);
+            while (mPairIds.size() < NB_KEYS) {
+                const uint32 id1 = nextRandom(randomState) % (NB_KEYS * 4) + 1;
+                const uint32 id2 = nextRandom(randomState) % id1;
+                const uint64 pairId = pairNumbers(id1, id2);
+                if (pairIds.add(pairId)) {
+                    mPairIds.add(pairId);
+                }
+            }
+
+            // Entities with different generations
+            for (uint32 i=0; i < NB_KEYS; i++) {
+                mEntities.add(Entity(i, i % 3));
+            }
+        }
+
+        /// Run the tests
+        void run() {
+
+            testPairIds();
+            testEntities();
+            testBodyPairs();
+        }
+
+        void testPairIds() {
+
+            Array<uint64> missingPairIds(mAllocator);
+            for (uint32 i=0; i < mPairIds.size(); i++) {
+                missingPairIds.add(mPairIds[i] + (uint64(1) << 62));
+            }
+
+            uint64 chainedSum, flatSum;
+            const double chainedTime = benchmarkMap<Map<uint64, uint64>>(mPairIds, missingPairIds, chainedSum);
+            const double flatTime = benchmarkMap<FlatMap<uint64, uint64, Uint64Hash>>(mPairIds, missingPairIds, flatSum);
+            rp3d_test(chainedSum == flatSum);
+
+            printTimings("pair id -> index map", chainedTime, flatTime);
+        }
+
+        void testEntities() {
+
+            Array<Entity> missingEntities(mAllocator);
+            for (uint32 i=0; i < mEntities.size(); i++) {
+                missingEntities.add(Entity(mEntities[i].getIndex(), mEntities[i].getGeneration() + 1));
+            }
+
+            uint64 chainedSum, flatSum;
+            const double chainedTime = benchmarkMap<Map<Entity, uint64>>(mEntities, missingEntities, chainedSum);
+            const double flatTime = benchmarkMap<FlatMap<Entity, uint64, EntityHash>>(mEntities, missingEntities, flatSum);
+            rp3d_test(chainedSum == flatSum);
+
+            printTimings("entity -> component index map", chainedTime, flatTime);
+        }
+
+        void testBodyPairs() {
+
+            Array<Pair<Entity, Entity>> bodyPairs(mAllocator);
+            Array<Pair<Entity, Entity>> missingBodyPairs(mAllocator);
+            for (uint32 i=0; i < mEntities.size(); i++) {
+                const Entity& otherEntity = mEntities[(i * 7 + 1) % mEntities.size()];
+                bodyPairs.add(Pair<Entity, Entity>(mEntities[i], otherEntity));
+                missingBodyPairs.add(Pair<Entity, Entity>(otherEntity, Entity(mEntities[i].getIndex(), 3)));
+            }
+
+            uint64 chainedNbFound, flatNbFound;
+            const double chainedTime = benchmarkSet<Set<Pair<Entity, Entity>>>(bodyPairs, missingBodyPairs, chainedNbFound);
+            const double flatTime = benchmarkSet<FlatSet<Pair<Entity, Entity>>>(bodyPairs, missingBodyPairs, flatNbFound);
+            rp3d_test(chainedNbFound == flatNbFound);
+
+            printTimings("set of body pairs", chainedTime, flatTime);
+        }
+ };
+
+}
+
+#endif
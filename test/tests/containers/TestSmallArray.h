@@ -0,0 +1,266 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2022 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SMALL_ARRAY_H
+#define TEST_SMALL_ARRAY_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/containers/SmallArray.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <type_traits>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class CountingAllocator
+/**
+ * Allocator that counts the number of allocations that are currently not released
+ */
+class CountingAllocator : public DefaultAllocator {
+
+    public:
+
+        int nbAllocations = 0;
+        int nbLiveAllocations = 0;
+
+        virtual void* allocate(size_t size) override {
+            nbAllocations++;
+            nbLiveAllocations++;
+            return DefaultAllocator::allocate(size);
+        }
+
+        virtual void release(void* pointer, size_t size) override {
+            nbLiveAllocations--;
+            DefaultAllocator::release(pointer, size);
+        }
+};
+
+// Class TestSmallArray
+/**
+ * Unit test for the SmallArray class
+ */
+class TestSmallArray : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        CountingAllocator mAllocator;
+
+        // ---------- Methods ---------- //
+
+        /// Return the sum of the elements of an array
+        int sumElements(const Array<int>& array) const {
+            int sum = 0;
+            for (uint32 i=0; i < array.size(); i++) {
+                sum += array[i];
+            }
+            return sum;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSmallArray(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testInlineStorage();
+            testSpill();
+            testCopy();
+            testClear();
+            testNonTrivialElements();
+        }
+
+        void testInlineStorage() {
+
+            mAllocator.nbAllocations = 0;
+
+            SmallArray<int, 8> array1(mAllocator);
+            rp3d_test(array1.capacity() == 8);
+            rp3d_test(array1.size() == 0);
+            rp3d_test(array1.isInline());
+
+            for (int i=0; i < 8; i++) {
+                array1.add(i);
+            }
+            rp3d_test(array1.size() == 8);
+            rp3d_test(array1.isInline());
+            rp3d_test(mAllocator.nbAllocations == 0);
+
+            // The small array can be used as an array
+            rp3d_test(sumElements(array1) == 28);
+
+            array1.removeAt(0);
+            rp3d_test(array1.size() == 7);
+            rp3d_test(array1[0] == 1);
+            rp3d_test(array1.find(7) != array1.end());
+            rp3d_test(mAllocator.nbAllocations == 0);
+        }
+
+        void testSpill() {
+
+            mAllocator.nbAllocations = 0;
+
+            {
+                SmallArray<int, 4> array1(mAllocator);
+                for (int i=0; i < 4; i++) {
+                    array1.add(i);
+                }
+                rp3d_test(mAllocator.nbAllocations == 0);
+
+                // The elements are moved to the allocator memory past the inline capacity
+                array1.add(4);
+                rp3d_test(!array1.isInline());
+                rp3d_test(array1.capacity() == 8);
+                rp3d_test(mAllocator.nbAllocations == 1);
+                for (int i=0; i < 5; i++) {
+                    rp3d_test(array1[i] == i);
+                }
+
+                for (int i=5; i < 100; i++) {
+                    array1.add(i);
+                }
+                rp3d_test(array1.size() == 100);
+                rp3d_test(sumElements(array1) == 4950);
+
+                // An array growing through an Array reference also spills to the allocator
+                SmallArray<int, 4> array2(mAllocator);
+                Array<int>& array2Ref = array2;
+                array2Ref.addWithoutInit(10);
+                rp3d_test(array2.size() == 10);
+                rp3d_test(!array2.isInline());
+            }
+
+            rp3d_test(mAllocator.nbLiveAllocations == 0);
+        }
+
+        void testCopy() {
+
+            mAllocator.nbAllocations = 0;
+
+            SmallArray<int, 4> array1(mAllocator);
+            array1.add(1);
+            array1.add(2);
+
+            // ----- Copy constructor ----- //
+
+            SmallArray<int, 4> array2(array1);
+            rp3d_test(array2.size() == 2);
+            rp3d_test(array2.isInline());
+            rp3d_test(array2[0] == 1);
+            rp3d_test(array2[1] == 2);
+            array2[0] = 5;
+            rp3d_test(array1[0] == 1);
+            rp3d_test(mAllocator.nbAllocations == 0);
+
+            SmallArray<int, 4> array3(mAllocator);
+            for (int i=0; i < 10; i++) {
+                array3.add(i);
+            }
+            SmallArray<int, 4> array4(array3);
+            rp3d_test(array4.size() == 10);
+            rp3d_test(!array4.isInline());
+            rp3d_test(array4 == array3);
+
+            // ----- Assignment ----- //
+
+            array4 = array1;
+            rp3d_test(array4.size() == 2);
+            rp3d_test(array4 == array1);
+
+            array1 = array3;
+            rp3d_test(array1.size() == 10);
+            rp3d_test(!array1.isInline());
+            rp3d_test(array1 == array3);
+
+            // ----- No copy into an Array ----- //
+
+            // A small array can be used as a reference to an array but cannot be copied into an array
+            rp3d_test((std::is_convertible<SmallArray<int, 4>&, Array<int>&>::value));
+            rp3d_test((!std::is_constructible<Array<int>, const SmallArray<int, 4>&>::value));
+            rp3d_test((!std::is_assignable<Array<int>&, const SmallArray<int, 4>&>::value));
+        }
+
+        void testClear() {
+
+            mAllocator.nbLiveAllocations = 0;
+
+            {
+                SmallArray<int, 4> array1(mAllocator);
+                for (int i=0; i < 10; i++) {
+                    array1.add(i);
+                }
+                rp3d_test(mAllocator.nbLiveAllocations == 1);
+
+                array1.clear();
+                rp3d_test(array1.size() == 0);
+                rp3d_test(array1.capacity() == 16);
+
+                // The inline buffer is used again after the memory is released
+                array1.clear(true);
+                rp3d_test(array1.size() == 0);
+                rp3d_test(array1.capacity() == 4);
+                rp3d_test(array1.isInline());
+                rp3d_test(mAllocator.nbLiveAllocations == 0);
+
+                array1.add(7);
+                rp3d_test(array1[0] == 7);
+                rp3d_test(mAllocator.nbLiveAllocations == 0);
+            }
+
+            rp3d_test(mAllocator.nbLiveAllocations == 0);
+        }
+
+        void testNonTrivialElements() {
+
+            mAllocator.nbLiveAllocations = 0;
+
+            {
+                SmallArray<std::string, 2> array1(mAllocator);
+                array1.add("first string long enough to be allocated on the heap");
+                array1.add("second");
+                array1.add("third");
+                rp3d_test(array1.size() == 3);
+                rp3d_test(array1[0] == "first string long enough to be allocated on the heap");
+                rp3d_test(array1[2] == "third");
+
+                SmallArray<std::string, 2> array2(array1);
+                rp3d_test(array2 == array1);
+            }
+
+            rp3d_test(mAllocator.nbLiveAllocations == 0);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,992 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_PHYSICS_WORLD_H
+#define TEST_PHYSICS_WORLD_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+#include <set>
+#include <utility>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class ContactPairsRecorder
+/**
+ * Event listener that records the pairs of colliders of the contact events of a frame
+ */
+class ContactPairsRecorder : public EventListener {
+
+    public:
+
+        using ColliderPair = std::pair<Collider*, Collider*>;
+
+        std::set<ColliderPair> startPairs;
+        std::set<ColliderPair> stayPairs;
+        std::set<ColliderPair> exitPairs;
+
+        void reset() {
+            startPairs.clear();
+            stayPairs.clear();
+            exitPairs.clear();
+        }
+
+        static ColliderPair makePair(Collider* collider1, Collider* collider2) {
+            return collider1 < collider2 ? ColliderPair(collider1, collider2) : ColliderPair(collider2, collider1);
+        }
+
+        virtual void onContact(const CollisionCallback::CallbackData& callbackData) override {
+
+            for (uint32 i=0; i < callbackData.getNbContactPairs(); i++) {
+
+                const CollisionCallback::ContactPair contactPair = callbackData.getContactPair(i);
+                const ColliderPair pair = makePair(contactPair.getCollider1(), contactPair.getCollider2());
+
+                switch (contactPair.getEventType()) {
+                    case CollisionCallback::ContactPair::EventType::ContactStart: startPairs.insert(pair); break;
+                    case CollisionCallback::ContactPair::EventType::ContactStay: stayPairs.insert(pair); break;
+                    case CollisionCallback::ContactPair::EventType::ContactExit: exitPairs.insert(pair); break;
+                }
+            }
+        }
+};
+
+// Class ContactPointsRecorder
+/**
+ * Event listener that records the contact points of the moving bodies of a frame. The points and
+ * normals are expressed from the moving body so that they do not depend on the order of the colliders.
+ */
+class ContactPointsRecorder : public EventListener {
+
+    public:
+
+        struct ContactPointData {
+            Vector3 worldPoint;
+            Vector3 worldNormal;
+            decimal penetrationDepth;
+        };
+
+        std::vector<CollisionBody*> movingBodies;
+        std::vector<std::vector<ContactPointData>> contactPoints;
+
+        void reset() {
+            contactPoints.assign(movingBodies.size(), std::vector<ContactPointData>());
+        }
+
+        virtual void onContact(const CollisionCallback::CallbackData& callbackData) override {
+
+            for (uint32 i=0; i < callbackData.getNbContactPairs(); i++) {
+
+                const CollisionCallback::ContactPair contactPair = callbackData.getContactPair(i);
+                if (contactPair.getEventType() == CollisionCallback::ContactPair::EventType::ContactExit) continue;
+
+                for (uint32 b=0; b < movingBodies.size(); b++) {
+
+                    const bool isBody1Moving = contactPair.getBody1() == movingBodies[b];
+                    if (!isBody1Moving && contactPair.getBody2() != movingBodies[b]) continue;
+
+                    for (uint32 c=0; c < contactPair.getNbContactPoints(); c++) {
+
+                        const CollisionCallback::ContactPoint contactPoint = contactPair.getContactPoint(c);
+
+                        ContactPointData data;
+                        data.worldPoint = isBody1Moving ? contactPair.getCollider1()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider1() :
+                                                          contactPair.getCollider2()->getLocalToWorldTransform() * contactPoint.getLocalPointOnCollider2();
+                        data.worldNormal = isBody1Moving ? contactPoint.getWorldNormal() : -contactPoint.getWorldNormal();
+                        data.penetrationDepth = contactPoint.getPenetrationDepth();
+                        contactPoints[b].push_back(data);
+                    }
+                }
+            }
+        }
+};
+
+// Class TestPhysicsWorld
+/**
+ * Unit test for the PhysicsWorld class.
+ */
+class TestPhysicsWorld : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestPhysicsWorld(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testFixedTimeStep();
+            testKinematicBodyInterpolation();
+            testExportRigidBodiesState();
+            testDeterministicSimulation();
+            testSnapshot();
+            testSnapshotWithReactivatedBodies();
+            testRemoveManyOverlappingPairs();
+            testIslandSleepAndContactWakeUp();
+            testIslandSleepAndExplicitWakeUp();
+            testSeparatingAxisOfPreviousFrame();
+        }
+
+        /// Scene with a stack of boxes on a static floor and a sphere falling far away from the stack
+        struct SleepingScene {
+
+            PhysicsWorld* world;
+            BoxShape* floorShape;
+            BoxShape* boxShape;
+            SphereShape* sphereShape;
+            std::vector<RigidBody*> stack;
+            RigidBody* fallingSphere;
+        };
+
+        SleepingScene createSleepingScene() {
+
+            SleepingScene scene;
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isSleepingEnabled = true;
+            scene.world = mPhysicsCommon.createPhysicsWorld(settings);
+            scene.world->setTimeBeforeSleep(decimal(0.2));
+
+            scene.floorShape = mPhysicsCommon.createBoxShape(Vector3(10, decimal(0.5), 10));
+            scene.boxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            scene.sphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+
+            RigidBody* floor = scene.world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(scene.floorShape, Transform::identity());
+
+            // Stack of boxes with a different mass for each box (the heaviest one at the bottom)
+            for (int i = 0; i < 4; i++) {
+                RigidBody* box = scene.world->createRigidBody(Transform(Vector3(0, decimal(0.5) + i * decimal(1.0), 0), Quaternion::identity()));
+                box->addCollider(scene.boxShape, Transform::identity());
+                box->setMass(decimal(4 - i));
+                scene.stack.push_back(box);
+            }
+
+            // Sphere falling far away from the stack (it is never put to sleep)
+            scene.fallingSphere = scene.world->createRigidBody(Transform(Vector3(100, 1000, 0), Quaternion::identity()));
+            scene.fallingSphere->addCollider(scene.sphereShape, Transform::identity());
+            scene.fallingSphere->setMass(decimal(7));
+
+            return scene;
+        }
+
+        void destroySleepingScene(SleepingScene& scene) {
+            mPhysicsCommon.destroyPhysicsWorld(scene.world);
+            mPhysicsCommon.destroyBoxShape(scene.floorShape);
+            mPhysicsCommon.destroyBoxShape(scene.boxShape);
+            mPhysicsCommon.destroySphereShape(scene.sphereShape);
+        }
+
+        /// Run the simulation until all the boxes of the stack are sleeping
+        bool simulateUntilStackIsSleeping(SleepingScene& scene) {
+
+            for (int frame = 0; frame < 600; frame++) {
+
+                scene.world->update(decimal(1.0 / 60.0));
+
+                bool isStackSleeping = true;
+                for (RigidBody* box : scene.stack) {
+                    isStackSleeping = isStackSleeping && box->isSleeping();
+                }
+                if (isStackSleeping) return true;
+            }
+
+            return false;
+        }
+
+        /// Test that the components of each body still belong to that body
+        void checkBodiesComponents(SleepingScene& scene) {
+
+            for (uint32 i = 0; i < scene.stack.size(); i++) {
+
+                RigidBody* box = scene.stack[i];
+                rp3d_test(approxEqual(box->getMass(), decimal(4 - i)));
+                rp3d_test(approxEqual(box->getTransform().getPosition().x, decimal(0.0), decimal(0.1)));
+                rp3d_test(approxEqual(box->getTransform().getPosition().y, decimal(0.5) + i * decimal(1.0), decimal(0.1)));
+                rp3d_test(approxEqual(box->getCollider(0)->getLocalToWorldTransform().getPosition(), box->getTransform().getPosition()));
+            }
+            rp3d_test(approxEqual(scene.fallingSphere->getMass(), decimal(7)));
+            rp3d_test(approxEqual(scene.fallingSphere->getCollider(0)->getLocalToWorldTransform().getPosition(),
+                                  scene.fallingSphere->getTransform().getPosition()));
+
+            // The exported state of each body is the state of that body
+            const uint32 nbBodies = scene.world->getNbRigidBodies();
+            std::vector<Vector3> positions(nbBodies);
+            scene.world->exportRigidBodiesState(positions.data(), nullptr, nullptr, nullptr);
+            for (uint32 i = 0; i < nbBodies; i++) {
+                rp3d_test(approxEqual(positions[i], scene.world->getRigidBody(i)->getTransform().getPosition()));
+            }
+        }
+
+        /// Test that the sleeping boxes are not simulated anymore while the other bodies are
+        void checkStackIsNotSimulated(SleepingScene& scene) {
+
+            std::vector<Vector3> positions;
+            for (RigidBody* box : scene.stack) {
+                positions.push_back(box->getTransform().getPosition());
+            }
+            const Vector3 spherePosition = scene.fallingSphere->getTransform().getPosition();
+
+            for (int frame = 0; frame < 10; frame++) {
+                scene.world->update(decimal(1.0 / 60.0));
+            }
+
+            for (uint32 i = 0; i < scene.stack.size(); i++) {
+                rp3d_test(scene.stack[i]->isSleeping());
+                rp3d_test(scene.stack[i]->getTransform().getPosition() == positions[i]);
+            }
+            rp3d_test(!scene.fallingSphere->isSleeping());
+            rp3d_test(scene.fallingSphere->getTransform().getPosition().y < spherePosition.y);
+        }
+
+        void testIslandSleepAndContactWakeUp() {
+
+            SleepingScene scene = createSleepingScene();
+
+            // The whole stack is put to sleep
+            rp3d_test(simulateUntilStackIsSleeping(scene));
+            checkBodiesComponents(scene);
+            checkStackIsNotSimulated(scene);
+            checkBodiesComponents(scene);
+
+            // Drop a box on the stack. The contact with the top box wakes up the whole island at once.
+            RigidBody* droppedBox = scene.world->createRigidBody(Transform(Vector3(0, decimal(5.0), 0), Quaternion::identity()));
+            droppedBox->addCollider(scene.boxShape, Transform::identity());
+            droppedBox->setLinearVelocity(Vector3(0, -2, 0));
+
+            bool isStackWokenUp = false;
+            for (int frame = 0; frame < 120 && !isStackWokenUp; frame++) {
+
+                scene.world->update(decimal(1.0 / 60.0));
+
+                uint32 nbAwakeBoxes = 0;
+                for (RigidBody* box : scene.stack) {
+                    if (!box->isSleeping()) nbAwakeBoxes++;
+                }
+
+                // The boxes of the island are all woken up in the same frame
+                rp3d_test(nbAwakeBoxes == 0 || nbAwakeBoxes == scene.stack.size());
+                isStackWokenUp = nbAwakeBoxes > 0;
+            }
+            rp3d_test(isStackWokenUp);
+            checkBodiesComponents(scene);
+
+            // The stack goes back to sleep with the dropped box on it
+            rp3d_test(simulateUntilStackIsSleeping(scene));
+            checkBodiesComponents(scene);
+
+            destroySleepingScene(scene);
+        }
+
+        void testIslandSleepAndExplicitWakeUp() {
+
+            SleepingScene scene = createSleepingScene();
+
+            rp3d_test(simulateUntilStackIsSleeping(scene));
+
+            // Waking up all the bodies at once
+            scene.world->enableSleeping(false);
+            for (RigidBody* box : scene.stack) {
+                rp3d_test(!box->isSleeping());
+            }
+            checkBodiesComponents(scene);
+            scene.world->update(decimal(1.0 / 60.0));
+            checkBodiesComponents(scene);
+
+            scene.world->enableSleeping(true);
+            rp3d_test(simulateUntilStackIsSleeping(scene));
+            checkBodiesComponents(scene);
+
+            // Waking up a single box of the island
+            scene.stack[1]->setIsSleeping(false);
+            rp3d_test(!scene.stack[1]->isSleeping());
+            rp3d_test(scene.stack[0]->isSleeping() && scene.stack[2]->isSleeping() && scene.stack[3]->isSleeping());
+            checkBodiesComponents(scene);
+
+            // Its contacts with the other boxes wake up the rest of the island
+            for (int frame = 0; frame < 2; frame++) {
+                scene.world->update(decimal(1.0 / 60.0));
+            }
+            for (RigidBody* box : scene.stack) {
+                rp3d_test(!box->isSleeping());
+            }
+            checkBodiesComponents(scene);
+
+            // Putting a box to sleep explicitly
+            rp3d_test(simulateUntilStackIsSleeping(scene));
+            scene.stack[3]->setIsSleeping(false);
+            scene.stack[3]->setIsSleeping(true);
+            checkBodiesComponents(scene);
+            checkStackIsNotSimulated(scene);
+
+            destroySleepingScene(scene);
+        }
+
+        void testFixedTimeStep() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.fixedTimeStep = decimal(0.1);
+            settings.maxNbFixedTimeSteps = 4;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+            world->setIsGravityEnabled(false);
+
+            RigidBody* body = world->createRigidBody(Transform::identity());
+            body->setLinearVelocity(Vector3(10, 0, 0));
+
+            rp3d_test(approxEqual(world->getFixedTimeStep(), decimal(0.1)));
+            rp3d_test(world->getMaxNbFixedTimeSteps() == 4);
+
+            // Not enough elapsed time for a step
+            rp3d_test(world->updateWithFixedTimeStep(decimal(0.05)) == 0);
+            rp3d_test(approxEqual(world->getInterpolationFactor(), decimal(0.5)));
+            rp3d_test(approxEqual(body->getTransform().getPosition(), Vector3::zero()));
+
+            // Two steps and a quarter of a step left
+            rp3d_test(world->updateWithFixedTimeStep(decimal(0.175)) == 2);
+            rp3d_test(approxEqual(world->getInterpolationFactor(), decimal(0.25), decimal(0.001)));
+            rp3d_test(approxEqual(body->getTransform().getPosition(), Vector3(2, 0, 0), decimal(0.001)));
+
+            Transform interpolatedTransforms[1];
+            world->getInterpolatedTransforms(interpolatedTransforms);
+            rp3d_test(approxEqual(interpolatedTransforms[0].getPosition(), Vector3(1.25, 0, 0), decimal(0.001)));
+
+            // Teleporting a body must not interpolate it from its old location
+            body->setTransform(Transform(Vector3(0, 5, 0), Quaternion::identity()));
+            body->resetTransformInterpolation();
+            world->getInterpolatedTransforms(interpolatedTransforms);
+            rp3d_test(approxEqual(interpolatedTransforms[0].getPosition(), Vector3(0, 5, 0), decimal(0.001)));
+
+            // The number of steps is clamped and the time that cannot be simulated is dropped
+            rp3d_test(world->updateWithFixedTimeStep(decimal(1.0)) == 4);
+            rp3d_test(world->getInterpolationFactor() < decimal(1.0));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        void testKinematicBodyInterpolation() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.fixedTimeStep = decimal(0.125);
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            RigidBody* body = world->createRigidBody(Transform::identity());
+            body->setType(BodyType::KINEMATIC);
+
+            Transform interpolatedTransforms[1];
+
+            // The kinematic body is moved by the application before each fixed time step
+            for (int step = 1; step <= 3; step++) {
+
+                body->setTransform(Transform(Vector3(decimal(step), 0, 0), Quaternion::identity()));
+
+                // The body is interpolated from its position at the end of the previous step
+                rp3d_test(world->updateWithFixedTimeStep(decimal(0.1875)) == 1);
+                world->getInterpolatedTransforms(interpolatedTransforms);
+                rp3d_test(approxEqual(interpolatedTransforms[0].getPosition(), Vector3(decimal(step - 1) + decimal(0.5), 0, 0), decimal(0.001)));
+
+                rp3d_test(world->updateWithFixedTimeStep(decimal(0.0625)) == 1);
+                world->getInterpolatedTransforms(interpolatedTransforms);
+                rp3d_test(approxEqual(interpolatedTransforms[0].getPosition(), Vector3(decimal(step), 0, 0), decimal(0.001)));
+            }
+
+            // A teleported kinematic body is not interpolated
+            body->setTransform(Transform(Vector3(10, 0, 0), Quaternion::identity()));
+            body->resetTransformInterpolation();
+            rp3d_test(world->updateWithFixedTimeStep(decimal(0.1875)) == 1);
+            world->getInterpolatedTransforms(interpolatedTransforms);
+            rp3d_test(approxEqual(interpolatedTransforms[0].getPosition(), Vector3(10, 0, 0), decimal(0.001)));
+
+            // A body moved before a step with a variable time step is interpolated from its
+            // position at the end of this step (not from its position before the first move)
+            body->setTransform(Transform(Vector3(20, 0, 0), Quaternion::identity()));
+            world->update(decimal(0.125));
+            body->setTransform(Transform(Vector3(21, 0, 0), Quaternion::identity()));
+            rp3d_test(world->updateWithFixedTimeStep(decimal(0.125)) == 1);
+            world->getInterpolatedTransforms(interpolatedTransforms);
+            rp3d_test(approxEqual(interpolatedTransforms[0].getPosition(), Vector3(decimal(20.5), 0, 0), decimal(0.001)));
+
+            // The transforms are written at the index of each body in the world even if the
+            // components of the sleeping bodies are stored after the other ones
+            RigidBody* body2 = world->createRigidBody(Transform(Vector3(0, 3, 0), Quaternion::identity()));
+            body->setType(BodyType::DYNAMIC);
+            body->setIsSleeping(true);
+            body2->setIsSleeping(false);
+            Transform interpolatedTransforms2[2];
+            world->getInterpolatedTransforms(interpolatedTransforms2);
+            rp3d_test(approxEqual(interpolatedTransforms2[0].getPosition(), Vector3(decimal(20.5), 0, 0), decimal(0.001)));
+            rp3d_test(approxEqual(interpolatedTransforms2[1].getPosition(), Vector3(0, 3, 0), decimal(0.001)));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        void testExportRigidBodiesState() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            world->setIsGravityEnabled(false);
+
+            RigidBody* staticBody = world->createRigidBody(Transform(Vector3(0, -5, 0), Quaternion::identity()));
+            staticBody->setType(BodyType::STATIC);
+            RigidBody* dynamicBody = world->createRigidBody(Transform(Vector3(1, 2, 3), Quaternion::identity()));
+            dynamicBody->setLinearVelocity(Vector3(1, 0, 0));
+            RigidBody* kinematicBody = world->createRigidBody(Transform::identity());
+            kinematicBody->setType(BodyType::KINEMATIC);
+
+            Vector3 positions[3];
+            Quaternion orientations[3];
+            Vector3 linearVelocities[3];
+            Vector3 angularVelocities[3];
+            uint32 indices[3];
+
+            // All the bodies are exported the first time
+            rp3d_test(world->exportRigidBodiesState(positions, orientations, linearVelocities, angularVelocities, indices, true) == 3);
+            rp3d_test(indices[0] == 0 && indices[1] == 1 && indices[2] == 2);
+            rp3d_test(approxEqual(positions[0], Vector3(0, -5, 0)));
+            rp3d_test(approxEqual(positions[1], Vector3(1, 2, 3)));
+            rp3d_test(approxEqual(linearVelocities[1], Vector3(1, 0, 0)));
+            rp3d_test(approxEqual(orientations[2].getVectorV(), Vector3::zero()));
+
+            // Nothing has changed since the last export
+            rp3d_test(world->exportRigidBodiesState(positions, nullptr, nullptr, nullptr, indices, true) == 0);
+
+            // After an update, only the moving bodies have changed
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(world->exportRigidBodiesState(positions, nullptr, nullptr, nullptr, indices, true) == 1);
+            rp3d_test(indices[0] == 1);
+            rp3d_test(approxEqual(positions[0], dynamicBody->getTransform().getPosition()));
+
+            // The kinematic body has changed once it moves
+            kinematicBody->setAngularVelocity(Vector3(0, 1, 0));
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(world->exportRigidBodiesState(positions, orientations, nullptr, nullptr, indices, true) == 2);
+            rp3d_test((indices[0] == 1 && indices[1] == 2) || (indices[0] == 2 && indices[1] == 1));
+            const uint32 kinematicExportIndex = indices[0] == 2 ? 0 : 1;
+            rp3d_test(approxEqual(orientations[kinematicExportIndex].getVectorV(), kinematicBody->getTransform().getOrientation().getVectorV()));
+            kinematicBody->setAngularVelocity(Vector3::zero());
+
+            // Set the state of the kinematic body in bulk
+            const uint32 kinematicIndex = 2;
+            const Vector3 kinematicPosition(4, 5, 6);
+            const Quaternion kinematicOrientation = Quaternion::identity();
+            const Vector3 kinematicVelocity(0, 2, 0);
+            world->setKinematicBodiesState(&kinematicIndex, 1, &kinematicPosition, &kinematicOrientation, &kinematicVelocity, nullptr);
+            rp3d_test(approxEqual(kinematicBody->getTransform().getPosition(), kinematicPosition));
+            rp3d_test(approxEqual(kinematicBody->getLinearVelocity(), kinematicVelocity));
+
+            // The state of a non kinematic body is not changed
+            const uint32 staticIndex = 0;
+            world->setKinematicBodiesState(&staticIndex, 1, &kinematicPosition, &kinematicOrientation, nullptr, nullptr);
+            rp3d_test(approxEqual(staticBody->getTransform().getPosition(), Vector3(0, -5, 0)));
+
+            // Export all the bodies
+            rp3d_test(world->exportRigidBodiesState(positions, orientations, linearVelocities, angularVelocities) == 3);
+            rp3d_test(approxEqual(positions[2], kinematicPosition));
+            rp3d_test(approxEqual(linearVelocities[2], kinematicVelocity));
+
+            // The bodies are still exported in the order of getRigidBody() after a body is destroyed
+            world->destroyRigidBody(staticBody);
+            rp3d_test(world->exportRigidBodiesState(positions, nullptr, nullptr, nullptr, indices) == 2);
+            rp3d_test(indices[0] == 0 && indices[1] == 1);
+            rp3d_test(approxEqual(positions[0], dynamicBody->getTransform().getPosition()));
+            rp3d_test(approxEqual(positions[1], kinematicPosition));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Simulate the cube stack scene of the testbed application and return a hash of the state of its
+        /// bodies. Static bodies that do not interact with the scene are added after the scene bodies to
+        /// change the state of the hash tables of the world.
+        uint64 simulateSceneAndComputeHash(bool isDeterministic, uint32 nbUnrelatedBodies) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isDeterministic = isDeterministic;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            // Same bodies as in the CubeStackScene of the testbed (pyramid of 15 floors of cubes on a floor)
+            const int nbFloors = 15;
+            const Vector3 boxSize(2, 2, 2);
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(decimal(0.5) * boxSize);
+            BoxShape* floorShape = mPhysicsCommon.createBoxShape(Vector3(25, decimal(0.5), 10));
+
+            std::vector<RigidBody*> boxes;
+            for (int i = 1; i <= nbFloors; i++) {
+                for (int j = 0; j < i; j++) {
+                    RigidBody* box = world->createRigidBody(Transform::identity());
+                    Collider* collider = box->addCollider(boxShape, Transform::identity());
+                    box->updateMassPropertiesFromColliders();
+                    collider->getMaterial().setBounciness(decimal(0.4));
+                    boxes.push_back(box);
+                }
+            }
+
+            RigidBody* floor = world->createRigidBody(Transform::identity());
+            floor->addCollider(floorShape, Transform::identity());
+            floor->updateMassPropertiesFromColliders();
+            floor->setType(BodyType::STATIC);
+            const uint32 nbSceneBodies = static_cast<uint32>(boxes.size()) + 1;
+
+            // Initial positions of the bodies (as in CubeStackScene::initBodiesPositions())
+            int index = 0;
+            for (int i = nbFloors; i > 0; i--) {
+                for (int j = 0; j < i; j++) {
+                    const Vector3 position((-i * decimal(0.5) + j) * (decimal(0.1) + boxSize.x),
+                                           boxSize.y + (nbFloors - i) * (boxSize.y + decimal(0.1)), 0);
+                    boxes[index]->setTransform(Transform(position, Quaternion::identity()));
+                    index++;
+                }
+            }
+
+            for (uint32 i = 0; i < nbUnrelatedBodies; i++) {
+                RigidBody* body = world->createRigidBody(Transform(Vector3(decimal(1000.0) + i * 10, 0, 0), Quaternion::identity()));
+                body->setType(BodyType::STATIC);
+                body->addCollider(boxShape, Transform::identity());
+            }
+
+            for (int i = 0; i < 300; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+
+            // Hash the state of the scene bodies (FNV-1a)
+            const uint32 nbBodies = world->getNbRigidBodies();
+            std::vector<Vector3> positions(nbBodies);
+            std::vector<Quaternion> orientations(nbBodies);
+            std::vector<Vector3> linearVelocities(nbBodies);
+            std::vector<Vector3> angularVelocities(nbBodies);
+            world->exportRigidBodiesState(positions.data(), orientations.data(), linearVelocities.data(), angularVelocities.data());
+
+            uint64 hash = 14695981039346656037ULL;
+            const auto hashBytes = [&hash](const void* data, size_t nbBytes) {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < nbBytes; i++) {
+                    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+                }
+            };
+            hashBytes(positions.data(), nbSceneBodies * sizeof(Vector3));
+            hashBytes(orientations.data(), nbSceneBodies * sizeof(Quaternion));
+            hashBytes(linearVelocities.data(), nbSceneBodies * sizeof(Vector3));
+            hashBytes(angularVelocities.data(), nbSceneBodies * sizeof(Vector3));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(floorShape);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+
+            return hash;
+        }
+
+        void testDeterministicSimulation() {
+
+            // Two identical simulations must give the same result
+            const uint64 hash = simulateSceneAndComputeHash(true, 0);
+            rp3d_test(simulateSceneAndComputeHash(true, 0) == hash);
+
+            // In deterministic mode, the result must not depend on the state of the hash tables
+            rp3d_test(simulateSceneAndComputeHash(true, 150) == hash);
+        }
+
+        /// Return a hash of the state of all the rigid bodies of a world
+        uint64 computeWorldStateHash(PhysicsWorld* world) {
+
+            const uint32 nbBodies = world->getNbRigidBodies();
+            std::vector<Vector3> positions(nbBodies);
+            std::vector<Quaternion> orientations(nbBodies);
+            std::vector<Vector3> linearVelocities(nbBodies);
+            std::vector<Vector3> angularVelocities(nbBodies);
+            world->exportRigidBodiesState(positions.data(), orientations.data(), linearVelocities.data(), angularVelocities.data());
+
+            uint64 hash = 14695981039346656037ULL;
+            const auto hashBytes = [&hash](const void* data, size_t nbBytes) {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < nbBytes; i++) {
+                    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+                }
+            };
+            hashBytes(positions.data(), nbBodies * sizeof(Vector3));
+            hashBytes(orientations.data(), nbBodies * sizeof(Quaternion));
+            hashBytes(linearVelocities.data(), nbBodies * sizeof(Vector3));
+            hashBytes(angularVelocities.data(), nbBodies * sizeof(Vector3));
+
+            return hash;
+        }
+
+        void testSnapshot() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isDeterministic = true;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            BoxShape* floorShape = mPhysicsCommon.createBoxShape(Vector3(20, decimal(0.5), 20));
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(floorShape, Transform::identity());
+
+            // Stack of boxes
+            for (int i = 0; i < 6; i++) {
+                RigidBody* box = world->createRigidBody(Transform(Vector3(decimal(0.1) * i, decimal(0.5) + i * decimal(1.05), 0), Quaternion::identity()));
+                box->addCollider(boxShape, Transform::identity());
+            }
+
+            // Pendulum made of two boxes linked with hinge joints
+            RigidBody* anchor = world->createRigidBody(Transform(Vector3(5, 6, 0), Quaternion::identity()));
+            anchor->setType(BodyType::STATIC);
+            RigidBody* link1 = world->createRigidBody(Transform(Vector3(7, 6, 0), Quaternion::identity()));
+            link1->addCollider(boxShape, Transform::identity());
+            RigidBody* link2 = world->createRigidBody(Transform(Vector3(9, 6, 0), Quaternion::identity()));
+            link2->addCollider(boxShape, Transform::identity());
+            HingeJointInfo jointInfo1(anchor, link1, Vector3(5, 6, 0), Vector3(0, 0, 1));
+            world->createJoint(jointInfo1);
+            HingeJointInfo jointInfo2(link1, link2, Vector3(8, 6, 0), Vector3(0, 0, 1));
+            Joint* joint2 = world->createJoint(jointInfo2);
+
+            for (int i = 0; i < 60; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+
+            // Take a snapshot of the world
+            std::vector<uint8> snapshot(world->getSnapshotSize());
+            rp3d_test(world->takeSnapshot(snapshot.data(), snapshot.size()) == snapshot.size());
+
+            // A buffer that is too small is rejected
+            rp3d_test(world->takeSnapshot(snapshot.data(), snapshot.size() - 1) == 0);
+
+            for (int i = 0; i < 30; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+            const uint64 hash = computeWorldStateHash(world);
+
+            // Restore the snapshot and simulate the same frames again
+            rp3d_test(world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            for (int i = 0; i < 30; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+            rp3d_test(computeWorldStateHash(world) == hash);
+
+            // A truncated or too long snapshot is rejected and the world is not modified
+            std::vector<uint8> worldState(world->getSnapshotSize());
+            world->takeSnapshot(worldState.data(), worldState.size());
+            rp3d_test(!world->restoreSnapshot(snapshot.data(), snapshot.size() - 1));
+            rp3d_test(!world->restoreSnapshot(snapshot.data(), snapshot.size() / 2));
+            rp3d_test(!world->restoreSnapshot(snapshot.data(), 2));
+            std::vector<uint8> longSnapshot(snapshot);
+            longSnapshot.push_back(0);
+            rp3d_test(!world->restoreSnapshot(longSnapshot.data(), longSnapshot.size()));
+            std::vector<uint8> newWorldState(world->getSnapshotSize());
+            world->takeSnapshot(newWorldState.data(), newWorldState.size());
+            rp3d_test(newWorldState == worldState);
+
+            // A snapshot cannot be restored if the joints of the world have changed. The bodies, which
+            // come first in the snapshot, are not restored either.
+            world->destroyJoint(joint2);
+            worldState.resize(world->getSnapshotSize());
+            world->takeSnapshot(worldState.data(), worldState.size());
+            rp3d_test(!world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            newWorldState.resize(world->getSnapshotSize());
+            world->takeSnapshot(newWorldState.data(), newWorldState.size());
+            rp3d_test(newWorldState == worldState);
+
+            // A snapshot cannot be restored if the bodies of the world have changed
+            world->createRigidBody(Transform::identity());
+            rp3d_test(!world->restoreSnapshot(snapshot.data(), snapshot.size()));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(floorShape);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        void testSnapshotWithReactivatedBodies() {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isDeterministic = true;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            BoxShape* floorShape = mPhysicsCommon.createBoxShape(Vector3(20, decimal(0.5), 20));
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(floorShape, Transform::identity());
+
+            // Stack of boxes
+            std::vector<RigidBody*> boxes;
+            std::vector<Collider*> boxColliders;
+            for (int i = 0; i < 4; i++) {
+                RigidBody* box = world->createRigidBody(Transform(Vector3(decimal(0.1) * i, decimal(0.5) + i * decimal(1.05), 0), Quaternion::identity()));
+                boxColliders.push_back(box->addCollider(boxShape, Transform::identity()));
+                boxes.push_back(box);
+            }
+
+            for (int i = 0; i < 30; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+
+            std::vector<uint8> snapshot(world->getSnapshotSize());
+            world->takeSnapshot(snapshot.data(), snapshot.size());
+            const int broadPhaseId0 = boxColliders[0]->getBroadPhaseId();
+            const int broadPhaseId1 = boxColliders[1]->getBroadPhaseId();
+
+            for (int i = 0; i < 30; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+            const uint64 hash = computeWorldStateHash(world);
+
+            // Deactivate and activate two bodies again such that their colliders swap their broad-phase nodes
+            rp3d_test(world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            boxes[0]->setIsActive(false);
+            boxes[1]->setIsActive(false);
+            boxes[0]->setIsActive(true);
+            boxes[1]->setIsActive(true);
+            rp3d_test(boxColliders[0]->getBroadPhaseId() == broadPhaseId1);
+            rp3d_test(boxColliders[1]->getBroadPhaseId() == broadPhaseId0);
+
+            // The broad-phase ids of the snapshot are restored with the broad-phase tree
+            rp3d_test(world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            rp3d_test(boxColliders[0]->getBroadPhaseId() == broadPhaseId0);
+            rp3d_test(boxColliders[1]->getBroadPhaseId() == broadPhaseId1);
+            for (int i = 0; i < 30; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+            rp3d_test(computeWorldStateHash(world) == hash);
+
+            // A snapshot where a collider is in the broad-phase cannot be restored if the collider is not in the broad-phase anymore
+            boxes[2]->setIsActive(false);
+            rp3d_test(!world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            rp3d_test(boxColliders[2]->getBroadPhaseId() == -1);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(floorShape);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        void testRemoveManyOverlappingPairs() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+            world->setIsGravityEnabled(false);
+
+            ContactPairsRecorder recorder;
+            world->setEventListener(&recorder);
+
+            // Flat height field (the spheres overlapping it create convex vs concave pairs)
+            const int nbGridColumns = 20;
+            const int nbGridRows = 20;
+            std::vector<float> heights(nbGridColumns * nbGridRows, 0.0f);
+            HeightFieldShape* heightFieldShape = mPhysicsCommon.createHeightFieldShape(nbGridColumns, nbGridRows, -1, 1, heights.data(),
+                                                                                       HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE);
+            RigidBody* ground = world->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            Collider* groundCollider = ground->addCollider(heightFieldShape, Transform::identity());
+
+            // Grid of overlapping spheres (the neighbor spheres create convex vs convex pairs)
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            std::vector<RigidBody*> spheres;
+            std::vector<Collider*> sphereColliders;
+            for (int x = 0; x < 8; x++) {
+                for (int z = 0; z < 8; z++) {
+                    RigidBody* sphere = world->createRigidBody(Transform(Vector3(decimal(-3.5) + x * decimal(0.9), decimal(0.3),
+                                                                                 decimal(-3.5) + z * decimal(0.9)), Quaternion::identity()));
+                    sphereColliders.push_back(sphere->addCollider(sphereShape, Transform::identity()));
+                    spheres.push_back(sphere);
+                }
+            }
+
+            world->update(decimal(1.0 / 60.0));
+            const std::set<ContactPairsRecorder::ColliderPair> initialPairs = recorder.startPairs;
+            rp3d_test(initialPairs.count(ContactPairsRecorder::makePair(groundCollider, sphereColliders[0])) == 1);
+            rp3d_test(initialPairs.count(ContactPairsRecorder::makePair(sphereColliders[0], sphereColliders[1])) == 1);
+
+            // Move every other sphere far away so that many pairs are removed in the same frame
+            std::set<Collider*> movedColliders;
+            for (uint32 i = 0; i < spheres.size(); i += 2) {
+                spheres[i]->setTransform(Transform(Vector3(decimal(100) + decimal(3) * i, decimal(100), 0), Quaternion::identity()));
+                movedColliders.insert(sphereColliders[i]);
+            }
+
+            recorder.reset();
+            world->update(decimal(1.0 / 60.0));
+
+            uint32 nbRemovedPairs = 0;
+            for (const ContactPairsRecorder::ColliderPair& pair : initialPairs) {
+
+                const bool isPairMoved = movedColliders.count(pair.first) == 1 || movedColliders.count(pair.second) == 1;
+
+                // The contact of the pairs with a moved sphere must be lost
+                if (isPairMoved) {
+                    rp3d_test(recorder.exitPairs.count(pair) == 1);
+                    rp3d_test(recorder.stayPairs.count(pair) == 0);
+                    nbRemovedPairs++;
+                }
+            }
+            rp3d_test(nbRemovedPairs > 64);
+
+            // The other spheres are still touching the ground
+            rp3d_test(recorder.stayPairs.count(ContactPairsRecorder::makePair(groundCollider, sphereColliders[1])) == 1);
+            for (const ContactPairsRecorder::ColliderPair& pair : recorder.startPairs) {
+                rp3d_test(movedColliders.count(pair.first) == 0 && movedColliders.count(pair.second) == 0);
+            }
+
+            // Move the spheres back to check that the removed pairs can be created again
+            for (uint32 i = 0; i < spheres.size(); i += 2) {
+                spheres[i]->setTransform(Transform(Vector3(decimal(-3.5) + (i / 8) * decimal(0.9), decimal(0.3),
+                                                           decimal(-3.5) + (i % 8) * decimal(0.9)), Quaternion::identity()));
+            }
+
+            recorder.reset();
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(recorder.startPairs.count(ContactPairsRecorder::makePair(groundCollider, sphereColliders[0])) == 1);
+            rp3d_test(recorder.startPairs.count(ContactPairsRecorder::makePair(sphereColliders[0], sphereColliders[1])) == 1);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroySphereShape(sphereShape);
+            mPhysicsCommon.destroyHeightFieldShape(heightFieldShape);
+        }
+
+        /// Scene with a capsule moving near the corner of a static box and a capsule moving above a static height field
+        struct SeparatingAxisScene {
+
+            PhysicsWorld* world;
+            ContactPointsRecorder recorder;
+            std::vector<RigidBody*> capsules;
+            std::vector<Collider*> capsuleColliders;
+        };
+
+        void createSeparatingAxisScene(SeparatingAxisScene& scene, BoxShape* boxShape, CapsuleShape* capsuleShape,
+                                       HeightFieldShape* heightFieldShape) {
+
+            scene.world = mPhysicsCommon.createPhysicsWorld();
+            scene.world->setEventListener(&scene.recorder);
+
+            RigidBody* box = scene.world->createRigidBody(Transform::identity());
+            box->setType(BodyType::STATIC);
+            box->addCollider(boxShape, Transform::identity());
+
+            RigidBody* ground = scene.world->createRigidBody(Transform(Vector3(20, 0, 0), Quaternion::identity()));
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(heightFieldShape, Transform::identity());
+
+            for (int i = 0; i < 2; i++) {
+                RigidBody* capsule = scene.world->createRigidBody(Transform(Vector3(20 * i, 10, 0), Quaternion::identity()));
+                capsule->setType(BodyType::KINEMATIC);
+                scene.capsuleColliders.push_back(capsule->addCollider(capsuleShape, Transform::identity()));
+                scene.capsules.push_back(capsule);
+                scene.recorder.movingBodies.push_back(capsule);
+            }
+        }
+
+        void testSeparatingAxisOfPreviousFrame() {
+
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(1, 1, 1));
+            CapsuleShape* capsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.5), decimal(1.0));
+
+            // Height field with a slope along the x axis (the height is 0.5 * x in local-space). The AABBs of its
+            // triangles overlap the AABB of the capsule even when the capsule is separated from the slope.
+            std::vector<float> heights(20 * 20);
+            for (int i = 0; i < 20 * 20; i++) {
+                heights[i] = 0.5f * (i % 20);
+            }
+            HeightFieldShape* heightFieldShape = mPhysicsCommon.createHeightFieldShape(20, 20, 0, decimal(9.5), heights.data(),
+                                                                                       HeightFieldShape::HeightDataType::HEIGHT_FLOAT_TYPE);
+
+            // In the first world, the overlapping pairs are kept between frames and the shapes that are still
+            // separated along the separating axis of the previous frame are not tested in the narrow-phase. In
+            // the second world, the colliders of the capsules are created again at each frame (no previous frame).
+            SeparatingAxisScene cachedScene;
+            SeparatingAxisScene referenceScene;
+            createSeparatingAxisScene(cachedScene, boxShape, capsuleShape, heightFieldShape);
+            createSeparatingAxisScene(referenceScene, boxShape, capsuleShape, heightFieldShape);
+
+            // Heights of the capsules at each frame. The capsules stay close enough to the static shapes to keep
+            // their overlapping pairs but only touch them twice.
+            const decimal boxHeights[10] = {decimal(0.95), decimal(0.9), decimal(0.85), decimal(0.8), decimal(0.7),
+                                            decimal(0.8), decimal(0.9), decimal(0.85), decimal(0.68), decimal(0.95)};
+            const decimal groundHeights[10] = {decimal(1.2), decimal(1.18), decimal(1.15), decimal(1.12), decimal(0.95),
+                                               decimal(1.15), decimal(1.2), decimal(1.13), decimal(0.97), decimal(1.2)};
+
+            for (int frame = 0; frame < 10; frame++) {
+
+                const decimal shift = decimal(0.01) * (frame % 3);
+                const Transform boxCapsuleTransform(Vector3(decimal(1.3) + shift, 1 + boxHeights[frame], decimal(1.3) - shift), Quaternion::identity());
+                const Transform groundCapsuleTransform(Vector3(20 + shift, groundHeights[frame], -shift), Quaternion::identity());
+
+                for (SeparatingAxisScene* scene : {&cachedScene, &referenceScene}) {
+
+                    scene->capsules[0]->setTransform(boxCapsuleTransform);
+                    scene->capsules[1]->setTransform(groundCapsuleTransform);
+                    scene->recorder.reset();
+                }
+
+                for (int i = 0; i < 2; i++) {
+                    referenceScene.capsules[i]->removeCollider(referenceScene.capsuleColliders[i]);
+                    referenceScene.capsuleColliders[i] = referenceScene.capsules[i]->addCollider(capsuleShape, Transform::identity());
+                }
+
+                cachedScene.world->update(decimal(1.0 / 60.0));
+                referenceScene.world->update(decimal(1.0 / 60.0));
+
+                const bool isTouching = frame == 4 || frame == 8;
+
+                for (int i = 0; i < 2; i++) {
+
+                    const std::vector<ContactPointsRecorder::ContactPointData>& points = cachedScene.recorder.contactPoints[i];
+                    const std::vector<ContactPointsRecorder::ContactPointData>& referencePoints = referenceScene.recorder.contactPoints[i];
+
+                    rp3d_test(points.empty() != isTouching);
+                    rp3d_test(points.size() == referencePoints.size());
+
+                    // Each contact point must have the same contact point in the reference world
+                    for (const ContactPointsRecorder::ContactPointData& point : points) {
+
+                        bool isPointFound = false;
+                        for (const ContactPointsRecorder::ContactPointData& referencePoint : referencePoints) {
+                            isPointFound = isPointFound || (approxEqual(point.worldPoint, referencePoint.worldPoint, decimal(0.001)) &&
+                                                            approxEqual(point.worldNormal, referencePoint.worldNormal, decimal(0.001)) &&
+                                                            approxEqual(point.penetrationDepth, referencePoint.penetrationDepth, decimal(0.001)));
+                        }
+                        rp3d_test(isPointFound);
+                    }
+                }
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(cachedScene.world);
+            mPhysicsCommon.destroyPhysicsWorld(referenceScene.world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+            mPhysicsCommon.destroyCapsuleShape(capsuleShape);
+            mPhysicsCommon.destroyHeightFieldShape(heightFieldShape);
+        }
+ };
+
+}
+
+#endif